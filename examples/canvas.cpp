@@ -0,0 +1,150 @@
+/***********************************************************************
+* canvas.cpp - Shows the use of the FCanvas widget                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cmath>
+
+#include <final/final.h>
+
+namespace fc = finalcut::fc;
+using finalcut::FPoint;
+using finalcut::FSize;
+
+//----------------------------------------------------------------------
+// class Dialog
+//----------------------------------------------------------------------
+
+class Dialog final : public finalcut::FDialog
+{
+  public:
+    explicit Dialog (FWidget* parent = nullptr);
+
+  private:
+    // Methods
+    void drawGraph();
+
+    // Event handlers
+    void onShow (finalcut::FShowEvent*) override;
+    void onTimer (finalcut::FTimerEvent*) override;
+    void onKeyPress (finalcut::FKeyEvent*) override;
+
+    // Data members
+    finalcut::FCanvas canvas{this};
+    finalcut::FLabel  label{this};
+    int               phase{0};
+};
+
+//----------------------------------------------------------------------
+Dialog::Dialog (FWidget* parent)
+  : finalcut::FDialog{parent}
+{
+  FDialog::setText ("Canvas");
+  finalcut::FDialog::setGeometry (FPoint{8, 3}, FSize{64, 20});
+  canvas.setGeometry (FPoint{2, 1}, FSize{60, 15});
+  canvas.setPixelMode (finalcut::FCanvas::Braille);
+  label.setGeometry (FPoint{2, 17}, FSize{60, 1});
+  label << "<m> change pixel mode   <q> quit";
+}
+
+//----------------------------------------------------------------------
+void Dialog::drawGraph()
+{
+  // Draws two sine waves with a phase shift
+
+  const auto width = int(canvas.getPixelWidth());
+  const auto height = int(canvas.getPixelHeight());
+  const double amplitude = double(height - 1) / 2.0;
+  FPoint last1{}, last2{};
+  canvas.clear();
+  canvas.drawLine (FPoint{0, height / 2}, FPoint{width - 1, height / 2}
+                  , fc::LightGray);
+
+  for (int x{0}; x < width; x++)
+  {
+    const double angle = double(x + phase) / 10.0;
+    const FPoint p1{x, int(amplitude * (1.0 - std::sin(angle)))};
+    const FPoint p2{x, int(amplitude * (1.0 - 0.5 * std::cos(angle)))};
+
+    if ( x > 0 )
+    {
+      canvas.drawLine (last1, p1, fc::LightGreen);
+      canvas.drawLine (last2, p2, fc::LightRed);
+    }
+
+    last1 = p1;
+    last2 = p2;
+  }
+}
+
+//----------------------------------------------------------------------
+void Dialog::onShow (finalcut::FShowEvent*)
+{
+  addTimer(50);
+}
+
+//----------------------------------------------------------------------
+void Dialog::onTimer (finalcut::FTimerEvent*)
+{
+  phase++;
+  drawGraph();  // The canvas schedules its own redraw
+}
+
+//----------------------------------------------------------------------
+void Dialog::onKeyPress (finalcut::FKeyEvent* ev)
+{
+  if ( ! ev )
+    return;
+
+  if ( ev->key() == 'm' )
+  {
+    const auto mode = canvas.getPixelMode();
+
+    if ( mode == finalcut::FCanvas::HalfBlock )
+      canvas.setPixelMode (finalcut::FCanvas::Quadrant);
+    else if ( mode == finalcut::FCanvas::Quadrant )
+      canvas.setPixelMode (finalcut::FCanvas::Braille);
+    else
+      canvas.setPixelMode (finalcut::FCanvas::HalfBlock);
+
+    ev->accept();
+  }
+  else if ( ev->key() == 'q' )
+  {
+    close();
+    ev->accept();
+  }
+  else
+    finalcut::FDialog::onKeyPress(ev);
+}
+
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+
+int main (int argc, char* argv[])
+{
+  finalcut::FApplication app(argc, argv);
+  Dialog dialog(&app);
+  finalcut::FWidget::setMainWidget(&dialog);
+  dialog.show();
+  return app.exec();
+}
@@ -176,11 +176,16 @@ void Listview::populate()
     {{ "Zurich", "Mostly Cloudy", "23°C", "44%", "1023.7 mb" }}
   }};
 
+  // Sort only once after the last insertion
+  listview.beginUpdate();
+
   for (const auto& place : weather)
   {
     const finalcut::FStringList line (place.begin(), place.end());
     listview.insert (line);
   }
+
+  listview.endUpdate();
 }
 
 //----------------------------------------------------------------------
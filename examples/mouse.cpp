@@ -119,7 +119,7 @@ void ColorChooser::draw()
 
   for (FColor c{0}; c < 16; c++)
   {
-    print() << FPoint{2 + (c / 8) * 3, 3 + c % 8};
+    print() << FPoint{2 + int(c / 8) * 3, 3 + int(c % 8)};
 
     if ( c < 6 )
       setColor (fc::LightGray, c);
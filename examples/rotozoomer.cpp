@@ -20,11 +20,14 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include <chrono>
 #include <iomanip>
 #include <string>
+#include <vector>
 
 #include <final/final.h>
 
@@ -32,7 +35,6 @@ namespace fc = finalcut::fc;
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
 using std::chrono::system_clock;
-using std::chrono::time_point;
 using finalcut::FPoint;
 using finalcut::FSize;
 
@@ -68,17 +70,21 @@ class RotoZoomer final : public finalcut::FDialog
     // Methods
     void draw() override;
     void rotozoomer (double, double, double, double);
+    void blitRotozoomer (double, double, double, double);
+    int  runBenchmark();
     void generateReport();
     void adjustSize() override;
 
     // Data member
     bool                     benchmark{false};
+    bool                     use_blit{true};
     int                      loops{0};
     int                      path{0};
+    int                      print_ms{0};
+    int                      blit_ms{0};
     std::wstring             data{std::wstring(256, L'\0')};
+    std::vector<finalcut::FChar> screen{};
     finalcut::FString        report{};
-    time_point<system_clock> start{};
-    time_point<system_clock> end{};
 };
 
 
@@ -130,15 +136,16 @@ RotoZoomer::~RotoZoomer()
 //----------------------------------------------------------------------
 void RotoZoomer::draw()
 {
-  if ( benchmark && start == time_point<system_clock>() )
-    start = system_clock::now();
-
   finalcut::FDialog::draw();
   auto cx = double(80.0 / 2.0 + (80.0 / 2.0 * std::sin(double(path) / 50.0)));
   auto cy = double(23.0 + (23.0 * std::cos(double(path) / 50.0)));
   auto r  = double(128.0 + 96.0 * std::cos(double(path) / 10.0));
   auto a  = double(path) / 50.0;
-  rotozoomer (cx, cy, r, a);
+
+  if ( use_blit )
+    blitRotozoomer (cx, cy, r, a);
+  else
+    rotozoomer (cx, cy, r, a);
 }
 
 //----------------------------------------------------------------------
@@ -184,28 +191,124 @@ void RotoZoomer::rotozoomer (double cx, double cy, double r, double a)
   }
 }
 
+//----------------------------------------------------------------------
+void RotoZoomer::blitRotozoomer (double cx, double cy, double r, double a)
+{
+  // Renders the frame into a cell buffer and copies it
+  // to the window with a single blit() call
+
+  const auto Cols = int(getClientWidth());
+  const auto Lines = int(getClientHeight());
+
+  if ( Cols <= 0 || Lines <= 0 )
+    return;
+
+  auto Ax   = int(4096.0 * (cx + r * std::cos(a)));
+  auto Ay   = int(4096.0 * (cy + r * std::sin(a)));
+  auto Bx   = int(4096.0 * (cx + r * std::cos(a + 2.02358)));
+  auto By   = int(4096.0 * (cy + r * std::sin(a + 2.02358)));
+  auto Cx   = int(4096.0 * (cx + r * std::cos(a - 1.11701)));
+  auto Cy   = int(4096.0 * (cy + r * std::sin(a - 1.11701)));
+  int  dxdx = (Bx - Ax) / 80;
+  int  dydx = (By - Ay) / 80;
+  int  dxdy = (Cx - Ax) / 23;
+  int  dydy = (Cy - Ay) / 23;
+
+  // Cell templates for the three colors
+  finalcut::FChar cell = getAttribute();
+  cell.ch = { L'\0' };
+  cell.attr.byte[2] = 0;
+  cell.attr.byte[3] = 0;
+  cell.attr.bit.char_width = 1;
+  cell.fg_color = fc::Black;
+  finalcut::FChar red_cell{cell};
+  finalcut::FChar cyan_cell{cell};
+  finalcut::FChar white_cell{cell};
+  red_cell.bg_color = fc::Red;
+  cyan_cell.bg_color = fc::Cyan;
+  white_cell.bg_color = fc::White;
+  screen.resize(std::size_t(Cols * Lines));
+  auto cells = screen.begin();
+
+  for (auto y = 0; y < Lines; y++)
+  {
+    Cx = Ax;
+    Cy = Ay;
+
+    for (auto x = 0; x < Cols; x++)
+    {
+      auto ch = data[((Cy >> 14) & 0xf) + ((Cx >> 10) & 0xf0)];
+
+      if ( ch == '+' )
+        *cells = red_cell;
+      else if ( ch == 'x' )
+        *cells = cyan_cell;
+      else
+        *cells = white_cell;
+
+      cells->ch[0] = ch;
+      ++cells;
+      Cx += dxdx;
+      Cy += dydx;
+    }
+
+    Ax += dxdy;
+    Ay += dydy;
+  }
+
+  print() << FPoint{2, 3};
+  blit (FSize{std::size_t(Cols), std::size_t(Lines)}, screen.data());
+}
+
+//----------------------------------------------------------------------
+int RotoZoomer::runBenchmark()
+{
+  // Returns the elapsed time in milliseconds
+
+  const auto start = system_clock::now();
+
+  for (path = 1; path < loops; path++)
+  {
+    redraw();
+    forceTerminalUpdate();
+  }
+
+  const auto end = system_clock::now();
+  return int(duration_cast<milliseconds>(end - start).count());
+}
+
 //----------------------------------------------------------------------
 void RotoZoomer::generateReport()
 {
   finalcut::FString term_type = finalcut::FTerm::getTermType();
   finalcut::FString dimension_str{};
-  finalcut::FString time_str{};
-  finalcut::FString fps_str{};
   finalcut::FStringStream rep;
   dimension_str << getDesktopWidth()
                 << "x" << getDesktopHeight();
-  int elapsed_ms = int(duration_cast<milliseconds>(end - start).count());
-  time_str << double(elapsed_ms) / 1000 << "s";
-  fps_str << double(loops) * 1000.0 / double(elapsed_ms);
-
-  rep << finalcut::FString{55, '-'} << "\n"
-      << "Terminal            Size    Time      Loops  Frame rate\n"
-      << finalcut::FString{55, '-'} << "\n"
-      << std::left << std::setw(20) << term_type
-      << std::setw(8) << dimension_str
-      << std::setw(10) << time_str
-      << std::setw(7) << loops
-      << std::setw(7) << fps_str.left(7) << "fps\n";
+
+  rep << finalcut::FString{62, '-'} << "\n"
+      << "Terminal            Size    Method Time      Loops  Frame rate\n"
+      << finalcut::FString{62, '-'} << "\n";
+
+  for (auto method : {"print", "blit"})
+  {
+    const bool blit_method = ( std::strcmp(method, "blit") == 0 );
+    const int elapsed_ms = std::max(blit_method ? blit_ms : print_ms, 1);
+    finalcut::FString time_str{};
+    finalcut::FString fps_str{};
+    time_str << double(elapsed_ms) / 1000 << "s";
+    fps_str << double(loops) * 1000.0 / double(elapsed_ms);
+    rep << std::left << std::setw(20) << term_type
+        << std::setw(8) << dimension_str
+        << std::setw(7) << method
+        << std::setw(10) << time_str
+        << std::setw(7) << loops
+        << std::setw(7) << fps_str.left(7) << "fps\n";
+  }
+
+  finalcut::FString gain_str{};
+  gain_str << double(std::max(print_ms, 1)) / double(std::max(blit_ms, 1));
+  rep << "Speedup with blit(): " << gain_str.left(5) << "x\n";
   report << rep.str();
 }
 
@@ -222,13 +325,11 @@ void RotoZoomer::onShow (finalcut::FShowEvent*)
     addTimer(33);  // Starts the timer every 33 milliseconds
   else
   {
-    for (path = 1; path < loops; path++)
-    {
-      redraw();
-      forceTerminalUpdate();
-    }
-
-    end = system_clock::now();
+    // Per-cell print() versus block copy with blit()
+    use_blit = false;
+    print_ms = runBenchmark();
+    use_blit = true;
+    blit_ms = runBenchmark();
     generateReport();
     flush();
     close();
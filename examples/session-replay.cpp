@@ -0,0 +1,611 @@
+/***********************************************************************
+* session-replay.cpp - Replays a recorded terminal session             *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <final/final.h>
+
+/*  Replays the input of a session that was recorded with the
+ *  --record=<FILE> option (asciicast v2) and measures the output
+ *  of the program for each recorded input event.
+ *
+ *  The program runs in a pseudo terminal with the recorded size.
+ *  After each input, the output is read until the program has
+ *  been silent for the settle time. The table compares the
+ *  recorded output (bytes and frames) with the replayed output
+ *  and shows the time to the first output byte (latency) and to
+ *  the last output byte (done). Replayed frames are the output
+ *  blocks read from the pseudo terminal.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+//----------------------------------------------------------------------
+// struct Interaction
+//----------------------------------------------------------------------
+
+struct Interaction
+{
+  double      time{0.0};           // Recording time of the input
+  std::string input{};             // Raw input bytes
+  std::size_t recorded_bytes{0};   // Recorded output after the input
+  std::size_t recorded_frames{0};
+  std::size_t bytes{0};            // Replayed output after the input
+  std::size_t frames{0};
+  double      latency{-1.0};       // Milliseconds to the first byte
+  double      done{0.0};           // Milliseconds to the last byte
+};
+
+//----------------------------------------------------------------------
+// struct Recording
+//----------------------------------------------------------------------
+
+struct Recording
+{
+  std::size_t width{80};
+  std::size_t height{24};
+  std::string term{"xterm"};
+  std::size_t startup_bytes{0};    // Recorded output before the first input
+  std::size_t startup_frames{0};
+  std::vector<Interaction> interactions{};
+};
+
+
+//----------------------------------------------------------------------
+// Recording file parser
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+void appendUTF8 (std::string& str, unsigned long code)
+{
+  if ( code < 0x80 )
+    str += char(code);
+  else if ( code < 0x800 )
+  {
+    str += char(0xc0 | (code >> 6));
+    str += char(0x80 | (code & 0x3f));
+  }
+  else if ( code < 0x10000 )
+  {
+    str += char(0xe0 | (code >> 12));
+    str += char(0x80 | ((code >> 6) & 0x3f));
+    str += char(0x80 | (code & 0x3f));
+  }
+  else
+  {
+    str += char(0xf0 | (code >> 18));
+    str += char(0x80 | ((code >> 12) & 0x3f));
+    str += char(0x80 | ((code >> 6) & 0x3f));
+    str += char(0x80 | (code & 0x3f));
+  }
+}
+
+//----------------------------------------------------------------------
+bool parseJsonString ( const std::string& line, std::size_t& pos
+                     , std::string& str )
+{
+  // Reads the JSON string at pos. FTermRecorder writes valid UTF-8
+  // unescaped, so the escapes \u0080 to \u00ff stand for single raw
+  // bytes (e.g. X10 mouse coordinates) and must not be converted to
+  // UTF-8. Higher code points come from other asciicast writers.
+
+  str.clear();
+  pos = line.find('"', pos);
+
+  if ( pos == std::string::npos )
+    return false;
+
+  pos++;
+
+  while ( pos < line.length() && line[pos] != '"' )
+  {
+    char ch = line[pos++];
+
+    if ( ch != '\\' )
+    {
+      str += ch;
+      continue;
+    }
+
+    if ( pos >= line.length() )
+      return false;
+
+    ch = line[pos++];
+
+    switch ( ch )
+    {
+      case 'b': str += '\b'; break;
+      case 'f': str += '\f'; break;
+      case 'n': str += '\n'; break;
+      case 'r': str += '\r'; break;
+      case 't': str += '\t'; break;
+
+      case 'u':
+      {
+        if ( pos + 4 > line.length() )
+          return false;
+
+        auto code = std::strtoul(line.substr(pos, 4).c_str(), nullptr, 16);
+        pos += 4;
+
+        if ( code >= 0xd800 && code < 0xdc00
+          && line.compare(pos, 2, "\\u") == 0 && pos + 6 <= line.length() )
+        {
+          // UTF-16 surrogate pair
+          const auto low = std::strtoul ( line.substr(pos + 2, 4).c_str()
+                                        , nullptr, 16 );
+
+          if ( low >= 0xdc00 && low < 0xe000 )
+          {
+            pos += 6;
+            code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+          }
+        }
+
+        if ( code < 0x100 )
+          str += char(code);  // Raw byte
+        else
+          appendUTF8 (str, code);
+
+        break;
+      }
+
+      default:  // '"', '\\' and '/'
+        str += ch;
+    }
+  }
+
+  pos++;  // Skip the closing quote
+  return true;
+}
+
+//----------------------------------------------------------------------
+std::size_t getHeaderValue (const std::string& header, const char key[])
+{
+  const auto pos = header.find(key);
+
+  if ( pos == std::string::npos )
+    return 0;
+
+  return std::strtoul(header.c_str() + pos + std::strlen(key), nullptr, 10);
+}
+
+//----------------------------------------------------------------------
+bool readRecording (const char filename[], Recording& rec)
+{
+  std::ifstream file{filename};
+  std::string line{};
+
+  if ( ! file || ! std::getline(file, line) )
+    return false;
+
+  // Header
+  if ( getHeaderValue(line, "\"version\":") != 2 )
+    return false;
+
+  if ( const auto w = getHeaderValue(line, "\"width\":") )
+    rec.width = w;
+
+  if ( const auto h = getHeaderValue(line, "\"height\":") )
+    rec.height = h;
+
+  std::size_t pos = line.find("\"TERM\":");
+  std::string term{};
+
+  if ( pos != std::string::npos
+    && parseJsonString(line, pos += 7, term) && ! term.empty() )
+    rec.term = term;
+
+  // Events
+  std::string data{};
+
+  while ( std::getline(file, line) )
+  {
+    if ( line.empty() || line[0] != '[' )
+      continue;
+
+    const double time = std::strtod(line.c_str() + 1, nullptr);
+    pos = line.find(',');
+    std::string type{};
+
+    if ( pos == std::string::npos
+      || ! parseJsonString(line, pos, type)
+      || ! parseJsonString(line, pos, data) )
+      continue;
+
+    if ( type == "i" )
+    {
+      Interaction interaction{};
+      interaction.time = time;
+      interaction.input = data;
+      rec.interactions.push_back(interaction);
+    }
+    else if ( type == "o" && rec.interactions.empty() )
+    {
+      rec.startup_bytes += data.length();
+      rec.startup_frames++;
+    }
+    else if ( type == "o" )
+    {
+      rec.interactions.back().recorded_bytes += data.length();
+      rec.interactions.back().recorded_frames++;
+    }
+  }
+
+  return true;
+}
+
+
+//----------------------------------------------------------------------
+// class SessionReplay
+//----------------------------------------------------------------------
+
+class SessionReplay final
+{
+  public:
+    // Constructor
+    SessionReplay (Recording&, int, int);
+
+    // Destructor
+    ~SessionReplay();
+
+    // Methods
+    bool start (char*[]);
+    void run (bool);
+    void printReport() const;
+
+  private:
+    // Methods
+    void readOutput ( Clock::time_point, int
+                    , std::size_t&, std::size_t&
+                    , double* = nullptr, double* = nullptr );
+    void stopProgram();
+
+    // Data members
+    Recording&  recording;
+    int         settle_time{};      // Milliseconds without output
+    int         startup_time{};
+    int         master_fd{-1};
+    pid_t       child{-1};
+    std::size_t startup_bytes{0};
+    std::size_t startup_frames{0};
+};
+
+//----------------------------------------------------------------------
+SessionReplay::SessionReplay (Recording& rec, int settle, int startup)
+  : recording{rec}
+  , settle_time{settle}
+  , startup_time{startup}
+{ }
+
+//----------------------------------------------------------------------
+SessionReplay::~SessionReplay()
+{
+  stopProgram();
+}
+
+//----------------------------------------------------------------------
+bool SessionReplay::start (char* argv[])
+{
+  // Starts the program in a pseudo terminal
+
+  master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+  if ( master_fd < 0 || grantpt(master_fd) != 0 || unlockpt(master_fd) != 0 )
+    return false;
+
+  const char* slave_name = ptsname(master_fd);
+
+  if ( ! slave_name )
+    return false;
+
+  struct winsize size{};
+  size.ws_row = static_cast<unsigned short>(recording.height);
+  size.ws_col = static_cast<unsigned short>(recording.width);
+  child = fork();
+
+  if ( child < 0 )
+    return false;
+
+  if ( child == 0 )
+  {
+    // Child process: the slave side becomes the controlling terminal
+    setsid();
+    const int slave_fd = open(slave_name, O_RDWR);
+
+    if ( slave_fd < 0 )
+      _exit(EXIT_FAILURE);
+
+#if defined(TIOCSCTTY)
+    ioctl (slave_fd, TIOCSCTTY, 0);
+#endif
+    ioctl (slave_fd, TIOCSWINSZ, &size);
+    dup2 (slave_fd, STDIN_FILENO);
+    dup2 (slave_fd, STDOUT_FILENO);
+    dup2 (slave_fd, STDERR_FILENO);
+
+    if ( slave_fd > STDERR_FILENO )
+      close (slave_fd);
+
+    close (master_fd);
+    setenv ("TERM", recording.term.c_str(), 1);
+    execvp (argv[0], argv);
+    _exit(EXIT_FAILURE);
+  }
+
+  ioctl (master_fd, TIOCSWINSZ, &size);
+  readOutput (Clock::now(), startup_time, startup_bytes, startup_frames);
+  return true;
+}
+
+//----------------------------------------------------------------------
+void SessionReplay::run (bool realtime)
+{
+  const auto replay_start = Clock::now();
+  const double first_time = recording.interactions.empty()
+                          ? 0.0 : recording.interactions[0].time;
+
+  for (auto&& interaction : recording.interactions)
+  {
+    if ( realtime )
+    {
+      // Keep the recorded distance between the input events
+      const auto offset = std::chrono::duration<double>
+                          (interaction.time - first_time);
+      std::this_thread::sleep_until
+        (replay_start + std::chrono::duration_cast<Clock::duration>(offset));
+    }
+
+    const auto& input = interaction.input;
+    const auto sent = Clock::now();
+
+    if ( write(master_fd, input.data(), input.length()) < 0 )
+      break;
+
+    readOutput ( sent, settle_time
+               , interaction.bytes, interaction.frames
+               , &interaction.latency, &interaction.done );
+  }
+}
+
+//----------------------------------------------------------------------
+void SessionReplay::readOutput ( Clock::time_point since, int quiet_ms
+                               , std::size_t& bytes, std::size_t& frames
+                               , double* first, double* last )
+{
+  // Reads the program output until it is silent for quiet_ms
+
+  using milliseconds = std::chrono::duration<double, std::milli>;
+  std::array<char, 65536> buffer{};
+  struct pollfd pfd{};
+  pfd.fd = master_fd;
+  pfd.events = POLLIN;
+
+  while ( poll(&pfd, 1, quiet_ms) > 0 )
+  {
+    const ssize_t n = read(master_fd, buffer.data(), buffer.size());
+
+    if ( n <= 0 )  // The program has ended
+      break;
+
+    const double elapsed = milliseconds(Clock::now() - since).count();
+
+    if ( first && *first < 0.0 )
+      *first = elapsed;
+
+    if ( last )
+      *last = elapsed;
+
+    bytes += std::size_t(n);
+    frames++;
+  }
+}
+
+//----------------------------------------------------------------------
+void SessionReplay::stopProgram()
+{
+  if ( master_fd >= 0 )
+  {
+    close (master_fd);  // Sends SIGHUP to the program
+    master_fd = -1;
+  }
+
+  if ( child <= 0 )
+    return;
+
+  for (int i{0}; i < 100; i++)
+  {
+    if ( waitpid(child, nullptr, WNOHANG) != 0 )
+    {
+      child = -1;
+      return;
+    }
+
+    std::this_thread::sleep_for (std::chrono::milliseconds(10));
+  }
+
+  kill (child, SIGKILL);
+  waitpid (child, nullptr, 0);
+  child = -1;
+}
+
+//----------------------------------------------------------------------
+std::string getPrintableInput (const std::string& input)
+{
+  std::string str{};
+
+  for (auto&& ch : input)
+  {
+    if ( ch == '\033' )
+      str += "^[";
+    else if ( uChar(ch) < 0x20 || ch == 0x7f )
+    {
+      str += '^';
+      str += char(ch ^ 0x40);
+    }
+    else
+      str += ch;
+  }
+
+  if ( str.length() > 14 )
+    str = str.substr(0, 13) + "~";
+
+  return str;
+}
+
+//----------------------------------------------------------------------
+void SessionReplay::printReport() const
+{
+  std::size_t recorded_bytes{recording.startup_bytes};
+  std::size_t recorded_frames{recording.startup_frames};
+  std::size_t bytes{startup_bytes};
+  std::size_t frames{startup_frames};
+  double latency_sum{0.0};
+  double latency_max{0.0};
+  std::size_t answered{0};
+  std::array<char, 128> str{};
+
+  std::printf ( "%5s  %-14s %10s %10s %10s %7s %9s %9s\n"
+              , "#", "input", "rec.bytes", "rec.frames"
+              , "bytes", "frames", "latency", "done" );
+  std::printf ( "%5s  %-14s %10zu %10zu %10zu %7zu\n", "start", ""
+              , recording.startup_bytes, recording.startup_frames
+              , startup_bytes, startup_frames );
+  std::size_t n{0};
+
+  for (auto&& i : recording.interactions)
+  {
+    n++;
+    std::snprintf (str.data(), str.size(), "%5zu", n);
+    std::printf ( "%s  %-14s %10zu %10zu %10zu %7zu"
+                , str.data(), getPrintableInput(i.input).c_str()
+                , i.recorded_bytes, i.recorded_frames, i.bytes, i.frames );
+
+    if ( i.latency >= 0.0 )
+    {
+      std::printf (" %6.2f ms %6.2f ms\n", i.latency, i.done);
+      latency_sum += i.latency;
+      latency_max = std::max(latency_max, i.latency);
+      answered++;
+    }
+    else
+      std::printf ("         -         -\n");
+
+    recorded_bytes += i.recorded_bytes;
+    recorded_frames += i.recorded_frames;
+    bytes += i.bytes;
+    frames += i.frames;
+  }
+
+  std::printf ( "%5s  %-14s %10zu %10zu %10zu %7zu\n", "total", ""
+              , recorded_bytes, recorded_frames, bytes, frames );
+
+  if ( answered > 0 )
+    std::printf ( "\nLatency: %.2f ms mean, %.2f ms max "
+                  "(%zu of %zu inputs with output)\n"
+                , latency_sum / double(answered), latency_max
+                , answered, recording.interactions.size() );
+}
+
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+void usage (const char name[])
+{
+  std::cerr << "Usage: " << name << " [--realtime] [--settle=<MS>] "
+               "[--startup=<MS>] <FILE> <PROGRAM> [ARGS...]\n\n"
+               "  --realtime      Keep the recorded time between inputs\n"
+               "  --settle=<MS>   Silence after an input (default 200 ms)\n"
+               "  --startup=<MS>  Silence after the start (default 1000 ms)\n";
+}
+
+//----------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+  bool realtime{false};
+  int settle{200};
+  int startup{1000};
+  int arg{1};
+
+  for (; arg < argc && std::strncmp(argv[arg], "--", 2) == 0; arg++)
+  {
+    const std::string option{argv[arg]};
+
+    if ( option == "--realtime" )
+      realtime = true;
+    else if ( option.compare(0, 9, "--settle=") == 0 )
+      settle = std::atoi(argv[arg] + 9);
+    else if ( option.compare(0, 10, "--startup=") == 0 )
+      startup = std::atoi(argv[arg] + 10);
+    else
+    {
+      usage (argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if ( argc - arg < 2 )
+  {
+    usage (argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  Recording recording{};
+
+  if ( ! readRecording(argv[arg], recording) )
+  {
+    std::cerr << "Cannot read the asciicast v2 file " << argv[arg] << "\n";
+    return EXIT_FAILURE;
+  }
+
+  SessionReplay replay{recording, settle, startup};
+
+  if ( ! replay.start(argv + arg + 1) )
+  {
+    std::cerr << "Cannot create a pseudo terminal\n";
+    return EXIT_FAILURE;
+  }
+
+  replay.run (realtime);
+  replay.printReport();
+  return EXIT_SUCCESS;
+}
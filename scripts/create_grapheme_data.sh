@@ -0,0 +1,159 @@
+#!/bin/sh
+#
+# Creates the grapheme cluster break and column width tables
+# in ../src/fgraphemedata.cpp from the Unicode Character Database
+# of the installed Perl (module Unicode::UCD)
+
+OUTPUT="../src/fgraphemedata.cpp"
+
+perl -w - > "$OUTPUT" <<'PERL'
+use strict;
+use Unicode::UCD qw(prop_invmap prop_invlist);
+
+# Must match FGrapheme::BreakProperty
+my %break_value =
+(
+  Other => 0, CR => 1, LF => 2, Control => 3, Extend => 4, ZWJ => 5,
+  Regional_Indicator => 6, Prepend => 7, SpacingMark => 8,
+  L => 9, V => 10, T => 11, LV => 12, LVT => 13
+);
+
+my $size = 0x110000;
+my $shift = 7;
+my $block_size = 1 << $shift;
+my @break = (0) x $size;
+my @width = (1) x $size;
+my @pict = (0) x $size;
+
+sub ranges
+{
+  my ($name, $callback) = @_;
+  my ($starts, $values) = prop_invmap($name);
+
+  for my $i (0 .. $#$starts)
+  {
+    my $end = ( $i < $#$starts ) ? $starts->[$i + 1] - 1 : $size - 1;
+    $callback->($starts->[$i], $end, $values->[$i]);
+  }
+}
+
+ranges ("Grapheme_Cluster_Break", sub
+{
+  my ($first, $last, $value) = @_;
+  # The pseudo value ExtPict_XX marks unassigned pictographs
+  my $v = $break_value{$value} // 0;
+  @break[$first .. $last] = ($v) x ($last - $first + 1);
+});
+
+ranges ("East_Asian_Width", sub
+{
+  my ($first, $last, $value) = @_;
+  @width[$first .. $last] = (2) x ($last - $first + 1)
+    if ( $value eq "W" || $value eq "F" );
+});
+
+ranges ("General_Category", sub
+{
+  my ($first, $last, $value) = @_;
+  @width[$first .. $last] = (0) x ($last - $first + 1)
+    if ( $value =~ /^(Mn|Me|Cf|Cc|Cs|Zl|Zp)$/ );
+});
+
+my @list = prop_invlist("Extended_Pictographic");
+
+for ( my $i = 0; $i < @list; $i += 2 )
+{
+  my $last = ( $i + 1 < @list ) ? $list[$i + 1] - 1 : $size - 1;
+  @pict[$list[$i] .. $last] = (1) x ($last - $list[$i] + 1);
+}
+
+my @property = (0) x $size;
+
+for my $cp ( 0 .. $size - 1 )
+{
+  # Hangul vowels and trailing consonants join the leading consonant
+  $width[$cp] = 0 if ( $break[$cp] == 10 || $break[$cp] == 11 );
+  $width[$cp] = 1 if ( $cp == 0xad );  # Soft hyphen
+  $property[$cp] = $break[$cp] | ($width[$cp] << 4) | ($pict[$cp] << 6);
+}
+
+my %block_number = ();
+my @blocks = ();
+my @index = ();
+
+for ( my $cp = 0; $cp < $size; $cp += $block_size )
+{
+  my $key = join(",", @property[$cp .. $cp + $block_size - 1]);
+
+  if ( ! exists $block_number{$key} )
+  {
+    $block_number{$key} = scalar(@blocks);
+    push @blocks, [ @property[$cp .. $cp + $block_size - 1] ];
+  }
+
+  push @index, $block_number{$key};
+}
+
+die "Too many blocks" if ( @blocks > 256 );
+
+sub print_table
+{
+  my ($name, $values) = @_;
+  my $count = scalar(@$values);
+  print "const std::array<uInt8, $count> FGrapheme::$name =\n{{\n";
+
+  for ( my $i = 0; $i < $count; $i += 12 )
+  {
+    my $last = ( $i + 11 < $count ) ? $i + 11 : $count - 1;
+    my $line = join(", ", map { sprintf("0x%02x", $_) } @$values[$i .. $last]);
+    print "  $line", ( $last < $count - 1 ) ? ",\n" : "\n";
+  }
+
+  print "}};\n";
+}
+
+my $version = Unicode::UCD::UnicodeVersion();
+
+print <<HEADER;
+/***********************************************************************
+* fgraphemedata.cpp - Unicode grapheme break and width tables          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+// Generated by scripts/create_grapheme_data.sh from the
+// Unicode Character Database $version - do not edit
+
+#include "final/fgrapheme.h"
+
+namespace finalcut
+{
+
+// static class attributes
+HEADER
+
+print_table ("block_index", \@index);
+print "\n";
+print_table ("block_data", [ map { @$_ } @blocks ]);
+
+print <<FOOTER;
+
+}  // namespace finalcut
+FOOTER
+PERL
@@ -25,11 +25,14 @@
 #include <iostream>
 #include <memory>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <thread>
 
 #include "final/fapplication.h"
 #include "final/fevent.h"
+#include "final/feventstatistics.h"
+#include "final/finstrumentation.h"
 #include "final/flog.h"
 #include "final/flogger.h"
 #include "final/fmenu.h"
@@ -81,6 +84,9 @@ struct timeval FApplication::time_last_event {};
 // class FApplication
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FApplication> FApplication::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FApplication::FApplication (const int& _argc, char* _argv[])
@@ -156,6 +162,14 @@ FApplication::FLogPtr& FApplication::getLog()
   return *logger_ptr;
 }
 
+//----------------------------------------------------------------------
+FEventStatistics& FApplication::getEventStatistics()
+{
+  // Global event statistics (disabled by default)
+  static auto statistics = new FEventStatistics();
+  return *statistics;
+}
+
 //----------------------------------------------------------------------
 void FApplication::setLog (const FLogPtr& log)
 {
@@ -233,7 +247,23 @@ bool FApplication::sendEvent (FObject* receiver, FEvent* event )
     return false;
 
   // Sends the event event directly to receiver
-  bool ret = receiver->event(event);
+  FInstrumentation::count (FInstrumentation::Event);
+  auto& statistics = getEventStatistics();
+  bool ret{};
+
+  if ( statistics.isEnabled() )
+  {
+    using std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    const auto start = steady_clock::now();
+    ret = receiver->event(event);
+    const auto time = duration_cast<nanoseconds>(steady_clock::now() - start);
+    statistics.add (event->getType(), uInt64(time.count()));
+  }
+  else
+    ret = receiver->event(event);
+
   event->send = true;
   return ret;
 }
@@ -357,6 +387,19 @@ void FApplication::setLogFile (const FString& filename)
   }
 }
 
+//----------------------------------------------------------------------
+void FApplication::setInstrumentation (const char socket_path[])
+{
+  // Enables the counters, SIGUSR1 requests a dump
+
+  FInstrumentation::enable();
+  getEventStatistics().enable();
+  FInstrumentation::setDumpSignal (SIGUSR1);
+
+  if ( socket_path )
+    FInstrumentation::setDumpSocket (socket_path);
+}
+
 //----------------------------------------------------------------------
 void FApplication::setKeyboardWidget (FWidget* widget)
 {
@@ -414,14 +457,20 @@ void FApplication::init()
     auto cmd2 = std::bind(&FApplication::keyReleased, this);
     auto cmd3 = std::bind(&FApplication::escapeKeyPressed, this);
     auto cmd4 = std::bind(&FApplication::mouseTracking, this);
+    auto cmd5 = std::bind(&FApplication::textPasted, this);
+    auto cmd6 = std::bind(&FApplication::terminalFocusChanged, this);
     FKeyboardCommand key_cmd1 (cmd1);
     FKeyboardCommand key_cmd2 (cmd2);
     FKeyboardCommand key_cmd3 (cmd3);
     FKeyboardCommand key_cmd4 (cmd4);
+    FKeyboardCommand key_cmd5 (cmd5);
+    FKeyboardCommand key_cmd6 (cmd6);
     keyboard->setPressCommand (key_cmd1);
     keyboard->setReleaseCommand (key_cmd2);
     keyboard->setEscPressedCommand (key_cmd3);
     keyboard->setMouseTrackingCommand (key_cmd4);
+    keyboard->setPasteCommand (key_cmd5);
+    keyboard->setTermFocusCommand (key_cmd6);
     // Set the keyboard keypress timeout
     keyboard->setKeypressTimeout (key_timeout);
   }
@@ -484,9 +533,11 @@ inline void FApplication::setLongOptions (std::vector<CmdOption>& long_options)
     {"no-terminal-data-request", no_argument,       nullptr,  'r' },
     {"no-color-change",          no_argument,       nullptr,  'c' },
     {"no-sgr-optimizer",         no_argument,       nullptr,  's' },
+    {"record",                   required_argument, nullptr,  'R' },
     {"vgafont",                  no_argument,       nullptr,  'v' },
     {"newfont",                  no_argument,       nullptr,  'n' },
     {"dark-theme",               no_argument,       nullptr,  't' },
+    {"instrumentation",          optional_argument, nullptr,  'I' },
 
   #if defined(__FreeBSD__) || defined(__DragonFly__)
     {"no-esc-for-alt-meta",      no_argument,       nullptr,  'E' },
@@ -523,12 +574,16 @@ inline void FApplication::setCmdOptionsMap (CmdMap& cmd_map)
   cmd_map['c'] = [opt] (const char*) { opt().color_change = false; };
   // --no-sgr-optimizer
   cmd_map['s'] = [opt] (const char*) { opt().sgr_optimizer = false; };
+  // --record
+  cmd_map['R'] = [opt] (const char* arg) { opt().recording_file = arg; };
   // --vgafont
   cmd_map['v'] = [opt] (const char*) { opt().vgafont = true; };
   // --newfont
   cmd_map['n'] = [opt] (const char*) { opt().newfont = true; };
   // --dark-theme
   cmd_map['t'] = [opt] (const char*) { opt().dark_theme = true; };
+  // --instrumentation
+  cmd_map['I'] = [] (const char* arg) { setInstrumentation(arg); };
 #if defined(__FreeBSD__) || defined(__DragonFly__)
   // --no-esc-for-alt-meta
   cmd_map['E'] = [opt] (const char*) { opt().meta_sends_escape = false; };
@@ -600,12 +655,19 @@ void FApplication::showParameterUsage()
     << "    Do not redefine the color palette\n"
     << "  --no-sgr-optimizer        "
     << "    Do not optimize SGR sequences\n"
+    << "  --record=<FILE>           "
+    << "    Records the terminal session to FILE\n"
     << "  --vgafont                 "
     << "    Set the standard vga 8x16 font\n"
     << "  --newfont                 "
     << "    Enables the graphical font\n"
     << "  --dark-theme              "
     << "    Enables the dark theme\n"
+    << "  --instrumentation[=<SOCKET>]\n"
+    << "                            "
+    << "    Counts the drawing work, SIGUSR1 writes it\n"
+    << "                            "
+    << "    to the log or to the Unix socket SOCKET\n"
 
 #if defined(__FreeBSD__) || defined(__DragonFly__)
     << "\n"
@@ -695,6 +757,33 @@ void FApplication::mouseTracking() const
   performMouseAction();
 }
 
+//----------------------------------------------------------------------
+void FApplication::textPasted() const
+{
+  sendPasteEvent (keyboard_widget);
+}
+
+//----------------------------------------------------------------------
+void FApplication::terminalFocusChanged() const
+{
+  // While the terminal is unfocused, FVTerm writes the screen
+  // changes only at the background frame rate
+
+  const bool focus_in = ( keyboard->getKey() == fc::Fkey_term_focus_in );
+
+  if ( focus_in == isTerminalFocused() )
+    return;
+
+  setTerminalFocus (focus_in);
+  const auto ev_type = ( focus_in ) ? fc::TerminalFocusIn_Event
+                                    : fc::TerminalFocusOut_Event;
+  FFocusEvent focus_ev (ev_type);
+  sendTerminalFocusEvent (internal::var::app_object, &focus_ev);
+
+  if ( focus_in )
+    forceTerminalUpdate();  // Catch-up frame with all collected changes
+}
+
 //----------------------------------------------------------------------
 inline void FApplication::performKeyboardAction()
 {
@@ -791,6 +880,30 @@ inline bool FApplication::sendKeyUpEvent (FWidget* widget) const
   return k_up_ev.isAccepted();
 }
 
+//----------------------------------------------------------------------
+inline void FApplication::sendPasteEvent (FWidget* widget) const
+{
+  // Send the whole pasted text as one event
+  FPasteEvent paste_ev (fc::Paste_Event, keyboard->getPasteText());
+  sendEvent (widget, &paste_ev);
+}
+
+//----------------------------------------------------------------------
+void FApplication::sendTerminalFocusEvent ( FObject* object
+                                          , FFocusEvent* ev ) const
+{
+  // Sends the event to the object and all its descendants
+
+  if ( ! object )
+    return;
+
+  sendEvent (object, ev);
+  const auto children = object->getChildren();  // Copy
+
+  for (auto&& child : children)
+    sendTerminalFocusEvent (child, ev);
+}
+
 //----------------------------------------------------------------------
 inline void FApplication::sendKeyboardAccelerator()
 {
@@ -1276,6 +1389,31 @@ void FApplication::processCloseWidget()
   setTerminalUpdates (FVTerm::start_terminal_updates);
 }
 
+//----------------------------------------------------------------------
+void FApplication::processInstrumentationDump() const
+{
+  // Writes the requested dump of the instrumentation counters
+
+  if ( ! FInstrumentation::isDumpRequested() )
+    return;
+
+  FInstrumentation::clearDumpRequest();
+  std::ostringstream dump{};
+  FInstrumentation::print(dump);
+  dump << "\n";
+  getEventStatistics().print(dump);
+
+  if ( FInstrumentation::getDumpSocket().empty() )
+  {
+    getLog()->info("Instrumentation dump\n" + dump.str());
+    return;
+  }
+
+  if ( ! FInstrumentation::writeToSocket(dump.str()) )
+    getLog()->warn ( "Cannot write the instrumentation dump to "
+                   + FInstrumentation::getDumpSocket() );
+}
+
 //----------------------------------------------------------------------
 void FApplication::processLogger() const
 {
@@ -1304,8 +1442,10 @@ bool FApplication::processNextEvent()
     processMouseEvent();
     processResizeEvent();
     processCloseWidget();
+    processUpdateList();      // coalesced widget redraws
     processTerminalUpdate();  // after terminal changes
     flush();
+    processInstrumentationDump();
     processLogger();
   }
 
@@ -1317,6 +1457,13 @@ bool FApplication::processNextEvent()
     num_events += processTimerEvent();
   }
 
+  // Draw updates that were requested by timer or user events
+  if ( processUpdateList() )
+  {
+    processTerminalUpdate();
+    flush();
+  }
+
   return ( num_events > 0 );
 }
 
@@ -1354,6 +1501,7 @@ bool FApplication::isEventProcessable ( FObject* receiver
         case fc::KeyPress_Event:
         case fc::KeyUp_Event:
         case fc::KeyDown_Event:
+        case fc::Paste_Event:
         case fc::MouseDown_Event:
         case fc::MouseUp_Event:
         case fc::MouseDoubleClick_Event:
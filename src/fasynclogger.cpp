@@ -0,0 +1,342 @@
+/***********************************************************************
+* fasynclogger.cpp - The FINAL CUT background logger                   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <cstdio>
+#include <string>
+
+#include "final/fasynclogger.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline void appendLittleEndian ( std::string& buffer
+                               , uInt64 value
+                               , std::size_t bytes )
+{
+  for (std::size_t i{0}; i < bytes; i++)
+    buffer += char((value >> (8 * i)) & 0xff);
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FAsyncLogger
+//----------------------------------------------------------------------
+
+// static class attribute
+constexpr std::size_t FAsyncLogger::DEFAULT_CAPACITY;
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FAsyncLogger::FAsyncLogger (std::size_t size)
+{
+  // The capacity is rounded up to a power of two
+  capacity = 2;
+
+  while ( capacity < size )
+    capacity <<= 1;
+
+  ring.reset(new Slot[capacity]);
+
+  for (std::size_t i{0}; i < capacity; i++)
+    ring[i].sequence.store(i, std::memory_order_relaxed);
+
+  worker = std::thread(&FAsyncLogger::run, this);
+}
+
+//----------------------------------------------------------------------
+FAsyncLogger::~FAsyncLogger()  // destructor
+{
+  sync();  // Transfer the remaining stream buffer content
+
+  {
+    std::lock_guard<std::mutex> lock_guard(wait_mutex);
+    running.store(false);
+  }
+
+  wakeup.notify_one();
+
+  if ( worker.joinable() )
+    worker.join();
+}
+
+
+// public methods of FAsyncLogger
+//----------------------------------------------------------------------
+void FAsyncLogger::setOutputStream (const std::ostream& os)
+{
+  std::lock_guard<std::mutex> lock_guard(output_mutex);
+  FLogger::setOutputStream(os);
+}
+
+//----------------------------------------------------------------------
+void FAsyncLogger::setLineEnding (LineEnding eol)
+{
+  std::lock_guard<std::mutex> lock_guard(output_mutex);
+  FLogger::setLineEnding(eol);
+}
+
+//----------------------------------------------------------------------
+void FAsyncLogger::enableTimestamp()
+{
+  std::lock_guard<std::mutex> lock_guard(output_mutex);
+  FLogger::enableTimestamp();
+}
+
+//----------------------------------------------------------------------
+void FAsyncLogger::disableTimestamp()
+{
+  std::lock_guard<std::mutex> lock_guard(output_mutex);
+  FLogger::disableTimestamp();
+}
+
+//----------------------------------------------------------------------
+void FAsyncLogger::flush()
+{
+  // Non-blocking: the background thread flushes the output stream
+  flush_request.store(true);
+  wakeup.notify_one();
+}
+
+//----------------------------------------------------------------------
+void FAsyncLogger::drain()
+{
+  // Waits until all messages queued so far have been written
+
+  const std::size_t target = enqueue_pos.load();
+  std::unique_lock<std::mutex> lock(wait_mutex);
+  flush_request.store(true);
+  wakeup.notify_one();
+
+  while ( running.load()
+       && written_pos.load(std::memory_order_acquire) < target )
+  {
+    drained.wait_for (lock, std::chrono::milliseconds(10));
+  }
+}
+
+
+// private methods of FAsyncLogger
+//----------------------------------------------------------------------
+void FAsyncLogger::push (LogLevel level, const std::string& msg)
+{
+  // Lock-free multi-producer enqueue into the bounded ring buffer
+
+  const std::size_t mask = capacity - 1;
+  std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+  Slot* slot{nullptr};
+
+  while ( true )
+  {
+    slot = &ring[pos & mask];
+    const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+    const auto diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+
+    if ( diff == 0 )
+    {
+      if ( enqueue_pos.compare_exchange_weak ( pos, pos + 1
+                                             , std::memory_order_relaxed ) )
+        break;
+    }
+    else if ( diff < 0 )  // The ring buffer is full
+    {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    else
+      pos = enqueue_pos.load(std::memory_order_relaxed);
+  }
+
+  slot->record.time = std::chrono::system_clock::now();
+  slot->record.level = level;
+  slot->record.message = msg;
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  wakeup.notify_one();
+}
+
+//----------------------------------------------------------------------
+bool FAsyncLogger::pop (LogRecord& record)
+{
+  // Single-consumer dequeue (only called by the background thread)
+
+  const std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+  Slot& slot = ring[pos & (capacity - 1)];
+  const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+
+  if ( seq != pos + 1 )
+    return false;  // Empty or not yet published
+
+  std::swap (record, slot.record);
+  slot.sequence.store(pos + capacity, std::memory_order_release);
+  dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FAsyncLogger::isQueueEmpty() const
+{
+  return dequeue_pos.load(std::memory_order_relaxed)
+      == enqueue_pos.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------
+void FAsyncLogger::run()
+{
+  LogRecord record{};
+
+  while ( true )
+  {
+    {
+      std::lock_guard<std::mutex> lock_guard(output_mutex);
+      bool written{false};
+
+      while ( pop(record) )
+      {
+        writeRecord (record);
+        written = true;
+      }
+
+      reportDroppedMessages();
+      const bool flush_requested = flush_request.exchange(false);
+
+      if ( written || flush_requested )
+        getOutputStream().flush();
+
+      written_pos.store ( dequeue_pos.load(std::memory_order_relaxed)
+                        , std::memory_order_release );
+    }
+
+    std::unique_lock<std::mutex> lock(wait_mutex);
+    drained.notify_all();
+
+    if ( ! running.load() && isQueueEmpty() )
+      break;
+
+    wakeup.wait_for ( lock, std::chrono::milliseconds(100)
+                    , [this] ()
+                      {
+                        return ! running.load()
+                            || flush_request.load()
+                            || ! isQueueEmpty();
+                      } );
+  }
+}
+
+//----------------------------------------------------------------------
+void FAsyncLogger::writeRecord (const LogRecord& record)
+{
+  switch ( getFormat() )
+  {
+    case Text:
+    {
+      std::string prefix{};
+
+      if ( isTimestamp() )
+      {
+        const auto t = std::chrono::system_clock::to_time_t(record.time);
+        prefix += getTimeString(t);
+        prefix += ' ';
+      }
+
+      prefix += '[';
+      prefix += getLevelString(record.level);
+      prefix += "] ";
+      printLogLine (prefix, record.message);
+      break;
+    }
+
+    case Compact:
+      writeCompactRecord (record);
+      break;
+
+    case Binary:
+      writeBinaryRecord (record);
+      break;
+  }
+}
+
+//----------------------------------------------------------------------
+void FAsyncLogger::writeCompactRecord (const LogRecord& record)
+{
+  static constexpr std::array<char, 4> level_letter{{'I', 'W', 'E', 'D'}};
+  std::string prefix{};
+
+  if ( isTimestamp() )
+  {
+    using namespace std::chrono;
+    const auto usec = duration_cast<microseconds>
+                      (record.time.time_since_epoch()).count();
+    std::array<char, 32> str;
+    std::snprintf ( str.data(), str.size(), "%lld.%06lld "
+                  , static_cast<long long>(usec / 1000000)
+                  , static_cast<long long>(usec % 1000000) );
+    prefix += str.data();
+  }
+
+  prefix += level_letter[std::size_t(record.level) & 3];
+  prefix += ' ';
+  printLogLine (prefix, record.message);
+}
+
+//----------------------------------------------------------------------
+void FAsyncLogger::writeBinaryRecord (const LogRecord& record)
+{
+  using namespace std::chrono;
+  const auto usec = duration_cast<microseconds>
+                    (record.time.time_since_epoch()).count();
+  const std::string& msg = record.message;
+  record_buffer.clear();
+  record_buffer.reserve (17 + msg.length());
+  internal::appendLittleEndian (record_buffer, uInt64(usec / 1000000), 8);
+  internal::appendLittleEndian (record_buffer, uInt64(usec % 1000000), 4);
+  internal::appendLittleEndian (record_buffer, uInt64(record.level), 1);
+  internal::appendLittleEndian (record_buffer, uInt64(msg.length()), 4);
+  record_buffer += msg;
+  getOutputStream().write ( record_buffer.data()
+                          , std::streamsize(record_buffer.length()) );
+}
+
+//----------------------------------------------------------------------
+void FAsyncLogger::reportDroppedMessages()
+{
+  // Writes a warning when messages were lost due to a full ring buffer
+
+  const std::size_t count = dropped.load(std::memory_order_relaxed);
+
+  if ( count == reported_drops )
+    return;
+
+  LogRecord record{};
+  record.time = std::chrono::system_clock::now();
+  record.level = Warn;
+  record.message = std::to_string(count - reported_drops)
+                 + " log messages dropped (ring buffer full)";
+  reported_drops = count;
+  writeRecord (record);
+}
+
+}  // namespace finalcut
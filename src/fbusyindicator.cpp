@@ -30,6 +30,9 @@ namespace finalcut
 // class FBusyIndicator
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FBusyIndicator> FBusyIndicator::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FBusyIndicator::FBusyIndicator (FWidget* parent)
@@ -50,7 +53,10 @@ void FBusyIndicator::start()
   running = true;
   createIndicatorText();
   show();
-  addTimer(TIMER);
+
+  // The animation pauses while the terminal is unfocused
+  if ( isTerminalFocused() )
+    addTimer(TIMER);
 }
 
 //----------------------------------------------------------------------
@@ -117,5 +123,22 @@ void FBusyIndicator::onTimer (finalcut::FTimerEvent*)
   redraw();
 }
 
+//----------------------------------------------------------------------
+void FBusyIndicator::onTerminalFocusIn (FFocusEvent*)
+{
+  // Resume the animation
+
+  if ( running )
+    addTimer(TIMER);
+}
+
+//----------------------------------------------------------------------
+void FBusyIndicator::onTerminalFocusOut (FFocusEvent*)
+{
+  // Pause the animation
+
+  delOwnTimers();
+}
+
 }  // namespace finalcut
 
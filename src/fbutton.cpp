@@ -33,6 +33,9 @@ namespace finalcut
 // class FButton
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FButton> FButton::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FButton::FButton(FWidget* parent)
@@ -200,7 +203,7 @@ bool FButton::setDown (bool enable)
   if ( button_down != enable )
   {
     button_down = enable;
-    redraw();
+    update();
   }
 
   return enable;
@@ -25,6 +25,7 @@
 #include "final/fbuttongroup.h"
 #include "final/fcolorpair.h"
 #include "final/fevent.h"
+#include "final/fradiobutton.h"
 #include "final/fsize.h"
 #include "final/fstatusbar.h"
 #include "final/ftogglebutton.h"
@@ -36,6 +37,9 @@ namespace finalcut
 // class FButtonGroup
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FButtonGroup> FButtonGroup::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FButtonGroup::FButtonGroup(FWidget* parent)
@@ -386,7 +390,7 @@ bool FButtonGroup::isRadioButton (const FToggleButton* button) const
   if ( ! button )
     return false;
 
-  return bool( button->getClassName() == "FRadioButton" );
+  return button->isInstanceOf<FRadioButton>();
 }
 
 //----------------------------------------------------------------------
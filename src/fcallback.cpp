@@ -25,6 +25,34 @@
 namespace finalcut
 {
 
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline bool isSameSignal (const FString& cb_signal, const char str[])
+{
+  // Compares a signal name without a temporary FString
+
+  const wchar_t* s = cb_signal.wc_str();
+  const char* p = str;
+
+  if ( ! s )
+    return *p == '\0';
+
+  while ( *s != L'\0' && *s == wchar_t(uChar(*p)) && uChar(*p) < 0x80 )
+  {
+    s++;
+    p++;
+  }
+
+  if ( uChar(*p) >= 0x80 )  // Multibyte characters need a conversion
+    return cb_signal == FString(str);
+
+  return *s == wchar_t(uChar(*p));
+}
+
+}  // namespace internal
+
 //----------------------------------------------------------------------
 // class FCallback
 //----------------------------------------------------------------------
@@ -85,5 +113,21 @@ void FCallback::emitCallback (const FString& emit_signal) const
   }
 }
 
+//----------------------------------------------------------------------
+void FCallback::emitCallback (const char emit_signal[]) const
+{
+  // Initiate callback for the given signal without allocating
+  // memory - this is called for every mouse and focus event
+
+  if ( callback_objects.empty() || ! emit_signal )
+    return;
+
+  for (auto&& cback : callback_objects)
+  {
+    if ( internal::isSameSignal(cback.cb_signal, emit_signal) )
+      cback.cb_function();
+  }
+}
+
 }  // namespace finalcut
 
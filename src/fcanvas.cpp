@@ -0,0 +1,420 @@
+/***********************************************************************
+* fcanvas.cpp - Widget FCanvas                                         *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+#include "final/fcanvas.h"
+#include "final/fpoint.h"
+#include "final/fsize.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FCanvas
+//----------------------------------------------------------------------
+
+// static class attribute
+const FTypeTag<FCanvas> FCanvas::type_tag{};
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FCanvas::FCanvas (FWidget* parent)
+  : FWidget{parent}
+{
+  init();
+}
+
+//----------------------------------------------------------------------
+FCanvas::~FCanvas()  // destructor
+{ }
+
+
+// public methods of FCanvas
+//----------------------------------------------------------------------
+FColor FCanvas::getPixel (int x, int y) const
+{
+  if ( x < 0 || y < 0
+    || std::size_t(x) >= pixel_width
+    || std::size_t(y) >= pixel_height )
+    return fc::Default;
+
+  return pixels[std::size_t(y) * pixel_width + std::size_t(x)];
+}
+
+//----------------------------------------------------------------------
+void FCanvas::setPixelMode (PixelMode mode)
+{
+  if ( pixel_mode == mode )
+    return;
+
+  pixel_mode = mode;
+  resizeBuffers();
+}
+
+//----------------------------------------------------------------------
+void FCanvas::setSize (const FSize& size, bool adjust)
+{
+  FWidget::setSize (size, adjust);
+  resizeBuffers();
+}
+
+//----------------------------------------------------------------------
+void FCanvas::setGeometry ( const FPoint& pos, const FSize& size
+                          , bool adjust )
+{
+  FWidget::setGeometry (pos, size, adjust);
+  resizeBuffers();
+}
+
+//----------------------------------------------------------------------
+void FCanvas::setPixel (int x, int y, FColor color)
+{
+  if ( x < 0 || y < 0
+    || std::size_t(x) >= pixel_width
+    || std::size_t(y) >= pixel_height )
+    return;
+
+  auto& pixel = pixels[std::size_t(y) * pixel_width + std::size_t(x)];
+
+  if ( pixel == color )
+    return;
+
+  pixel = color;
+  const int cx = x / getCellPixelWidth();
+  const int cy = y / getCellPixelHeight();
+  setDirty (cx, cy, cx, cy);
+}
+
+//----------------------------------------------------------------------
+void FCanvas::setPixels (const FColor* data, std::size_t stride)
+{
+  // Copies a complete pixel image with pixel_width x pixel_height
+  // pixels. Row y starts at data[y * stride].
+
+  if ( ! data || pixels.empty() )
+    return;
+
+  if ( stride == 0 )
+    stride = pixel_width;
+
+  const int cell_height = getCellPixelHeight();
+
+  for (std::size_t y{0}; y < pixel_height; y++)
+  {
+    const FColor* src = &data[y * stride];
+    const auto dst = pixels.begin() + int(y * pixel_width);
+
+    if ( std::equal(src, src + pixel_width, dst) )
+      continue;
+
+    std::copy (src, src + pixel_width, dst);
+    const int cy = int(y) / cell_height;
+    setDirty (0, cy, int(getWidth()) - 1, cy);
+  }
+}
+
+//----------------------------------------------------------------------
+void FCanvas::hide()
+{
+  FWidget::hide();
+  hideArea (getSize());
+}
+
+//----------------------------------------------------------------------
+void FCanvas::clear()
+{
+  std::fill (pixels.begin(), pixels.end(), fc::Default);
+  setAllDirty();
+}
+
+//----------------------------------------------------------------------
+void FCanvas::drawLine (const FPoint& p1, const FPoint& p2, FColor color)
+{
+  // Bresenham's line algorithm
+
+  int x = p1.getX();
+  int y = p1.getY();
+  const int x2 = p2.getX();
+  const int y2 = p2.getY();
+  const int dx = std::abs(x2 - x);
+  const int dy = -std::abs(y2 - y);
+  const int sx = ( x < x2 ) ? 1 : -1;
+  const int sy = ( y < y2 ) ? 1 : -1;
+  int err = dx + dy;
+
+  while ( true )
+  {
+    setPixel (x, y, color);
+
+    if ( x == x2 && y == y2 )
+      break;
+
+    const int e2 = 2 * err;
+
+    if ( e2 >= dy )
+    {
+      err += dy;
+      x += sx;
+    }
+
+    if ( e2 <= dx )
+    {
+      err += dx;
+      y += sy;
+    }
+  }
+}
+
+
+// private methods of FCanvas
+//----------------------------------------------------------------------
+void FCanvas::init()
+{
+  unsetFocusable();
+  resizeBuffers();
+}
+
+//----------------------------------------------------------------------
+void FCanvas::resizeBuffers()
+{
+  // The pixel content is cleared after a size change
+
+  const std::size_t width = getWidth();
+  const std::size_t height = getHeight();
+  pixel_width = width * std::size_t(getCellPixelWidth());
+  pixel_height = height * std::size_t(getCellPixelHeight());
+  pixels.assign (pixel_width * pixel_height, fc::Default);
+  FChar blank{};
+  blank.ch[0] = L' ';
+  blank.fg_color = getForegroundColor();
+  blank.bg_color = getBackgroundColor();
+  blank.attr.bit.char_width = 1;
+  cells.assign (width * height, blank);
+  setAllDirty();
+}
+
+//----------------------------------------------------------------------
+void FCanvas::setDirty (int x1, int y1, int x2, int y2)
+{
+  // Extends the dirty cell rectangle
+
+  if ( ! isDirty() )
+  {
+    dirty_x1 = x1;
+    dirty_y1 = y1;
+    dirty_x2 = x2;
+    dirty_y2 = y2;
+    update();  // The first change schedules the redraw
+    return;
+  }
+
+  dirty_x1 = std::min(dirty_x1, x1);
+  dirty_y1 = std::min(dirty_y1, y1);
+  dirty_x2 = std::max(dirty_x2, x2);
+  dirty_y2 = std::max(dirty_y2, y2);
+}
+
+//----------------------------------------------------------------------
+void FCanvas::setAllDirty()
+{
+  if ( ! isDirty() )
+    update();
+
+  dirty_x1 = 0;
+  dirty_y1 = 0;
+  dirty_x2 = int(getWidth()) - 1;
+  dirty_y2 = int(getHeight()) - 1;
+}
+
+//----------------------------------------------------------------------
+void FCanvas::convertDirtyCells()
+{
+  // Converts the pixels of the dirty rectangle into cells
+
+  if ( cell_fg != getForegroundColor() || cell_bg != getBackgroundColor() )
+  {
+    cell_fg = getForegroundColor();
+    cell_bg = getBackgroundColor();
+    setAllDirty();
+  }
+
+  if ( ! isDirty() || cells.empty() )
+    return;
+
+  // The pixel mode is selected once, so that each inner
+  // loop has a single inlined conversion
+  switch ( pixel_mode )
+  {
+    case HalfBlock:
+      convertCells ( [this] (int cx, int cy, FChar& cell)
+                     {
+                       convertHalfBlockCell (cx, cy, cell);
+                     } );
+      break;
+
+    case Quadrant:
+      convertCells ( [this] (int cx, int cy, FChar& cell)
+                     {
+                       convertQuadrantCell (cx, cy, cell);
+                     } );
+      break;
+
+    case Braille:
+      convertCells ( [this] (int cx, int cy, FChar& cell)
+                     {
+                       convertBrailleCell (cx, cy, cell);
+                     } );
+      break;
+  }
+
+  dirty_x1 = 0;
+  dirty_y1 = 0;
+  dirty_x2 = -1;
+  dirty_y2 = -1;
+}
+
+//----------------------------------------------------------------------
+template <typename ConvertFunc>
+inline void FCanvas::convertCells (ConvertFunc convert)
+{
+  // Converts the cells of the dirty rectangle row by row
+
+  const auto width = std::size_t(getWidth());
+
+  for (int cy{dirty_y1}; cy <= dirty_y2; cy++)
+  {
+    auto cell = &cells[std::size_t(cy) * width + std::size_t(dirty_x1)];
+
+    for (int cx{dirty_x1}; cx <= dirty_x2; cx++)
+    {
+      convert (cx, cy, *cell);
+      ++cell;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FCanvas::convertHalfBlockCell (int cx, int cy, FChar& cell) const
+{
+  const auto index = std::size_t(2 * cy) * pixel_width + std::size_t(cx);
+  const FColor upper = getPixelColor(pixels[index]);
+  const FColor lower = getPixelColor(pixels[index + pixel_width]);
+
+  if ( upper == lower )
+  {
+    cell.ch[0] = L' ';
+    cell.fg_color = cell_fg;
+    cell.bg_color = upper;
+  }
+  else
+  {
+    cell.ch[0] = fc::UpperHalfBlock;  // ▀
+    cell.fg_color = upper;
+    cell.bg_color = lower;
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FCanvas::convertQuadrantCell (int cx, int cy, FChar& cell) const
+{
+  // Bit 0 = upper left, bit 1 = upper right,
+  // bit 2 = lower left, bit 3 = lower right
+  static constexpr std::array<wchar_t, 16> quadrant_char
+  {{
+    L' ',   0x2598, 0x259d, 0x2580,  //   ▘ ▝ ▀
+    0x2596, 0x258c, 0x259e, 0x259b,  // ▖ ▌ ▞ ▛
+    0x2597, 0x259a, 0x2590, 0x259c,  // ▗ ▚ ▐ ▜
+    0x2584, 0x2599, 0x259f, 0x2588   // ▄ ▙ ▟ █
+  }};
+
+  const auto index = std::size_t(2 * cy) * pixel_width + std::size_t(2 * cx);
+  const std::array<FColor, 4> pixel
+  {{
+    pixels[index], pixels[index + 1],
+    pixels[index + pixel_width], pixels[index + pixel_width + 1]
+  }};
+  std::size_t mask{0};
+  FColor color{fc::Default};
+
+  for (std::size_t i{0}; i < pixel.size(); i++)
+  {
+    const bool is_set = ( pixel[i] != fc::Default );
+    mask |= std::size_t(is_set) << i;
+    color = ( is_set ) ? pixel[i] : color;
+  }
+
+  cell.ch[0] = quadrant_char[mask];
+  cell.fg_color = getPixelColor(color);
+  cell.bg_color = cell_bg;
+}
+
+//----------------------------------------------------------------------
+inline void FCanvas::convertBrailleCell (int cx, int cy, FChar& cell) const
+{
+  // Dot bit of the pixel (x, y) at index y * 2 + x
+  static constexpr std::array<uInt8, 8> dot_bit
+  {{ 0x01, 0x08, 0x02, 0x10, 0x04, 0x20, 0x40, 0x80 }};
+
+  auto index = std::size_t(4 * cy) * pixel_width + std::size_t(2 * cx);
+  std::size_t mask{0};
+  FColor color{fc::Default};
+
+  for (std::size_t y{0}; y < 4; y++)
+  {
+    for (std::size_t x{0}; x < 2; x++)
+    {
+      const FColor pixel = pixels[index + x];
+      const bool is_set = ( pixel != fc::Default );
+      mask |= ( is_set ) ? dot_bit[y * 2 + x] : 0;
+      color = ( is_set ) ? pixel : color;
+    }
+
+    index += pixel_width;
+  }
+
+  cell.ch[0] = ( mask == 0 ) ? L' ' : wchar_t(0x2800 + mask);  // ⠀ - ⣿
+  cell.fg_color = getPixelColor(color);
+  cell.bg_color = cell_bg;
+}
+
+//----------------------------------------------------------------------
+inline FColor FCanvas::getPixelColor (FColor color) const
+{
+  return ( color == fc::Default ) ? cell_bg : color;
+}
+
+//----------------------------------------------------------------------
+void FCanvas::draw()
+{
+  convertDirtyCells();
+
+  if ( cells.empty() )
+    return;
+
+  print() << FPoint{1, 1};
+  blit (getSize(), cells.data());
+}
+
+}  // namespace finalcut
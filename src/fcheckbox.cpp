@@ -30,6 +30,9 @@ namespace finalcut
 // class FCheckBox
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FCheckBox> FCheckBox::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FCheckBox::FCheckBox(FWidget* parent)
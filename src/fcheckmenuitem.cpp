@@ -31,6 +31,9 @@ namespace finalcut
 // class FCheckMenuItem
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FCheckMenuItem> FCheckMenuItem::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FCheckMenuItem::FCheckMenuItem (FWidget* parent)
@@ -0,0 +1,246 @@
+/***********************************************************************
+* fcolorquantizer.cpp - Maps 24-bit RGB colors to a terminal palette   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <limits>
+
+#include "final/fc.h"
+#include "final/fcolorquantizer.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline uInt32 colorDistance (FColor c1, FColor c2)
+{
+  // Weighted euclidean distance ("redmean"), a cheap approximation
+  // of the perceived difference between two colors
+
+  const int r1 = getRed(c1);
+  const int dr = r1 - getRed(c2);
+  const int dg = getGreen(c1) - getGreen(c2);
+  const int db = getBlue(c1) - getBlue(c2);
+  const int rmean = (r1 + getRed(c2)) / 2;
+  return uInt32 ( (((512 + rmean) * dr * dr) >> 8)
+                + 4 * dg * dg
+                + (((767 - rmean) * db * db) >> 8) );
+}
+
+//----------------------------------------------------------------------
+inline uInt8 expand5bit (std::size_t value)
+{
+  // Scales a 5-bit color channel to 8 bits
+  return uInt8((value << 3) | (value >> 2));
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FColorQuantizer
+//----------------------------------------------------------------------
+
+// static class attribute
+constexpr std::size_t FColorQuantizer::TABLE_SIZE;
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FColorQuantizer::FColorQuantizer()
+{
+  resetPalette();
+}
+
+
+// public methods of FColorQuantizer
+//----------------------------------------------------------------------
+FColor FColorQuantizer::getPaletteColor (FColor index) const
+{
+  // Returns the RGB value of a system color (0-15)
+
+  if ( index >= system_colors.size() )
+    return fc::Default;
+
+  return system_colors[index];
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizer::setPaletteColor (FColor index, int r, int g, int b)
+{
+  // Redefine the RGB value of a system color (0-15)
+
+  if ( index >= system_colors.size() )
+    return;
+
+  const FColor color = rgbColor (uInt8(r), uInt8(g), uInt8(b));
+
+  if ( system_colors[index] == color )
+    return;
+
+  system_colors[index] = color;
+
+  // Rebuild the affected tables on next use
+  if ( index < 8 )
+    tables[Palette8].reset();
+
+  tables[Palette16].reset();
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizer::resetPalette()
+{
+  // Standard VGA colors in the order of fc::colornames
+  system_colors =
+  {{
+    rgbColor(0x00, 0x00, 0x00), rgbColor(0x00, 0x00, 0xaa),
+    rgbColor(0x00, 0xaa, 0x00), rgbColor(0x00, 0xaa, 0xaa),
+    rgbColor(0xaa, 0x00, 0x00), rgbColor(0xaa, 0x00, 0xaa),
+    rgbColor(0xaa, 0x55, 0x00), rgbColor(0xaa, 0xaa, 0xaa),
+    rgbColor(0x55, 0x55, 0x55), rgbColor(0x55, 0x55, 0xff),
+    rgbColor(0x55, 0xff, 0x55), rgbColor(0x55, 0xff, 0xff),
+    rgbColor(0xff, 0x55, 0x55), rgbColor(0xff, 0x55, 0xff),
+    rgbColor(0xff, 0xff, 0x55), rgbColor(0xff, 0xff, 0xff)
+  }};
+
+  tables[Palette8].reset();
+  tables[Palette16].reset();
+}
+
+
+// private methods of FColorQuantizer
+//----------------------------------------------------------------------
+FColorQuantizer::PaletteType FColorQuantizer::getPaletteType (int max_color)
+{
+  if ( max_color >= 256 )
+    return Palette256;
+
+  if ( max_color >= 88 )
+    return Palette88;
+
+  if ( max_color >= 16 )
+    return Palette16;
+
+  return Palette8;
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizer::buildTable (PaletteType type)
+{
+  // The system colors of 88 and 256 color terminals are
+  // usually redefined by the theme, they are not used here
+  FColor first{0};
+  FColor last{7};
+
+  if ( type == Palette16 )
+    last = 15;
+  else if ( type == Palette88 )
+  {
+    first = 16;
+    last = 87;
+  }
+  else if ( type == Palette256 )
+  {
+    first = 16;
+    last = 255;
+  }
+
+  std::vector<FColor> palette{};
+  palette.reserve (last - first + 1);
+
+  for (FColor index = first; index <= last; index++)
+    palette.push_back (getRGB(index, type));
+
+  // Copies of the quantizer may still share the previous table,
+  // so a new table is built instead of changing it
+  auto table = std::make_shared<LookupTable>(TABLE_SIZE);
+
+  for (std::size_t i{0}; i < TABLE_SIZE; i++)
+  {
+    const FColor color = rgbColor ( internal::expand5bit((i >> 10) & 0x1f)
+                                  , internal::expand5bit((i >> 5) & 0x1f)
+                                  , internal::expand5bit(i & 0x1f) );
+    uInt32 min_distance = std::numeric_limits<uInt32>::max();
+    std::size_t nearest{0};
+
+    for (std::size_t n{0}; n < palette.size(); n++)
+    {
+      const uInt32 distance = internal::colorDistance (color, palette[n]);
+
+      if ( distance < min_distance )
+      {
+        min_distance = distance;
+        nearest = n;
+      }
+    }
+
+    (*table)[i] = uInt8(first + nearest);
+  }
+
+  tables[type] = table;
+}
+
+//----------------------------------------------------------------------
+FColor FColorQuantizer::getRGB (FColor index, PaletteType type) const
+{
+  // Returns the RGB value of a palette entry
+
+  if ( index < 16 )
+    return system_colors[index];
+
+  if ( type == Palette88 )
+  {
+    constexpr std::array<uInt8, 4> cube_level{{0x00, 0x8b, 0xcd, 0xff}};
+    constexpr std::array<uInt8, 8> gray_level =
+    {{
+      0x2e, 0x5c, 0x73, 0x8b, 0xa2, 0xb9, 0xd0, 0xe7
+    }};
+
+    if ( index >= 80 )
+    {
+      const uInt8 gray = gray_level[index - 80];
+      return rgbColor (gray, gray, gray);
+    }
+
+    index -= 16;
+    return rgbColor ( cube_level[(index / 16) % 4]
+                    , cube_level[(index / 4) % 4]
+                    , cube_level[index % 4] );
+  }
+
+  constexpr std::array<uInt8, 6> cube_level =
+  {{
+    0x00, 0x5f, 0x87, 0xaf, 0xd7, 0xff
+  }};
+
+  if ( index >= 232 )
+  {
+    const auto gray = uInt8(8 + 10 * (index - 232));
+    return rgbColor (gray, gray, gray);
+  }
+
+  index -= 16;
+  return rgbColor ( cube_level[(index / 36) % 6]
+                  , cube_level[(index / 6) % 6]
+                  , cube_level[index % 6] );
+}
+
+}  // namespace finalcut
@@ -42,6 +42,9 @@ namespace finalcut
 // class FDropDownListBox
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FDropDownListBox> FDropDownListBox::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FDropDownListBox::FDropDownListBox (FWidget* parent)
@@ -157,7 +160,7 @@ bool FDropDownListBox::containsWidget (const FPoint& p)
 
   if ( getTermGeometry().contains(p) )
     return true;
-  else if ( parent && parent->isInstanceOf("FComboBox") )
+  else if ( parent && parent->isInstanceOf<FComboBox>() )
     return static_cast<FComboBox*>(parent)->getTermGeometry().contains(p);
   else
     return false;
@@ -168,6 +171,9 @@ bool FDropDownListBox::containsWidget (const FPoint& p)
 // class FComboBox
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FComboBox> FComboBox::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FComboBox::FComboBox (FWidget* parent)
@@ -264,7 +270,7 @@ void FComboBox::setCurrentItem (std::size_t index)
 
   list_window.list.setCurrentItem(index);
   input_field = list_window.list.getItem(index).getText();
-  input_field.redraw();
+  input_field.update();
   processChanged();
 }
 
@@ -297,7 +303,7 @@ void FComboBox::remove (std::size_t item)
   {
     const std::size_t index = list_window.list.currentItem();
     input_field = list_window.list.getItem(index).getText();
-    input_field.redraw();
+    input_field.update();
   }
 
   if ( list_window.isShown() )
@@ -316,7 +322,7 @@ void FComboBox::clear()
 
   list_window.list.clear();
   input_field.clear();
-  redraw();
+  update();
 }
 
 //----------------------------------------------------------------------
@@ -709,11 +715,8 @@ void closeOpenComboBox()
   if ( ! openmenu )
     return;
 
-  if ( openmenu->isInstanceOf("FDropDownListBox") )
-  {
-    auto drop_down = static_cast<FDropDownListBox*>(openmenu);
+  if ( auto drop_down = openmenu->cast<FDropDownListBox>() )
     drop_down->hide();
-  }
 }
 
 //----------------------------------------------------------------------
@@ -39,6 +39,9 @@ namespace finalcut
 // class FDialog
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FDialog> FDialog::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FDialog::FDialog (FWidget* parent)
@@ -209,70 +212,17 @@ void FDialog::setPos (const FPoint& pos, bool)
     return;
   }
 
-  const int dx = getX() - pos.getX();
-  const int dy = getY() - pos.getY();
-  const int old_x = getTermX();
-  const int old_y = getTermY();
-  const auto& shadow = getShadow();
-  const std::size_t width = getWidth() + shadow.getWidth();  // width + right shadow
-  const std::size_t height = getHeight() + shadow.getHeight();  // height + bottom shadow
   const FRect old_geometry {getTermGeometryWithShadow()};
 
   // move to the new position
   FWindow::setPos(pos, false);
-  putArea (getTermPos(), getVWin());
-
-  // restoring the non-covered terminal areas
-  if ( getTermGeometry().overlap(old_geometry) )
-  {
-    FRect restore{};
-    const auto d_width = std::size_t(std::abs(dx));
-    const auto d_height = std::size_t(std::abs(dy));
-
-    // dx > 0 : move left
-    // dx = 0 : move vertical
-    // dx < 0 : move right
-    // dy > 0 : move up
-    // dy = 0 : move horizontal
-    // dy < 0 : move down
 
-    if ( dx > 0 )
-    {
-      if ( dy > 0 )
-        restore.setRect ( old_x + int(width) - dx, old_y
-                        , d_width, height - d_height );
-      else
-        restore.setRect ( old_x + int(width) - dx, old_y - dy
-                        , d_width, height - d_height );
-    }
-    else
-    {
-      if ( dy > 0 )
-        restore.setRect (old_x, old_y, d_width, height - d_height);
-      else
-        restore.setRect (old_x, old_y - dy, d_width, height - d_height);
-    }
-
-    restoreVTerm (restore);
-
-    if ( dy > 0 )
-      restore.setRect ( old_x, old_y + int(height) - dy, width, d_height);
-    else
-      restore.setRect ( old_x, old_y, width, d_height);
-
-    restoreVTerm (restore);
-  }
-  else
-  {
-    restoreVTerm (old_geometry);
-  }
-
-  restoreOverlaidWindows();
+  // The old and the new window region are composed at the next
+  // terminal update, so that a fast drag is restored only once
+  addDamage (old_geometry);
+  addDamage (getTermGeometryWithShadow());
   FWindow::adjustSize();
   setCursorToFocusWidget();
-
-  if ( updateTerminal() )
-    flush();
 }
 
 //----------------------------------------------------------------------
@@ -287,9 +237,10 @@ inline bool FDialog::moveUp (int n)
   if ( isBottomOutside() )
   {
     const auto y_max = int(getMaxHeight());
+    const FRect old_geometry {getTermGeometryWithShadow()};
     FWindow::setY(y_max, false);
-    putArea (getTermPos(), getVWin());
-    restoreOverlaidWindows();
+    addDamage (old_geometry);
+    addDamage (getTermGeometryWithShadow());
   }
   else
     move ({0, -n});
@@ -310,9 +261,10 @@ inline bool FDialog::moveLeft (int n)
   if ( isLeftOutside() )
   {
     const auto x_max = int(getMaxWidth());
+    const FRect old_geometry {getTermGeometryWithShadow()};
     FWindow::setX(x_max, false);
-    putArea (getTermPos(), getVWin());
-    restoreOverlaidWindows();
+    addDamage (old_geometry);
+    addDamage (getTermGeometryWithShadow());
   }
   else
     move ({-n, 0});
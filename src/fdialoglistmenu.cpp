@@ -30,6 +30,9 @@ namespace finalcut
 // class FDialogListMenu
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FDialogListMenu> FDialogListMenu::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FDialogListMenu::FDialogListMenu(FWidget* parent)
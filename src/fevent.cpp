@@ -77,6 +77,37 @@ void FKeyEvent::ignore()
 { accpt = false; }
 
 
+//----------------------------------------------------------------------
+// class FPasteEvent
+//----------------------------------------------------------------------
+
+FPasteEvent::FPasteEvent ( fc::events ev_type  // constructor
+                         , const FString& str )
+  : FEvent{ev_type}
+  , text{str}
+{ }
+
+//----------------------------------------------------------------------
+FPasteEvent::~FPasteEvent()  // destructor
+{ }
+
+//----------------------------------------------------------------------
+const FString& FPasteEvent::getText() const
+{ return text; }
+
+//----------------------------------------------------------------------
+bool FPasteEvent::isAccepted() const
+{ return accpt; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::accept()
+{ accpt = true; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::ignore()
+{ accpt = false; }
+
+
 //----------------------------------------------------------------------
 // class FMouseEvent
 //----------------------------------------------------------------------
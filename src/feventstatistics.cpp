@@ -0,0 +1,162 @@
+/***********************************************************************
+* feventstatistics.cpp - Counts and times the dispatched events        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <iomanip>
+
+#include "final/feventstatistics.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+constexpr std::array<const char*, FEventStatistics::EVENT_TYPES> event_name =
+{{
+  "None",
+  "KeyPress",
+  "KeyUp",
+  "KeyDown",
+  "Paste",
+  "MouseDown",
+  "MouseUp",
+  "MouseDoubleClick",
+  "MouseWheel",
+  "MouseMove",
+  "FocusIn",
+  "FocusOut",
+  "ChildFocusIn",
+  "ChildFocusOut",
+  "WindowActive",
+  "WindowInactive",
+  "WindowRaised",
+  "WindowLowered",
+  "TerminalFocusIn",
+  "TerminalFocusOut",
+  "Accelerator",
+  "Resize",
+  "Show",
+  "Hide",
+  "Close",
+  "Timer",
+  "User"
+}};
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FEventStatistics
+//----------------------------------------------------------------------
+
+// static class attributes
+constexpr std::size_t FEventStatistics::HISTOGRAM_SIZE;
+constexpr std::size_t FEventStatistics::EVENT_TYPES;
+
+// public methods of FEventStatistics
+//----------------------------------------------------------------------
+uInt64 FEventStatistics::getTotalCount() const
+{
+  uInt64 total{0};
+
+  for (auto&& entry : entries)
+    total += entry.count;
+
+  return total;
+}
+
+//----------------------------------------------------------------------
+const char* FEventStatistics::getEventName (fc::events type)
+{
+  return internal::event_name[getIndex(type)];
+}
+
+//----------------------------------------------------------------------
+std::size_t FEventStatistics::getHistogramBucket (uInt64 nsec)
+{
+  // Returns the number of significant bits of the microseconds
+
+  uInt64 usec = nsec / 1000;
+  std::size_t bucket{0};
+
+  while ( usec > 0 && bucket < HISTOGRAM_SIZE - 1 )
+  {
+    usec >>= 1;
+    bucket++;
+  }
+
+  return bucket;
+}
+
+//----------------------------------------------------------------------
+void FEventStatistics::add (fc::events type, uInt64 nsec)
+{
+  auto& entry = entries[getIndex(type)];
+  entry.count++;
+  entry.total_time += nsec;
+
+  if ( nsec > entry.max_time )
+    entry.max_time = nsec;
+
+  entry.histogram[getHistogramBucket(nsec)]++;
+}
+
+//----------------------------------------------------------------------
+void FEventStatistics::clear()
+{
+  entries.fill(Entry{});
+}
+
+//----------------------------------------------------------------------
+void FEventStatistics::print (std::ostream& out) const
+{
+  // Writes a table of all event types that have occurred
+
+  const auto flags = out.flags();
+  out << std::dec << std::left << std::setw(18) << "event"
+      << std::right << std::setw(10) << "count"
+      << std::setw(10) << "avg [us]"
+      << std::setw(10) << "max [us]"
+      << "  histogram [< 2^n us]\n";
+
+  for (std::size_t index{0}; index < EVENT_TYPES; index++)
+  {
+    const auto& entry = entries[index];
+
+    if ( entry.count == 0 )
+      continue;
+
+    out << std::left << std::setw(18) << internal::event_name[index]
+        << std::right << std::setw(10) << entry.count
+        << std::setw(10) << entry.total_time / entry.count / 1000
+        << std::setw(10) << entry.max_time / 1000 << " ";
+
+    for (std::size_t n{0}; n < HISTOGRAM_SIZE; n++)
+      if ( entry.histogram[n] > 0 )
+        out << " " << n << ":" << entry.histogram[n];
+
+    out << "\n";
+  }
+
+  out.flags(flags);
+}
+
+}  // namespace finalcut
@@ -90,6 +90,7 @@ FString fileChooser ( FWidget* parent
 }
 
 // static class attributes
+const FTypeTag<FFileDialog> FFileDialog::type_tag{};
 FSystem*  FFileDialog::fsystem{nullptr};
 
 
@@ -227,7 +228,7 @@ bool FFileDialog::setShowHiddenFiles (bool enable)
 
   show_hidden = enable;
   readDir();
-  filebrowser.redraw();
+  filebrowser.update();
   return show_hidden;
 }
 
@@ -0,0 +1,175 @@
+/***********************************************************************
+* fgrapheme.cpp - Grapheme cluster segmentation and column width       *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include "final/fgrapheme.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+constexpr wchar_t emoji_presentation_selector = 0xfe0f;
+
+//----------------------------------------------------------------------
+inline bool isControl (FGrapheme::BreakProperty prop)
+{
+  return prop == FGrapheme::CR
+      || prop == FGrapheme::LF
+      || prop == FGrapheme::Control;
+}
+
+//----------------------------------------------------------------------
+inline bool isHangulJoin ( FGrapheme::BreakProperty prev
+                         , FGrapheme::BreakProperty next )
+{
+  // Grapheme break rules GB6 to GB8
+
+  switch ( prev )
+  {
+    case FGrapheme::L:
+      return next == FGrapheme::L
+          || next == FGrapheme::V
+          || next == FGrapheme::LV
+          || next == FGrapheme::LVT;
+
+    case FGrapheme::LV:
+    case FGrapheme::V:
+      return next == FGrapheme::V || next == FGrapheme::T;
+
+    case FGrapheme::LVT:
+    case FGrapheme::T:
+      return next == FGrapheme::T;
+
+    default:
+      return false;
+  }
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FGrapheme
+//----------------------------------------------------------------------
+
+// static class attributes
+constexpr wchar_t     FGrapheme::UNICODE_LAST;
+constexpr std::size_t FGrapheme::BLOCK_SHIFT;
+constexpr std::size_t FGrapheme::INDEX_SIZE;
+constexpr std::size_t FGrapheme::DATA_SIZE;
+
+
+// public methods of FGrapheme
+//----------------------------------------------------------------------
+std::size_t FGrapheme::nextCluster ( const wchar_t str[]
+                                   , std::size_t length
+                                   , std::size_t& width )
+{
+  // Returns the number of characters of the grapheme cluster
+  // at the beginning of str and stores its column width in width
+
+  width = 0;
+
+  if ( ! str || length == 0 )
+    return 0;
+
+  auto prev = getBreakProperty(str[0]);
+  const bool pict_base = isExtendedPictographic(str[0]);
+  bool pict_seq = pict_base;  // ExtPict Extend*
+  bool pict_zwj{false};       // ExtPict Extend* ZWJ
+  std::size_t ri_count = ( prev == RegionalIndicator ) ? 1 : 0;
+  width = getCharWidth(str[0]);
+  std::size_t n{1};
+
+  while ( n < length )
+  {
+    const wchar_t wchar = str[n];
+    const auto next = getBreakProperty(wchar);
+    const bool pict = isExtendedPictographic(wchar);
+
+    if ( prev == CR && next == LF )  // GB3
+    {
+      n++;
+      break;
+    }
+
+    if ( internal::isControl(prev) || internal::isControl(next) )
+      break;  // GB4, GB5
+
+    if ( next == Extend || next == ZWJ )  // GB9
+    {
+      if ( pict_base && wchar == internal::emoji_presentation_selector )
+        width = 2;
+
+      pict_zwj = pict_seq && next == ZWJ;
+      pict_seq = pict_seq && next == Extend;
+    }
+    else if ( internal::isHangulJoin(prev, next)  // GB6 - GB8
+           || next == SpacingMark                 // GB9a
+           || prev == Prepend )                   // GB9b
+    {
+      width += getCharWidth(wchar);
+      pict_seq = pict_zwj = false;
+    }
+    else if ( prev == ZWJ && pict_zwj && pict )  // GB11
+    {
+      // The joined pictograph is part of the same glyph
+      pict_seq = true;
+      pict_zwj = false;
+    }
+    else if ( prev == RegionalIndicator && next == RegionalIndicator
+           && ri_count % 2 == 1 )  // GB12, GB13
+    {
+      // A pair of regional indicators forms a two-column flag
+      ri_count++;
+      width = 2;
+    }
+    else
+      break;  // GB999
+
+    prev = next;
+    n++;
+  }
+
+  return n;
+}
+
+//----------------------------------------------------------------------
+std::size_t FGrapheme::getColumnWidth ( const wchar_t str[]
+                                      , std::size_t length )
+{
+  // Returns the column width of the string in a single pass
+
+  std::size_t column_width{0};
+  std::size_t pos{0};
+
+  while ( pos < length )
+  {
+    std::size_t width{0};
+    pos += nextCluster (str + pos, length - pos, width);
+    column_width += width;
+  }
+
+  return column_width;
+}
+
+}  // namespace finalcut
@@ -0,0 +1,223 @@
+/***********************************************************************
+* finstrumentation.cpp - Counters and timers for the drawing hot paths *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+#include "final/finstrumentation.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+#if defined(MSG_NOSIGNAL)
+constexpr int send_flags = MSG_NOSIGNAL;  // No SIGPIPE on a closed socket
+#else
+constexpr int send_flags = 0;
+#endif
+
+constexpr std::array<const char*, FInstrumentation::NumberOfProbes>
+    probe_name =
+{{
+  "updateVTerm",
+  "putArea",
+  "updateTerminal",
+  "flush",
+  "changeAttribute",
+  "moveCursor",
+  "timerDispatch",
+  "event",
+  "widgetRedraw",
+  "outputBlocked",
+  "frameSkipped"
+}};
+
+//----------------------------------------------------------------------
+inline void addCounter ( FInstrumentation::Counter& to
+                       , const FInstrumentation::Counter& from )
+{
+  to.count += from.count;
+  to.amount += from.amount;
+  to.total_time += from.total_time;
+  to.max_time = std::max(to.max_time, from.max_time);
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FInstrumentation
+//----------------------------------------------------------------------
+
+// static class attributes
+FInstrumentation::Counters         FInstrumentation::frame{};
+FInstrumentation::Counters         FInstrumentation::last_frame{};
+FInstrumentation::Counters         FInstrumentation::totals{};
+uInt64                             FInstrumentation::frames{0};
+bool                               FInstrumentation::enabled{false};
+volatile std::sig_atomic_t         FInstrumentation::dump_request{0};
+std::string                        FInstrumentation::socket_path{};
+
+
+// public methods of FInstrumentation
+//----------------------------------------------------------------------
+FInstrumentation::Counter FInstrumentation::getCounter (Probe probe)
+{
+  // Returns the totals including the running frame
+
+  Counter counter = totals[probe];
+  internal::addCounter (counter, frame[probe]);
+  return counter;
+}
+
+//----------------------------------------------------------------------
+const char* FInstrumentation::getProbeName (Probe probe)
+{
+  if ( probe >= NumberOfProbes )
+    return "";
+
+  return internal::probe_name[probe];
+}
+
+//----------------------------------------------------------------------
+void FInstrumentation::setDumpSignal (int signum)
+{
+  // The given signal requests a dump of the counters
+
+  std::signal (signum, FInstrumentation::dump_signal_handler);
+}
+
+//----------------------------------------------------------------------
+void FInstrumentation::endFrame()
+{
+  if ( ! enabled )
+    return;
+
+  for (std::size_t i{0}; i < NumberOfProbes; i++)
+    internal::addCounter (totals[i], frame[i]);
+
+  last_frame = frame;
+  frame.fill(Counter{});
+  frames++;
+}
+
+//----------------------------------------------------------------------
+void FInstrumentation::clear()
+{
+  frame.fill(Counter{});
+  last_frame.fill(Counter{});
+  totals.fill(Counter{});
+  frames = 0;
+}
+
+//----------------------------------------------------------------------
+void FInstrumentation::print (std::ostream& out)
+{
+  // Writes the totals and the values of the last frame
+
+  const auto flags = out.flags();
+  out << std::dec << "frames: " << frames << "\n"
+      << std::left << std::setw(16) << "probe"
+      << std::right << std::setw(10) << "count"
+      << std::setw(12) << "amount"
+      << std::setw(12) << "time [us]"
+      << std::setw(10) << "max [us]"
+      << std::setw(12) << "last frame"
+      << std::setw(12) << "time [us]" << "\n";
+
+  for (std::size_t i{0}; i < NumberOfProbes; i++)
+  {
+    const auto counter = getCounter(Probe(i));
+    const auto& last = last_frame[i];
+    out << std::left << std::setw(16) << internal::probe_name[i]
+        << std::right << std::setw(10) << counter.count
+        << std::setw(12) << counter.amount
+        << std::setw(12) << counter.total_time / 1000
+        << std::setw(10) << counter.max_time / 1000
+        << std::setw(12) << last.count
+        << std::setw(12) << last.total_time / 1000 << "\n";
+  }
+
+  out.flags(flags);
+}
+
+//----------------------------------------------------------------------
+bool FInstrumentation::writeToSocket (const std::string& text)
+{
+  // Sends the text to the Unix domain socket of the dump socket path
+
+  struct sockaddr_un address{};
+
+  if ( socket_path.empty()
+    || socket_path.length() >= sizeof(address.sun_path) )
+    return false;
+
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if ( fd < 0 )
+    return false;
+
+  address.sun_family = AF_UNIX;
+  std::strncpy ( address.sun_path, socket_path.c_str()
+               , sizeof(address.sun_path) - 1 );
+  auto addr = reinterpret_cast<struct sockaddr*>(&address);
+
+  if ( ::connect(fd, addr, sizeof(address)) != 0 )
+  {
+    ::close(fd);
+    return false;
+  }
+
+  const char* data = text.data();
+  std::size_t remaining = text.length();
+
+  while ( remaining > 0 )
+  {
+    const ssize_t bytes = ::send(fd, data, remaining, internal::send_flags);
+
+    if ( bytes <= 0 )
+      break;
+
+    data += bytes;
+    remaining -= std::size_t(bytes);
+  }
+
+  ::close(fd);
+  return remaining == 0;
+}
+
+
+// private methods of FInstrumentation
+//----------------------------------------------------------------------
+void FInstrumentation::dump_signal_handler (int)
+{
+  // Only async-signal-safe operations are allowed here
+  requestDump();
+}
+
+}  // namespace finalcut
@@ -464,7 +464,7 @@ constexpr std::array<FMetakeyMap, 232> fmetakey =
   { fc::Fmkey_tilde                , "\033~" }   // M-~
 }};
 
-constexpr std::array<FKeyName, 388> fkeyname =
+constexpr std::array<FKeyName, 391> fkeyname =
 {{
   { fc::Fckey_a                   , "Ctrl+A" },
   { fc::Fckey_b                   , "Ctrl+B" },
@@ -853,6 +853,9 @@ constexpr std::array<FKeyName, 388> fkeyname =
   { fc::Fkey_mouse                , "xterm mouse" },
   { fc::Fkey_extended_mouse       , "SGR extended mouse" },
   { fc::Fkey_urxvt_mouse          , "urxvt mouse extension" },
+  { fc::Fkey_paste                , "bracketed paste" },
+  { fc::Fkey_term_focus_in        , "terminal focus in" },
+  { fc::Fkey_term_focus_out       , "terminal focus out" },
   { fc::Fkey_incomplete           , "incomplete key string" }
 }};
 
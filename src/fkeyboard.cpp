@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <string>
 
 #include "final/fapplication.h"
@@ -40,6 +41,8 @@
 #include "final/fterm.h"
 #include "final/ftermdetection.h"
 #include "final/ftermios.h"
+#include "final/ftermrecorder.h"
+#include "final/futf8.h"
 
 #if defined(__linux__)
   #include "final/ftermlinux.h"
@@ -48,6 +51,21 @@
 namespace finalcut
 {
 
+namespace internal
+{
+
+// Bracketed paste mode sequences (DEC private mode 2004)
+constexpr char paste_start[] = "\033[200~";
+constexpr char paste_end[] = "\033[201~";
+constexpr std::size_t paste_seq_len = sizeof(paste_start) - 1;
+
+// Focus event sequences (DEC private mode 1004)
+constexpr char focus_in[] = "\033[I";
+constexpr char focus_out[] = "\033[O";
+constexpr std::size_t focus_seq_len = sizeof(focus_in) - 1;
+
+}  // namespace internal
+
 // static class attributes
 uInt64 FKeyboard::key_timeout{100000};             // 100 ms  (10 Hz)
 uInt64 FKeyboard::read_blocking_time{100000};      // 100 ms  (10 Hz)
@@ -209,6 +227,15 @@ void FKeyboard::clearKeyBufferOnTimeout()
 {
   // Empty the buffer on timeout
 
+  if ( paste_mode )
+  {
+    // Deliver a paste without end sequence after a longer timeout
+    if ( FObject::isTimeout(&time_keypressed, PASTE_TIMEOUT) )
+      finishPasteMode();
+
+    return;
+  }
+
   if ( fifo_in_use && isKeypressTimeout() )
     clearKeyBuffer();
 }
@@ -244,7 +271,26 @@ void FKeyboard::processQueuedInput()
     key = fkey_queue.front();
     fkey_queue.pop();
 
-    if ( key > 0 )
+    if ( key == fc::Fkey_term_focus_in || key == fc::Fkey_term_focus_out )
+    {
+      termFocusChanged();
+      key = 0;
+
+      if ( FApplication::isQuit() )
+        return;
+    }
+    else if ( key == fc::Fkey_paste )
+    {
+      paste_text = paste_queue.front();
+      paste_queue.pop();
+      textPasted();
+      paste_text = FString{};
+      key = 0;
+
+      if ( FApplication::isQuit() )
+        return;
+    }
+    else if ( key > 0 )
     {
       keyPressed();
 
@@ -290,6 +336,33 @@ inline FKey FKeyboard::getMouseProtocolKey() const
   return NOT_SET;
 }
 
+//----------------------------------------------------------------------
+inline FKey FKeyboard::getTermFocusKey()
+{
+  // Looking for a terminal focus event in the key buffer
+
+  constexpr std::size_t len = internal::focus_seq_len;
+  FKey keycode{};
+
+  if ( std::strncmp(fifo_buf, internal::focus_in, len) == 0 )
+    keycode = fc::Fkey_term_focus_in;
+  else if ( std::strncmp(fifo_buf, internal::focus_out, len) == 0 )
+    keycode = fc::Fkey_term_focus_out;
+  else
+    return NOT_SET;
+
+  std::size_t n{};
+
+  for (n = len; n < FIFO_BUF_SIZE; n++)  // Remove founded entry
+    fifo_buf[n - len] = fifo_buf[n];
+
+  for (n = n - len; n < FIFO_BUF_SIZE; n++)  // Fill rest with '\0'
+    fifo_buf[n] = '\0';
+
+  unprocessed_buffer_data = bool(fifo_buf[0] != '\0');
+  return keycode;
+}
+
 //----------------------------------------------------------------------
 inline FKey FKeyboard::getTermcapKey()
 {
@@ -416,6 +489,14 @@ inline bool FKeyboard::isKeypressTimeout()
   return FObject::isTimeout (&time_keypressed, key_timeout);
 }
 
+//----------------------------------------------------------------------
+inline bool FKeyboard::isPasteStart() const
+{
+  return std::strncmp ( fifo_buf
+                      , internal::paste_start
+                      , internal::paste_seq_len ) == 0;
+}
+
 //----------------------------------------------------------------------
 FKey FKeyboard::UTF8decode (const char utf8[]) const
 {
@@ -478,6 +559,10 @@ inline ssize_t FKeyboard::readKey()
   setNonBlockingInput();
   const ssize_t bytes = read(FTermios::getStdIn(), &read_character, 1);
   unsetNonBlockingInput();
+
+  if ( bytes > 0 && FTerm::getFTermRecorder() )
+    FTerm::getFTermRecorder()->recordInput (read_character);
+
   return bytes;
 }
 
@@ -487,7 +572,13 @@ void FKeyboard::parseKeyBuffer()
   ssize_t bytesread{};
   FObject::getCurrentTime (&time_keypressed);
 
-  while ( (bytesread = readKey()) > 0 )
+  if ( paste_mode )
+  {
+    readPasteData();
+    parseFifoBuffer();  // Keys after the end of the paste
+  }
+
+  while ( ! paste_mode && (bytesread = readKey()) > 0 )
   {
     has_pending_input = false;
 
@@ -498,36 +589,51 @@ void FKeyboard::parseKeyBuffer()
       fifo_in_use = true;
     }
 
-    // Read the rest from the fifo buffer
-    while ( ! isKeypressTimeout()
-         && fifo_offset > 0
-         && fkey != fc::Fkey_incomplete )
-    {
-      fkey = parseKeyString();
-      fkey = keyCorrection(fkey);
+    parseFifoBuffer();
 
-      if ( fkey == fc::Fkey_mouse
-        || fkey == fc::Fkey_extended_mouse
-        || fkey == fc::Fkey_urxvt_mouse )
-      {
-        key = fkey;
-        mouseTracking();
-        fifo_offset = int(std::strlen(fifo_buf));
-        break;
-      }
+    if ( fkey_queue.size() >= MAX_QUEUE_SIZE )
+      break;
+  }
+}
 
-      if ( fkey != fc::Fkey_incomplete )
-      {
-        fkey_queue.push(fkey);
-        fifo_offset = int(std::strlen(fifo_buf));
-      }
+//----------------------------------------------------------------------
+void FKeyboard::parseFifoBuffer()
+{
+  // Read the rest from the fifo buffer
+  while ( ! paste_mode
+       && ! isKeypressTimeout()
+       && fifo_offset > 0
+       && fkey != fc::Fkey_incomplete )
+  {
+    fkey = parseKeyString();
+
+    if ( fkey == fc::Fkey_paste )  // Start of a bracketed paste
+    {
+      startPasteMode();
+      readPasteData();
+      continue;
     }
 
-    fkey = 0;
+    fkey = keyCorrection(fkey);
 
-    if ( fkey_queue.size() >= MAX_QUEUE_SIZE )
+    if ( fkey == fc::Fkey_mouse
+      || fkey == fc::Fkey_extended_mouse
+      || fkey == fc::Fkey_urxvt_mouse )
+    {
+      key = fkey;
+      mouseTracking();
+      fifo_offset = int(std::strlen(fifo_buf));
       break;
+    }
+
+    if ( fkey != fc::Fkey_incomplete )
+    {
+      fkey_queue.push(fkey);
+      fifo_offset = int(std::strlen(fifo_buf));
+    }
   }
+
+  fkey = 0;
 }
 
 //----------------------------------------------------------------------
@@ -537,7 +643,15 @@ FKey FKeyboard::parseKeyString()
 
   if ( firstchar == ESC[0] )
   {
-    FKey keycode = getMouseProtocolKey();
+    if ( isPasteStart() )
+      return fc::Fkey_paste;
+
+    FKey keycode = getTermFocusKey();
+
+    if ( keycode != NOT_SET )
+      return keycode;
+
+    keycode = getMouseProtocolKey();
 
     if ( keycode != NOT_SET )
       return keycode;
@@ -605,6 +719,113 @@ void FKeyboard::substringKeyHandling()
   }
 }
 
+//----------------------------------------------------------------------
+void FKeyboard::startPasteMode()
+{
+  // Moves the buffer content after the start sequence
+  // into the paste buffer
+
+  paste_mode = true;
+  paste_buffer.assign (fifo_buf + internal::paste_seq_len);
+  std::fill_n (fifo_buf, FIFO_BUF_SIZE, '\0');
+  fifo_offset = 0;
+  fifo_in_use = false;
+  unprocessed_buffer_data = false;
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::readPasteData()
+{
+  // Reads the pasted text in blocks up to the end sequence
+
+  std::size_t end_pos = paste_buffer.find(internal::paste_end);
+
+  if ( end_pos == std::string::npos )
+  {
+    std::array<char, PASTE_READ_SIZE> block{};
+    const auto recorder = FTerm::getFTermRecorder();
+    const int stdin_no = FTermios::getStdIn();
+    ssize_t bytes{};
+    setNonBlockingInput();
+
+    while ( end_pos == std::string::npos
+         && (bytes = read(stdin_no, block.data(), block.size())) > 0 )
+    {
+      has_pending_input = false;
+
+      if ( recorder )
+        for (ssize_t i{0}; i < bytes; i++)
+          recorder->recordInput (block[std::size_t(i)]);
+
+      // The end sequence can span two blocks
+      const std::size_t size = paste_buffer.length();
+      const std::size_t search_pos = ( size < internal::paste_seq_len )
+                                     ? 0 : size - internal::paste_seq_len;
+      paste_buffer.append (block.data(), std::size_t(bytes));
+      end_pos = paste_buffer.find(internal::paste_end, search_pos);
+    }
+
+    unsetNonBlockingInput();
+  }
+
+  if ( end_pos == std::string::npos )
+    return;  // Wait for more data
+
+  // Keys after the end sequence go back into the fifo buffer
+  const std::size_t rest_pos = end_pos + internal::paste_seq_len;
+  const std::size_t rest_len = std::min ( paste_buffer.length() - rest_pos
+                                        , FIFO_BUF_SIZE - 1 );
+  std::copy_n (paste_buffer.begin() + int(rest_pos), rest_len, fifo_buf);
+  fifo_offset = int(std::strlen(fifo_buf));
+  fifo_in_use = bool(fifo_offset > 0);
+  unprocessed_buffer_data = fifo_in_use;
+  paste_buffer.resize(end_pos);
+  finishPasteMode();
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::finishPasteMode()
+{
+  // Converts the pasted bytes into text with "\n" line breaks
+  // and queues it as a single paste key
+
+  const std::size_t length = paste_buffer.length();
+  std::wstring text(length, L'\0');
+
+  if ( utf8_input && length > 0 )
+    text.resize (decodeUTF8(paste_buffer.data(), length, &text[0]));
+  else
+    std::transform ( paste_buffer.begin(), paste_buffer.end(), text.begin()
+                   , [] (char ch) { return wchar_t(uChar(ch)); } );
+
+  std::size_t out{0};
+
+  for (std::size_t i{0}; i < text.length(); i++)
+  {
+    if ( text[i] == L'\r' )
+    {
+      text[out] = L'\n';
+
+      if ( i + 1 < text.length() && text[i + 1] == L'\n' )
+        i++;
+    }
+    else
+      text[out] = text[i];
+
+    out++;
+  }
+
+  text.resize(out);
+  paste_buffer.clear();
+  paste_mode = false;
+
+  if ( text.empty() )
+    return;
+
+  paste_queue.push(text);
+  fkey_queue.push(fc::Fkey_paste);
+}
+
 //----------------------------------------------------------------------
 void FKeyboard::keyPressed() const
 {
@@ -629,4 +850,16 @@ void FKeyboard::mouseTracking() const
   mouse_tracking_cmd.execute();
 }
 
+//----------------------------------------------------------------------
+void FKeyboard::textPasted() const
+{
+  paste_cmd.execute();
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::termFocusChanged() const
+{
+  term_focus_cmd.execute();
+}
+
 }  // namespace finalcut
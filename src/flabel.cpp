@@ -37,6 +37,9 @@ namespace finalcut
 // class FLabel
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FLabel> FLabel::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FLabel::FLabel(FWidget* parent)
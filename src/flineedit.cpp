@@ -40,6 +40,9 @@ namespace finalcut
 // class FLineEdit
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FLineEdit> FLineEdit::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FLineEdit::FLineEdit (FWidget* parent)
@@ -361,6 +364,20 @@ void FLineEdit::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FLineEdit::onPaste (FPasteEvent* ev)
+{
+  if ( isReadOnly() )
+    return;
+
+  if ( pasteInput(ev->getText()) )
+  {
+    ev->accept();
+    drawInputField();
+    forceTerminalUpdate();
+  }
+}
+
 //----------------------------------------------------------------------
 void FLineEdit::onMouseDown (FMouseEvent* ev)
 {
@@ -1096,6 +1113,64 @@ inline bool FLineEdit::keyInput (FKey key)
     return false;
 }
 
+//----------------------------------------------------------------------
+bool FLineEdit::pasteInput (const FString& str)
+{
+  // Inserts the pasted text in one step. Line breaks and
+  // tabs become spaces, other control characters are dropped.
+
+  const bool use_filter = ! input_filter.empty();
+  const std::wregex filter{ use_filter ? input_filter : L".*" };
+  std::array<wchar_t, 2> character{{L'\0', L'\0'}};
+  std::wstring input{};
+  input.reserve(str.getLength());
+
+  for (auto ch : str)
+  {
+    if ( ch == L'\n' || ch == L'\t' )
+      ch = L' ';
+
+    if ( ch < 0x20 || ch == 0x7f )
+      continue;
+
+    character[0] = ch;
+
+    if ( use_filter && ! regex_match(character.data(), filter) )
+      continue;
+
+    input += ch;
+  }
+
+  if ( input.empty() )
+    return false;
+
+  const auto len = text.getLength();
+  const auto end = ( insert_mode ) ? len : cursor_pos;
+  const std::size_t room = ( max_length > end ) ? max_length - end : 0;
+
+  if ( input.length() > room )
+  {
+    FTerm::beep();
+    input.resize(room);
+
+    if ( input.empty() )
+      return true;
+  }
+
+  if ( len == 0 )
+    text.setString(input);
+  else if ( insert_mode )
+    text.insert(input, cursor_pos);
+  else
+    text.overwrite(input, cursor_pos);
+
+  cursor_pos += input.length();
+  print_text = ( isPasswordField() ) ? getPasswordText() : text;
+  adjustTextOffset();
+  processChanged();
+  return true;
+}
+
 //----------------------------------------------------------------------
 inline wchar_t FLineEdit::characterFilter (const wchar_t c) const
 {
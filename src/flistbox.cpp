@@ -21,6 +21,7 @@
 ***********************************************************************/
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 
 #include "final/fapplication.h"
@@ -47,6 +48,7 @@ FListBoxItem::FListBoxItem()
 FListBoxItem::FListBoxItem (const FListBoxItem& item)
   : text{item.text}
   , data_pointer{item.data_pointer}
+  , line_width{item.line_width}
   , brackets{item.brackets}
   , selected{item.selected}
 { }
@@ -67,17 +69,47 @@ FListBoxItem& FListBoxItem::operator = (const FListBoxItem& item)
   {
     text         = item.text;
     data_pointer = item.data_pointer;
+    line_width   = item.line_width;
     brackets     = item.brackets;
     selected     = item.selected;
     return *this;
   }
 }
 
+//----------------------------------------------------------------------
+void FListBoxItem::setText (const FString& txt)
+{
+  if ( listbox )
+  {
+    const FString old_text{text};
+    text.setString(txt);
+    listbox->changeItemText (*this, old_text);
+  }
+  else
+    text.setString(txt);
+}
+
+//----------------------------------------------------------------------
+void FListBoxItem::clear()
+{
+  if ( listbox )
+  {
+    const FString old_text{text};
+    text.clear();
+    listbox->changeItemText (*this, old_text);
+  }
+  else
+    text.clear();
+}
+
 
 //----------------------------------------------------------------------
 // class FListBox
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FListBox> FListBox::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FListBox::FListBox (FWidget* parent)
@@ -116,7 +148,7 @@ void FListBox::setCurrentItem (std::size_t index)
   yoffset = 0;
   adjustSize();
   vbar->setValue(yoffset);
-  redraw();
+  update();
 }
 
 //----------------------------------------------------------------------
@@ -131,29 +163,15 @@ void FListBox::showInsideBrackets ( const std::size_t index
                                   , fc::brackets_type b )
 {
   auto iter = index2iterator(index - 1);
+  const std::size_t old_max_width = max_line_width;
+  removeLineWidth (*iter);
   iter->brackets = b;
+  addLineWidth (*iter);
 
-  if ( b == fc::NoBrackets )
-    return;
-
-  const auto column_width = getColumnWidth(iter->getText()) + 2;
-
-  if ( column_width > max_line_width )
+  if ( max_line_width != old_max_width )
   {
-    max_line_width = column_width;
-
-    if ( column_width >= getWidth() - nf_offset - 3 )
-    {
-      const int hmax = ( max_line_width > getWidth() - nf_offset - 4 )
-                       ? int(max_line_width - getWidth() + nf_offset + 4)
-                       : 0;
-      hbar->setMaximum (hmax);
-      hbar->setPageSize (int(max_line_width), int(getWidth() - nf_offset - 4));
-      hbar->setValue (xoffset);
-
-      if ( ! hbar->isShown() )
-        hbar->show();
-    }
+    recalculateHorizontalBar();
+    hbar->setValue (xoffset);
   }
 }
 
@@ -178,6 +196,40 @@ void FListBox::setText (const FString& txt)
   text.setString(txt);
 }
 
+//----------------------------------------------------------------------
+void FListBox::setFilter ( const FString& pattern
+                         , FSearchIndex::MatchMode mode )
+{
+  // Shows only the items that match the pattern.
+  // The filter is applied again after each change of the list.
+
+  restoreFilteredItems();
+  filter.pattern.clear();
+
+  if ( pattern.isEmpty() || conv_type == lazy_convert )
+  {
+    afterFilterChange();
+    return;
+  }
+
+  filter.pattern = pattern;
+  filter.mode = mode;
+  applyFilter();
+  current = ( itemlist.empty() ) ? 0 : 1;
+  afterFilterChange();
+}
+
+//----------------------------------------------------------------------
+void FListBox::clearFilter()
+{
+  if ( ! filter.active )
+    return;
+
+  restoreFilteredItems();
+  filter.pattern.clear();
+  afterFilterChange();
+}
+
 //----------------------------------------------------------------------
 void FListBox::hide()
 {
@@ -188,73 +240,140 @@ void FListBox::hide()
 //----------------------------------------------------------------------
 void FListBox::insert (const FListBoxItem& listItem)
 {
-  const std::size_t column_width = getColumnWidth(listItem.text);
-  const bool has_brackets(listItem.brackets);
-  recalculateHorizontalBar (column_width, has_brackets);
-
-  itemlist.push_back (listItem);
+  const std::size_t old_max_width = max_line_width;
+  appendItem (listItem);
 
   if ( current == 0 )
     current = 1;
 
-  std::size_t element_count = getCount();
+  if ( max_line_width > old_max_width )
+    recalculateHorizontalBar();
+
+  const std::size_t element_count = getCount();
   recalculateVerticalBar (element_count);
+  reapplyFilter();
+}
+
+//----------------------------------------------------------------------
+void FListBox::insert (const FListBoxItems& items)
+{
+  // Appends all items and updates the scroll bars only once
+
+  reserve (itemlist.size() + items.size());
+
+  for (auto&& item : items)
+    appendItem (item);
+
+  afterInsertion();
 }
 
 //----------------------------------------------------------------------
 void FListBox::remove (std::size_t item)
 {
-  if ( item > getCount() )
+  remove (item, 1);
+}
+
+//----------------------------------------------------------------------
+void FListBox::remove (std::size_t item, std::size_t count)
+{
+  // Removes count items starting with the 1-based position item.
+  // With an active filter, the position refers to the shown items
+  // and the filter is applied again to the remaining items.
+
+  if ( item < 1 || item > getCount() || count == 0 )
     return;
 
-  itemlist.erase (itemlist.begin() + int(item) - 1);
-  const std::size_t element_count = getCount();
-  max_line_width = 0;
+  count = std::min(count, getCount() - item + 1);
 
-  for (auto&& listbox_item : itemlist)
+  if ( ! filter.active )
   {
-    const auto column_width = getColumnWidth(listbox_item.getText());
+    removeItems (item, count);
+    return;
+  }
 
-    if ( column_width > max_line_width )
-      max_line_width = column_width;
+  // Map the shown items to their positions in the complete list
+  const auto first_pos = filter.positions.begin() + int(item) - 1;
+  const std::vector<std::size_t> positions(first_pos, first_pos + int(count));
+  restoreFilteredItems();
+  std::size_t last = positions.size();
+
+  while ( last > 0 )  // Removes contiguous runs from the back
+  {
+    std::size_t first = last - 1;
+
+    while ( first > 0 && positions[first - 1] + 1 == positions[first] )
+      first--;
+
+    removeItems (positions[first] + 1, last - first);
+    last = first;
   }
 
-  const int hmax = ( max_line_width > getWidth() - nf_offset - 4 )
-                   ? int(max_line_width - getWidth() + nf_offset + 4)
-                   : 0;
-  hbar->setMaximum (hmax);
-  hbar->setPageSize (int(max_line_width), int(getWidth() - nf_offset - 4));
+  reapplyFilter();
+}
 
-  if ( hbar->isShown() && isHorizontallyScrollable() )
-    hbar->hide();
+//----------------------------------------------------------------------
+void FListBox::replace (std::size_t item, const FListBoxItem& listItem)
+{
+  // With an active filter, the position refers to the shown items
+  // and the filter is applied again to the changed list
 
-  const int vmax = ( element_count + 2 > getHeight() )
-                   ? int(element_count - getHeight()) + 2
-                   : 0;
-  vbar->setMaximum (vmax);
-  vbar->setPageSize (int(element_count), int(getHeight()) - 2);
+  if ( item < 1 || item > getCount() )
+    return;
+
+  if ( filter.active )
+  {
+    item = filter.positions[item - 1] + 1;
+    restoreFilteredItems();
+  }
+
+  auto iter = index2iterator(item - 1);
+  const std::size_t old_max_width = max_line_width;
+  removeLineWidth (*iter);
+  search_index.replace (iter->getText(), listItem.getText(), item - 1);
+  *iter = listItem;
+  addLineWidth (*iter);
 
-  if ( vbar->isShown() && isVerticallyScrollable() )
-    vbar->hide();
+  if ( max_line_width != old_max_width )
+    recalculateHorizontalBar();
+
+  reapplyFilter();
+}
+
+//----------------------------------------------------------------------
+void FListBox::replace (const FListBoxItems& items)
+{
+  // Replaces the complete list content and keeps the current
+  // position if it is still valid
 
-  if ( current >= item && current > 1 )
-    current--;
+  restoreFilteredItems();
+  itemlist = items;
+  bindItems();
+  search_index.invalidate();
+  rebuildLineWidths();
+  const std::size_t element_count = getCount();
 
   if ( current > element_count )
     current = element_count;
+  else if ( current == 0 && element_count > 0 )
+    current = 1;
 
-  if ( yoffset > int(element_count - getHeight()) + 2 )
-    yoffset = int(element_count - getHeight()) + 2;
+  if ( element_count == 0 )
+    xoffset = 0;
 
-  if ( yoffset < 0 )
-    yoffset = 0;
+  recalculateHorizontalBar();
+  recalculateVerticalBar (element_count);
+  adjustYOffset (element_count);
+  reapplyFilter();
 }
 
 //----------------------------------------------------------------------
 void FListBox::clear()
 {
+  filter = FilterData{};
   itemlist.clear();
   itemlist.shrink_to_fit();
+  line_width_count.clear();
+  search_index.clear();
   current = 0;
   xoffset = 0;
   yoffset = 0;
@@ -305,6 +424,35 @@ void FListBox::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FListBox::onPaste (FPasteEvent* ev)
+{
+  // With paste insertion, each pasted line becomes a new item.
+  // All items are inserted at once, followed by a single redraw.
+  // Otherwise, the text is typed in as key presses.
+
+  if ( ! paste_insertion )
+    return;
+
+  FListBoxItems items{};
+
+  for (auto&& line : ev->getText().split("\n"))
+    if ( ! line.isEmpty() )
+      items.emplace_back (line);
+
+  if ( items.empty() )
+    return;
+
+  const std::size_t current_before = current;
+  insert (items);
+  ev->accept();
+
+  if ( current_before != current )
+    processChanged();
+
+  updateDrawing (true, true);
+}
+
 //----------------------------------------------------------------------
 void FListBox::onMouseDown (FMouseEvent* ev)
 {
@@ -1082,32 +1230,180 @@ inline void FListBox::updateDrawing (bool draw_vbar, bool draw_hbar)
 }
 
 //----------------------------------------------------------------------
-void FListBox::recalculateHorizontalBar (std::size_t len, bool has_brackets)
+void FListBox::appendItem (const FListBoxItem& listItem)
+{
+  restoreFilteredItems();
+  const std::size_t capacity = itemlist.capacity();
+  itemlist.push_back (listItem);
+
+  if ( itemlist.capacity() != capacity )
+    bindItems();  // The items have been copied to a new memory block
+  else
+    itemlist.back().listbox = this;
+
+  addLineWidth (itemlist.back());
+  search_index.add (listItem.text, itemlist.size() - 1);
+}
+
+//----------------------------------------------------------------------
+void FListBox::bindItems()
+{
+  // The copies of the items in the list need
+  // the list box to report their text changes
+
+  for (auto&& listItem : itemlist)
+    listItem.listbox = this;
+}
+
+//----------------------------------------------------------------------
+std::size_t FListBox::getItemPosition (const FListBoxItem& listItem) const
+{
+  // Returns the 1-based position of the item in the shown list
+  // or 0 if the item is not part of it
+
+  if ( itemlist.empty() )
+    return 0;
+
+  const std::less<const FListBoxItem*> less{};
+  const FListBoxItem* first = &itemlist.front();
+
+  if ( less(&listItem, first) || ! less(&listItem, first + itemlist.size()) )
+    return 0;
+
+  return std::size_t(&listItem - first) + 1;
+}
+
+//----------------------------------------------------------------------
+void FListBox::changeItemText ( FListBoxItem& listItem
+                               , const FString& old_text )
 {
-  if ( has_brackets )
-    len += 2;
+  // Called by FListBoxItem::setText() and clear()
+
+  const std::size_t pos = getItemPosition(listItem);
 
-  if ( len <= max_line_width )
+  if ( pos == 0 )
     return;
 
-  max_line_width = len;
+  const std::size_t old_max_width = max_line_width;
+  removeLineWidth (listItem);
+  addLineWidth (listItem);
+  search_index.replace (old_text, listItem.text, pos - 1);
 
-  if ( len >= getWidth() - nf_offset - 3 )
+  if ( max_line_width != old_max_width )
   {
-    const int hmax = ( max_line_width > getWidth() - nf_offset - 4 )
-                     ? int(max_line_width - getWidth() + nf_offset + 4)
-                     : 0;
-    hbar->setMaximum (hmax);
-    hbar->setPageSize (int(max_line_width), int(getWidth() - nf_offset) - 4);
-    hbar->calculateSliderValues();
+    recalculateHorizontalBar();
+    hbar->setValue (xoffset);
+  }
+}
 
-    if ( isShown() )
-    {
-      if ( isHorizontallyScrollable() )
-        hbar->show();
-      else
-        hbar->hide();
-    }
+//----------------------------------------------------------------------
+void FListBox::removeItems (std::size_t item, std::size_t count)
+{
+  // Removes count items of the complete list starting
+  // with the 1-based position item
+
+  const auto first = itemlist.begin() + int(item) - 1;
+  const auto last = first + int(count);
+
+  for (auto iter = first; iter != last; ++iter)
+    removeLineWidth (*iter);
+
+  itemlist.erase (first, last);
+  search_index.invalidate();  // Positions moved, rebuilt at the next search
+  const std::size_t element_count = getCount();
+  recalculateHorizontalBar();
+  recalculateVerticalBar (element_count);
+
+  if ( current >= item + count )
+    current -= count;
+  else if ( current >= item )
+    current = ( item > 1 ) ? item - 1 : 1;
+
+  if ( current > element_count )
+    current = element_count;
+
+  if ( yoffset > int(element_count - getHeight()) + 2 )
+    yoffset = int(element_count - getHeight()) + 2;
+
+  if ( yoffset < 0 )
+    yoffset = 0;
+}
+
+//----------------------------------------------------------------------
+void FListBox::addLineWidth (FListBoxItem& listItem)
+{
+  // The number of items per line width is stored in an ordered map,
+  // so the maximum width is known after every insert or remove
+  // in O(log n) without scanning the whole list
+
+  listItem.line_width = getColumnWidth(listItem.text);
+
+  if ( listItem.brackets != fc::NoBrackets )
+    listItem.line_width += 2;
+
+  line_width_count[listItem.line_width]++;
+
+  if ( listItem.line_width > max_line_width )
+    max_line_width = listItem.line_width;
+}
+
+//----------------------------------------------------------------------
+void FListBox::removeLineWidth (const FListBoxItem& listItem)
+{
+  const auto iter = line_width_count.find(listItem.line_width);
+
+  if ( iter == line_width_count.end() )
+    return;
+
+  if ( iter->second > 1 )
+    iter->second--;
+  else
+    line_width_count.erase(iter);
+
+  max_line_width = ( line_width_count.empty() )
+                   ? 0
+                   : line_width_count.rbegin()->first;
+}
+
+//----------------------------------------------------------------------
+void FListBox::rebuildLineWidths()
+{
+  line_width_count.clear();
+  max_line_width = 0;
+
+  for (auto&& listItem : itemlist)
+    addLineWidth (listItem);
+}
+
+//----------------------------------------------------------------------
+void FListBox::afterInsertion()
+{
+  // Scroll bar update after one or more items have been inserted
+
+  if ( current == 0 && getCount() > 0 )
+    current = 1;
+
+  recalculateHorizontalBar();
+  recalculateVerticalBar (getCount());
+  reapplyFilter();
+}
+
+//----------------------------------------------------------------------
+void FListBox::recalculateHorizontalBar()
+{
+  const int hmax = ( max_line_width > getWidth() - nf_offset - 4 )
+                   ? int(max_line_width - getWidth() + nf_offset + 4)
+                   : 0;
+  hbar->setMaximum (hmax);
+  hbar->setPageSize (int(max_line_width), int(getWidth() - nf_offset) - 4);
+  hbar->calculateSliderValues();
+
+  if ( isShown() )
+  {
+    if ( isHorizontallyScrollable() )
+      hbar->show();
+    else
+      hbar->hide();
   }
 }
 
@@ -1547,28 +1843,15 @@ inline bool FListBox::spacebarProcessing()
   if ( inc_len > 0 )  // Enter a spacebar for incremental search
   {
     inc_search += L' ';
-    bool inc_found{false};
-    auto iter = itemlist.begin();
+    const std::size_t pos = findIncSearchItem(inc_search);
 
-    while ( iter != itemlist.end() )
-    {
-      if ( ! inc_found
-        && inc_search.toLower()
-        == iter->getText().left(inc_len + 1).toLower() )
-      {
-        setCurrentItem(iter);
-        inc_found = true;
-        break;
-      }
-
-      ++iter;
-    }
-
-    if ( ! inc_found )
+    if ( pos == FSearchIndex::NOT_FOUND )
     {
       inc_search.remove(inc_len, 1);
       return false;
     }
+
+    setCurrentItem(pos + 1);
   }
   else if ( isMultiSelection() )  // Change selection
   {
@@ -1624,19 +1907,10 @@ inline bool FListBox::deletePreviousCharacter()
 
   if ( inc_len > 1 )
   {
-    auto iter = itemlist.begin();
-
-    while ( iter != itemlist.end() )
-    {
-      if ( inc_search.toLower()
-           == iter->getText().left(inc_len - 1).toLower() )
-      {
-        setCurrentItem(iter);
-        break;
-      }
+    const std::size_t pos = findIncSearchItem(inc_search);
 
-      ++iter;
-    }
+    if ( pos != FSearchIndex::NOT_FOUND )
+      setCurrentItem(pos + 1);
   }
 
   return true;
@@ -1654,25 +1928,10 @@ inline bool FListBox::keyIncSearchInput (FKey key)
   else
     inc_search += wchar_t(key);
 
-  std::size_t inc_len = inc_search.getLength();
-  bool inc_found{false};
-  auto iter = itemlist.begin();
-
-  while ( iter != itemlist.end() )
-  {
-    if ( ! inc_found
-      && inc_search.toLower()
-      == iter->getText().left(inc_len).toLower() )
-    {
-      setCurrentItem(iter);
-      inc_found = true;
-      break;
-    }
-
-    ++iter;
-  }
+  const std::size_t inc_len = inc_search.getLength();
+  const std::size_t pos = findIncSearchItem(inc_search);
 
-  if ( ! inc_found )
+  if ( pos == FSearchIndex::NOT_FOUND )
   {
     inc_search.remove(inc_len - 1, 1);
 
@@ -1682,9 +1941,162 @@ inline bool FListBox::keyIncSearchInput (FKey key)
       return true;
   }
 
+  setCurrentItem(pos + 1);
   return true;
 }
 
+//----------------------------------------------------------------------
+std::size_t FListBox::findIncSearchItem (const FString& prefix)
+{
+  // Returns the 0-based position of the first item that begins
+  // with prefix, or FSearchIndex::NOT_FOUND
+
+  if ( ! search_index.isValid() )
+    buildSearchIndex();
+
+  std::size_t pos = search_index.findPrefix(prefix);
+
+  // An item can also be overwritten by an assignment via getItem()
+  // without a report, so a hit is verified and the index rebuilt
+  // if necessary
+  if ( pos != FSearchIndex::NOT_FOUND
+    && ( pos >= getCount()
+      || ! FSearchIndex::startsWith(itemlist[pos].getText(), prefix) ) )
+  {
+    buildSearchIndex();
+    pos = search_index.findPrefix(prefix);
+  }
+
+  return pos;
+}
+
+//----------------------------------------------------------------------
+void FListBox::buildSearchIndex()
+{
+  search_index.clear();
+
+  for (std::size_t i{0}; i < itemlist.size(); i++)
+    search_index.add (itemlist[i].getText(), i);
+}
+
+//----------------------------------------------------------------------
+void FListBox::applyFilter()
+{
+  // Moves the complete list aside and shows the matching items
+
+  if ( ! search_index.isValid() )
+    buildSearchIndex();
+
+  filter.positions = search_index.match(filter.pattern, filter.mode);
+  filter.items.swap(itemlist);
+  std::swap (filter.index, search_index);
+  filter.line_width_count.swap(line_width_count);
+  filter.active = true;
+  itemlist.reserve(filter.positions.size());
+
+  for (auto&& pos : filter.positions)
+    itemlist.push_back(filter.items[pos]);
+
+  bindItems();
+  search_index.invalidate();
+  rebuildLineWidths();
+}
+
+//----------------------------------------------------------------------
+void FListBox::reapplyFilter()
+{
+  // Filters the list again after a change of its content.
+  // The current item moves to the nearest shown item before it.
+
+  if ( filter.active || filter.pattern.isEmpty()
+    || conv_type == lazy_convert )
+    return;
+
+  const std::size_t current_pos = current;  // In the complete list
+  applyFilter();
+  const auto& positions = filter.positions;
+  const auto iter = std::upper_bound ( positions.begin(), positions.end()
+                                     , current_pos - 1 );
+
+  if ( itemlist.empty() )
+    current = 0;
+  else if ( current_pos == 0 || iter == positions.begin() )
+    current = 1;
+  else
+    current = std::size_t(iter - positions.begin());
+
+  const std::size_t element_count = getCount();
+  recalculateHorizontalBar();
+  recalculateVerticalBar (element_count);
+  adjustYOffset (element_count);
+}
+
+//----------------------------------------------------------------------
+void FListBox::restoreFilteredItems()
+{
+  // Returns the shown items to the complete list and
+  // keeps the current item and the filter setting
+
+  if ( ! filter.active )
+    return;
+
+  const std::size_t shown = itemlist.size();
+
+  if ( current > 0 && current <= shown )
+    current = filter.positions[current - 1] + 1;
+  else
+    current = ( filter.items.empty() ) ? 0 : 1;
+
+  itemlist.swap(filter.items);
+  std::swap (search_index, filter.index);
+  line_width_count.swap(filter.line_width_count);
+  max_line_width = ( line_width_count.empty() )
+                   ? 0
+                   : line_width_count.rbegin()->first;
+
+  // Take over the shown items, their texts may have changed
+  for (std::size_t i{0}; i < shown; i++)
+  {
+    auto& listItem = itemlist[filter.positions[i]];
+    const auto& shown_item = filter.items[i];
+
+    if ( listItem.text != shown_item.text )
+      search_index.replace ( listItem.text, shown_item.text
+                           , filter.positions[i] );
+
+    if ( listItem.line_width != shown_item.line_width )
+    {
+      removeLineWidth (listItem);
+      listItem = shown_item;
+      addLineWidth (listItem);
+    }
+    else
+      listItem = shown_item;
+  }
+
+  FilterData setting{};
+  setting.pattern = filter.pattern;
+  setting.mode = filter.mode;
+  std::swap (filter, setting);
+}
+
+//----------------------------------------------------------------------
+void FListBox::afterFilterChange()
+{
+  const std::size_t element_count = getCount();
+  inc_search.clear();
+  xoffset = 0;
+  yoffset = 0;
+  last_current = -1;
+  last_yoffset = -1;
+  recalculateHorizontalBar();
+  recalculateVerticalBar (element_count);
+  adjustYOffset (element_count);
+  vbar->setValue(yoffset);
+  hbar->setValue(xoffset);
+  update();
+}
+
 //----------------------------------------------------------------------
 void FListBox::processClick() const
 {
@@ -1724,9 +2136,17 @@ void FListBox::lazyConvert(FListBoxItems::iterator iter, std::size_t y)
   if ( conv_type != lazy_convert || ! iter->getText().isNull() )
     return;
 
-  lazy_inserter (*iter, source_container, y + std::size_t(yoffset));
-  const auto column_width = getColumnWidth(iter->text);
-  recalculateHorizontalBar (column_width, hasBrackets(iter));
+  const std::size_t old_max_width = max_line_width;
+  const std::size_t index = y + std::size_t(yoffset);
+  removeLineWidth (*iter);
+  iter->listbox = nullptr;  // No change report during the conversion
+  lazy_inserter (*iter, source_container, index);
+  iter->listbox = this;
+  addLineWidth (*iter);
+  search_index.replace (FString{}, iter->getText(), index);
+
+  if ( max_line_width > old_max_width )
+    recalculateHorizontalBar();
 
   if ( hbar->isShown() )
     hbar->redraw();
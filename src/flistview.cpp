@@ -24,6 +24,8 @@
   #include <strings.h>  // need for strcasecmp
 #endif
 
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <unordered_map>
@@ -43,6 +45,18 @@
 namespace finalcut
 {
 
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline void combineLineKey (uInt64& key, uInt64 value)
+{
+  // FNV-1a style mixing of a value into a cache key
+  key = (key ^ value) * 0x100000001b3;
+}
+
+}  // namespace internal
+
 // Function prototypes
 uInt64 firstNumberFromString (const FString&);
 bool sortAscendingByName (const FObject*, const FObject*);
@@ -169,6 +183,9 @@ bool sortDescendingByNumber (const FObject* lhs, const FObject* rhs)
 // class FListViewItem
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FListViewItem> FListViewItem::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FListViewItem::FListViewItem (const FListViewItem& item)
@@ -181,13 +198,13 @@ FListViewItem::FListViewItem (const FListViewItem& item)
   if ( ! parent )
     return;
 
-  if ( parent->isInstanceOf("FListView") )
+  if ( auto listview = parent->cast<FListView>() )
   {
-    static_cast<FListView*>(parent)->insert (this);
+    listview->insert (this);
   }
-  else if ( parent->isInstanceOf("FListViewItem") )
+  else if ( auto parent_item = parent->cast<FListViewItem>() )
   {
-    static_cast<FListViewItem*>(parent)->insert (this);
+    parent_item->insert (this);
   }
 }
 
@@ -208,13 +225,13 @@ FListViewItem::~FListViewItem()  // destructor
   if ( ! parent )
     return;
 
-  if ( parent->isInstanceOf("FListView") )
+  if ( auto listview = parent->cast<FListView>() )
   {
-    static_cast<FListView*>(parent)->remove (this);
+    listview->remove (this);
   }
-  else if ( parent->isInstanceOf("FListViewItem") )
+  else if ( auto parent_item = parent->cast<FListViewItem>() )
   {
-    static_cast<FListViewItem*>(parent)->remove (this);
+    parent_item->remove (this);
   }
 }
 
@@ -248,7 +265,7 @@ uInt FListViewItem::getDepth() const
 {
   const auto& parent = getParent();
 
-  if ( parent && parent->isInstanceOf("FListViewItem") )
+  if ( parent && parent->isInstanceOf<FListViewItem>() )
   {
     const auto& parent_item = static_cast<FListViewItem*>(parent);
     return parent_item->getDepth() + 1;
@@ -269,7 +286,7 @@ void FListViewItem::setText (int column, const FString& text)
   const auto index = std::size_t(column - 1);
   auto parent = getParent();
 
-  if ( parent && parent->isInstanceOf("FListView") )
+  if ( parent && parent->isInstanceOf<FListView>() )
   {
     auto listview = static_cast<FListView*>(parent);
 
@@ -282,7 +299,10 @@ void FListViewItem::setText (int column, const FString& text)
     }
   }
 
+  const FString old_text{column_list[index]};
   column_list[index] = text;
+  line_cache_id = newLineCacheId();
+  updateSearchIndex (column, old_text);
 }
 
 //----------------------------------------------------------------------
@@ -292,7 +312,13 @@ FObject::iterator FListViewItem::insert (FListViewItem* child)
   if ( ! child )
     return FListView::getNullIterator();
 
-  return appendItem(child);
+  const auto child_iter = appendItem(child);
+  const auto listview = getListView();
+
+  if ( listview )
+    listview->insertSearchItem (getChildren(), child_iter);
+
+  return child_iter;
 }
 
 //----------------------------------------------------------------------
@@ -304,17 +330,15 @@ FObject::iterator FListViewItem::insert ( FListViewItem* child
 
   if ( *parent_iter )
   {
-    if ( (*parent_iter)->isInstanceOf("FListView") )
+    if ( auto parent = (*parent_iter)->cast<FListView>() )
     {
       // Add FListViewItem to a FListView parent
-      auto parent = static_cast<FListView*>(*parent_iter);
       return parent->insert (child);
     }
-    else if ( (*parent_iter)->isInstanceOf("FListViewItem") )
+    else if ( auto parent_item = (*parent_iter)->cast<FListViewItem>() )
     {
       // Add FListViewItem to a FListViewItem parent
-      auto parent = static_cast<FListViewItem*>(*parent_iter);
-      return parent->insert (child);
+      return parent_item->insert (child);
     }
   }
 
@@ -330,7 +354,7 @@ void FListViewItem::remove (FListViewItem* item) const
   auto parent = item->getParent();
 
   // Search for a FListView parent in my object tree
-  while ( parent && ! parent->isInstanceOf("FListView") )
+  while ( parent && ! parent->isInstanceOf<FListView>() )
   {
     parent = parent->getParent();
   }
@@ -338,9 +362,8 @@ void FListViewItem::remove (FListViewItem* item) const
   if ( parent == nullptr )
     return;
 
-  if ( parent->isInstanceOf("FListView") )
+  if ( auto listview = parent->cast<FListView>() )
   {
-    auto listview = static_cast<FListView*>(parent);
     listview->remove(item);
   }
   else
@@ -444,6 +467,38 @@ std::size_t FListViewItem::getVisibleLines()
   return visible_lines;
 }
 
+//----------------------------------------------------------------------
+FListView* FListViewItem::getListView() const
+{
+  auto parent = getParent();
+
+  // Search for a FListView parent in my object tree
+  while ( parent && ! parent->isInstanceOf<FListView>() )
+    parent = parent->getParent();
+
+  return static_cast<FListView*>(parent);
+}
+
+//----------------------------------------------------------------------
+void FListViewItem::updateSearchIndex ( int column
+                                      , const FString& old_text ) const
+{
+  const auto listview = getListView();
+
+  if ( listview )
+    listview->replaceSearchItem (this, column, old_text);
+}
+
+//----------------------------------------------------------------------
+uInt64 FListViewItem::newLineCacheId()
+{
+  // Returns a new identifier for the cached row of an item.
+  // A new identifier invalidates the row in the list view.
+
+  static uInt64 line_cache_id{0};
+  return ++line_cache_id;
+}
+
 //----------------------------------------------------------------------
 void FListViewItem::setCheckable (bool enable)
 {
@@ -464,7 +519,7 @@ void FListViewItem::resetVisibleLineCounter()
   visible_lines = 0;
   auto parent = getParent();
 
-  if ( parent && parent->isInstanceOf("FListViewItem") )
+  if ( parent && parent->isInstanceOf<FListViewItem>() )
   {
     auto parent_item = static_cast<FListViewItem*>(parent);
     return parent_item->resetVisibleLineCounter();
@@ -667,6 +722,9 @@ void FListViewIterator::parentElement()
 // class FListView
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FListView> FListView::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FListView::FListView (FWidget* parent)
@@ -854,21 +912,24 @@ FObject::iterator FListView::insert ( FListViewItem* item
 
   if ( parent_iter == root )
   {
-    item_iter = appendItem (item);
+    item_iter = moveToSortPosition (itemlist, appendItem(item));
+    insertSearchItem (itemlist, item_iter);
   }
   else if ( *parent_iter )
   {
-    if ( (*parent_iter)->isInstanceOf("FListView") )
+    if ( auto parent = (*parent_iter)->cast<FListView>() )
     {
       // Add FListViewItem to a FListView parent
-      auto parent = static_cast<FListView*>(*parent_iter);
-      item_iter = parent->appendItem (item);
+      item_iter = parent->moveToSortPosition ( parent->itemlist
+                                             , parent->appendItem(item) );
+      parent->insertSearchItem (parent->itemlist, item_iter);
     }
-    else if ( (*parent_iter)->isInstanceOf("FListViewItem") )
+    else if ( auto parent_item = (*parent_iter)->cast<FListViewItem>() )
     {
       // Add FListViewItem to a FListViewItem parent
-      auto parent = static_cast<FListViewItem*>(*parent_iter);
-      item_iter = parent->appendItem (item);
+      item_iter = moveToSortPosition ( parent_item->getChildren()
+                                     , parent_item->appendItem(item) );
+      insertSearchItem (parent_item->getChildren(), item_iter);
     }
     else
       item_iter = getNullIterator();
@@ -887,6 +948,8 @@ void FListView::remove (FListViewItem* item)
     return;
 
   auto parent = item->getParent();
+  invalidateSearchIndex();
+  line_cache.erase(item);
   const auto& current_item = static_cast<FListViewItem*>(*current_iter);
   const auto& first_item = itemlist.front();
   auto end_iter = static_cast<FListViewIterator>(itemlist.end());
@@ -954,7 +1017,14 @@ void FListView::remove (FListViewItem* item)
 //----------------------------------------------------------------------
 void FListView::clear()
 {
-  itemlist.clear();
+  // Detach the item list first, so that the item destructors
+  // do not update the view for every single item
+  FObjectList items{};
+  items.swap(itemlist);
+  search_items.clear();
+  search_index.clear();
+  search_column = -1;
+  line_cache.clear();
   current_iter = getNullIterator();
   first_visible_line = getNullIterator();
   last_visible_line = getNullIterator();
@@ -964,60 +1034,72 @@ void FListView::clear()
   vbar->setMinimum(0);
   vbar->setValue(0);
   vbar->hide();
+
+  for (auto&& item : items)
+    delete item;
+
   clearList();
 }
 
 //----------------------------------------------------------------------
-void FListView::sort()
+FListViewItem* FListView::findItem (const FString& prefix, int column)
 {
-  // Sorts the list view according to the specified setting
+  // Returns the first item in tree order whose column text begins
+  // with prefix (case-insensitive), or nullptr if there is none
+
+  if ( column < 1 || itemlist.empty() )
+    return nullptr;
+
+  if ( column != search_column || ! search_index.isValid() )
+    buildSearchIndex (column);
+
+  const std::size_t pos = search_index.findPrefix(prefix);
+
+  if ( pos == FSearchIndex::NOT_FOUND )
+    return nullptr;
+
+  return search_items[pos];
+}
 
-  if ( sort_column < 1 && sort_column > int(header.size()) )
+//----------------------------------------------------------------------
+void FListView::beginUpdate()
+{
+  // Defers sorting, counting and scrollbar calculation of the
+  // following insertions until the matching endUpdate() call
+
+  update_depth++;
+}
+
+//----------------------------------------------------------------------
+void FListView::endUpdate()
+{
+  if ( update_depth == 0 )
     return;
 
-  fc::sorting_type column_sort_type = getColumnSortType(sort_column);
-  assert ( column_sort_type == fc::by_name
-        || column_sort_type == fc::by_number
-        || column_sort_type == fc::user_defined
-        || column_sort_type == fc::unknown );
+  update_depth--;
 
-  switch ( column_sort_type )
-  {
-    case fc::unknown:
-    case fc::by_name:
-      if ( sort_order == fc::ascending )
-      {
-        sort (sortAscendingByName);
-      }
-      else if ( sort_order == fc::descending )
-      {
-        sort (sortDescendingByName);
-      }
-      break;
+  if ( isUpdating() )
+    return;
 
-    case fc::by_number:
-      if ( sort_order == fc::ascending )
-      {
-        sort (sortAscendingByNumber);
-      }
-      else if ( sort_order == fc::descending )
-      {
-        sort (sortDescendingByNumber);
-      }
-      break;
+  // One pass for all items inserted since beginUpdate()
+  sort();
+  const std::size_t element_count = getCount();
+  recalculateVerticalBar (element_count);
+}
 
-    case fc::user_defined:
-      if ( sort_order == fc::ascending && user_defined_ascending )
-      {
-        sort (user_defined_ascending);
-      }
-      else if ( sort_order == fc::descending && user_defined_descending )
-      {
-        sort (user_defined_descending);
-      }
-      break;
-  }
+//----------------------------------------------------------------------
+void FListView::sort()
+{
+  // Sorts the list view according to the specified setting
+
+  invalidateSearchIndex();  // The tree order changes
+  const auto cmp = getSortCompare();
+
+  if ( cmp )
+    sort (cmp);
 
+  sorted_by = cmp;
+  sorted_column = sort_column;
   current_iter = itemlist.begin();
   first_visible_line = itemlist.begin();
 }
@@ -1469,6 +1551,49 @@ void FListView::setNullIterator (const iterator& null_iter)
   getNullIterator() = null_iter;
 }
 
+//----------------------------------------------------------------------
+FListView::CompareFunction FListView::getSortCompare() const
+{
+  // Returns the compare function of the current sort setting
+  // or nullptr if the list is not sorted
+
+  if ( sort_column < 1 || sort_column > int(header.size()) )
+    return nullptr;
+
+  const fc::sorting_type column_sort_type = getColumnSortType(sort_column);
+  assert ( column_sort_type == fc::by_name
+        || column_sort_type == fc::by_number
+        || column_sort_type == fc::user_defined
+        || column_sort_type == fc::unknown );
+
+  switch ( column_sort_type )
+  {
+    case fc::unknown:
+    case fc::by_name:
+      if ( sort_order == fc::ascending )
+        return sortAscendingByName;
+      else if ( sort_order == fc::descending )
+        return sortDescendingByName;
+      break;
+
+    case fc::by_number:
+      if ( sort_order == fc::ascending )
+        return sortAscendingByNumber;
+      else if ( sort_order == fc::descending )
+        return sortDescendingByNumber;
+      break;
+
+    case fc::user_defined:
+      if ( sort_order == fc::ascending )
+        return user_defined_ascending;
+      else if ( sort_order == fc::descending )
+        return user_defined_descending;
+      break;
+  }
+
+  return nullptr;
+}
+
 //----------------------------------------------------------------------
 void FListView::init()
 {
@@ -1577,8 +1702,8 @@ FObject::iterator FListView::getListEnd (const FListViewItem* item)
 
   if ( this == parent )
     return itemlist.end();
-  else if ( parent->isInstanceOf("FListViewItem") )
-    return static_cast<FListViewItem*>(parent)->end();
+  else if ( auto parent_item = parent->cast<FListViewItem>() )
+    return parent_item->end();
   else
     return getNullIterator();
 }
@@ -1693,6 +1818,8 @@ void FListView::drawList()
   const auto& itemlist_end = itemlist.end();
   auto path_end = itemlist_end;
   auto iter = first_visible_line;
+  updateLineLayoutKey();
+  line_cache_pass++;
 
   while ( iter != path_end && iter != itemlist_end && y < page_height )
   {
@@ -1722,6 +1849,15 @@ void FListView::drawList()
     ++iter;
   }
 
+  // Releases the cached rows of items that are no longer visible
+  for (auto entry = line_cache.begin(); entry != line_cache.end(); )
+  {
+    if ( entry->second.pass == line_cache_pass )
+      ++entry;
+    else
+      entry = line_cache.erase(entry);
+  }
+
   // Reset color
   setColor();
 
@@ -1738,14 +1874,39 @@ void FListView::drawList()
 }
 
 //----------------------------------------------------------------------
-void FListView::drawListLine ( const FListViewItem* item
+void FListView::drawListLine ( FListViewItem* item
                              , bool is_focus
                              , bool is_current )
 {
   // Set line color and attributes
   setLineAttributes (is_current, is_focus);
 
-  // Print the entry
+  // The cached row is reused as long as the item text, the column
+  // layout and the item state have not changed
+  auto& cache = line_cache[item];
+  const uInt64 key = getLineCacheKey(item);
+  cache.pass = line_cache_pass;
+
+  if ( cache.line.isEmpty()
+    || cache.item_id != item->line_cache_id
+    || cache.key != key )
+  {
+    buildListLine (item, cache.line);
+    cache.item_id = item->line_cache_id;
+    cache.key = key;
+  }
+  else
+    changeLineColors (cache.line);
+
+  print (cache.line);
+}
+
+//----------------------------------------------------------------------
+void FListView::buildListLine ( const FListViewItem* item
+                              , FTermBuffer& line_buffer )
+{
+  // Renders the visible part of an item row into line_buffer
+
   const std::size_t indent = item->getDepth() << 1;  // indent = 2 * depth
   FString line{getLinePrefix (item, indent)};
 
@@ -1803,24 +1964,13 @@ void FListView::drawListLine ( const FListViewItem* item
 
   const std::size_t width = getWidth() - nf_offset - 2;
   line = getColumnSubString ( line, std::size_t(xoffset) + 1, width );
-  const std::size_t len = line.getLength();
-  std::size_t char_width{0};
+  const std::size_t char_width = getColumnWidth(line);
 
-  for (std::size_t i{0}; i < len; i++)
-  {
-    try
-    {
-      char_width += getColumnWidth(line[i]);
-      print() << line[i];
-    }
-    catch (const std::out_of_range&)
-    {
-      return;
-    }
-  }
+  if ( char_width < width )
+    line += FString{width - char_width, L' '};
 
-  for (std::size_t i = char_width; i < width; i++)
-    print (' ');
+  line_buffer.clear();
+  line_buffer.write(line);
 }
 
 //----------------------------------------------------------------------
@@ -1881,6 +2031,62 @@ inline void FListView::setLineAttributes ( bool is_current
   }
 }
 
+//----------------------------------------------------------------------
+void FListView::updateLineLayoutKey()
+{
+  // Everything outside the items that changes the look of a row
+
+  uInt64 key{0xcbf29ce484222325};
+  internal::combineLineKey (key, uInt64(tree_view));
+  internal::combineLineKey (key, uInt64(nf_offset));
+  internal::combineLineKey (key, uInt64(xoffset));
+  internal::combineLineKey (key, uInt64(getWidth()));
+
+  for (auto&& h : header)
+  {
+    internal::combineLineKey (key, uInt64(h.width));
+    internal::combineLineKey (key, uInt64(h.alignment));
+  }
+
+  line_layout_key = key;
+}
+
+//----------------------------------------------------------------------
+inline uInt64 FListView::getLineCacheKey (const FListViewItem* item) const
+{
+  uInt64 key{line_layout_key};
+  const uInt64 state = uInt64(item->isExpandable())
+                     | uInt64(item->isExpand()) << 1
+                     | uInt64(item->isCheckable()) << 2
+                     | uInt64(item->isChecked()) << 3
+                     | uInt64(item->getDepth()) << 4;
+  internal::combineLineKey (key, state);
+  return key;
+}
+
+//----------------------------------------------------------------------
+inline void FListView::changeLineColors (FTermBuffer& line)
+{
+  // Applies the current colors and attributes to a cached row
+
+  const auto& attr = FVTerm::getAttribute();
+  const auto& first = line.front();
+
+  if ( first.fg_color == attr.fg_color
+    && first.bg_color == attr.bg_color
+    && first.attr.byte[0] == attr.attr.byte[0]
+    && first.attr.byte[1] == attr.attr.byte[1] )
+    return;
+
+  for (auto&& fchar : line)
+  {
+    fchar.fg_color = attr.fg_color;
+    fchar.bg_color = attr.bg_color;
+    fchar.attr.byte[0] = attr.attr.byte[0];
+    fchar.attr.byte[1] = attr.attr.byte[1];
+  }
+}
+
 //----------------------------------------------------------------------
 inline FString FListView::getCheckBox (const FListViewItem* item) const
 {
@@ -2205,8 +2411,19 @@ inline void FListView::afterInsertion()
     first_visible_line = itemlist.begin();
   }
 
+  if ( isUpdating() )
+    return;  // Deferred until endUpdate()
+
   // Sort list by a column (only if activated)
-  sort();
+  if ( isSortOutdated() )
+  {
+    sort();
+  }
+  else
+  {
+    current_iter = itemlist.begin();
+    first_visible_line = itemlist.begin();
+  }
 
   const std::size_t element_count = getCount();
   recalculateVerticalBar (element_count);
@@ -2449,6 +2666,103 @@ FObject::iterator FListView::appendItem (FListViewItem* item)
   return --itemlist.end();
 }
 
+//----------------------------------------------------------------------
+FObject::iterator FListView::moveToSortPosition ( FObjectList& list
+                                                , iterator item_iter )
+{
+  // Moves a just appended item with a binary search to its sorted
+  // position. Equal items keep their insertion order like with the
+  // stable list sort. An outdated sort order is restored completely
+  // in afterInsertion().
+
+  if ( item_iter == getNullIterator() || isUpdating() || isSortOutdated() )
+    return item_iter;
+
+  const auto cmp = sorted_by;
+
+  if ( ! cmp )
+    return item_iter;
+
+  auto item = static_cast<FListViewItem*>(*item_iter);
+  item->sort(cmp);  // Sort the sublevels of the new item
+
+  if ( item_iter == list.begin() || ! cmp(item, *std::prev(item_iter)) )
+    return item_iter;  // Already in order (e.g. sorted input)
+
+  const auto pos = std::upper_bound (list.begin(), item_iter, item, cmp);
+  list.splice (pos, list, item_iter);  // The iterator stays valid
+  return item_iter;
+}
+
+//----------------------------------------------------------------------
+void FListView::buildSearchIndex (int column)
+{
+  search_items.clear();
+  search_index.clear();
+  search_column = column;
+
+  for (auto&& item : itemlist)
+    addSearchItem (static_cast<FListViewItem*>(item));
+}
+
+//----------------------------------------------------------------------
+void FListView::invalidateSearchIndex()
+{
+  // The index is rebuilt once at the next search
+
+  search_items.clear();
+  search_index.invalidate();
+}
+
+//----------------------------------------------------------------------
+void FListView::insertSearchItem ( const FObjectList& list
+                                 , const_iterator item_iter )
+{
+  // Only an item at the end of the tree order is added directly.
+  // Any other position moves the tree positions of the following
+  // items and invalidates the index.
+
+  if ( search_column < 1 || ! search_index.isValid() )
+    return;
+
+  if ( ! isUpdating() && ! isSortOutdated()
+    && &list == &itemlist && std::next(item_iter) == itemlist.end() )
+    addSearchItem (static_cast<FListViewItem*>(*item_iter));
+  else
+    invalidateSearchIndex();
+}
+
+//----------------------------------------------------------------------
+void FListView::replaceSearchItem ( const FListViewItem* item
+                                  , int column
+                                  , const FString& old_text )
+{
+  // Updates the search text of the item after a text change
+
+  if ( column != search_column || ! search_index.isValid() )
+    return;
+
+  const std::size_t pos = item->search_position;
+
+  if ( pos >= search_items.size() || search_items[pos] != item )
+    return;
+
+  search_index.replace (old_text, item->getText(column), pos);
+}
+
+//----------------------------------------------------------------------
+void FListView::addSearchItem (FListViewItem* item)
+{
+  // Adds the item and its subitems in tree order
+
+  item->search_position = search_items.size();
+  search_index.add (item->getText(search_column), item->search_position);
+  search_items.push_back(item);
+
+  for (auto&& child : item->getChildren())
+    addSearchItem (static_cast<FListViewItem*>(child));
+}
+
 //----------------------------------------------------------------------
 void FListView::processClick() const
 {
@@ -2513,7 +2827,7 @@ inline void FListView::collapseAndScrollLeft()
       // Jump to parent element
       const auto& parent = item->getParent();
 
-      if ( parent->isInstanceOf("FListViewItem") )
+      if ( parent->isInstanceOf<FListViewItem>() )
       {
         current_iter.parentElement();
 
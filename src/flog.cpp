@@ -46,8 +46,8 @@ FLog::~FLog()  // destructor
 FLog& FLog::operator << (LogLevel l)
 {
   using std::placeholders::_1;
+  std::lock_guard<std::recursive_mutex> lock_guard(stream_mutex);
   sync();
-  std::lock_guard<std::mutex> lock_guard(mut);
 
   switch ( l )
   {
@@ -76,13 +76,23 @@ FLog& FLog::operator << (LogLevel l)
 //----------------------------------------------------------------------
 int FLog::sync()
 {
-  if ( ! str().empty() )
+  std::string message{};
+  FLogPrint log_print{};
+
   {
-    std::lock_guard<std::mutex> lock_guard(mut);
-    current_log (str());
+    // The stream mutex is already held when called via operator <<
+    std::lock_guard<std::recursive_mutex> lock_guard(stream_mutex);
+
+    if ( str().empty() )
+      return 0;
+
+    message = str();
     str("");
+    log_print = current_log;
   }
 
+  // The output methods lock the output mutex themselves
+  log_print (message);
   return 0;
 }
 
@@ -21,6 +21,7 @@
 ***********************************************************************/
 
 #include <array>
+#include <cstring>
 #include <string>
 
 #include "final/flogger.h"
@@ -39,43 +40,37 @@ FLogger::FLogger()
 
 //----------------------------------------------------------------------
 FLogger::~FLogger()  // destructor
-{ }
+{
+  // Write out the remaining stream buffer content
+  // while the virtual output methods are still available
+  sync();
+}
 
 
-// private methods of FLogger
+// protected methods of FLogger
 //----------------------------------------------------------------------
-void FLogger::newlineReplace ( std::string& str
-                             , const std::string& replace_str ) const
+const std::string& FLogger::getTimeString (std::time_t t)
 {
-  std::size_t pos{0};
-  std::size_t npos{std::string::npos};
+  // The formatted time string is only recalculated
+  // when the second changes
 
-  while ( (pos = str.find("\n", pos)) != npos
-       && pos + 1 < str.length() )
-  {
-    str.replace(pos, 1, replace_str);
-    pos += replace_str.length();
-  }
-}
+  if ( t == time_cache )
+    return time_string;
 
-//----------------------------------------------------------------------
-std::string FLogger::getTimeString() const
-{
   std::array<char, 100> str;
-  const auto& now = std::chrono::system_clock::now();
-  const auto& t = std::chrono::system_clock::to_time_t(now);
+
   // Print RFC 2822 date
   struct tm time{};
   localtime_r (&t, &time);
   std::strftime (str.data(), str.size(), "%a, %d %b %Y %T %z", &time);
-  return std::string(str.data());
+  time_string = str.data();
+  time_cache = t;
+  return time_string;
 }
 
 //----------------------------------------------------------------------
-std::string FLogger::getEOL()
+const char* FLogger::getEOL()
 {
-  std::lock_guard<std::mutex> lock_guard(getMutex());
-
   if ( getEnding() == FLog::LF )
     return "\n";
   else if ( getEnding() == FLog::CR )
@@ -87,45 +82,80 @@ std::string FLogger::getEOL()
 }
 
 //----------------------------------------------------------------------
-void FLogger::printLogLine (const std::string& msg)
+const char* FLogger::getLevelString (LogLevel level)
 {
-  const std::string& log_level = [this] ()
+  switch ( level )
   {
-    std::lock_guard<std::mutex> lock_guard(getMutex());
+    case Info:
+      return "INFO";
 
-    switch ( getLevel() )
-    {
-      case Info:
-        return "INFO";
+    case Warn:
+      return "WARNING";
 
-      case Warn:
-        return "WARNING";
+    case Error:
+      return "ERROR";
 
-      case Error:
-        return "ERROR";
+    case Debug:
+      return "DEBUG";
+  }
 
-      case Debug:
-        return "DEBUG";
-    }
+  return "";
+}
 
-    return "";
-  }();
+//----------------------------------------------------------------------
+void FLogger::printLogLine (const std::string& msg)
+{
+  // The caller must hold the logger mutex
+  const auto& now = std::chrono::system_clock::now();
+  std::string prefix{};
 
-  const std::string prefix = [this, &log_level] ()
+  if ( timestamp )
   {
-    if ( timestamp )
-      return getTimeString() + " [" + log_level + "] ";
-    else
-      return "[" + log_level + "] ";
-  }();
-
-  std::string message{msg};
-  const std::string& eol = getEOL();
-  const std::string replace_str = eol + prefix;
-  newlineReplace (message, replace_str);
-  output << prefix << message << eol;
+    prefix += getTimeString(std::chrono::system_clock::to_time_t(now));
+    prefix += ' ';
+  }
+
+  prefix += '[';
+  prefix += getLevelString(getLevel());
+  prefix += "] ";
+  printLogLine (prefix, msg);
 }
 
-}  // namespace finalcut
+//----------------------------------------------------------------------
+void FLogger::printLogLine ( const std::string& prefix
+                           , const std::string& msg )
+{
+  // Assembles the complete log line in a single pass and writes it
+  // with one stream operation. Every inner newline character is
+  // replaced by the line ending and a repeated prefix.
 
+  const char* eol = getEOL();
+  const std::size_t eol_length = std::strlen(eol);
+  const std::size_t length = msg.length();
+  std::size_t pos{0};
+  line_buffer.clear();
+  line_buffer.reserve (prefix.length() + length + eol_length);
+  line_buffer += prefix;
 
+  while ( pos < length )
+  {
+    const std::size_t newline = msg.find('\n', pos);
+
+    // A newline at the end of the message is kept
+    if ( newline == std::string::npos || newline + 1 >= length )
+    {
+      line_buffer.append (msg, pos, std::string::npos);
+      break;
+    }
+
+    line_buffer.append (msg, pos, newline - pos);
+    line_buffer.append (eol, eol_length);
+    line_buffer += prefix;
+    pos = newline + 1;
+  }
+
+  line_buffer.append (eol, eol_length);
+  output.write (line_buffer.data(), std::streamsize(line_buffer.length()));
+}
+
+}  // namespace finalcut
@@ -32,6 +32,7 @@
 #include "final/fmenu.h"
 #include "final/fmenubar.h"
 #include "final/fmenuitem.h"
+#include "final/fradiomenuitem.h"
 #include "final/fstatusbar.h"
 #include "final/fwidgetcolors.h"
 
@@ -42,6 +43,9 @@ namespace finalcut
 // class FMenu
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FMenu> FMenu::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FMenu::FMenu(FWidget* parent)
@@ -360,19 +364,19 @@ bool FMenu::isDialog (const FWidget* w) const
 //----------------------------------------------------------------------
 bool FMenu::isMenuBar (const FWidget* w) const
 {
-  return w->isInstanceOf("FMenuBar");
+  return w->isInstanceOf<FMenuBar>();
 }
 
 //----------------------------------------------------------------------
 bool FMenu::isMenu (const FWidget* w) const
 {
-  return w->isInstanceOf("FMenu");
+  return w->isInstanceOf<FMenu>();
 }
 
 //----------------------------------------------------------------------
 bool FMenu::isRadioMenuItem (const FWidget* w) const
 {
-  return w->isInstanceOf("FRadioMenuItem");
+  return w->isInstanceOf<FRadioMenuItem>();
 }
 
 //----------------------------------------------------------------------
@@ -39,6 +39,9 @@ namespace finalcut
 // class FMenuBar
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FMenuBar> FMenuBar::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FMenuBar::FMenuBar(FWidget* parent)
@@ -25,6 +25,7 @@
 
 #include "final/fapplication.h"
 #include "final/fdialog.h"
+#include "final/fdialoglistmenu.h"
 #include "final/fevent.h"
 #include "final/flog.h"
 #include "final/fmenu.h"
@@ -40,6 +41,9 @@ namespace finalcut
 // class FMenuItem
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FMenuItem> FMenuItem::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FMenuItem::FMenuItem (FWidget* parent)
@@ -467,7 +471,7 @@ bool FMenuItem::isDialog (const FWidget* w) const
 //----------------------------------------------------------------------
 bool FMenuItem::isMenuBar (const FWidget* w) const
 {
-  return ( w ) ? w->isInstanceOf("FMenuBar") : false;
+  return ( w ) ? w->isInstanceOf<FMenuBar>() : false;
 }
 
 //----------------------------------------------------------------------
@@ -476,8 +480,8 @@ bool FMenuItem::isMenu (const FWidget* w) const
   if ( ! w )
     return false;
 
-  const bool m1 = w->isInstanceOf("FMenu");
-  const bool m2 = w->isInstanceOf("FDialogListMenu");
+  const bool m1 = w->isInstanceOf<FMenu>();
+  const bool m2 = w->isInstanceOf<FDialogListMenu>();
   return bool( m1 || m2 );
 }
 
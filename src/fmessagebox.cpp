@@ -47,6 +47,9 @@ constexpr std::array<const char* const, 8> button_text =
 // class FMessageBox
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FMessageBox> FMessageBox::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FMessageBox::FMessageBox (FWidget* parent)
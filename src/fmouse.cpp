@@ -1550,16 +1550,25 @@ void FMouseControl::setRawData ( FMouse::mouse_type mt
 //----------------------------------------------------------------------
 void FMouseControl::processQueuedInput()
 {
-  while ( ! fmousedata_queue.empty() )
+  // The queue keeps its capacity, so that the mouse data
+  // of an event does not need a heap allocation
+
+  while ( hasDataInQueue() )
   {
     if ( FApplication::isQuit() )
       return;
 
-    FMouseDataPtr md(std::move(fmousedata_queue.front()));
-    fmousedata_queue.pop();
+    // Copy the data, a nested event loop can grow the queue
+    const FMouseData md(std::move(fmousedata_queue[queue_pos]));
+    queue_pos++;
+
+    if ( ! hasDataInQueue() )
+    {
+      fmousedata_queue.clear();
+      queue_pos = 0;
+    }
 
-    if ( md.get() )
-      event_cmd.execute(*md);
+    event_cmd.execute(md);
 
     if ( FApplication::isQuit() )
       return;
@@ -1577,7 +1586,7 @@ void FMouseControl::processEvent (struct timeval* time)
   {
     mouse_object->processEvent(time);
     auto& md = static_cast<FMouseData&>(*mouse_object);
-    fmousedata_queue.emplace(new FMouseData(std::move(md)));
+    fmousedata_queue.emplace_back(std::move(md));
   }
 }
 
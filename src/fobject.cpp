@@ -25,12 +25,14 @@
 #include "final/emptyfstring.h"
 #include "final/fevent.h"
 #include "final/fc.h"
+#include "final/finstrumentation.h"
 #include "final/fobject.h"
 
 namespace finalcut
 {
 
 // static class attributes
+const FTypeTag<FObject> FObject::type_tag{};
 bool FObject::timer_modify_lock;
 FObject::FTimerList* FObject::timer_list{nullptr};
 const FString* fc::emptyFString::empty_string{nullptr};
@@ -83,13 +85,7 @@ FObject::~FObject()  // destructor
     fc::emptyFString::clear();
 
   // Delete children objects
-  if ( hasChildren() )
-  {
-    auto delete_list = children_list;
-
-    for (auto&& obj : delete_list)
-      delete obj;
-  }
+  deleteChildren();
 
   if ( parent_obj )
     parent_obj->delChild(this);
@@ -109,8 +105,19 @@ FObject* FObject::getChild (int index) const
   if ( index <= 0 || index > int(numOfChildren()) )
     return nullptr;
 
-  auto iter = begin();
-  std::advance (iter, index - 1);
+  // Walk from the nearer end of the list
+  const auto pos = std::size_t(index - 1);
+  const std::size_t size = numOfChildren();
+
+  if ( pos < size / 2 )
+  {
+    auto iter = begin();
+    std::advance (iter, pos);
+    return *iter;
+  }
+
+  auto iter = end();
+  std::advance (iter, -int(size - pos));
   return *iter;
 }
 
@@ -150,28 +157,25 @@ void FObject::addChild (FObject* obj)
   if ( max_children != UNLIMITED && max_children <= numOfChildren() )
     throw std::length_error ("max. child objects reached");
 
-  if ( obj->parent_obj )
+  if ( obj->has_parent )
     obj->parent_obj->delChild(obj);
 
-  obj->parent_obj = this;
-  obj->has_parent = true;
-  children_list.push_back(obj);
+  linkChild (obj);
 }
 
 //----------------------------------------------------------------------
 void FObject::delChild (FObject* obj)
 {
-  // Deletes the child object obj from children list
+  // Deletes the child object obj from children list.
+  // The stored list position makes this a constant-time operation.
 
-  if ( ! obj )
+  if ( ! obj || ! obj->has_parent || obj->parent_obj != this )
     return;
 
-  if ( hasChildren() )
-  {
-    obj->parent_obj = nullptr;
-    obj->has_parent = false;
-    children_list.remove(obj);
-  }
+  children_list.erase(obj->child_iter);
+  obj->child_iter = iterator{};
+  obj->parent_obj = nullptr;
+  obj->has_parent = false;
 }
 
 //----------------------------------------------------------------------
@@ -183,9 +187,39 @@ void FObject::setParent (FObject* parent)
     return;
 
   removeParent();
-  parent_obj = parent;
-  has_parent = true;
-  parent->children_list.push_back(this);
+  parent->linkChild (this);
+}
+
+//----------------------------------------------------------------------
+void FObject::moveChildren (FObject* new_parent)
+{
+  // Transfers all child objects to new_parent in linear time
+
+  if ( ! new_parent || new_parent == this || isChild(new_parent)
+    || ! hasChildren() )
+    return;
+
+  if ( new_parent->max_children != UNLIMITED
+    && new_parent->max_children - new_parent->numOfChildren()
+       < numOfChildren() )
+    throw std::length_error ("max. child objects reached");
+
+  for (auto&& obj : children_list)
+    obj->parent_obj = new_parent;
+
+  // The list nodes are relinked, so all child iterators remain valid
+  new_parent->children_list.splice ( new_parent->children_list.end()
+                                   , children_list );
+}
+
+//----------------------------------------------------------------------
+void FObject::deleteChildren()
+{
+  // Deletes all child objects. Every child unlinks itself from
+  // the front of the list, so this takes linear time.
+
+  while ( hasChildren() )
+    delete children_list.front();
 }
 
 //----------------------------------------------------------------------
@@ -426,6 +460,7 @@ uInt FObject::processTimerEvent()
     if ( timer.interval.tv_usec > 0 || timer.interval.tv_sec > 0 )
       activated++;
 
+    FInstrumentation::ScopedTimer dispatch(FInstrumentation::TimerDispatch);
     FTimerEvent t_ev(fc::Timer_Event, timer.id);
     performTimerAction (timer.object, &t_ev);
   }
@@ -433,6 +468,16 @@ uInt FObject::processTimerEvent()
   return activated;
 }
 
+
+// private methods of FObject
+//----------------------------------------------------------------------
+void FObject::linkChild (FObject* obj)
+{
+  obj->parent_obj = this;
+  obj->has_parent = true;
+  obj->child_iter = children_list.insert(children_list.end(), obj);
+}
+
 //----------------------------------------------------------------------
 void FObject::performTimerAction (FObject*, FEvent*)
 {
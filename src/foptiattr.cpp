@@ -21,9 +21,11 @@
 ***********************************************************************/
 
 #include <array>
+#include <cstdio>
 #include <cstring>
 
 #include "final/fc.h"
+#include "final/finstrumentation.h"
 #include "final/foptiattr.h"
 #include "final/fstartoptions.h"
 #include "final/ftermcap.h"
@@ -47,6 +49,58 @@ FOptiAttr::FOptiAttr()
   reset_byte_mask.attr.bit.printed = true;
 }
 
+//----------------------------------------------------------------------
+FOptiAttr::FOptiAttr (const FOptiAttr& opti_attr)  // copy constructor
+  : F_enter_bold_mode{opti_attr.F_enter_bold_mode}
+  , F_exit_bold_mode{opti_attr.F_exit_bold_mode}
+  , F_enter_dim_mode{opti_attr.F_enter_dim_mode}
+  , F_exit_dim_mode{opti_attr.F_exit_dim_mode}
+  , F_enter_italics_mode{opti_attr.F_enter_italics_mode}
+  , F_exit_italics_mode{opti_attr.F_exit_italics_mode}
+  , F_enter_underline_mode{opti_attr.F_enter_underline_mode}
+  , F_exit_underline_mode{opti_attr.F_exit_underline_mode}
+  , F_enter_blink_mode{opti_attr.F_enter_blink_mode}
+  , F_exit_blink_mode{opti_attr.F_exit_blink_mode}
+  , F_enter_reverse_mode{opti_attr.F_enter_reverse_mode}
+  , F_exit_reverse_mode{opti_attr.F_exit_reverse_mode}
+  , F_enter_standout_mode{opti_attr.F_enter_standout_mode}
+  , F_exit_standout_mode{opti_attr.F_exit_standout_mode}
+  , F_enter_secure_mode{opti_attr.F_enter_secure_mode}
+  , F_exit_secure_mode{opti_attr.F_exit_secure_mode}
+  , F_enter_protected_mode{opti_attr.F_enter_protected_mode}
+  , F_exit_protected_mode{opti_attr.F_exit_protected_mode}
+  , F_enter_crossed_out_mode{opti_attr.F_enter_crossed_out_mode}
+  , F_exit_crossed_out_mode{opti_attr.F_exit_crossed_out_mode}
+  , F_enter_dbl_underline_mode{opti_attr.F_enter_dbl_underline_mode}
+  , F_exit_dbl_underline_mode{opti_attr.F_exit_dbl_underline_mode}
+  , F_set_attributes{opti_attr.F_set_attributes}
+  , F_exit_attribute_mode{opti_attr.F_exit_attribute_mode}
+  , F_enter_alt_charset_mode{opti_attr.F_enter_alt_charset_mode}
+  , F_exit_alt_charset_mode{opti_attr.F_exit_alt_charset_mode}
+  , F_enter_pc_charset_mode{opti_attr.F_enter_pc_charset_mode}
+  , F_exit_pc_charset_mode{opti_attr.F_exit_pc_charset_mode}
+  , F_set_a_foreground{opti_attr.F_set_a_foreground}
+  , F_set_a_background{opti_attr.F_set_a_background}
+  , F_set_foreground{opti_attr.F_set_foreground}
+  , F_set_background{opti_attr.F_set_background}
+  , F_set_color_pair{opti_attr.F_set_color_pair}
+  , F_orig_pair{opti_attr.F_orig_pair}
+  , F_orig_colors{opti_attr.F_orig_colors}
+  , on{opti_attr.on}
+  , off{opti_attr.off}
+  , reset_byte_mask{opti_attr.reset_byte_mask}
+  , quantizer{opti_attr.quantizer}
+  , max_color{opti_attr.max_color}
+  , attr_without_color{opti_attr.attr_without_color}
+  , ansi_default_color{opti_attr.ansi_default_color}
+  , true_color{opti_attr.true_color}
+  , alt_equal_pc_charset{opti_attr.alt_equal_pc_charset}
+  , monochron{opti_attr.monochron}
+  , fake_reverse{opti_attr.fake_reverse}
+{
+  // The copy has its own SGR optimizer for its own attribute buffer
+}
+
 //----------------------------------------------------------------------
 FOptiAttr::~FOptiAttr()  // destructor
 { }
@@ -547,6 +601,7 @@ FColor FOptiAttr::vga2ansi (FColor color)
 //----------------------------------------------------------------------
 const char* FOptiAttr::changeAttribute (FChar& term, FChar& next)
 {
+  FInstrumentation::count (FInstrumentation::ChangeAttribute);
   const bool next_has_color = hasColor(next);
   fake_reverse = false;
   attr_buf[0] = '\0';
@@ -1297,10 +1352,11 @@ void FOptiAttr::change_color (FChar& term, FChar& next)
     return;
   }
 
-  if ( next.fg_color != fc::Default )
+  // RGB colors are kept in the cell and converted on output
+  if ( next.fg_color != fc::Default && ! isRGBColor(next.fg_color) )
     next.fg_color %= max_color;
 
-  if ( next.bg_color != fc::Default )
+  if ( next.bg_color != fc::Default && ! isRGBColor(next.bg_color) )
     next.bg_color %= max_color;
 
   FColor fg = next.fg_color;
@@ -1380,19 +1436,42 @@ inline void FOptiAttr::change_current_color ( const FChar& term
                    || off.attr.bit.standout
                    || term.attr.bit.reverse
                    || term.attr.bit.standout ) && fake_reverse );
+  const bool fg_changed ( term.fg_color != fg || frev );
+  const bool bg_changed ( term.bg_color != bg || frev );
+  const bool pair_only ( sp && ! (AF && AB) && ! (Sf && Sb) );
+  const bool direct_fg ( true_color && ! pair_only && isRGBColor(fg) );
+  const bool direct_bg ( true_color && ! pair_only && isRGBColor(bg) );
+
+  // Without true color support, RGB colors are
+  // downsampled to the terminal palette
+  if ( direct_fg )
+  {
+    if ( fg_changed )
+      change_rgb_color (38, fg);
+  }
+  else
+    fg = rgb2PaletteColor(fg);
+
+  if ( direct_bg )
+  {
+    if ( bg_changed )
+      change_rgb_color (48, bg);
+  }
+  else
+    bg = rgb2PaletteColor(bg);
 
   if ( AF && AB )
   {
     const auto ansi_fg = vga2ansi(fg);
     const auto ansi_bg = vga2ansi(bg);
 
-    if ( term.fg_color != fg || frev )
+    if ( fg_changed && ! direct_fg )
     {
       color_str = FTermcap::encodeParameter(AF, ansi_fg, 0, 0, 0, 0, 0, 0, 0, 0);
       append_sequence (color_str);
     }
 
-    if ( term.bg_color != bg || frev )
+    if ( bg_changed && ! direct_bg )
     {
       color_str = FTermcap::encodeParameter(AB, ansi_bg, 0, 0, 0, 0, 0, 0, 0, 0);
       append_sequence (color_str);
@@ -1400,13 +1479,13 @@ inline void FOptiAttr::change_current_color ( const FChar& term
   }
   else if ( Sf && Sb )
   {
-    if ( term.fg_color != fg || frev )
+    if ( fg_changed && ! direct_fg )
     {
       color_str = FTermcap::encodeParameter(Sf, fg, 0, 0, 0, 0, 0, 0, 0, 0);
       append_sequence (color_str);
     }
 
-    if ( term.bg_color != bg || frev )
+    if ( bg_changed && ! direct_bg )
     {
       color_str = FTermcap::encodeParameter(Sb, bg, 0, 0, 0, 0, 0, 0, 0, 0);
       append_sequence (color_str);
@@ -1421,6 +1500,17 @@ inline void FOptiAttr::change_current_color ( const FChar& term
   }
 }
 
+//----------------------------------------------------------------------
+inline void FOptiAttr::change_rgb_color (int sgr, FColor color)
+{
+  // Sets a 24-bit color with SGR 38;2 (foreground) or 48;2 (background)
+
+  std::array<char, 24> rgb_str{};
+  std::snprintf ( rgb_str.data(), rgb_str.size(), CSI "%d;2;%d;%d;%dm"
+                , sgr, getRed(color), getGreen(color), getBlue(color) );
+  append_sequence (rgb_str.data());
+}
+
 //----------------------------------------------------------------------
 inline void FOptiAttr::resetAttribute (FChar& attr) const
 {
@@ -25,6 +25,7 @@
 
 #include "final/fapplication.h"
 #include "final/fc.h"
+#include "final/finstrumentation.h"
 #include "final/foptimove.h"
 #include "final/ftermcap.h"
 
@@ -487,6 +488,7 @@ void FOptiMove::check_boundaries ( int& xold, int& yold
 //----------------------------------------------------------------------
 const char* FOptiMove::moveCursor (int xold, int yold, int xnew, int ynew)
 {
+  FInstrumentation::count (FInstrumentation::MoveCursor);
   int method{0};
   int move_time{LONG_DURATION};
 
@@ -0,0 +1,139 @@
+/***********************************************************************
+* foutputwriter.cpp - Non-blocking writer for the terminal output      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include "final/foutputwriter.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FOutputWriter
+//----------------------------------------------------------------------
+
+// static class attribute
+constexpr std::size_t FOutputWriter::COMPACT_SIZE;
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FOutputWriter::FOutputWriter (int file_descriptor)
+  : fd{file_descriptor}
+{ }
+
+
+// public methods of FOutputWriter
+//----------------------------------------------------------------------
+void FOutputWriter::clear()
+{
+  buffer.clear();
+  offset = 0;
+}
+
+
+// private methods of FOutputWriter
+//----------------------------------------------------------------------
+bool FOutputWriter::writeBuffer (bool blocking)
+{
+  // Writes the queued bytes and returns true if nothing remains
+
+  if ( ! hasPendingOutput() )
+  {
+    clear();
+    return true;
+  }
+
+  const int flags = ::fcntl(fd, F_GETFL);
+  const bool set_nonblock = ! blocking && flags != -1
+                         && (flags & O_NONBLOCK) == 0;
+
+  if ( set_nonblock )
+    ::fcntl (fd, F_SETFL, flags | O_NONBLOCK);
+
+  bool write_error{false};
+
+  while ( hasPendingOutput() )
+  {
+    const ssize_t bytes = ::write ( fd, buffer.data() + offset
+                                  , buffer.size() - offset );
+
+    if ( bytes > 0 )
+    {
+      offset += std::size_t(bytes);
+      written_bytes += uInt64(bytes);
+    }
+    else if ( bytes < 0 && errno == EINTR )
+      continue;
+    else if ( bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+    {
+      blocked_count++;
+
+      if ( ! blocking )
+        break;
+
+      // Waits until the terminal can take more output
+      struct pollfd pfd{fd, POLLOUT, 0};
+
+      if ( ::poll(&pfd, 1, -1) < 0 && errno != EINTR )
+      {
+        write_error = true;
+        break;
+      }
+    }
+    else
+    {
+      write_error = true;
+      break;
+    }
+  }
+
+  if ( set_nonblock )
+    ::fcntl (fd, F_SETFL, flags);
+
+  if ( write_error )
+  {
+    // The terminal is gone, the output can no longer be delivered
+    error_count++;
+    clear();
+    return false;
+  }
+
+  if ( ! hasPendingOutput() )
+  {
+    clear();
+    return true;
+  }
+
+  if ( offset >= COMPACT_SIZE )  // Release the already written bytes
+  {
+    buffer.erase(0, offset);
+    offset = 0;
+  }
+
+  return false;
+}
+
+}  // namespace finalcut
@@ -33,6 +33,9 @@ namespace finalcut
 // class FProgressbar
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FProgressbar> FProgressbar::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FProgressbar::FProgressbar(FWidget* parent)
@@ -59,7 +62,8 @@ void FProgressbar::setPercentage (std::size_t percentage_value)
   else
     percentage = percentage_value;
 
-  if ( isShown() )
+  // An unfocused terminal gets the new value with the next focus
+  if ( isShown() && isTerminalFocused() )
   {
     drawProgressLabel();
     drawProgressBar();
@@ -126,6 +130,18 @@ void FProgressbar::reset()
   }
 }
 
+//----------------------------------------------------------------------
+void FProgressbar::onTerminalFocusIn (FFocusEvent*)
+{
+  // Draws the progress that was made while the terminal was unfocused
+
+  if ( isShown() )
+  {
+    drawProgressLabel();
+    drawProgressBar();
+  }
+}
+
 
 // private methods of FProgressbar
 //----------------------------------------------------------------------
@@ -30,6 +30,9 @@ namespace finalcut
 // class FRadioButton
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FRadioButton> FRadioButton::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FRadioButton::FRadioButton(FWidget* parent)
@@ -33,6 +33,9 @@ namespace finalcut
 // class FRadioMenuItem
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FRadioMenuItem> FRadioMenuItem::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FRadioMenuItem::FRadioMenuItem (FWidget* parent)
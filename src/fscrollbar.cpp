@@ -34,6 +34,9 @@ namespace finalcut
 // class FScrollbar
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FScrollbar> FScrollbar::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FScrollbar::FScrollbar(FWidget* parent)
@@ -35,6 +35,9 @@ namespace finalcut
 // class FScrollView
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FScrollView> FScrollView::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FScrollView::FScrollView (FWidget* parent)
@@ -715,7 +718,7 @@ void FScrollView::init()
   const FWidget* parent = getParentWidget();
 
   assert ( parent != nullptr );
-  assert ( ! parent->isInstanceOf("FScrollView") );
+  assert ( ! parent->isInstanceOf<FScrollView>() );
 
   initScrollbar (vbar, fc::vertical, &FScrollView::cb_vbarChange);
   initScrollbar (hbar, fc::horizontal, &FScrollView::cb_hbarChange);
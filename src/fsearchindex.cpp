@@ -0,0 +1,323 @@
+/***********************************************************************
+* fsearchindex.cpp - Case-insensitive text search index                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <cwctype>
+#include <utility>
+
+#include "final/fsearchindex.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline wchar_t foldChar (wchar_t c)
+{
+  return wchar_t(std::towlower(std::wint_t(c)));
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FSearchIndex
+//----------------------------------------------------------------------
+
+// static class attribute
+constexpr std::size_t FSearchIndex::NOT_FOUND;
+
+// public methods of FSearchIndex
+//----------------------------------------------------------------------
+void FSearchIndex::clear()
+{
+  entries.clear();
+  min_tree.clear();
+  sorted_count = 0;
+  removed_count = 0;
+  valid = true;
+}
+
+//----------------------------------------------------------------------
+void FSearchIndex::invalidate()
+{
+  clear();
+  valid = false;
+}
+
+//----------------------------------------------------------------------
+void FSearchIndex::add (const FString& text, std::size_t position)
+{
+  // An invalid index is rebuilt completely by its owner
+
+  if ( ! valid )
+    return;
+
+  entries.push_back ({std::wstring{}, position, false});
+  foldCase (text, entries.back().key);
+}
+
+//----------------------------------------------------------------------
+void FSearchIndex::replace ( const FString& old_text
+                           , const FString& text
+                           , std::size_t position )
+{
+  // Replaces the text of the entry at the list position
+
+  if ( ! valid )
+    return;
+
+  Entry old_entry{std::wstring{}, position, false};
+  foldCase (old_text, old_entry.key);
+  const auto sorted_end = entries.begin() + int(sorted_count);
+  const auto iter = std::lower_bound ( entries.begin(), sorted_end
+                                     , old_entry, lessEntry );
+
+  if ( iter == sorted_end || iter->removed
+    || iter->position != position || iter->key != old_entry.key )
+  {
+    // Unknown or not yet merged entry, the owner rebuilds the index
+    invalidate();
+    return;
+  }
+
+  // The new entry is merged in at the next lookup, which
+  // also drops the removed one
+  iter->removed = true;
+  removed_count++;
+  add (text, position);
+}
+
+//----------------------------------------------------------------------
+std::size_t FSearchIndex::findPrefix (const FString& prefix)
+{
+  // Returns the lowest position of a text that begins
+  // with prefix (case-insensitive)
+
+  if ( ! valid || entries.empty() )
+    return NOT_FOUND;
+
+  mergePendingEntries();
+  foldCase (prefix, pattern);
+  const std::size_t length = pattern.length();
+  auto key_less = [] (const Entry& e, const std::wstring& p)
+                  {
+                    return e.key < p;
+                  };
+  auto has_prefix = [this, &length] (const Entry& e)
+                    {
+                      return e.key.compare(0, length, pattern) == 0;
+                    };
+  const auto first = std::lower_bound ( entries.begin(), entries.end()
+                                      , pattern, key_less );
+  const auto last = std::partition_point (first, entries.end(), has_prefix);
+
+  if ( first == last )
+    return NOT_FOUND;
+
+  return getMinPosition ( std::size_t(first - entries.begin())
+                        , std::size_t(last - entries.begin()) );
+}
+
+//----------------------------------------------------------------------
+std::vector<std::size_t> FSearchIndex::match ( const FString& text
+                                             , MatchMode mode )
+{
+  // Returns all matching positions in ascending order
+
+  std::vector<std::size_t> positions{};
+
+  if ( ! valid )
+    return positions;
+
+  mergePendingEntries();
+  foldCase (text, pattern);
+
+  for (auto&& entry : entries)
+  {
+    bool found{false};
+
+    switch ( mode )
+    {
+      case PrefixMatch:
+        found = ( entry.key.compare(0, pattern.length(), pattern) == 0 );
+        break;
+
+      case SubstringMatch:
+        found = ( entry.key.find(pattern) != std::wstring::npos );
+        break;
+
+      case FuzzyMatch:
+        found = isFuzzyMatch (entry.key, pattern);
+        break;
+    }
+
+    if ( found )
+      positions.push_back(entry.position);
+  }
+
+  std::sort (positions.begin(), positions.end());
+  return positions;
+}
+
+//----------------------------------------------------------------------
+bool FSearchIndex::startsWith (const FString& text, const FString& prefix)
+{
+  // Case-insensitive prefix comparison without string copies
+
+  const std::size_t length = prefix.getLength();
+
+  if ( text.getLength() < length )
+    return false;
+
+  const wchar_t* t = text.wc_str();
+  const wchar_t* p = prefix.wc_str();
+
+  for (std::size_t i{0}; i < length; i++)
+    if ( internal::foldChar(t[i]) != internal::foldChar(p[i]) )
+      return false;
+
+  return true;
+}
+
+
+// private methods of FSearchIndex
+//----------------------------------------------------------------------
+bool FSearchIndex::lessEntry (const Entry& e1, const Entry& e2)
+{
+  return e1.key < e2.key
+      || ( e1.key == e2.key && e1.position < e2.position );
+}
+
+//----------------------------------------------------------------------
+void FSearchIndex::foldCase (const FString& text, std::wstring& key) const
+{
+  const std::size_t length = text.getLength();
+  key.resize(length);
+
+  if ( length == 0 )
+    return;
+
+  const wchar_t* str = text.wc_str();
+
+  for (std::size_t i{0}; i < length; i++)
+    key[i] = internal::foldChar(str[i]);
+}
+
+//----------------------------------------------------------------------
+void FSearchIndex::mergePendingEntries()
+{
+  if ( sorted_count == entries.size() )
+    return;
+
+  if ( removed_count > 0 )
+  {
+    // Only sorted entries are marked as removed
+    const auto last = std::remove_if ( entries.begin()
+                                     , entries.end()
+                                     , [] (const Entry& e)
+                                       {
+                                         return e.removed;
+                                       } );
+    entries.erase (last, entries.end());
+    sorted_count -= removed_count;
+    removed_count = 0;
+  }
+
+  const auto middle = entries.begin() + int(sorted_count);
+  std::sort (middle, entries.end(), lessEntry);
+  std::inplace_merge (entries.begin(), middle, entries.end(), lessEntry);
+  sorted_count = entries.size();
+  buildMinTree();
+}
+
+//----------------------------------------------------------------------
+void FSearchIndex::buildMinTree()
+{
+  // Iterative segment tree with the leaves at [n, 2n)
+
+  const std::size_t n = entries.size();
+  min_tree.resize(2 * n);
+
+  if ( n == 0 )
+    return;
+
+  for (std::size_t i{0}; i < n; i++)
+    min_tree[n + i] = entries[i].position;
+
+  for (std::size_t i = n - 1; i > 0; i--)
+    min_tree[i] = std::min(min_tree[2 * i], min_tree[2 * i + 1]);
+}
+
+//----------------------------------------------------------------------
+std::size_t FSearchIndex::getMinPosition ( std::size_t left
+                                         , std::size_t right ) const
+{
+  // Minimum position in the entry range [left, right)
+
+  const std::size_t n = entries.size();
+  std::size_t result{NOT_FOUND};
+  left += n;
+  right += n;
+
+  while ( left < right )
+  {
+    if ( left & 1 )
+    {
+      result = std::min(result, min_tree[left]);
+      left++;
+    }
+
+    if ( right & 1 )
+    {
+      right--;
+      result = std::min(result, min_tree[right]);
+    }
+
+    left >>= 1;
+    right >>= 1;
+  }
+
+  return result;
+}
+
+//----------------------------------------------------------------------
+bool FSearchIndex::isFuzzyMatch ( const std::wstring& key
+                                , const std::wstring& fuzzy )
+{
+  std::size_t pos{0};
+
+  for (auto&& ch : fuzzy)
+  {
+    pos = key.find(ch, pos);
+
+    if ( pos == std::wstring::npos )
+      return false;
+
+    pos++;
+  }
+
+  return true;
+}
+
+}  // namespace finalcut
@@ -39,6 +39,9 @@ namespace finalcut
 // class FSpinBox
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FSpinBox> FSpinBox::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FSpinBox::FSpinBox (FWidget* parent)
@@ -369,8 +372,7 @@ inline void FSpinBox::updateInputField()
 {
   input_field.clear();
   input_field << pfix << value << sfix;
-  input_field.redraw();
-  redraw();
+  update();  // Draws the input field as well
 }
 
 //----------------------------------------------------------------------
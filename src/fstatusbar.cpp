@@ -33,6 +33,9 @@ namespace finalcut
 // class FStatusKey
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FStatusKey> FStatusKey::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FStatusKey::FStatusKey(FWidget* parent)
@@ -104,7 +107,7 @@ void FStatusKey::init()
   setGeometry (FPoint{1, 1}, FSize{1, 1});
   FWidget* parent = getParentWidget();
 
-  if ( parent && parent->isInstanceOf("FStatusBar") )
+  if ( parent && parent->isInstanceOf<FStatusBar>() )
   {
     setConnectedStatusbar (static_cast<FStatusBar*>(parent));
 
@@ -124,6 +127,9 @@ void FStatusKey::processActivate() const
 // class FStatusBar
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FStatusBar> FStatusBar::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FStatusBar::FStatusBar(FWidget* parent)
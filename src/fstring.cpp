@@ -28,13 +28,42 @@
 #include "final/fapplication.h"
 #include "final/flog.h"
 #include "final/fstring.h"
+#include "final/fstringbuilder.h"
+#include "final/futf8.h"
 
 namespace finalcut
 {
 
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline bool hasUTF8CompatibleCodeset()
+{
+  // The UTF-8 transcoder replaces the locale conversion for UTF-8
+  // and for 7-bit ASCII ("C" locale), which cannot represent
+  // other characters anyway. Other codesets are used unchanged.
+
+  const char* codeset = nl_langinfo(CODESET);
+  return std::strcmp(codeset, "UTF-8") == 0
+      || std::strcmp(codeset, "ANSI_X3.4-1968") == 0;
+}
+
+//----------------------------------------------------------------------
+constexpr char digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
+}  // namespace internal
+
 // static class attributes
+constexpr std::size_t FString::NUMBUFFER;
 wchar_t       FString::null_char{L'\0'};
 const wchar_t FString::const_null_char{L'\0'};
+char          FString::thousands_separator{'\0'};
+bool          FString::numeric_locale_cached{false};
 
 //----------------------------------------------------------------------
 // class FString
@@ -402,7 +431,9 @@ char* FString::c_str()
 //----------------------------------------------------------------------
 std::string FString::toString() const
 {
-  return std::string(c_str(), length);
+  // The number of bytes can exceed the number of characters
+  const char* str = c_str();
+  return ( str ) ? std::string(str) : std::string{};
 }
 
 //----------------------------------------------------------------------
@@ -760,138 +791,93 @@ FString& FString::setString (const FString& s)
 //----------------------------------------------------------------------
 FString& FString::setNumber (sInt64 num)
 {
-  std::array<wchar_t, 30> buf{};
-  wchar_t* s = &buf[29];  // Pointer to the last character
-  auto abs_num = static_cast<uInt64>(num);
+  // The digits are written directly into the string buffer
 
-  if ( num < 0 )
-    abs_num = static_cast<uInt64>(-num);
+  const bool negative = ( num < 0 );
+  const uInt64 abs_num = negative ? uInt64(0) - uInt64(num) : uInt64(num);
+  const std::size_t len = _countDigits(abs_num) + ( negative ? 1 : 0 );
 
-  *s = '\0';
+  if ( ! _setLength(len) )
+    return *this;
 
-  do
-  {
-    *--s = L"0123456789"[abs_num % 10];
-    abs_num /= 10;
-  }
-  while ( abs_num );
+  _writeDigits (string + len, abs_num);
 
-  if ( num < 0 )
-    *--s = '-';
+  if ( negative )
+    string[0] = L'-';
 
-  _assign (s);
   return *this;
 }
 
 //----------------------------------------------------------------------
 FString& FString::setNumber (uInt64 num)
 {
-  wchar_t buf[30]{};
-  wchar_t* s = &buf[29];  // Pointer to the last character
-  *s = '\0';
+  const std::size_t len = _countDigits(num);
 
-  do
-  {
-    *--s = L"0123456789"[num % 10];
-    num /= 10;
-  }
-  while ( num );
+  if ( _setLength(len) )
+    _writeDigits (string + len, num);
 
-  _assign (s);
   return *this;
 }
 
 //----------------------------------------------------------------------
 FString& FString::setNumber (lDouble f_num, int precision)
 {
-  std::array<wchar_t, 20> format{};  // = "%.<precision>Lg"
-  wchar_t* s = &format[0];
-  *s++ = L'%';
-  *s++ = L'.';
-
-  // The precision can not have more than 2 digits
-  if ( precision > 99 )
-    precision = 99;
+  NumberBuffer buf;
+  const std::size_t len = _formatFloat (buf, f_num, precision);
 
-  if ( precision >= 10 )
-  {
-    // The precision value is 2 digits long
-    *s++ = precision / 10 + L'0';
-    *s++ = precision % 10 + L'0';
-  }
-  else
-  {
-    // The precision value has only 1 digit
-    *s++ = precision + L'0';
-  }
+  if ( len == 0 )  // Non-ASCII characters from the locale
+    return sprintf(L"%.*Lg", std::min(precision, 99), f_num);
 
-  *s++ = L'L';
-  *s++ = L'g';
-  *s = L'\0';
+  if ( _setLength(len) )
+    std::copy (buf.data(), buf.data() + len, string);
 
-  return sprintf(format.data(), f_num);
+  return *this;
 }
 
 //----------------------------------------------------------------------
 FString& FString::setFormatedNumber (sInt64 num, char separator)
 {
-  int n{0};
-  std::array<wchar_t, 30> buf{};
-  wchar_t* s = &buf[29];  // Pointer to the last character
-  auto abs_num = static_cast<uInt64>(num);
+  const bool negative = ( num < 0 );
+  const uInt64 abs_num = negative ? uInt64(0) - uInt64(num) : uInt64(num);
+  const std::size_t digits = _countDigits(abs_num);
+  const std::size_t len = digits + (digits - 1) / 3 + ( negative ? 1 : 0 );
 
   if ( separator == 0 )
     separator = ' ';
 
-  if ( num < 0 )
-    abs_num = static_cast<uInt64>(-num);
-
-  *s = L'\0';
-
-  do
-  {
-    *--s = L"0123456789"[abs_num % 10];
-    abs_num /= 10;
-    n++;
+  if ( ! _setLength(len) )
+    return *this;
 
-    if ( abs_num && n % 3 == 0 )
-      *--s = separator;
-  }
-  while ( abs_num );
+  _writeDigits (string + len, abs_num, wchar_t(uChar(separator)));
 
-  if ( num < 0 )
-    *--s = '-';
+  if ( negative )
+    string[0] = L'-';
 
-  _assign (s);
   return *this;
 }
 
 //----------------------------------------------------------------------
 FString& FString::setFormatedNumber (uInt64 num, char separator)
 {
-  int n{0};
-  wchar_t buf[30]{};
-  wchar_t* s = &buf[29];  // Pointer to the last character
-  *s = L'\0';
+  const std::size_t digits = _countDigits(num);
+  const std::size_t len = digits + (digits - 1) / 3;
 
   if ( separator == 0 )
     separator = ' ';
 
-  do
-  {
-    *--s = L"0123456789"[num % 10];
-    num /= 10;
-    n++;
-
-    if ( num && n % 3 == 0 )
-      *--s = separator;
-  }
-  while ( num );
+  if ( _setLength(len) )
+    _writeDigits (string + len, num, wchar_t(uChar(separator)));
 
-  _assign (s);
   return *this;
 }
 
+//----------------------------------------------------------------------
+void FString::updateNumericLocale()
+{
+  thousands_separator = nl_langinfo(THOUSEP)[0];
+  numeric_locale_cached = true;
+}
+
 // FString operators
 //----------------------------------------------------------------------
 bool FString::operator < (const FString& s) const
@@ -994,40 +980,36 @@ const FString& FString::insert (const FString& s, std::size_t pos)
 //----------------------------------------------------------------------
 FString FString::replace (const FString& from, const FString& to) const
 {
-  FString s{*this};
-
   // handle NULL and empty string
   if ( ! (string && *string) )
-    return s;
+    return *this;
 
   if ( from.isNull() || to.isNull() )
-    return s;
+    return *this;
 
   if ( from.isEmpty() )
-    return s;
+    return *this;
 
-  const wchar_t* p = s.string;
+  const wchar_t* p = string;
+  const wchar_t* match = std::wcsstr(p, from.string);
+
+  if ( ! match )
+    return *this;
+
+  // Copy the text between the matches in a single pass
   const std::size_t from_length = from.getLength();
-  const std::size_t to_length = to.getLength();
-  std::size_t pos{0};
+  FStringBuilder builder{length};
 
-  while ( *p )
+  while ( match )
   {
-    if ( std::wcsncmp(p, from.string, from_length) == 0 )
-    {
-      s._remove(pos, from_length);
-      s._insert(pos, to_length, to.string);
-      pos += to_length;
-      p = s.string + pos;
-    }
-    else
-    {
-      pos++;
-      p++;
-    }
+    builder.append (p, std::size_t(match - p));
+    builder.append (to);
+    p = match + from_length;
+    match = std::wcsstr(p, from.string);
   }
 
-  return s;
+  builder.append (p, length - std::size_t(p - string));
+  return builder.release();
 }
 
 //----------------------------------------------------------------------
@@ -1037,6 +1019,9 @@ FString FString::replaceControlCodes() const
 
   for (auto&& c : s)
   {
+    if ( c >= L'\x20' && c < L'\x7f' )  // Printable ASCII
+      continue;
+
     if ( c <= L'\x1f' )
     {
       c += L'\x2400';
@@ -1059,27 +1044,27 @@ FString FString::replaceControlCodes() const
 //----------------------------------------------------------------------
 FString FString::expandTabs (int tabstop) const
 {
-  FString instr{string};
-  FString outstr{};
-
-  if ( tabstop <= 0 )
-    return instr;
+  if ( tabstop <= 0 || ! string || ! std::wcschr(string, L'\t') )
+    return *this;
 
-  const FStringList tab_split = instr.split("\t");
-  const uLong last = tab_split.size();
+  const auto tab_len = std::size_t(tabstop);
+  FStringBuilder builder{length + tab_len * 4};
+  const wchar_t* p = string;
 
-  for (std::size_t i{0}; i < last; i++)
+  while ( *p )
   {
-    const auto len = tab_split[i].getLength();
-    const auto tab_len = std::size_t(tabstop);
+    const wchar_t* tab = std::wcschr(p, L'\t');
+    const std::size_t len = ( tab ) ? std::size_t(tab - p) : std::wcslen(p);
+    builder.append (p, len);
 
-    if ( i == last - 1 )
-      outstr += tab_split[i];
-    else
-      outstr += tab_split[i] + FString(tab_len - (len % tab_len), L' ');
+    if ( ! tab )
+      break;
+
+    builder.append (tab_len - (len % tab_len), L' ');
+    p = tab + 1;
   }
 
-  return outstr;
+  return builder.release();
 }
 
 //----------------------------------------------------------------------
@@ -1249,6 +1234,55 @@ void FString::_assign (const wchar_t s[])
   string[capacity()] = L'\0';
 }
 
+//----------------------------------------------------------------------
+void FString::_assign (const wchar_t s[], std::size_t len)
+{
+  // Assigns len characters without a string comparison
+
+  if ( ! s )
+  {
+    clear();
+    return;
+  }
+
+  if ( _setLength(len) )
+    std::wmemcpy (string, s, len);
+}
+
+//----------------------------------------------------------------------
+bool FString::_setLength (std::size_t len)
+{
+  // Sets the length and the terminating null character. The content
+  // is undefined. A new buffer is only allocated if it is too small.
+
+  if ( ! string || len > capacity() )
+  {
+    if ( string )
+      delete[](string);
+
+    bufsize = FWDBUFFER + len + 1;
+
+    try
+    {
+      string = new wchar_t[bufsize];
+    }
+    catch (const std::bad_alloc&)
+    {
+      badAllocOutput ("wchar_t[bufsize]");
+      string = nullptr;
+      length = 0;
+      bufsize = 0;
+      return false;
+    }
+
+    string[bufsize - 1] = L'\0';
+  }
+
+  length = len;
+  string[length] = L'\0';
+  return true;
+}
+
 //----------------------------------------------------------------------
 void FString::_insert (std::size_t len, const wchar_t s[])
 {
@@ -1383,6 +1417,11 @@ inline const char* FString::_to_cstring (const wchar_t s[]) const
   if ( ! s )  // handle NULL string
     return nullptr;
 
+  if ( c_string )
+    delete[](c_string);
+
+  c_string = nullptr;
+
   if ( ! *s )  // handle empty string
   {
     try
@@ -1399,8 +1438,26 @@ inline const char* FString::_to_cstring (const wchar_t s[]) const
     return c_string;
   }
 
-  if ( c_string )
-    delete[](c_string);
+  const std::size_t len = std::wcslen(s);
+  const std::size_t utf8_length = getUTF8Length(s, len);
+
+  // ASCII strings are identical in all supported codesets
+  if ( utf8_length == len || internal::hasUTF8CompatibleCodeset() )
+  {
+    try
+    {
+      c_string = new char[utf8_length + 1];
+    }
+    catch (const std::bad_alloc&)
+    {
+      badAllocOutput ("char[size]");
+      return nullptr;
+    }
+
+    encodeUTF8 (s, len, c_string);
+    c_string[utf8_length] = '\0';
+    return c_string;
+  }
 
   const wchar_t* src = s;
   auto state = std::mbstate_t();
@@ -1451,6 +1508,27 @@ inline const wchar_t* FString::_to_wcstring (const char s[]) const
     }
   }
 
+  const std::size_t len = std::strlen(s);
+
+  // ASCII strings are identical in all supported codesets
+  if ( isASCII(s, len) || internal::hasUTF8CompatibleCodeset() )
+  {
+    wchar_t* dest{};
+
+    try
+    {
+      dest = new wchar_t[len + 1];  // Never more characters than bytes
+    }
+    catch (const std::bad_alloc&)
+    {
+      badAllocOutput ("wchar_t[size]");
+      return nullptr;
+    }
+
+    dest[decodeUTF8(s, len, dest)] = L'\0';
+    return dest;
+  }
+
   const char* src = s;
   wchar_t* dest{};
   auto state = std::mbstate_t();
@@ -1515,6 +1593,128 @@ inline const wchar_t* FString::_extractToken ( wchar_t* rest[]
   return token;
 }
 
+//----------------------------------------------------------------------
+void FString::_appendNumber (sInt64 num)
+{
+  const bool negative = ( num < 0 );
+  const uInt64 abs_num = negative ? uInt64(0) - uInt64(num) : uInt64(num);
+  std::array<wchar_t, 24> buf;
+  buf.back() = L'\0';
+  wchar_t* s = _writeDigits (&buf.back(), abs_num);
+
+  if ( negative )
+    *--s = L'-';
+
+  _insert (length, std::size_t(&buf.back() - s), s);
+}
+
+//----------------------------------------------------------------------
+void FString::_appendNumber (uInt64 num)
+{
+  std::array<wchar_t, 24> buf;
+  buf.back() = L'\0';
+  wchar_t* s = _writeDigits (&buf.back(), num);
+  _insert (length, std::size_t(&buf.back() - s), s);
+}
+
+//----------------------------------------------------------------------
+void FString::_appendNumber (lDouble num, int precision)
+{
+  NumberBuffer buf;
+  const std::size_t len = _formatFloat (buf, num, precision);
+
+  if ( len == 0 )  // Non-ASCII characters from the locale
+  {
+    const FString numstr(FString().setNumber(num, precision));
+    _insert (length, numstr.length, numstr.string);
+    return;
+  }
+
+  std::array<wchar_t, NUMBUFFER> wbuf;
+  std::copy (buf.data(), buf.data() + len + 1, wbuf.data());
+  _insert (length, len, wbuf.data());
+}
+
+//----------------------------------------------------------------------
+std::size_t FString::_countDigits (uInt64 num)
+{
+  std::size_t digits{1};
+
+  while ( num >= 100 )
+  {
+    num /= 100;
+    digits += 2;
+  }
+
+  return ( num >= 10 ) ? digits + 1 : digits;
+}
+
+//----------------------------------------------------------------------
+wchar_t* FString::_writeDigits (wchar_t* end, uInt64 num, wchar_t separator)
+{
+  // Writes the decimal digits backwards in front of end
+  // and returns a pointer to the first digit
+
+  if ( separator != L'\0' )
+  {
+    std::size_t n{0};
+
+    do
+    {
+      *--end = L"0123456789"[num % 10];
+      num /= 10;
+      n++;
+
+      if ( num && n % 3 == 0 )
+        *--end = separator;
+    }
+    while ( num );
+
+    return end;
+  }
+
+  // Two digits per division
+  while ( num >= 100 )
+  {
+    const std::size_t i = std::size_t(num % 100) * 2;
+    num /= 100;
+    *--end = wchar_t(internal::digit_pairs[i + 1]);
+    *--end = wchar_t(internal::digit_pairs[i]);
+  }
+
+  if ( num >= 10 )
+  {
+    const std::size_t i = std::size_t(num) * 2;
+    *--end = wchar_t(internal::digit_pairs[i + 1]);
+    *--end = wchar_t(internal::digit_pairs[i]);
+  }
+  else
+    *--end = wchar_t(L'0' + wchar_t(num));
+
+  return end;
+}
+
+//----------------------------------------------------------------------
+std::size_t FString::_formatFloat ( NumberBuffer& buf
+                                  , lDouble num, int precision )
+{
+  // Formats num like "%.<precision>Lg" into a char buffer and returns
+  // the length, or 0 if the locale produces non-ASCII characters
+
+  // The precision can not have more than 2 digits
+  if ( precision > 99 )
+    precision = 99;
+
+  const int len = std::snprintf ( buf.data(), buf.size(), "%.*Lg"
+                                , precision, num );
+
+  if ( len <= 0 || std::size_t(len) >= buf.size()
+    || ! isASCII(buf.data(), std::size_t(len)) )
+    return 0;
+
+  return std::size_t(len);
+}
+
 
 // FString non-member operators
 //----------------------------------------------------------------------
@@ -0,0 +1,260 @@
+/***********************************************************************
+* fstringbuilder.cpp - Amortized construction of an FString            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <cwchar>
+
+#include "final/flog.h"
+#include "final/fstringbuilder.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FStringBuilder
+//----------------------------------------------------------------------
+
+// static class attribute
+constexpr std::size_t FStringBuilder::MIN_CAPACITY;
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FStringBuilder::FStringBuilder (std::size_t size)
+{
+  reserve(size);
+}
+
+//----------------------------------------------------------------------
+FStringBuilder::~FStringBuilder()  // destructor
+{
+  delete[] buffer;
+}
+
+
+// public methods of FStringBuilder
+//----------------------------------------------------------------------
+void FStringBuilder::reserve (std::size_t size)
+{
+  if ( size + 1 <= bufsize )
+    return;
+
+  wchar_t* new_buffer{};
+
+  try
+  {
+    new_buffer = new wchar_t[size + 1];
+  }
+  catch (const std::bad_alloc&)
+  {
+    badAllocOutput ("wchar_t[bufsize]");
+    return;
+  }
+
+  if ( buffer )
+    std::wmemcpy (new_buffer, buffer, length);
+
+  new_buffer[length] = L'\0';
+  delete[] buffer;
+  buffer = new_buffer;
+  bufsize = size + 1;
+}
+
+//----------------------------------------------------------------------
+FStringBuilder& FStringBuilder::append (const wchar_t s[], std::size_t len)
+{
+  if ( ! s || len == 0 )
+    return *this;
+
+  if ( length + len >= bufsize )
+    grow (length + len);
+
+  if ( length + len >= bufsize )
+    return *this;  // Out of memory
+
+  std::wmemcpy (buffer + length, s, len);
+  length += len;
+  buffer[length] = L'\0';
+  return *this;
+}
+
+//----------------------------------------------------------------------
+FStringBuilder& FStringBuilder::append (std::size_t count, wchar_t c)
+{
+  if ( count == 0 )
+    return *this;
+
+  if ( length + count >= bufsize )
+    grow (length + count);
+
+  if ( length + count >= bufsize )
+    return *this;  // Out of memory
+
+  std::wmemset (buffer + length, c, count);
+  length += count;
+  buffer[length] = L'\0';
+  return *this;
+}
+
+//----------------------------------------------------------------------
+void FStringBuilder::clear()
+{
+  // Keeps the buffer for reuse
+
+  length = 0;
+
+  if ( buffer )
+    buffer[0] = L'\0';
+}
+
+//----------------------------------------------------------------------
+FString FStringBuilder::str() const
+{
+  if ( length == 0 )
+    return FString{};
+
+  return FString{buffer};
+}
+
+//----------------------------------------------------------------------
+FString FStringBuilder::release()
+{
+  // Moves the buffer into an FString and leaves the builder empty
+
+  FString s{};
+
+  if ( length == 0 )
+    return s;
+
+  s.string = buffer;
+  s.length = length;
+  s.bufsize = bufsize;
+  buffer = nullptr;
+  length = 0;
+  bufsize = 0;
+  return s;
+}
+
+
+// private methods of FStringBuilder
+//----------------------------------------------------------------------
+void FStringBuilder::grow (std::size_t min_length)
+{
+  // Doubles the capacity until min_length fits
+
+  reserve (std::max({min_length, 2 * capacity(), MIN_CAPACITY}));
+}
+
+//----------------------------------------------------------------------
+void FStringBuilder::appendNumber (sInt64 num)
+{
+  const bool negative = ( num < 0 );
+  const uInt64 abs_num = negative ? uInt64(0) - uInt64(num) : uInt64(num);
+
+  if ( negative )
+    append(L'-');
+
+  appendNumber (abs_num);
+}
+
+//----------------------------------------------------------------------
+void FStringBuilder::appendNumber (uInt64 num)
+{
+  // The digits are written directly into the buffer
+
+  const std::size_t len = FString::_countDigits(num);
+
+  if ( length + len >= bufsize )
+    grow (length + len);
+
+  if ( length + len >= bufsize )
+    return;  // Out of memory
+
+  length += len;
+  FString::_writeDigits (buffer + length, num);
+  buffer[length] = L'\0';
+}
+
+//----------------------------------------------------------------------
+void FStringBuilder::appendNumber (lDouble num, int precision)
+{
+  FString::NumberBuffer buf;
+  const std::size_t len = FString::_formatFloat (buf, num, precision);
+
+  if ( len == 0 )  // Non-ASCII characters from the locale
+  {
+    append (FString().setNumber(num, precision));
+    return;
+  }
+
+  if ( length + len >= bufsize )
+    grow (length + len);
+
+  if ( length + len >= bufsize )
+    return;  // Out of memory
+
+  std::copy (buf.data(), buf.data() + len, buffer + length);
+  length += len;
+  buffer[length] = L'\0';
+}
+
+//----------------------------------------------------------------------
+bool FStringBuilder::appendFormatText (const FString& fmt, std::size_t& pos)
+{
+  // Appends the format text from pos to the next "{}" placeholder.
+  // Returns true if a placeholder was found, pos is then behind it.
+
+  const wchar_t* s = fmt.wc_str();
+  const std::size_t len = fmt.getLength();
+  std::size_t start = pos;
+
+  while ( pos < len )
+  {
+    const wchar_t c = s[pos];
+
+    if ( ( c == L'{' || c == L'}' ) && pos + 1 < len )
+    {
+      const wchar_t next = s[pos + 1];
+
+      if ( c == L'{' && next == L'}' )
+      {
+        append (s + start, pos - start);
+        pos += 2;
+        return true;
+      }
+
+      if ( next == c )  // "{{" or "}}"
+      {
+        append (s + start, pos - start + 1);
+        pos += 2;
+        start = pos;
+        continue;
+      }
+    }
+
+    pos++;
+  }
+
+  append (s + start, pos - start);
+  return false;
+}
+
+}  // namespace finalcut
@@ -32,6 +32,9 @@ namespace finalcut
 // class FSwitch
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FSwitch> FSwitch::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FSwitch::FSwitch(FWidget* parent)
@@ -35,6 +35,7 @@
 #include "final/fmouse.h"
 #include "final/foptiattr.h"
 #include "final/foptimove.h"
+#include "final/foutputwriter.h"
 #include "final/fstartoptions.h"
 #include "final/fstring.h"
 #include "final/fsystemimpl.h"
@@ -46,7 +47,9 @@
 #include "final/ftermdebugdata.h"
 #include "final/ftermdetection.h"
 #include "final/ftermios.h"
+#include "final/ftermrecorder.h"
 #include "final/ftermxterminal.h"
+#include "final/futf8.h"
 
 #if defined(UNIT_TEST)
   #include "final/ftermlinux.h"
@@ -88,6 +91,8 @@ FTermDetection* FTerm::term_detection{nullptr};
 FTermXTerminal* FTerm::xterm         {nullptr};
 FKeyboard*      FTerm::keyboard      {nullptr};
 FMouseControl*  FTerm::mouse         {nullptr};
+FTermRecorder*  FTerm::recorder      {nullptr};
+FOutputWriter*  FTerm::output_writer {nullptr};
 
 #if defined(UNIT_TEST)
   FTermLinux*   FTerm::linux         {nullptr};
@@ -124,7 +129,10 @@ FTerm::FTerm()
 FTerm::~FTerm()  // destructor
 {
   if ( internal::var::init_term_object == this )
+  {
     finish();  // Resetting console settings
+    stopRecording();
+  }
 
   internal::var::object_counter--;
 
@@ -1018,6 +1026,7 @@ void FTerm::resetColorMap()
   if ( op )
     putstring (op);
 
+  getFOptiAttr()->resetPaletteColors();
   std::fflush(stdout);
 }
 
@@ -1028,6 +1037,7 @@ void FTerm::setPalette (FColor index, int r, int g, int b)
 
   const auto& Ic = TCAP(fc::t_initialize_color);
   const auto& Ip = TCAP(fc::t_initialize_pair);
+  const FColor vga_index{index};
   bool state{false};
 
   index = FOptiAttr::vga2ansi(index);
@@ -1059,7 +1069,11 @@ void FTerm::setPalette (FColor index, int r, int g, int b)
 #endif
 
   if ( state )
+  {
+    // Downsampled RGB colors should use the new palette
+    getFOptiAttr()->setPaletteColor (vga_index, r, g, b);
     std::fflush(stdout);
+  }
 }
 
 //----------------------------------------------------------------------
@@ -1116,6 +1130,41 @@ void FTerm::beep()
   }
 }
 
+//----------------------------------------------------------------------
+bool FTerm::startRecording (const FString& filename)
+{
+  // Records the terminal output and input into an asciicast file
+
+  if ( ! recorder )
+  {
+    try
+    {
+      recorder = new FTermRecorder;
+    }
+    catch (const std::bad_alloc&)
+    {
+      badAllocOutput ("FTermRecorder");
+      return false;
+    }
+  }
+
+  if ( recorder->start(filename, getColumnNumber(), getLineNumber()) )
+    return true;
+
+  stopRecording();
+  return false;
+}
+
+//----------------------------------------------------------------------
+void FTerm::stopRecording()
+{
+  if ( ! recorder )
+    return;
+
+  delete recorder;  // Writes the remaining frame
+  recorder = nullptr;
+}
+
 //----------------------------------------------------------------------
 void FTerm::setEncoding (fc::encoding enc)
 {
@@ -1259,6 +1308,11 @@ int FTerm::putchar_ASCII (int c)
   if ( ! fsys )
     getFSystem();
 
+  drainOutputWriter();
+
+  if ( recorder )
+    recorder->recordOutput (char(c));
+
   if ( fsys->putchar(char(c)) == EOF )
     return 0;
   else
@@ -1271,38 +1325,32 @@ int FTerm::putchar_UTF8 (int c)
   if ( ! fsys )
     getFSystem();
 
+  drainOutputWriter();
+
   if ( c < 0x80 )
   {
     // 1 Byte (7-bit): 0xxxxxxx
+    if ( recorder )
+      recorder->recordOutput (char(c));
+
     fsys->putchar (c);
     return 1;
   }
-  else if ( c < 0x800 )
-  {
-    // 2 byte (11-bit): 110xxxxx 10xxxxxx
-    fsys->putchar (0xc0 | (c >> 6) );
-    fsys->putchar (0x80 | (c & 0x3f) );
-    return 2;
-  }
-  else if ( c < 0x10000 )
-  {
-    // 3 byte (16-bit): 1110xxxx 10xxxxxx 10xxxxxx
-    fsys->putchar (0xe0 | (c >> 12) );
-    fsys->putchar (0x80 | ((c >> 6) & 0x3f) );
-    fsys->putchar (0x80 | (c & 0x3f) );
-    return 3;
-  }
-  else if ( c < 0x200000 )
+
+  // Multi-byte sequence (invalid code points become U+FFFD)
+  std::array<char, 4> buf{};
+  const auto wc = wchar_t(c);
+  const auto len = encodeUTF8 (&wc, 1, buf.data());
+
+  for (std::size_t i{0}; i < len; i++)
   {
-    // 4 byte (21-bit): 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-    fsys->putchar (0xf0 | (c >> 18) );
-    fsys->putchar (0x80 | ((c >> 12) & 0x3f) );
-    fsys->putchar (0x80 | ((c >> 6) & 0x3f) );
-    fsys->putchar (0x80 | (c & 0x3f));
-    return 4;
+    if ( recorder )
+      recorder->recordOutput (buf[i]);
+
+    fsys->putchar (int(uChar(buf[i])));
   }
-  else
-    return EOF;
+
+  return int(len);
 }
 
 
@@ -1674,6 +1722,9 @@ void FTerm::init_optiAttr()
   };
 
   opti_attr->setTermEnvironment(optiattr_env);
+
+  if ( term_detection->canDisplayTrueColor() )
+    opti_attr->setTrueColorSupport();
 }
 
 //----------------------------------------------------------------------
@@ -1742,6 +1793,9 @@ void FTerm::init_locale()
   // Fallback to C
   if ( ! locale_name )
     std::setlocale (LC_ALL, "C");
+
+  // Renew the cached thousands separator
+  FString::updateNumericLocale();
 }
 
 //----------------------------------------------------------------------
@@ -2200,6 +2254,16 @@ void FTerm::useNormalScreenBuffer()
   }
 }
 
+//----------------------------------------------------------------------
+inline void FTerm::drainOutputWriter()
+{
+  // The terminal output queued by FVTerm must be written before
+  // any direct output via stdio, otherwise the sequences overlap
+
+  if ( output_writer && output_writer->hasPendingOutput() )
+    output_writer->drain();
+}
+
 //----------------------------------------------------------------------
 inline void FTerm::allocationValues() const
 {
@@ -2287,6 +2351,10 @@ void FTerm::init()
   if ( ! init_terminal() )
     return;
 
+  // Start the session recording
+  if ( ! init_recording() )
+    return;
+
   // Set maximum number of colors for detected terminals
   init_fixed_max_color();
 
@@ -2324,6 +2392,14 @@ void FTerm::init()
   if ( isXTerminal() )
     getFTermXTerminal()->metaSendsESC(true);
 
+  // Pasted text is enclosed in ESC [200~ and ESC [201~
+  if ( isXTerminal() )
+    getFTermXTerminal()->bracketedPaste(true);
+
+  // Report focus changes of the terminal window with ESC [I and ESC [O
+  if ( isXTerminal() )
+    getFTermXTerminal()->focusReporting(true);
+
   // switch to application escape key mode
   enableApplicationEscKey();
 
@@ -2411,6 +2487,20 @@ bool FTerm::init_terminal() const
   return true;
 }
 
+//----------------------------------------------------------------------
+bool FTerm::init_recording() const
+{
+  const auto& filename = getStartOptions().recording_file;
+
+  if ( filename.isEmpty() || startRecording(filename) )
+    return true;
+
+  data->setExitMessage ( "Could not open recording file \""
+                       + filename + "\"" );
+  FApplication::exit(EXIT_FAILURE);
+  return false;
+}
+
 //----------------------------------------------------------------------
 void FTerm::initOSspecifics() const
 {
@@ -2525,6 +2615,14 @@ void FTerm::finish() const
   if ( isXTerminal() )
     getFTermXTerminal()->metaSendsESC(false);
 
+  // Deactivate the bracketed paste mode
+  if ( isXTerminal() )
+    getFTermXTerminal()->bracketedPaste(false);
+
+  // Deactivate the focus event reporting
+  if ( isXTerminal() )
+    getFTermXTerminal()->focusReporting(false);
+
   // Switch to the normal screen
   useNormalScreenBuffer();
 
@@ -20,10 +20,6 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
-#if defined(__CYGWIN__)
-  #include "final/fconfig.h"  // includes _GNU_SOURCE for wcwidth()
-#endif
-
 #include <algorithm>
 #include <array>
 #include <limits>
@@ -32,6 +28,7 @@
 
 #include "final/fapplication.h"
 #include "final/fcharmap.h"
+#include "final/fgrapheme.h"
 #include "final/flog.h"
 #include "final/fpoint.h"
 #include "final/fterm.h"
@@ -452,17 +449,18 @@ std::size_t getColumnWidth (const FString& s, std::size_t pos)
   if ( pos > length )
     pos = length;
 
-  for (std::size_t i{0}; i < pos; i++)
+  if ( ! hasFullWidthSupports() )
+    return pos;
+
+  // Counts the grapheme clusters that begin before pos
+  const wchar_t* str = s.wc_str();
+  std::size_t i{0};
+
+  while ( i < pos )
   {
-    try
-    {
-      column_width += getColumnWidth(s[i]);
-    }
-    catch (const std::out_of_range& ex)
-    {
-      std::clog << FLog::Error
-                << "Out of Range error: " << ex.what() << std::endl;
-    }
+    std::size_t width{0};
+    i += FGrapheme::nextCluster (str + i, length - i, width);
+    column_width += width;
   }
 
   return column_width;
@@ -471,21 +469,19 @@ std::size_t getColumnWidth (const FString& s, std::size_t pos)
 //----------------------------------------------------------------------
 std::size_t getColumnWidth (const FString& s)
 {
-  int column_width{0};
-
   if ( s.isEmpty() )
     return 0;
 
-  for (const auto& wchar : s)
-    column_width += getColumnWidth(wchar);
+  if ( ! hasFullWidthSupports() )
+    return s.getLength();
 
-  return ( column_width == -1 ) ? 0 : std::size_t(column_width);
+  return FGrapheme::getColumnWidth (s.wc_str(), s.getLength());
 }
 
 //----------------------------------------------------------------------
 std::size_t getColumnWidth (const wchar_t wchar)
 {
-  int column_width{};
+  std::size_t column_width{};
 
 #if defined(__NetBSD__) || defined(__OpenBSD__) \
  || defined(__FreeBSD__) || defined(__DragonFly__) \
@@ -499,19 +495,31 @@ std::size_t getColumnWidth (const wchar_t wchar)
     || ! hasFullWidthSupports() )
     column_width = 1;
   else
-    column_width = wcwidth(wchar);
+    column_width = FGrapheme::getCharWidth(wchar);
 
-  return ( column_width == -1 ) ? 0 : std::size_t(column_width);
+  return column_width;
 }
 
 //----------------------------------------------------------------------
 std::size_t getColumnWidth (FChar& term_char)
 {
-  const std::size_t char_width = getColumnWidth(term_char.ch[0]);
+  std::size_t char_width{};
+
+  if ( term_char.ch[1] == L'\0' || ! hasFullWidthSupports() )
+    char_width = getColumnWidth(term_char.ch[0]);
+  else
+  {
+    // The character cell contains a grapheme cluster
+    const auto& ch = term_char.ch;
+    const auto end = std::find(ch.begin(), ch.end(), L'\0');
+    const auto length = std::size_t(std::distance(ch.begin(), end));
+    char_width = FGrapheme::getClusterWidth (ch.data(), length);
+  }
 
   if ( char_width == 2 && FTerm::getEncoding() != fc::UTF8 )
   {
     term_char.ch[0] = '.';
+    term_char.ch[1] = L'\0';
     term_char.attr.bit.char_width = 1;
   }
   else
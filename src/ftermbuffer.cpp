@@ -26,6 +26,7 @@
 
 #include "final/fc.h"
 #include "final/fcolorpair.h"
+#include "final/fgrapheme.h"
 #include "final/fstring.h"
 #include "final/fstyle.h"
 #include "final/ftermbuffer.h"
@@ -35,6 +36,35 @@
 namespace finalcut
 {
 
+namespace internal
+{
+
+//----------------------------------------------------------------------
+void setClusterCharacters ( FChar& fchar, const wchar_t cluster[]
+                          , std::size_t length )
+{
+  // Stores the code points of a grapheme cluster in a character cell.
+  // A cluster that does not fit is cut down to a valid glyph, a joined
+  // emoji sequence to its first pictograph.
+
+  constexpr wchar_t zero_width_joiner = 0x200d;
+  constexpr wchar_t emoji_presentation_selector = 0xfe0f;
+  const auto end = cluster + length;
+
+  if ( length > UNICODE_MAX )
+  {
+    if ( std::find(cluster, end, zero_width_joiner) != end )
+      length = ( cluster[1] == emoji_presentation_selector ) ? 2 : 1;
+    else
+      length = UNICODE_MAX;
+  }
+
+  fchar.ch = { L'\0' };
+  std::copy (cluster, cluster + length, fchar.ch.begin());
+}
+
+}  // namespace internal
+
 //----------------------------------------------------------------------
 // class FTermBuffer
 //----------------------------------------------------------------------
@@ -47,14 +77,19 @@ FString FTermBuffer::toString() const
 {
   std::wstring wide_string{};
   wide_string.reserve(data.size());
-  std::transform ( data.begin()
-                 , data.end()
-                 , std::back_inserter(wide_string)
-                 , [] (const FChar& fchar)
-                   {
-                     return fchar.ch[0];
-                   }
-                 );
+
+  for (auto&& fchar : data)
+  {
+    // A cell can contain all code points of a grapheme cluster
+    for (auto&& ch : fchar.ch)
+    {
+      if ( ch == L'\0' )
+        break;
+
+      wide_string.push_back(ch);
+    }
+  }
+
   return wide_string;
 }
 
@@ -62,20 +97,28 @@ FString FTermBuffer::toString() const
 int FTermBuffer::write (const FString& string)
 {
   assert ( ! string.isNull() );
-  const auto len = int(string.getLength());
+  const auto len = string.getLength();
+  const wchar_t* str = string.wc_str();
+  std::size_t pos{0};
 
-  for (auto&& c : string)
+  while ( pos < len )
   {
+    // Each grapheme cluster is stored in one character cell
+    std::size_t width{0};
+    const std::size_t cluster = FGrapheme::nextCluster ( str + pos
+                                                       , len - pos
+                                                       , width );
     FChar nc;  // next character
     nc = FVTerm::getAttribute();
-    nc.ch[0] = c;
+    internal::setClusterCharacters (nc, str + pos, cluster);
     nc.attr.byte[2] = 0;
     nc.attr.byte[3] = 0;
     getColumnWidth(nc);  // add column width
     data.push_back(std::move(nc));
+    pos += cluster;
   }
 
-  return len;
+  return int(len);
 }
 
 //----------------------------------------------------------------------
@@ -54,6 +54,7 @@ FSystem*         FTermcap::fsystem                  {nullptr};
 FTermData*       FTermcap::fterm_data               {nullptr};
 FTermDetection*  FTermcap::term_detection           {nullptr};
 char             FTermcap::string_buf[2048]         {};
+std::mutex       FTermcap::encode_mutex             {};
 
 //----------------------------------------------------------------------
 // class FTermcap
@@ -258,6 +259,22 @@ int FTermcap::_tputs (const char* str, int affcnt, fn_putc putc)
   return fsystem->tputs (str, affcnt, putc);
 }
 
+//----------------------------------------------------------------------
+char* FTermcap::copyEncodedString (const char* str)
+{
+  // tparm() and tgoto() return a static buffer. The encoded string
+  // is copied into a buffer of the calling thread, so that threads
+  // can encode parameters concurrently (with encode_mutex locked).
+
+  static thread_local std::string encoded{};
+
+  if ( ! str )
+    return nullptr;
+
+  encoded = str;
+  return &encoded[0];
+}
+
 
 // private Data Member of FTermcap - termcap capabilities
 //----------------------------------------------------------------------
@@ -63,6 +63,7 @@ bool                          FTermDetection::decscusr_support{};
 
 bool                          FTermDetection::terminal_detection{};
 bool                          FTermDetection::color256{};
+bool                          FTermDetection::true_color{};
 const FString*                FTermDetection::answer_back{nullptr};
 const FString*                FTermDetection::sec_da{nullptr};
 int                           FTermDetection::gnome_terminal_id{};
@@ -428,6 +429,11 @@ const char* FTermDetection::init_256colorTerminal()
   else
     color256 = false;
 
+  // COLORTERM=truecolor or COLORTERM=24bit announces 24-bit colors
+  const auto& colorterm = color_env.string1;
+  true_color = colorterm && ( std::strcmp(colorterm, "truecolor") == 0
+                           || std::strcmp(colorterm, "24bit") == 0 );
+
   new_termtype = termtype_256color_quirks();
 
 #if DEBUG
@@ -583,7 +589,7 @@ FString FTermDetection::getXTermColorName (FColor color)
   const int stdin_no = FTermios::getStdIn();
 
   // get color
-  std::fprintf (stdout, OSC "4;%hu;?" BEL, color);
+  std::fprintf (stdout, OSC "4;%u;?" BEL, color);
   std::fflush (stdout);
   FD_ZERO(&ifds);
   FD_SET(stdin_no, &ifds);
@@ -594,7 +600,7 @@ FString FTermDetection::getXTermColorName (FColor color)
   if ( select (stdin_no + 1, &ifds, nullptr, nullptr, &tv) < 1 )
     return color_str;
 
-  constexpr auto parse = "\033]4;%10hu;%509[^\n]s";
+  constexpr auto parse = "\033]4;%10u;%509[^\n]s";
   std::array<char, 35> temp{};
   std::size_t pos{0};
 
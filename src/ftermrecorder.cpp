@@ -0,0 +1,234 @@
+/***********************************************************************
+* ftermrecorder.cpp - Records the terminal output and input            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+#include "final/ftermrecorder.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+std::size_t getUTF8SequenceLength (const std::string& str, std::size_t pos)
+{
+  // Returns the length of the valid UTF-8 sequence at pos, or 0
+
+  const auto first = uChar(str[pos]);
+  std::size_t len{0};
+  wchar_t min{0};
+
+  if ( first >= 0xc2 && first <= 0xdf )
+  {
+    len = 2;
+    min = 0x80;
+  }
+  else if ( first >= 0xe0 && first <= 0xef )
+  {
+    len = 3;
+    min = 0x800;
+  }
+  else if ( first >= 0xf0 && first <= 0xf4 )
+  {
+    len = 4;
+    min = 0x10000;
+  }
+  else
+    return 0;
+
+  if ( pos + len > str.length() )
+    return 0;
+
+  auto code = wchar_t(first & (0x7f >> len));
+
+  for (std::size_t i{1}; i < len; i++)
+  {
+    const auto ch = uChar(str[pos + i]);
+
+    if ( (ch & 0xc0) != 0x80 )
+      return 0;
+
+    code = wchar_t((code << 6) | (ch & 0x3f));
+  }
+
+  if ( code < min || code > 0x10ffff || (code >= 0xd800 && code <= 0xdfff) )
+    return 0;
+
+  return len;
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FTermRecorder
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FTermRecorder::~FTermRecorder()  // destructor
+{
+  stop();
+}
+
+
+// public methods of FTermRecorder
+//----------------------------------------------------------------------
+bool FTermRecorder::start ( const FString& filename
+                          , std::size_t width, std::size_t height )
+{
+  stop();
+  stream.open(filename.c_str(), std::ofstream::out | std::ofstream::trunc);
+
+  if ( ! stream.is_open() )
+    return false;
+
+  frame.clear();
+  input.clear();
+  frame_count = 0;
+  input_count = 0;
+  output_bytes = 0;
+  start_time = std::chrono::steady_clock::now();
+  const char* term = std::getenv("TERM");
+  line = "{\"version\": 2, \"width\": " + std::to_string(width)
+       + ", \"height\": " + std::to_string(height)
+       + ", \"timestamp\": " + std::to_string(std::time(nullptr))
+       + ", \"env\": {\"TERM\": ";
+  appendJsonString (line, term ? term : "");
+  line += "}}\n";
+  stream.write (line.data(), std::streamsize(line.length()));
+  return stream.good();
+}
+
+//----------------------------------------------------------------------
+void FTermRecorder::stop()
+{
+  if ( ! isRecording() )
+    return;
+
+  if ( ! input.empty() )
+    writeInput();
+
+  endFrame();
+  stream.close();
+}
+
+//----------------------------------------------------------------------
+void FTermRecorder::endFrame()
+{
+  // Writes the output of the current frame as one event
+
+  if ( frame.empty() )
+    return;
+
+  if ( isRecording() )
+  {
+    const auto now = std::chrono::steady_clock::now();
+    writeEvent (getSeconds(now), 'o', frame);
+    stream.flush();
+    frame_count++;
+    output_bytes += frame.length();
+  }
+
+  frame.clear();
+}
+
+
+// private methods of FTermRecorder
+//----------------------------------------------------------------------
+void FTermRecorder::writeInput()
+{
+  if ( isRecording() )
+  {
+    writeEvent (getSeconds(input_time), 'i', input);
+    input_count++;
+  }
+
+  input.clear();
+}
+
+//----------------------------------------------------------------------
+void FTermRecorder::writeEvent ( double seconds, char type
+                               , const std::string& data )
+{
+  std::array<char, 32> time_str{};
+  std::snprintf (time_str.data(), time_str.size(), "[%.6f, \"", seconds);
+  line = time_str.data();
+  line += type;
+  line += "\", ";
+  appendJsonString (line, data);
+  line += "]\n";
+  stream.write (line.data(), std::streamsize(line.length()));
+}
+
+//----------------------------------------------------------------------
+double FTermRecorder::getSeconds (const TimePoint& time) const
+{
+  using seconds = std::chrono::duration<double>;
+  return std::chrono::duration_cast<seconds>(time - start_time).count();
+}
+
+//----------------------------------------------------------------------
+void FTermRecorder::appendJsonString (std::string& str, const std::string& data)
+{
+  static constexpr char hex_digit[] = "0123456789abcdef";
+  std::size_t pos{0};
+  str += '"';
+
+  while ( pos < data.length() )
+  {
+    const auto ch = uChar(data[pos]);
+    std::size_t len{1};
+
+    if ( ch == '"' || ch == '\\' )
+    {
+      str += '\\';
+      str += char(ch);
+    }
+    else if ( ch >= 0x20 && ch < 0x7f )
+      str += char(ch);
+    else if ( ch >= 0x80 )
+      len = internal::getUTF8SequenceLength(data, pos);
+
+    if ( len > 1 )
+      str.append (data, pos, len);
+    else if ( ch < 0x20 || ch >= 0x7f )
+    {
+      // Control characters and invalid UTF-8 bytes
+      len = 1;
+      str += "\\u00";
+      str += hex_digit[ch >> 4];
+      str += hex_digit[ch & 0x0f];
+    }
+
+    pos += len;
+  }
+
+  str += '"';
+}
+
+}  // namespace finalcut
@@ -189,6 +189,28 @@ void FTermXTerminal::metaSendsESC (bool enable)
     disableXTermMetaSendsESC();
 }
 
+//----------------------------------------------------------------------
+void FTermXTerminal::bracketedPaste (bool enable)
+{
+  // activate/deactivate the xterm bracketed paste mode
+
+  if ( enable )
+    enableXTermBracketedPaste();
+  else
+    disableXTermBracketedPaste();
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::focusReporting (bool enable)
+{
+  // activate/deactivate the xterm focus in/out reporting
+
+  if ( enable )
+    enableXTermFocusReporting();
+  else
+    disableXTermFocusReporting();
+}
+
 //----------------------------------------------------------------------
 void FTermXTerminal::init()
 {
@@ -947,4 +969,56 @@ void FTermXTerminal::disableXTermMetaSendsESC()
   meta_sends_esc = false;
 }
 
+//----------------------------------------------------------------------
+void FTermXTerminal::enableXTermBracketedPaste()
+{
+  // Activate the xterm bracketed paste mode
+
+  if ( bracketed_paste )
+    return;
+
+  FTerm::putstring (CSI "?2004h");  // enable bracketed paste mode
+  std::fflush(stdout);
+  bracketed_paste = true;
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::disableXTermBracketedPaste()
+{
+  // Deactivate the xterm bracketed paste mode
+
+  if ( ! bracketed_paste )
+    return;
+
+  FTerm::putstring (CSI "?2004l");  // disable bracketed paste mode
+  std::fflush(stdout);
+  bracketed_paste = false;
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::enableXTermFocusReporting()
+{
+  // Activate the xterm focus in/out reporting
+
+  if ( focus_reporting )
+    return;
+
+  FTerm::putstring (CSI "?1004h");  // enable focus event reporting
+  std::fflush(stdout);
+  focus_reporting = true;
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::disableXTermFocusReporting()
+{
+  // Deactivate the xterm focus in/out reporting
+
+  if ( ! focus_reporting )
+    return;
+
+  FTerm::putstring (CSI "?1004l");  // disable focus event reporting
+  std::fflush(stdout);
+  focus_reporting = false;
+}
+
 }  // namespace finalcut
@@ -39,6 +39,9 @@ namespace finalcut
 // class FTextView
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FTextView> FTextView::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FTextView::FTextView(FWidget* parent)
@@ -343,6 +346,23 @@ void FTextView::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FTextView::onPaste (FPasteEvent* ev)
+{
+  // Appends the pasted lines with a single insert and redraw
+
+  const int yoffset_before = yoffset;
+  insert (ev->getText(), -1);
+  scrollToEnd();  // Redraws the text when the offset changes
+  ev->accept();
+
+  if ( yoffset_before == yoffset && isShown() )
+  {
+    drawText();
+    forceTerminalUpdate();
+  }
+}
+
 //----------------------------------------------------------------------
 void FTextView::onMouseDown (FMouseEvent* ev)
 {
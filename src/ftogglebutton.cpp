@@ -24,8 +24,10 @@
 
 #include "final/fapplication.h"
 #include "final/fbuttongroup.h"
+#include "final/fcheckbox.h"
 #include "final/fevent.h"
 #include "final/fpoint.h"
+#include "final/fradiobutton.h"
 #include "final/fstatusbar.h"
 #include "final/ftogglebutton.h"
 #include "final/fwidget.h"
@@ -37,6 +39,9 @@ namespace finalcut
 // class FToggleButton
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FToggleButton> FToggleButton::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FToggleButton::FToggleButton (FWidget* parent)
@@ -44,7 +49,7 @@ FToggleButton::FToggleButton (FWidget* parent)
 {
   init();
 
-  if ( parent && parent->isInstanceOf("FButtonGroup") )
+  if ( parent && parent->isInstanceOf<FButtonGroup>() )
   {
     setGroup(static_cast<FButtonGroup*>(parent));
 
@@ -60,7 +65,7 @@ FToggleButton::FToggleButton (const FString& txt, FWidget* parent)
   FToggleButton::setText(txt);  // call own method
   init();
 
-  if ( parent && parent->isInstanceOf("FButtonGroup") )
+  if ( parent && parent->isInstanceOf<FButtonGroup>() )
   {
     setGroup(static_cast<FButtonGroup*>(parent));
 
@@ -360,13 +365,13 @@ void FToggleButton::setHotkeyAccelerator()
 //----------------------------------------------------------------------
 bool FToggleButton::isRadioButton() const
 {
-  return isInstanceOf("FRadioButton");
+  return isInstanceOf<FRadioButton>();
 }
 
 //----------------------------------------------------------------------
 bool FToggleButton::isCheckboxButton() const
 {
-  return isInstanceOf("FCheckBox");
+  return isInstanceOf<FCheckBox>();
 }
 
 //----------------------------------------------------------------------
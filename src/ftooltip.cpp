@@ -31,6 +31,9 @@ namespace finalcut
 // class FToolTip
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FToolTip> FToolTip::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FToolTip::FToolTip (FWidget* parent)
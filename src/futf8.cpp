@@ -0,0 +1,327 @@
+/***********************************************************************
+* futf8.cpp - Locale-independent UTF-8 transcoding                     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
+#include <cwchar>
+
+#include "final/ftypes.h"
+#include "final/futf8.h"
+
+// SSE2 conversion of 16 characters requires 4-byte wide characters
+#if defined(__SSE2__) && WCHAR_MAX > 0xffff
+  #define USE_SSE2_UTF8
+#endif
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+constexpr uInt32 REPLACEMENT_CHAR = 0xfffd;
+
+//----------------------------------------------------------------------
+inline bool isValidCodePoint (uInt32 code)
+{
+  return code < 0x110000 && ( code < 0xd800 || code > 0xdfff );
+}
+
+//----------------------------------------------------------------------
+inline std::size_t getEncodedLength (uInt32 code)
+{
+  if ( code < 0x80 )
+    return 1;
+
+  if ( code < 0x800 )
+    return 2;
+
+  if ( code < 0x10000 || ! isValidCodePoint(code) )
+    return 3;  // Invalid code points become U+FFFD
+
+  return 4;
+}
+
+#if defined(USE_SSE2_UTF8)
+//----------------------------------------------------------------------
+inline bool isASCIIBlock (const wchar_t* src)
+{
+  // Checks 16 wide characters for values below 0x80
+
+  const auto* p = reinterpret_cast<const __m128i*>(src);
+  const __m128i bits = _mm_or_si128 ( _mm_or_si128 ( _mm_loadu_si128(p)
+                                                   , _mm_loadu_si128(p + 1) )
+                                    , _mm_or_si128 ( _mm_loadu_si128(p + 2)
+                                                   , _mm_loadu_si128(p + 3) ) );
+  const __m128i high = _mm_and_si128(bits, _mm_set1_epi32(~0x7f));
+  return _mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128()))
+      == 0xffff;
+}
+
+//----------------------------------------------------------------------
+inline void narrowASCIIBlock (const wchar_t* src, char* dest)
+{
+  // Packs 16 ASCII wide characters into 16 bytes
+
+  const auto* p = reinterpret_cast<const __m128i*>(src);
+  const __m128i lo = _mm_packs_epi32 ( _mm_loadu_si128(p)
+                                     , _mm_loadu_si128(p + 1) );
+  const __m128i hi = _mm_packs_epi32 ( _mm_loadu_si128(p + 2)
+                                     , _mm_loadu_si128(p + 3) );
+  _mm_storeu_si128 ( reinterpret_cast<__m128i*>(dest)
+                   , _mm_packus_epi16(lo, hi) );
+}
+
+//----------------------------------------------------------------------
+inline bool widenASCIIBlock (const char* src, wchar_t* dest)
+{
+  // Expands 16 bytes to 16 wide characters if they are all ASCII
+
+  const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+
+  if ( _mm_movemask_epi8(bytes) != 0 )
+    return false;
+
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+  const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+  auto* p = reinterpret_cast<__m128i*>(dest);
+  _mm_storeu_si128 (p, _mm_unpacklo_epi16(lo, zero));
+  _mm_storeu_si128 (p + 1, _mm_unpackhi_epi16(lo, zero));
+  _mm_storeu_si128 (p + 2, _mm_unpacklo_epi16(hi, zero));
+  _mm_storeu_si128 (p + 3, _mm_unpackhi_epi16(hi, zero));
+  return true;
+}
+#endif  // defined(USE_SSE2_UTF8)
+
+//----------------------------------------------------------------------
+inline std::size_t getSequenceLength (uChar lead)
+{
+  // Number of bytes of a UTF-8 sequence (0 = invalid lead byte)
+
+  if ( lead < 0x80 )
+    return 1;
+
+  if ( lead >= 0xc2 && lead <= 0xdf )
+    return 2;
+
+  if ( lead >= 0xe0 && lead <= 0xef )
+    return 3;
+
+  if ( lead >= 0xf0 && lead <= 0xf4 )
+    return 4;
+
+  return 0;  // Continuation byte, overlong 0xc0/0xc1 or above U+10FFFF
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+bool isASCII (const char s[], std::size_t len)
+{
+  std::size_t i{0};
+
+#if defined(USE_SSE2_UTF8)
+  for (; i + 16 <= len; i += 16)
+  {
+    const auto p = reinterpret_cast<const __m128i*>(s + i);
+
+    if ( _mm_movemask_epi8(_mm_loadu_si128(p)) != 0 )
+      return false;
+  }
+#endif
+
+  for (; i < len; i++)
+    if ( uChar(s[i]) >= 0x80 )
+      return false;
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+std::size_t getUTF8Length (const wchar_t s[], std::size_t len)
+{
+  // Returns the number of bytes of the UTF-8 encoded string
+
+  std::size_t bytes{0};
+  std::size_t i{0};
+
+  while ( i < len )
+  {
+#if defined(USE_SSE2_UTF8)
+    if ( i + 16 <= len && internal::isASCIIBlock(s + i) )
+    {
+      bytes += 16;
+      i += 16;
+      continue;
+    }
+#endif
+
+    bytes += internal::getEncodedLength(uInt32(s[i]));
+    i++;
+  }
+
+  return bytes;
+}
+
+//----------------------------------------------------------------------
+std::size_t encodeUTF8 (const wchar_t s[], std::size_t len, char dest[])
+{
+  // Writes getUTF8Length(s, len) bytes to dest (without a null byte)
+
+  char* d = dest;
+  std::size_t i{0};
+
+  while ( i < len )
+  {
+#if defined(USE_SSE2_UTF8)
+    if ( i + 16 <= len && internal::isASCIIBlock(s + i) )
+    {
+      internal::narrowASCIIBlock (s + i, d);
+      d += 16;
+      i += 16;
+      continue;
+    }
+#endif
+
+    auto code = uInt32(s[i]);
+    i++;
+
+    if ( code < 0x80 )
+    {
+      // 1 byte (7-bit): 0xxxxxxx
+      *d++ = char(code);
+      continue;
+    }
+
+    if ( code < 0x800 )
+    {
+      // 2 byte (11-bit): 110xxxxx 10xxxxxx
+      *d++ = char(0xc0 | (code >> 6));
+      *d++ = char(0x80 | (code & 0x3f));
+      continue;
+    }
+
+    if ( ! internal::isValidCodePoint(code) )
+      code = internal::REPLACEMENT_CHAR;
+
+    if ( code < 0x10000 )
+    {
+      // 3 byte (16-bit): 1110xxxx 10xxxxxx 10xxxxxx
+      *d++ = char(0xe0 | (code >> 12));
+      *d++ = char(0x80 | ((code >> 6) & 0x3f));
+      *d++ = char(0x80 | (code & 0x3f));
+    }
+    else
+    {
+      // 4 byte (21-bit): 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+      *d++ = char(0xf0 | (code >> 18));
+      *d++ = char(0x80 | ((code >> 12) & 0x3f));
+      *d++ = char(0x80 | ((code >> 6) & 0x3f));
+      *d++ = char(0x80 | (code & 0x3f));
+    }
+  }
+
+  return std::size_t(d - dest);
+}
+
+//----------------------------------------------------------------------
+std::size_t decodeUTF8 (const char s[], std::size_t len, wchar_t dest[])
+{
+  // Writes at most len wide characters to dest (without a null
+  // character) and returns their number
+
+  const auto src = reinterpret_cast<const uChar*>(s);
+  wchar_t* d = dest;
+  std::size_t i{0};
+
+  while ( i < len )
+  {
+#if defined(USE_SSE2_UTF8)
+    if ( i + 16 <= len && internal::widenASCIIBlock(s + i, d) )
+    {
+      d += 16;
+      i += 16;
+      continue;
+    }
+#endif
+
+    const uChar lead = src[i];
+    const std::size_t seq_len = internal::getSequenceLength(lead);
+
+    if ( seq_len == 1 )
+    {
+      *d++ = wchar_t(lead);
+      i++;
+      continue;
+    }
+
+    if ( seq_len == 0 || i + seq_len > len )
+    {
+      *d++ = wchar_t(internal::REPLACEMENT_CHAR);
+      i++;
+      continue;
+    }
+
+    // Second byte ranges exclude overlong forms, surrogates
+    // and code points above U+10FFFF
+    const uChar second = src[i + 1];
+    uChar min{0x80};
+    uChar max{0xbf};
+
+    if ( lead == 0xe0 )
+      min = 0xa0;
+    else if ( lead == 0xed )
+      max = 0x9f;
+    else if ( lead == 0xf0 )
+      min = 0x90;
+    else if ( lead == 0xf4 )
+      max = 0x8f;
+
+    bool valid = second >= min && second <= max;
+    uInt32 code = uInt32(lead) & (0xff >> (seq_len + 1));
+
+    for (std::size_t n{1}; valid && n < seq_len; n++)
+    {
+      const uChar next = src[i + n];
+      valid = ( next & 0xc0 ) == 0x80;
+      code = (code << 6) | (next & 0x3f);
+    }
+
+    if ( valid )
+    {
+      *d++ = wchar_t(code);
+      i += seq_len;
+    }
+    else
+    {
+      *d++ = wchar_t(internal::REPLACEMENT_CHAR);
+      i++;
+    }
+  }
+
+  return std::size_t(d - dest);
+}
+
+}  // namespace finalcut
@@ -24,6 +24,14 @@
   #include <unistd.h>  // need for ttyname_r
 #endif
 
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cwchar>
 #include <queue>
 #include <string>
 #include <vector>
@@ -32,52 +40,111 @@
 #include "final/fc.h"
 #include "final/fcharmap.h"
 #include "final/fcolorpair.h"
+#include "final/fgrapheme.h"
 #include "final/fkeyboard.h"
+#include "final/finstrumentation.h"
 #include "final/flog.h"
 #include "final/fmouse.h"
 #include "final/foptiattr.h"
 #include "final/foptimove.h"
+#include "final/foutputwriter.h"
 #include "final/fstyle.h"
 #include "final/fsystem.h"
 #include "final/fterm.h"
 #include "final/ftermdata.h"
 #include "final/ftermbuffer.h"
 #include "final/ftermcap.h"
+#include "final/ftermrecorder.h"
 #include "final/ftypes.h"
+#include "final/futf8.h"
 #include "final/fvterm.h"
 #include "final/fwidget.h"
 #include "final/fwindow.h"
+#include "final/fworkerpool.h"
+
+// The SSE2 character comparison requires 4-byte wide characters
+#if defined(__SSE2__) && WCHAR_MAX > 0xffff
+  #define USE_SSE2_COMPARE
+#endif
 
 namespace finalcut
 {
 
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline bool isSameCharacter (const FChar& c1, const FChar& c2)
+{
+  // Same result as c1 == c2
+
+#if defined(USE_SSE2_COMPARE)
+  static_assert ( sizeof(FChar) == 52
+               && offsetof(FChar, encoded_char) == 20
+               && offsetof(FChar, fg_color) == 40
+               && offsetof(FChar, attr) == 48
+                , "Unexpected FChar layout" );
+
+  // Compares the bytes 0-19 (ch) and 40-47 (colors) in three
+  // 16-byte blocks and then the attribute bytes #0 and #1
+  const auto p1 = reinterpret_cast<const __m128i*>(&c1);
+  const auto p2 = reinterpret_cast<const __m128i*>(&c2);
+  auto equal_bytes = [&p1, &p2] (int i)
+                     {
+                       const auto a = _mm_loadu_si128(p1 + i);
+                       const auto b = _mm_loadu_si128(p2 + i);
+                       return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+                     };
+  const int eq0 = equal_bytes(0);
+  const int eq1 = equal_bytes(1);
+  const int eq2 = equal_bytes(2);
+  return eq0 == 0xffff
+      && (eq1 & 0x000f) == 0x000f
+      && (eq2 & 0xff00) == 0xff00
+      && c1.attr.byte[0] == c2.attr.byte[0]
+      && c1.attr.byte[1] == c2.attr.byte[1]
+      && c1.attr.bit.fullwidth_padding == c2.attr.bit.fullwidth_padding;
+#else
+  return c1 == c2;
+#endif
+}
+
+//----------------------------------------------------------------------
+inline void setVTermCharacter (const FChar& new_char, FChar& vterm_char)
+{
+  // Copies new_char to the virtual terminal. A character that
+  // is already on the screen is kept and marked as unchanged.
+
+  if ( vterm_char.attr.bit.printed && isSameCharacter(vterm_char, new_char) )
+  {
+    vterm_char.attr.bit.no_changes = true;
+    return;
+  }
+
+  std::memcpy (&vterm_char, &new_char, sizeof(vterm_char));
+  vterm_char.attr.bit.no_changes = false;
+}
+
+//----------------------------------------------------------------------
+struct TerminalBand  // Output of a row band of the terminal update
+{
+  TerminalBand (const FOptiAttr& attr, const FOptiMove& move)
+    : opti_attr{attr}
+    , opti_move{move}
+  { }
+
+  std::vector<int> buffer{};
+  FPoint           term_pos{-1, -1};
+  FChar            term_attribute{};
+  FOptiAttr        opti_attr;
+  FOptiMove        opti_move;
+};
+
+}  // namespace internal
+
 // static class attributes
-bool                 FVTerm::draw_completed{false};
-bool                 FVTerm::no_terminal_updates{false};
-bool                 FVTerm::cursor_hideable{false};
-bool                 FVTerm::force_terminal_update{false};
-uInt64               FVTerm::flush_wait{16667};  // 16.6 ms  (60 Hz)
-uInt64               FVTerm::term_size_check_timeout{500000};  // 500 ms
-uInt                 FVTerm::erase_char_length{};
-uInt                 FVTerm::repeat_char_length{};
-uInt                 FVTerm::clr_bol_length{};
-uInt                 FVTerm::clr_eol_length{};
-uInt                 FVTerm::cursor_address_length{};
-struct timeval       FVTerm::time_last_flush{};
-struct timeval       FVTerm::last_term_size_check{};
-std::vector<int>*    FVTerm::output_buffer{nullptr};
-FPoint*              FVTerm::term_pos{nullptr};
-const FVTerm*        FVTerm::init_object{nullptr};
-FSystem*             FVTerm::fsystem{nullptr};
-FTerm*               FVTerm::fterm{nullptr};
-FVTerm::FTermArea*   FVTerm::vterm{nullptr};
-FVTerm::FTermArea*   FVTerm::vdesktop{nullptr};
-FVTerm::FTermArea*   FVTerm::active_area{nullptr};
-FMouseControl*       FVTerm::mouse{nullptr};
-FChar                FVTerm::term_attribute{};
-FChar                FVTerm::next_attribute{};
-FChar                FVTerm::s_ch{};
-FChar                FVTerm::i_ch{};
+FVTerm::FVTermSession               FVTerm::default_session{};
+FVTerm::FVTermSession*             FVTerm::session{&default_session};
 
 
 //----------------------------------------------------------------------
@@ -88,14 +155,14 @@ FChar                FVTerm::i_ch{};
 //----------------------------------------------------------------------
 FVTerm::FVTerm()
 {
-  if ( ! init_object )
+  if ( ! session->init_object )
     init();
 }
 
 //----------------------------------------------------------------------
 FVTerm::~FVTerm()  // destructor
 {
-  if ( init_object == this )
+  if ( session->init_object == this )
     finish();
 }
 
@@ -122,36 +189,63 @@ FPoint FVTerm::getPrintCursor()
 }
 
 //----------------------------------------------------------------------
-void FVTerm::setTermXY (int x, int y) const
+std::size_t FVTerm::getCompositionThreads()
 {
-  // Sets the hardware cursor to the given (x,y) position
+  if ( session->worker_pool )
+    return session->worker_pool->getThreadCount();
 
-  if ( term_pos->getX() == x && term_pos->getY() == y )
+  return 1;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::setTerminalFocus (bool enable)
+{
+  // Without terminal focus, the changes are collected and written
+  // at most once per background frame interval. The first update
+  // after regaining the focus writes all collected changes.
+
+  if ( enable == session->terminal_focused )
     return;
 
-  const auto term_width = int(FTerm::getColumnNumber());
-  const auto term_height = int(FTerm::getLineNumber());
+  session->terminal_focused = enable;
 
-  if ( x >= term_width && term_width > 0 )
+  if ( ! enable )
+    FObject::getCurrentTime (&session->time_last_background_frame);
+}
+
+//----------------------------------------------------------------------
+void FVTerm::setCompositionThreads (std::size_t threads)
+{
+  // Large compositions of the virtual terminal are split into row
+  // bands, which are processed by the given number of threads.
+  // A value of 0 or 1 composes in the calling thread only.
+
+  if ( session->worker_pool )
   {
-    y += x / term_width;
-    x %= term_width;
+    delete session->worker_pool;
+    session->worker_pool = nullptr;
   }
 
-  if ( term_pos->getY() >= term_height )
-    term_pos->setY(term_height - 1);
-
-  if ( y >= term_height )
-    y = term_height - 1;
+  if ( threads < 2 )
+    return;
 
-  const int term_x = term_pos->getX();
-  const int term_y = term_pos->getY();
-  const char* move_str = FTerm::moveCursorString (term_x, term_y, x, y);
+  try
+  {
+    session->worker_pool = new FWorkerPool(threads);
+  }
+  catch (const std::bad_alloc&)
+  {
+    badAllocOutput ("FWorkerPool");
+  }
+}
 
-  if ( move_str )
-    appendOutputBuffer(move_str);
+//----------------------------------------------------------------------
+void FVTerm::setTermXY (int x, int y) const
+{
+  // Sets the hardware cursor to the given (x,y) position
 
-  term_pos->setPoint(x, y);
+  auto output = getSessionOutput();
+  setTermXY (output, x, y);
 }
 
 //----------------------------------------------------------------------
@@ -159,12 +253,12 @@ void FVTerm::setTerminalUpdates (terminal_update refresh_state) const
 {
   if ( refresh_state == stop_terminal_updates )
   {
-    no_terminal_updates = true;
+    session->no_terminal_updates = true;
   }
   else if ( refresh_state == continue_terminal_updates
          || refresh_state == start_terminal_updates )
   {
-    no_terminal_updates = false;
+    session->no_terminal_updates = false;
   }
 
   if ( refresh_state == start_terminal_updates )
@@ -176,7 +270,7 @@ void FVTerm::hideCursor (bool enable) const
 {
   // Hides or shows the input cursor on the terminal
 
-  if ( ! cursor_hideable )
+  if ( ! session->cursor_hideable )
     return;
 
   const char* visibility_str = FTerm::cursorsVisibilityString (enable);
@@ -201,12 +295,10 @@ void FVTerm::setPrintCursor (const FPoint& pos)
 //----------------------------------------------------------------------
 FColor FVTerm::rgb2ColorIndex (uInt8 r, uInt8 g, uInt8 b) const
 {
-  // Converts a 24-bit RGB color to a 256-color compatible approximation
+  // Converts a 24-bit RGB color to the closest color
+  // of the terminal palette (8, 16, 88 or 256 colors)
 
-  const FColor ri = (((r * 5) + 127) / 255) * 36;
-  const FColor gi = (((g * 5) + 127) / 255) * 6;
-  const FColor bi = (((b * 5) + 127) / 255);
-  return 16 + ri + gi + bi;
+  return FTerm::getFOptiAttr()->rgb2PaletteColor (rgbColor(r, g, b));
 }
 
 //----------------------------------------------------------------------
@@ -243,7 +335,7 @@ void FVTerm::createVTerm (const FSize& size)
 
   const FRect box{0, 0, size.getWidth(), size.getHeight()};
   const FSize shadow{0, 0};
-  createArea (box, shadow, vterm);
+  createArea (box, shadow, session->vterm);
 }
 
 //----------------------------------------------------------------------
@@ -253,16 +345,24 @@ void FVTerm::resizeVTerm (const FSize& size) const
 
   const FRect box{0, 0, size.getWidth(), size.getHeight()};
   const FSize shadow{0, 0};
-  resizeArea (box, shadow, vterm);
+  resizeArea (box, shadow, session->vterm);
 }
 
 //----------------------------------------------------------------------
 void FVTerm::putVTerm() const
 {
-  for (auto i{0}; i < vterm->height; i++)
+  // Redraws every character of the virtual terminal
+
+  auto& vt = *session->vterm;
+  const int size = vt.width * vt.height;
+
+  for (auto i{0}; i < size; i++)
+    vt.data[i].attr.bit.no_changes = false;
+
+  for (auto i{0}; i < vt.height; i++)
   {
-    vterm->changes[i].xmin = 0;
-    vterm->changes[i].xmax = uInt(vterm->width - 1);
+    vt.changes[i].xmin = 0;
+    vt.changes[i].xmax = uInt(vt.width - 1);
   }
 
   updateTerminal();
@@ -273,24 +373,49 @@ bool FVTerm::updateTerminal() const
 {
   // Updates pending changes to the terminal
 
+  FInstrumentation::ScopedTimer timer(FInstrumentation::UpdateTerminal);
+  processDamage();
+
   // Check if terminal updates were stopped, application is stopping,
   // VTerm has no changes, or the drawing is not completed
-  if ( no_terminal_updates || FApplication::isQuit()
-    || ! (hasPendingUpdates(vterm) && draw_completed) )
+  if ( session->no_terminal_updates || FApplication::isQuit()
+    || ! (hasPendingUpdates(session->vterm) && session->draw_completed) )
   {
     return false;
   }
 
-  std::size_t changedlines = 0;
+  // Skips the frame while the terminal has not yet taken the output of
+  // the previous one (also forced ones). The changes remain in the
+  // vterm, so the next frame contains only the latest state.
+  if ( isOutputCongested() )
+  {
+    FInstrumentation::count (FInstrumentation::FrameSkipped);
+    return false;
+  }
 
+  // Coalesces the updates of an unfocused terminal (also forced ones)
+  if ( ! session->terminal_focused )
+  {
+    if ( ! isBackgroundFrameTimeout() )
+      return false;
+
+    FObject::getCurrentTime (&session->time_last_background_frame);
+  }
+
+  std::size_t changedlines = 0;
 
-  for (uInt y{0}; y < uInt(vterm->height); y++)
+  if ( ! updateTerminalBands(changedlines) )
   {
-    if ( updateTerminalLine(y) )
-      changedlines++;
+    auto output = getSessionOutput();
+
+    for (uInt y{0}; y < uInt(session->vterm->height); y++)
+    {
+      if ( updateTerminalLine(output, y) )
+        changedlines++;
+    }
   }
 
-  vterm->has_changes = false;
+  session->vterm->has_changes = false;
 
   // sets the new input cursor position
   bool cursor_update = updateTerminalCursor();
@@ -496,6 +621,9 @@ int FVTerm::print (FTermArea* area, FChar& term_char)
   if ( char_width == 0 )
     char_width = getColumnWidth(term_char);  // add column width
 
+  if ( joinPreviousCluster(area, term_char) )
+    return 0;
+
   if ( char_width == 0 && ! term_char.attr.bit.fullwidth_padding )
     return 0;
 
@@ -523,6 +651,120 @@ int FVTerm::print (FTermArea* area, FChar& term_char)
   return 1;
 }
 
+//----------------------------------------------------------------------
+int FVTerm::blit ( const FSize& size, const FChar* cells
+                 , std::size_t stride )
+{
+  auto area = getPrintArea();
+
+  if ( ! area )
+    return -1;
+
+  return blit (area, size, cells, stride);
+}
+
+//----------------------------------------------------------------------
+int FVTerm::blit ( FTermArea* area, const FSize& size
+                 , const FChar* cells, std::size_t stride )
+{
+  // Copies a block of width x height cells to the print cursor
+  // position. Row y of the block starts at cells[y * stride].
+  // The cells must have a valid char_width, a full-width character
+  // must be followed by its padding cell. The block is clipped at
+  // the area borders, the print cursor does not move.
+  // Returns the number of changed lines.
+
+  if ( ! area || ! cells )
+    return -1;
+
+  const std::size_t width = size.getWidth();
+
+  if ( stride == 0 )
+    stride = width;
+
+  const int ax = area->cursor_x - 1;
+  const int ay = area->cursor_y - 1;
+  int changed_lines{0};
+
+  for (std::size_t y{0}; y < size.getHeight(); y++)
+  {
+    if ( blitLine (area, ax, ay + int(y), &cells[y * stride], width) )
+      changed_lines++;
+  }
+
+  if ( changed_lines > 0 )
+    area->has_changes = true;
+
+  return changed_lines;
+}
+
+//----------------------------------------------------------------------
+int FVTerm::blit ( const FSize& size, const wchar_t* chars
+                 , const FColorPair* colors, std::size_t stride )
+{
+  auto area = getPrintArea();
+
+  if ( ! area )
+    return -1;
+
+  return blit (area, size, chars, colors, stride);
+}
+
+//----------------------------------------------------------------------
+int FVTerm::blit ( FTermArea* area, const FSize& size, const wchar_t* chars
+                 , const FColorPair* colors, std::size_t stride )
+{
+  // Like blit() with FChar cells, but with a plane of single-width
+  // code points and an optional color plane with the same stride.
+  // All other attributes are taken from the current text attribute.
+
+  if ( ! area || ! chars )
+    return -1;
+
+  const std::size_t width = size.getWidth();
+
+  if ( stride == 0 )
+    stride = width;
+
+  FChar nc{};  // next character
+  nc = FVTerm::getAttribute();
+  nc.ch = { L'\0' };
+  nc.attr.byte[2] = 0;
+  nc.attr.byte[3] = 0;
+  nc.attr.bit.char_width = 1;
+  std::vector<FChar> line(width, nc);
+  const int ax = area->cursor_x - 1;
+  const int ay = area->cursor_y - 1;
+  int changed_lines{0};
+
+  for (std::size_t y{0}; y < size.getHeight(); y++)
+  {
+    const wchar_t* ch = &chars[y * stride];
+
+    for (std::size_t x{0}; x < width; x++)
+      line[x].ch[0] = ch[x];
+
+    if ( colors )
+    {
+      const FColorPair* pair = &colors[y * stride];
+
+      for (std::size_t x{0}; x < width; x++)
+      {
+        line[x].fg_color = pair[x].getForegroundColor();
+        line[x].bg_color = pair[x].getBackgroundColor();
+      }
+    }
+
+    if ( blitLine (area, ax, ay + int(y), line.data(), width) )
+      changed_lines++;
+  }
+
+  if ( changed_lines > 0 )
+    area->has_changes = true;
+
+  return changed_lines;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::print (const FPoint& p)
 {
@@ -577,8 +819,14 @@ void FVTerm::flush()
 {
   // Flush the output buffer
 
-  if ( ! output_buffer || output_buffer->empty()
-    || ! (isFlushTimeout() || force_terminal_update) )
+  const auto& writer = session->output_writer;
+
+  // Continues the output that the terminal could not take yet
+  if ( writer && writer->hasPendingOutput() && ! writer->flush() )
+    FInstrumentation::count (FInstrumentation::OutputBlocked);
+
+  if ( ! session->output_buffer || session->output_buffer->empty()
+    || ! (isFlushTimeout() || session->force_terminal_update) )
     return;
 
   static const FTerm::defaultPutChar& FTermPutchar = FTerm::putchar();
@@ -586,13 +834,19 @@ void FVTerm::flush()
   if ( ! FTermPutchar )
     return;
 
-  for (auto&& ch : *output_buffer)
-    FTermPutchar(ch);
+  {
+    FInstrumentation::ScopedTimer timer(FInstrumentation::Flush);
+    const std::size_t bytes = writeOutputBuffer(FTermPutchar);
+    FInstrumentation::addAmount (FInstrumentation::Flush, bytes);
+    session->output_buffer->clear();
+  }
+
+  session->mouse->drawPointer();
+  FObject::getCurrentTime (&session->time_last_flush);
+  FInstrumentation::endFrame();
 
-  output_buffer->clear();
-  std::fflush(stdout);
-  mouse->drawPointer();
-  FObject::getCurrentTime (&time_last_flush);
+  if ( const auto recorder = FTerm::getFTermRecorder() )
+    recorder->endFrame();
 }
 
 
@@ -618,7 +872,7 @@ FVTerm::FTermArea* FVTerm::getPrintArea()
     }
   }
 
-  return vdesktop;
+  return session->vdesktop;
 }
 
 //----------------------------------------------------------------------
@@ -739,7 +993,11 @@ void FVTerm::removeArea (FTermArea*& area)
 //----------------------------------------------------------------------
 void FVTerm::restoreVTerm (const FRect& box)
 {
-  if ( ! vterm )
+  // Composes the terminal characters of the box from the virtual
+  // desktop and all windows. The windows that cover a line are
+  // determined once per line, not once per character.
+
+  if ( ! session->vterm )
     return;
 
   int x = box.getX() - 1;
@@ -753,38 +1011,89 @@ void FVTerm::restoreVTerm (const FRect& box)
   if ( y < 0 )
     y = 0;
 
-  if ( x + w > vterm->width )
-    w = vterm->width - x;
+  if ( x + w > session->vterm->width )
+    w = session->vterm->width - x;
 
   if ( w < 0 )
     return;
 
-  if ( y + h > vterm->height )
-    h = vterm->height - y;
+  if ( y + h > session->vterm->height )
+    h = session->vterm->height - y;
 
   if ( h < 0 )
     return;
 
-  for (auto ty{0}; ty < h; ty++)
+  // The lines are composed independently of each other
+  runRowBands ( h, w
+              , [x, y, w] (int first, int last)
+                {
+                  restoreVTermRows (x, w, y + first, y + last);
+                } );
+  session->vterm->has_changes = true;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::addDamage (const FRect& box)
+{
+  // Records a terminal region that has to be restored. The regions
+  // are composed together at the next terminal update, so several
+  // window moves between two updates cost only one restore.
+
+  if ( ! session->damage_list || box.isEmpty() )
+    return;
+
+  if ( session->damage_list->size() >= MAX_DAMAGE_RECTS )
   {
-    const int ypos = y + ty;
+    // Too many regions: restore the bounding rectangle instead
+    FRect bounds{box};
 
-    for (auto tx{0}; tx < w; tx++)
-    {
-      const int xpos = x + tx;
-      auto& tc = vterm->data[ypos * vterm->width + xpos];  // terminal character
-      auto sc = generateCharacter(FPoint{xpos, ypos});  // shown character
-      std::memcpy (&tc, &sc, sizeof(tc));
-    }
+    for (auto&& rect : *session->damage_list)
+      bounds = bounds.combined(rect);
+
+    session->damage_list->assign(1, bounds);
+  }
+  else
+    session->damage_list->push_back(box);
+
+  if ( session->vterm )
+    session->vterm->has_changes = true;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::processDamage()
+{
+  // Restores the recorded damage regions. Overlapping regions are
+  // merged first, so that no character is composed twice.
 
-    if ( int(vterm->changes[ypos].xmin) > x )
-      vterm->changes[ypos].xmin = uInt(x);
+  if ( ! session->damage_list || session->damage_list->empty() )
+    return;
+
+  auto& list = *session->damage_list;
+  bool merged{true};
+
+  while ( merged )
+  {
+    merged = false;
 
-    if ( int(vterm->changes[ypos].xmax) < x + w - 1 )
-      vterm->changes[ypos].xmax = uInt(x + w - 1);
+    for (std::size_t i{0}; i < list.size() && ! merged; i++)
+    {
+      for (std::size_t j{i + 1}; j < list.size(); j++)
+      {
+        if ( list[i].overlap(list[j]) )
+        {
+          list[i] = list[i].combined(list[j]);
+          list.erase(list.begin() + int(j));
+          merged = true;
+          break;
+        }
+      }
+    }
   }
 
-  vterm->has_changes = true;
+  for (auto&& rect : list)
+    restoreVTerm (rect);
+
+  list.clear();
 }
 
 //----------------------------------------------------------------------
@@ -806,15 +1115,15 @@ bool FVTerm::updateVTermCursor (const FTermArea* area) const
       && isInsideTerminal (FPoint{x, y})
       && isCovered (FPoint{x, y}, area) == non_covered )
     {
-      vterm->input_cursor_x = x;
-      vterm->input_cursor_y = y;
-      vterm->input_cursor_visible = true;
-      vterm->has_changes = true;
+      session->vterm->input_cursor_x = x;
+      session->vterm->input_cursor_y = y;
+      session->vterm->input_cursor_visible = true;
+      session->vterm->has_changes = true;
       return true;
     }
   }
 
-  vterm->input_cursor_visible = false;
+  session->vterm->input_cursor_visible = false;
   return false;
 }
 
@@ -839,24 +1148,27 @@ void FVTerm::getArea (const FPoint& pos, const FTermArea* area)
   if ( ! area )
     return;
 
+  processDamage();
+
   const int ax = pos.getX() - 1;
   const int ay = pos.getY() - 1;
   int y_end{};
   int length{};
 
-  if ( area->height + ay > vterm->height )
+  if ( area->height + ay > session->vterm->height )
     y_end = area->height - ay;
   else
     y_end = area->height;
 
-  if ( area->width + ax > vterm->width )
-    length = vterm->width - ax;
+  if ( area->width + ax > session->vterm->width )
+    length = session->vterm->width - ax;
   else
     length = area->width;
 
   for (auto y{0}; y < y_end; y++)  // line loop
   {
-    const auto& tc = vterm->data[(ay + y) * vterm->width + ax];  // terminal character
+    const auto& vt = *session->vterm;
+    const auto& tc = vt.data[(ay + y) * vt.width + ax];  // terminal character
     auto& ac = area->data[y * area->width];  // area character
     std::memcpy (&ac, &tc, sizeof(ac) * unsigned(length));
 
@@ -876,6 +1188,8 @@ void FVTerm::getArea (const FRect& box, const FTermArea* area)
   if ( ! area )
     return;
 
+  processDamage();
+
   const int x = box.getX();
   const int y = box.getY();
   const auto w = int(box.getWidth());
@@ -888,13 +1202,13 @@ void FVTerm::getArea (const FRect& box, const FTermArea* area)
   if ( x < 0 || y < 0 )
     return;
 
-  if ( y - 1 + h > vterm->height )
-    y_end = vterm->height - y + 1;
+  if ( y - 1 + h > session->vterm->height )
+    y_end = session->vterm->height - y + 1;
   else
     y_end = h - 1;
 
-  if ( x - 1 + w > vterm->width )
-    length = vterm->width - x + 1;
+  if ( x - 1 + w > session->vterm->width )
+    length = session->vterm->width - x + 1;
   else
     length = w;
 
@@ -904,7 +1218,8 @@ void FVTerm::getArea (const FRect& box, const FTermArea* area)
   for (auto _y = 0; _y < y_end; _y++)  // line loop
   {
     const int line_len = area->width + area->right_shadow;
-    const auto& tc = vterm->data[(y + _y - 1) * vterm->width + x - 1];  // terminal character
+    const auto& vt = *session->vterm;
+    const auto& tc = vt.data[(y + _y - 1) * vt.width + x - 1];  // term char
     auto& ac = area->data[(dy + _y) * line_len + dx];  // area character
     std::memcpy (&ac, &tc, sizeof(ac) * unsigned(length));
 
@@ -924,81 +1239,29 @@ void FVTerm::putArea (const FTermArea* area) const
   if ( ! area || ! area->visible )
     return;
 
-  int ax  = area->offset_left;
-  const int ay  = area->offset_top;
+  FInstrumentation::ScopedTimer timer(FInstrumentation::PutArea);
+
+  const int ay = area->offset_top;
   const int width = area->width + area->right_shadow;
   const int height = area->height + area->bottom_shadow;
-  int ol{0};  // Outside left
   int y_end{};
 
   // Call the preprocessing handler methods
   callPreprocessingHandler(area);
 
-  if ( ax < 0 )
-  {
-    ol = std::abs(ax);
-    ax = 0;
-  }
-
-  if ( height + ay > vterm->height )
-    y_end = vterm->height - ay;
+  if ( height + ay > session->vterm->height )
+    y_end = session->vterm->height - ay;
   else
     y_end = height;
 
-  for (auto y{0}; y < y_end; y++)  // Line loop
-  {
-    bool modified{false};
-    auto line_xmin = int(area->changes[y].xmin);
-    auto line_xmax = int(area->changes[y].xmax);
-
-    if ( line_xmin > line_xmax )
-      continue;
-
-    if ( ax == 0 )
-      line_xmin = ol;
-
-    if ( width + ax - ol >= vterm->width )
-      line_xmax = vterm->width + ol - ax - 1;
+  // The lines are updated independently of each other
+  runRowBands ( y_end, width
+              , [area] (int first, int last)
+                {
+                  putAreaRows (area, first, last);
+                } );
 
-    if ( ax + line_xmin >= vterm->width )
-      continue;
-
-    for (auto x = line_xmin; x <= line_xmax; x++)  // Column loop
-    {
-      // Global terminal positions
-      int tx = ax + x;
-      const int ty = ay + y;
-
-      if ( tx < 0 || ty < 0 )
-        continue;
-
-      tx -= ol;
-      bool update = updateVTermCharacter(area, FPoint{x, y}, FPoint{tx, ty});
-
-      if ( ! modified && ! update )
-        line_xmin++;  // Don't update covered character
-
-      if ( update )
-        modified = true;
-    }
-
-    int _xmin = ax + line_xmin - ol;
-    int _xmax = ax + line_xmax;
-
-    if ( _xmin < int(vterm->changes[ay + y].xmin) )
-      vterm->changes[ay + y].xmin = uInt(_xmin);
-
-    if ( _xmax >= vterm->width )
-      _xmax = vterm->width - 1;
-
-    if ( _xmax > int(vterm->changes[ay + y].xmax) )
-      vterm->changes[ay + y].xmax = uInt(_xmax);
-
-    area->changes[y].xmin = uInt(width);
-    area->changes[y].xmax = 0;
-  }
-
-  vterm->has_changes = true;
+  session->vterm->has_changes = true;
   updateVTermCursor(area);
 }
 
@@ -1010,6 +1273,8 @@ void FVTerm::putArea (const FPoint& pos, const FTermArea* area)
   if ( ! area || ! area->visible )
     return;
 
+  FInstrumentation::ScopedTimer timer(FInstrumentation::PutArea);
+
   int ax = pos.getX() - 1;
   const int ay = pos.getY() - 1;
   const int width = area->width + area->right_shadow;
@@ -1024,13 +1289,13 @@ void FVTerm::putArea (const FPoint& pos, const FTermArea* area)
     ax = 0;
   }
 
-  if ( ay + height > vterm->height )
-    y_end = vterm->height - ay;
+  if ( ay + height > session->vterm->height )
+    y_end = session->vterm->height - ay;
   else
     y_end = height;
 
-  if ( width - ol + ax > vterm->width )
-    length = vterm->width - ax;
+  if ( width - ol + ax > session->vterm->width )
+    length = session->vterm->width - ax;
   else
     length = width - ol;
 
@@ -1039,12 +1304,23 @@ void FVTerm::putArea (const FPoint& pos, const FTermArea* area)
 
   for (auto y{0}; y < y_end; y++)  // line loop
   {
+    auto& vt = *session->vterm;
+    int xmin{ax};  // Range of the changed terminal characters
+    int xmax{ax + length - 1};
+
     if ( area->changes[y].trans_count == 0 )
     {
       // Line has only covered characters
-      const auto& ac = area->data[y * width + ol];           // area character
-      auto& tc = vterm->data[(ay + y) * vterm->width + ax];  // terminal character
-      putAreaLine (ac, tc, std::size_t(length));
+      const auto& ac = area->data[y * width + ol];   // area character
+      auto& tc = vt.data[(ay + y) * vt.width + ax];  // terminal character
+      std::size_t first{};
+      std::size_t last{};
+
+      if ( ! putAreaLine (ac, tc, std::size_t(length), first, last) )
+        continue;  // No changes in this line
+
+      xmin = ax + int(first);
+      xmax = ax + int(last);
     }
     else
     {
@@ -1054,19 +1330,19 @@ void FVTerm::putArea (const FPoint& pos, const FTermArea* area)
         const int cx = ax + x;
         const int cy = ay + y;
         const auto& ac = area->data[y * width + ol + x];  // area character
-        auto& tc = vterm->data[cy * vterm->width + cx];   // terminal character
+        auto& tc = vt.data[cy * vt.width + cx];   // terminal character
         putAreaCharacter (FPoint{cx, cy}, area, ac, tc);
       }
     }
 
-    if ( ax < int(vterm->changes[ay + y].xmin) )
-      vterm->changes[ay + y].xmin = uInt(ax);
+    if ( xmin < int(vt.changes[ay + y].xmin) )
+      vt.changes[ay + y].xmin = uInt(xmin);
 
-    if ( ax + length - 1 > int(vterm->changes[ay + y].xmax) )
-      vterm->changes[ay + y].xmax = uInt(ax + length - 1);
+    if ( xmax > int(vt.changes[ay + y].xmax) )
+      vt.changes[ay + y].xmax = uInt(xmax);
   }
 
-  vterm->has_changes = true;
+  session->vterm->has_changes = true;
 }
 
 //----------------------------------------------------------------------
@@ -1107,11 +1383,11 @@ void FVTerm::scrollAreaForward (FTermArea* area) const
   area->changes[y_max].xmax = uInt(area->width - 1);
   area->has_changes = true;
 
-  if ( area == vdesktop && TCAP(fc::t_scroll_forward) )
+  if ( area == session->vdesktop && TCAP(fc::t_scroll_forward) )
   {
-    setTermXY (0, vdesktop->height);
+    setTermXY (0, session->vdesktop->height);
     FTerm::scrollTermForward();
-    putArea (FPoint{1, 1}, vdesktop);
+    putArea (FPoint{1, 1}, session->vdesktop);
 
     // avoid update lines from 0 to (y_max - 1)
     for (auto y{0}; y < y_max; y++)
@@ -1159,11 +1435,11 @@ void FVTerm::scrollAreaReverse (FTermArea* area) const
   area->changes[0].xmax = uInt(area->width - 1);
   area->has_changes = true;
 
-  if ( area == vdesktop && TCAP(fc::t_scroll_reverse)  )
+  if ( area == session->vdesktop && TCAP(fc::t_scroll_reverse)  )
   {
     setTermXY (0, 0);
     FTerm::scrollTermReverse();
-    putArea (FPoint{1, 1}, vdesktop);
+    putArea (FPoint{1, 1}, session->vdesktop);
 
     // avoid update lines from 1 to y_max
     for (auto y{1}; y <= y_max; y++)
@@ -1182,7 +1458,7 @@ void FVTerm::clearArea (FTermArea* area, int fillchar) const
   FChar nc{};  // next character
 
   // Current attributes with a space character
-  std::memcpy (&nc, &next_attribute, sizeof(nc));
+  std::memcpy (&nc, &session->next_attribute, sizeof(nc));
   nc.ch[0] = fillchar;
 
   if ( ! (area && area->data) )
@@ -1230,10 +1506,10 @@ void FVTerm::clearArea (FTermArea* area, int fillchar) const
 //----------------------------------------------------------------------
 void FVTerm::forceTerminalUpdate() const
 {
-  force_terminal_update = true;
+  session->force_terminal_update = true;
   processTerminalUpdate();
   flush();
-  force_terminal_update = false;
+  session->force_terminal_update = false;
 }
 
 //----------------------------------------------------------------------
@@ -1263,27 +1539,27 @@ bool FVTerm::processTerminalUpdate() const
 void FVTerm::startDrawing()
 {
   // Pauses the terminal updates for the printing phase
-  draw_completed = false;
+  session->draw_completed = false;
 }
 
 //----------------------------------------------------------------------
 void FVTerm::finishDrawing()
 {
   // After the printing phase is completed, the terminal will be updated
-  draw_completed = true;
+  session->draw_completed = true;
 }
 
 //----------------------------------------------------------------------
 void FVTerm::initTerminal()
 {
-  if ( fterm )
-    fterm->initTerminal();
+  if ( session->fterm )
+    session->fterm->initTerminal();
 
   // Get the global FMouseControl object
-  mouse = FTerm::getFMouseControl();
+  session->mouse = FTerm::getFMouseControl();
 
   // Hide the input cursor
-  cursor_hideable = FTerm::isCursorHideable();
+  session->cursor_hideable = FTerm::isCursorHideable();
   hideCursor();
 
   // Initialize character lengths
@@ -1378,7 +1654,7 @@ FVTerm::covered_state FVTerm::isCovered ( const FPoint& pos
 
   if ( FWidget::getWindowList() && ! FWidget::getWindowList()->empty() )
   {
-    bool found{ area == vdesktop };
+    bool found{ area == session->vdesktop };
 
     for (auto& win_obj : *FWidget::getWindowList())
     {
@@ -1442,8 +1718,7 @@ inline void FVTerm::updateOverlappedColor ( const FChar& area_char
     || nc.ch[0] == fc::FullBlock )
     nc.ch[0] = ' ';
 
-  nc.attr.bit.no_changes = bool(vterm_char.attr.bit.printed && vterm_char == nc);
-  std::memcpy (&vterm_char, &nc, sizeof(vterm_char));
+  internal::setVTermCharacter (nc, vterm_char);
 }
 
 //----------------------------------------------------------------------
@@ -1452,9 +1727,7 @@ inline void FVTerm::updateOverlappedCharacter ( FChar& cover_char
 {
   // Restore one character on vterm
 
-  cover_char.attr.bit.no_changes = \
-      bool(vterm_char.attr.bit.printed && vterm_char == cover_char);
-  std::memcpy (&vterm_char, &cover_char, sizeof(vterm_char));
+  internal::setVTermCharacter (cover_char, vterm_char);
 }
 
 //----------------------------------------------------------------------
@@ -1477,9 +1750,7 @@ inline void FVTerm::updateShadedCharacter ( const FChar& area_char
     || cover_char.ch[0] == fc::FullBlock )
     cover_char.ch[0] = ' ';
 
-  cover_char.attr.bit.no_changes = \
-      bool(vterm_char.attr.bit.printed && vterm_char == cover_char);
-  std::memcpy (&vterm_char, &cover_char, sizeof(vterm_char));
+  internal::setVTermCharacter (cover_char, vterm_char);
 }
 
 //----------------------------------------------------------------------
@@ -1493,9 +1764,7 @@ inline void FVTerm::updateInheritBackground ( const FChar& area_char
   FChar nc{};
   std::memcpy (&nc, &area_char, sizeof(nc));
   nc.bg_color = cover_char.bg_color;
-  nc.attr.bit.no_changes = \
-      bool(vterm_char.attr.bit.printed && vterm_char == nc);
-  std::memcpy (&vterm_char, &nc, sizeof(vterm_char));
+  internal::setVTermCharacter (nc, vterm_char);
 }
 
 //----------------------------------------------------------------------
@@ -1503,45 +1772,130 @@ inline void FVTerm::updateCharacter (const FChar& area_char, FChar& vterm_char)
 {
   // Copy a area character to the virtual terminal
 
-  std::memcpy (&vterm_char, &area_char, sizeof(vterm_char));
+  internal::setVTermCharacter (area_char, vterm_char);
+}
 
-  if ( vterm_char.attr.bit.printed && vterm_char == area_char )
-    vterm_char.attr.bit.no_changes = true;
-  else
-    vterm_char.attr.bit.no_changes = false;
+//----------------------------------------------------------------------
+inline void FVTerm::updateTransparentCount ( FLineChanges& line_changes
+                                           , const FChar& area_char
+                                           , const FChar& new_char )
+{
+  const auto& ac = area_char.attr.bit;
+  const auto& nc = new_char.attr.bit;
+
+  if ( ( ! ac.transparent && nc.transparent )
+    || ( ! ac.color_overlay && nc.color_overlay )
+    || ( ! ac.inherit_background && nc.inherit_background ) )
+  {
+    // add one transparent character form line
+    line_changes.trans_count++;
+  }
+
+  if ( ( ac.transparent && ! nc.transparent )
+    || ( ac.color_overlay && ! nc.color_overlay )
+    || ( ac.inherit_background && ! nc.inherit_background ) )
+  {
+    // remove one transparent character from line
+    line_changes.trans_count--;
+  }
 }
 
 //----------------------------------------------------------------------
-bool FVTerm::updateVTermCharacter ( const FTermArea* area
-                                  , const FPoint& area_pos
-                                  , const FPoint& terminal_pos )
+bool FVTerm::blitLine ( FTermArea* area, int x, int y
+                      , const FChar* line, std::size_t length )
 {
-  // Area character
-  const int width = area->width + area->right_shadow;
-  const int area_index = area_pos.getY() * width + area_pos.getX();
-  const auto& ac = area->data[area_index];
-  // Terminal character
-  const int terminal_index = terminal_pos.getY() * vterm->width
-                           + terminal_pos.getX();
-  auto& tc = vterm->data[terminal_index];
+  // Copies one line of cells to the area position (x, y)
+  // and returns true if the area line has changed
 
-  // Get covered state
-  const auto is_covered = isCovered(terminal_pos, area);
+  const int line_len = area->width + area->right_shadow;
 
-  if ( is_covered == fully_covered )
+  if ( y < 0 || y >= area->height + area->bottom_shadow || x >= line_len )
     return false;
 
-  if ( is_covered == half_covered )
-  {
-    // Overlapped character
-    auto oc = getOverlappedCharacter (terminal_pos, area);
-    updateOverlappedColor (ac, oc, tc);
-  }
-  else if ( ac.attr.bit.transparent )   // Transparent
+  if ( x < 0 )  // Clip on the left side
   {
-    // Covered character
-    auto cc = getCoveredCharacter (terminal_pos, area);
-    updateOverlappedCharacter (cc, tc);
+    if ( std::size_t(-x) >= length )
+      return false;
+
+    line += -x;
+    length -= std::size_t(-x);
+    x = 0;
+  }
+
+  length = std::min(length, std::size_t(line_len - x));
+  auto ac = &area->data[y * line_len + x];  // area characters
+
+  // Unchanged lines are detected with a single block comparison
+  if ( std::memcmp(ac, line, length * sizeof(FChar)) == 0 )
+    return false;
+
+  std::size_t first{0};
+  std::size_t last{length};
+
+  while ( first < length && ac[first] == line[first] )
+    first++;
+
+  if ( first == length )
+    return false;
+
+  while ( last > first && ac[last - 1] == line[last - 1] )
+    last--;
+
+  auto& line_changes = area->changes[y];
+
+  for (std::size_t i{first}; i < last; i++)
+  {
+    if ( ac[i] != line[i] )
+    {
+      updateTransparentCount (line_changes, ac[i], line[i]);
+      std::memcpy (&ac[i], &line[i], sizeof(FChar));
+    }
+  }
+
+  // Update the line changes only once
+  const auto xmin = uInt(x) + uInt(first);
+  const auto xmax = uInt(x) + uInt(last) - 1;
+
+  if ( xmin < line_changes.xmin )
+    line_changes.xmin = xmin;
+
+  if ( xmax > line_changes.xmax )
+    line_changes.xmax = xmax;
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FVTerm::updateVTermCharacter ( const FTermArea* area
+                                  , const FPoint& area_pos
+                                  , const FPoint& terminal_pos )
+{
+  // Area character
+  const int width = area->width + area->right_shadow;
+  const int area_index = area_pos.getY() * width + area_pos.getX();
+  const auto& ac = area->data[area_index];
+  // Terminal character
+  const int terminal_index = terminal_pos.getY() * session->vterm->width
+                           + terminal_pos.getX();
+  auto& tc = session->vterm->data[terminal_index];
+
+  // Get covered state
+  const auto is_covered = isCovered(terminal_pos, area);
+
+  if ( is_covered == fully_covered )
+    return false;
+
+  if ( is_covered == half_covered )
+  {
+    // Overlapped character
+    auto oc = getOverlappedCharacter (terminal_pos, area);
+    updateOverlappedColor (ac, oc, tc);
+  }
+  else if ( ac.attr.bit.transparent )   // Transparent
+  {
+    // Covered character
+    auto cc = getCoveredCharacter (terminal_pos, area);
+    updateOverlappedCharacter (cc, tc);
   }
   else  // Not transparent
   {
@@ -1563,7 +1917,8 @@ bool FVTerm::updateVTermCharacter ( const FTermArea* area
     }
   }
 
-  return true;
+  // Unchanged characters need no terminal update
+  return ! tc.attr.bit.no_changes;
 }
 
 //----------------------------------------------------------------------
@@ -1571,13 +1926,16 @@ void FVTerm::updateVTerm() const
 {
   // Updates the character data from all areas to VTerm
 
-  if ( hasPendingUpdates(vdesktop) )
+  FInstrumentation::ScopedTimer timer(FInstrumentation::UpdateVTerm);
+  processDamage();
+
+  if ( hasPendingUpdates(session->vdesktop) )
   {
-    putArea(vdesktop);
-    vdesktop->has_changes = false;
+    putArea(session->vdesktop);
+    session->vdesktop->has_changes = false;
   }
 
-  const FWidget* widget = vterm->widget;
+  const FWidget* widget = session->vterm->widget;
 
   if ( ! widget || ! widget->getWindowList()
     || widget->getWindowList()->empty() )
@@ -1665,73 +2023,53 @@ bool FVTerm::isInsideArea (const FPoint& pos, const FTermArea* area)
 }
 
 //----------------------------------------------------------------------
-FChar FVTerm::generateCharacter (const FPoint& pos)
+const FChar* FVTerm::composeCharacter ( const FTermArea* win
+                                      , int x, int y
+                                      , const FChar* sc
+                                      , FComposeBuffer& buffer )
 {
-  // Generates characters for a given position considering all areas
+  // Returns the character that is shown when the window character
+  // at the terminal position (x, y) is placed over sc
 
-  const int x = pos.getX();
-  const int y = pos.getY();
-  auto sc = &vdesktop->data[y * vdesktop->width + x];  // shown character
+  const int line_len = win->width + win->right_shadow;
+  const auto tmp = &win->data[(y - win->offset_top) * line_len
+                              + (x - win->offset_left)];
 
-  if ( ! FWidget::getWindowList() || FWidget::getWindowList()->empty() )
-    return *sc;
+  if ( tmp->attr.bit.transparent )  // Current character is transparent
+    return sc;
 
-  for (auto& win_obj : *FWidget::getWindowList())
+  if ( tmp->attr.bit.color_overlay )  // Transparent shadow
   {
-    const auto& win = win_obj->getVWin();
+    // Keep the current vterm character
+    if ( sc != &buffer.s_ch )
+      std::memcpy (&buffer.s_ch, sc, sizeof(buffer.s_ch));
 
-    if ( ! win || ! win->visible )
-      continue;
+    buffer.s_ch.fg_color = tmp->fg_color;
+    buffer.s_ch.bg_color = tmp->bg_color;
+    buffer.s_ch.attr.bit.reverse  = false;
+    buffer.s_ch.attr.bit.standout = false;
 
-    const int win_x = win->offset_left;
-    const int win_y = win->offset_top;
-    const FRect geometry { win_x, win_y
-        , std::size_t(win->width) + std::size_t(win->right_shadow)
-        , std::size_t(win->height) + std::size_t(win->bottom_shadow) };
+    if ( buffer.s_ch.ch[0] == fc::LowerHalfBlock
+      || buffer.s_ch.ch[0] == fc::UpperHalfBlock
+      || buffer.s_ch.ch[0] == fc::LeftHalfBlock
+      || buffer.s_ch.ch[0] == fc::RightHalfBlock
+      || buffer.s_ch.ch[0] == fc::MediumShade
+      || buffer.s_ch.ch[0] == fc::FullBlock )
+      buffer.s_ch.ch[0] = ' ';
 
-    // Window is visible and contains current character
-    if ( geometry.contains(x, y) )
-    {
-      const int line_len = win->width + win->right_shadow;
-      auto tmp = &win->data[(y - win_y) * line_len + (x - win_x)];
+    return &buffer.s_ch;
+  }
 
-      if ( ! tmp->attr.bit.transparent )   // Current character not transparent
-      {
-        if ( tmp->attr.bit.color_overlay )  // Transparent shadow
-        {
-          // Keep the current vterm character
-          if ( sc != &s_ch )
-            std::memcpy (&s_ch, sc, sizeof(s_ch));
-
-          s_ch.fg_color = tmp->fg_color;
-          s_ch.bg_color = tmp->bg_color;
-          s_ch.attr.bit.reverse  = false;
-          s_ch.attr.bit.standout = false;
-
-          if ( s_ch.ch[0] == fc::LowerHalfBlock
-            || s_ch.ch[0] == fc::UpperHalfBlock
-            || s_ch.ch[0] == fc::LeftHalfBlock
-            || s_ch.ch[0] == fc::RightHalfBlock
-            || s_ch.ch[0] == fc::MediumShade
-            || s_ch.ch[0] == fc::FullBlock )
-            s_ch.ch[0] = ' ';
-
-          sc = &s_ch;
-        }
-        else if ( tmp->attr.bit.inherit_background )
-        {
-          // Add the covered background to this character
-          std::memcpy (&i_ch, tmp, sizeof(i_ch));
-          i_ch.bg_color = sc->bg_color;  // Last background color
-          sc = &i_ch;
-        }
-        else  // Default
-          sc = tmp;
-      }
-    }
+  if ( tmp->attr.bit.inherit_background )
+  {
+    // Add the covered background to this character
+    const auto bg_color = sc->bg_color;  // Last background color
+    std::memcpy (&buffer.i_ch, tmp, sizeof(buffer.i_ch));
+    buffer.i_ch.bg_color = bg_color;
+    return &buffer.i_ch;
   }
 
-  return *sc;
+  return tmp;  // Default
 }
 
 //----------------------------------------------------------------------
@@ -1746,19 +2084,21 @@ FChar FVTerm::getCharacter ( character_type char_type
   int xx = ( x > 0 ) ? x : 0;
   int yy = ( y > 0 ) ? y : 0;
 
-  if ( xx >= vterm->width )
-    xx = vterm->width - 1;
+  if ( xx >= session->vterm->width )
+    xx = session->vterm->width - 1;
 
-  if ( yy >= vterm->height )
-    yy = vterm->height - 1;
+  if ( yy >= session->vterm->height )
+    yy = session->vterm->height - 1;
 
-  auto cc = &vdesktop->data[yy * vdesktop->width + xx];  // covered character
+  // Covered character
+  auto cc = &session->vdesktop->data[yy * session->vdesktop->width + xx];
 
   if ( ! area || ! FWidget::getWindowList() || FWidget::getWindowList()->empty() )
     return *cc;
 
   // Get the window layer of this widget object
   const int layer = FWindow::getWindowLayer(area->widget);
+  FComposeBuffer buffer{};
 
   for (auto&& win_obj : *FWidget::getWindowList())
   {
@@ -1784,7 +2124,7 @@ FChar FVTerm::getCharacter ( character_type char_type
 
       // Window visible and contains current character
       if ( geometry.contains(x, y) )
-        getAreaCharacter (FPoint{x, y}, win, cc);
+        getAreaCharacter (FPoint{x, y}, win, cc, buffer);
     }
     else if ( char_type == covered_character )
       break;
@@ -1810,41 +2150,48 @@ inline FChar FVTerm::getOverlappedCharacter (const FPoint& pos, const FTermArea*
 //----------------------------------------------------------------------
 void FVTerm::init()
 {
-  init_object = this;
-  vterm       = nullptr;
-  vdesktop    = nullptr;
-  fsystem     = FTerm::getFSystem();
+  session->init_object = this;
+  session->vterm       = nullptr;
+  session->vdesktop    = nullptr;
+  session->fsystem     = FTerm::getFSystem();
 
   try
   {
-    fterm         = new FTerm();
-    term_pos      = new FPoint(-1, -1);
-    output_buffer = new std::vector<int>;
+    session->fterm         = new FTerm();
+    session->term_pos      = new FPoint(-1, -1);
+    session->output_buffer = new std::vector<int>;
+    session->output_writer = new FOutputWriter(fileno(stdout));
+    session->damage_list   = new std::vector<FRect>;
   }
   catch (const std::bad_alloc&)
   {
-    badAllocOutput ("FTerm, FPoint, or std::queue<int>");
+    badAllocOutput ("FTerm, FPoint, std::queue<int>, FOutputWriter, "
+                    "or std::vector<FRect>");
     return;
   }
 
+  // Direct terminal output of FTerm waits for the queued output
+  FTerm::setOutputWriter (session->output_writer);
+
   // Presetting of the current locale for full-width character support.
   // The final setting is made later in FTerm::init_locale().
   std::setlocale (LC_ALL, "");
 
   // Reserve memory on the terminal output buffer
-  output_buffer->reserve(TERMINAL_OUTPUT_BUFFER_SIZE + 256);
+  session->output_buffer->reserve(TERMINAL_OUTPUT_BUFFER_SIZE + 256);
 
   // term_attribute stores the current state of the terminal
-  term_attribute.ch           = { L'\0' };
-  term_attribute.fg_color     = fc::Default;
-  term_attribute.bg_color     = fc::Default;
-  term_attribute.attr.byte[0] = 0;
-  term_attribute.attr.byte[1] = 0;
-  term_attribute.attr.byte[2] = 0;
-  term_attribute.attr.byte[3] = 0;
+  session->term_attribute.ch           = { L'\0' };
+  session->term_attribute.fg_color     = fc::Default;
+  session->term_attribute.bg_color     = fc::Default;
+  session->term_attribute.attr.byte[0] = 0;
+  session->term_attribute.attr.byte[1] = 0;
+  session->term_attribute.attr.byte[2] = 0;
+  session->term_attribute.attr.byte[3] = 0;
 
   // next_attribute contains the state of the next printed character
-  std::memcpy (&next_attribute, &term_attribute, sizeof(next_attribute));
+  std::memcpy ( &session->next_attribute, &session->term_attribute
+              , sizeof(session->next_attribute) );
 
   // Create virtual terminal
   FRect term_geometry {0, 0, FTerm::getColumnNumber(), FTerm::getLineNumber()};
@@ -1852,15 +2199,15 @@ void FVTerm::init()
 
   // Create virtual desktop area
   FSize shadow_size{0, 0};
-  createArea (term_geometry, shadow_size, vdesktop);
-  vdesktop->visible = true;
-  active_area = vdesktop;
+  createArea (term_geometry, shadow_size, session->vdesktop);
+  session->vdesktop->visible = true;
+  session->active_area = session->vdesktop;
 
   // Initialize the flush and last terminal size check time
-  time_last_flush.tv_sec = 0;
-  time_last_flush.tv_usec = 0;
-  last_term_size_check.tv_sec = 0;
-  last_term_size_check.tv_usec = 0;
+  session->time_last_flush.tv_sec = 0;
+  session->time_last_flush.tv_usec = 0;
+  session->last_term_size_check.tv_sec = 0;
+  session->last_term_size_check.tv_usec = 0;
 }
 
 //----------------------------------------------------------------------
@@ -1868,19 +2215,19 @@ void FVTerm::init_characterLengths (const FOptiMove* optimove)
 {
   if ( optimove )
   {
-    cursor_address_length = optimove->getCursorAddressLength();
-    erase_char_length     = optimove->getEraseCharsLength();
-    repeat_char_length    = optimove->getRepeatCharLength();
-    clr_bol_length        = optimove->getClrBolLength();
-    clr_eol_length        = optimove->getClrEolLength();
+    session->cursor_address_length = optimove->getCursorAddressLength();
+    session->erase_char_length     = optimove->getEraseCharsLength();
+    session->repeat_char_length    = optimove->getRepeatCharLength();
+    session->clr_bol_length        = optimove->getClrBolLength();
+    session->clr_eol_length        = optimove->getClrEolLength();
   }
   else
   {
-    cursor_address_length = INT_MAX;
-    erase_char_length     = INT_MAX;
-    repeat_char_length    = INT_MAX;
-    clr_bol_length        = INT_MAX;
-    clr_eol_length        = INT_MAX;
+    session->cursor_address_length = INT_MAX;
+    session->erase_char_length     = INT_MAX;
+    session->repeat_char_length    = INT_MAX;
+    session->clr_bol_length        = INT_MAX;
+    session->clr_eol_length        = INT_MAX;
   }
 }
 
@@ -1897,30 +2244,246 @@ void FVTerm::finish()
     && FTerm::getFTermData()->isInAlternateScreen() )
     clearTerm();
 
+  // All output must reach the terminal before it is reset
+  if ( session->output_writer )
+    session->output_writer->drain();
+
   forceTerminalUpdate();
 
-  if ( output_buffer )
-    delete output_buffer;
+  if ( session->output_writer )
+  {
+    session->output_writer->drain();
+    FTerm::setOutputWriter (nullptr);
+    delete session->output_writer;
+  }
+
+  if ( session->output_buffer )
+    delete session->output_buffer;
+
+  if ( session->damage_list )
+    delete session->damage_list;
+
+  session->output_buffer = nullptr;
+  session->output_writer = nullptr;
+  session->damage_list = nullptr;
 
   // remove virtual terminal + virtual desktop area
-  removeArea (vdesktop);
-  removeArea (vterm);
+  removeArea (session->vdesktop);
+  removeArea (session->vterm);
+
+  if ( session->term_pos )
+    delete session->term_pos;
+
+  if ( session->fterm )
+    delete session->fterm;
+
+  // Stop the composition threads
+  setCompositionThreads(0);
+
+  // The session can be initialized again
+  session->term_pos = nullptr;
+  session->fterm = nullptr;
+  session->init_object = nullptr;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::putAreaRows ( const FTermArea* area
+                         , int first_line, int last_line )
+{
+  // Adds the changes of the area lines [first_line, last_line)
+  // to the virtual terminal
+
+  int ax = area->offset_left;
+  const int ay = area->offset_top;
+  const int width = area->width + area->right_shadow;
+  int ol{0};  // Outside left
+
+  if ( ax < 0 )
+  {
+    ol = std::abs(ax);
+    ax = 0;
+  }
+
+  for (auto y{first_line}; y < last_line; y++)  // Line loop
+  {
+    auto line_xmin = int(area->changes[y].xmin);
+    auto line_xmax = int(area->changes[y].xmax);
+
+    if ( line_xmin > line_xmax )
+      continue;
+
+    if ( ax == 0 )
+      line_xmin = ol;
+
+    if ( width + ax - ol >= session->vterm->width )
+      line_xmax = session->vterm->width + ol - ax - 1;
+
+    if ( ax + line_xmin >= session->vterm->width )
+      continue;
+
+    // Range of the changed terminal characters
+    int changed_xmin{session->vterm->width};
+    int changed_xmax{-1};
+
+    for (auto x = line_xmin; x <= line_xmax; x++)  // Column loop
+    {
+      // Global terminal positions
+      int tx = ax + x;
+      const int ty = ay + y;
+
+      if ( tx < 0 || ty < 0 )
+        continue;
+
+      tx -= ol;
+
+      if ( updateVTermCharacter(area, FPoint{x, y}, FPoint{tx, ty}) )
+      {
+        changed_xmin = std::min(changed_xmin, tx);
+        changed_xmax = tx;
+      }
+    }
+
+    if ( changed_xmin <= changed_xmax )
+    {
+      auto& line_changes = session->vterm->changes[ay + y];
+
+      if ( changed_xmin < int(line_changes.xmin) )
+        line_changes.xmin = uInt(changed_xmin);
+
+      if ( changed_xmax > int(line_changes.xmax) )
+        line_changes.xmax = uInt(changed_xmax);
+    }
+
+    area->changes[y].xmin = uInt(width);
+    area->changes[y].xmax = 0;
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTerm::restoreVTermRows ( int x, int w
+                              , int first_line, int last_line )
+{
+  // Composes the columns [x, x + w) of the lines
+  // [first_line, last_line) of the virtual terminal
+
+  const auto& window_list = FWidget::getWindowList();
+  std::vector<const FTermArea*> line_windows{};
+  FComposeBuffer buffer{};
+
+  if ( window_list )
+    line_windows.reserve(window_list->size());
+
+  for (auto ypos{first_line}; ypos < last_line; ypos++)
+  {
+    line_windows.clear();
+
+    if ( window_list )
+    {
+      for (auto& win_obj : *window_list)
+      {
+        const auto& win = win_obj->getVWin();
+
+        if ( ! win || ! win->visible )
+          continue;
 
-  if ( term_pos )
-    delete term_pos;
+        const int win_x1 = win->offset_left;
+        const int win_y1 = win->offset_top;
+        const int win_x2 = win_x1 + win->width + win->right_shadow - 1;
+        const int win_y2 = win_y1 + win->height + win->bottom_shadow - 1;
 
-  if ( fterm )
-    delete fterm;
+        if ( ypos >= win_y1 && ypos <= win_y2
+          && win_x1 < x + w && win_x2 >= x )
+          line_windows.push_back(win);
+      }
+    }
+
+    // Terminal and desktop character
+    auto tc = &session->vterm->data[ypos * session->vterm->width + x];
+    auto dc = &session->vdesktop->data[ypos * session->vdesktop->width + x];
+
+    for (auto xpos{x}; xpos < x + w; xpos++)
+    {
+      const FChar* sc = dc;  // shown character
+
+      for (auto&& win : line_windows)
+      {
+        if ( xpos >= win->offset_left
+          && xpos < win->offset_left + win->width + win->right_shadow )
+          sc = composeCharacter (win, xpos, ypos, sc, buffer);
+      }
+
+      std::memcpy (tc, sc, sizeof(*tc));
+      ++tc;
+      ++dc;
+    }
+
+    if ( int(session->vterm->changes[ypos].xmin) > x )
+      session->vterm->changes[ypos].xmin = uInt(x);
+
+    if ( int(session->vterm->changes[ypos].xmax) < x + w - 1 )
+      session->vterm->changes[ypos].xmax = uInt(x + w - 1);
+  }
 
-  init_object = nullptr;
 }
 
 //----------------------------------------------------------------------
-void FVTerm::putAreaLine (const FChar& area_char, FChar& vterm_char, std::size_t length)
+void FVTerm::runRowBands ( int height, int width
+                         , const std::function<void(int, int)>& fn )
 {
-  // copy "length" characters from area to terminal
+  // Calls fn for bands of the lines [0, height). The bands are
+  // processed by the worker pool if parallel composition is enabled
+  // and the composition is large enough. Otherwise the calling
+  // thread processes all lines at once.
+
+  if ( height <= 0 )
+    return;
+
+  auto pool = session->worker_pool;
+
+  if ( ! pool || height < 2 || height * width < MIN_PARALLEL_CELLS )
+  {
+    fn (0, height);
+    return;
+  }
 
-  std::memcpy (&vterm_char, &area_char, sizeof(vterm_char) * length);
+  // Two bands per thread balance uneven line costs
+  const auto rows = std::size_t(height);
+  const auto bands = std::min(rows, 2 * pool->getThreadCount());
+  pool->run ( bands
+            , [rows, bands, &fn] (std::size_t band)
+              {
+                fn ( int(rows * band / bands)
+                   , int(rows * (band + 1) / bands) );
+              } );
+}
+
+//----------------------------------------------------------------------
+bool FVTerm::putAreaLine ( const FChar& area_char, FChar& vterm_char
+                         , std::size_t length
+                         , std::size_t& first, std::size_t& last )
+{
+  // Copies "length" characters from area to terminal and returns
+  // the range [first, last] of the changed characters
+
+  const FChar* ac = &area_char;
+  FChar* tc = &vterm_char;
+  bool changed{false};
+
+  for (std::size_t i{0}; i < length; i++)
+  {
+    internal::setVTermCharacter (ac[i], tc[i]);
+
+    if ( tc[i].attr.bit.no_changes )
+      continue;
+
+    if ( ! changed )
+      first = i;
+
+    last = i;
+    changed = true;
+  }
+
+  return changed;
 }
 
 //----------------------------------------------------------------------
@@ -1970,7 +2533,7 @@ void FVTerm::putAreaCharacter ( const FPoint& pos, const FTermArea* area
 
 //----------------------------------------------------------------------
 void FVTerm::getAreaCharacter ( const FPoint& pos, const FTermArea* area
-                              , FChar*& cc )
+                              , FChar*& cc, FComposeBuffer& buffer )
 {
   const int area_x = area->offset_left;
   const int area_y = area->offset_top;
@@ -1985,19 +2548,19 @@ void FVTerm::getAreaCharacter ( const FPoint& pos, const FTermArea* area
     if ( tmp.attr.bit.color_overlay )  // transparent shadow
     {
       // Keep the current vterm character
-      std::memcpy (&s_ch, cc, sizeof(s_ch));
-      s_ch.fg_color = tmp.fg_color;
-      s_ch.bg_color = tmp.bg_color;
-      s_ch.attr.bit.reverse  = false;
-      s_ch.attr.bit.standout = false;
-      cc = &s_ch;
+      std::memcpy (&buffer.s_ch, cc, sizeof(buffer.s_ch));
+      buffer.s_ch.fg_color = tmp.fg_color;
+      buffer.s_ch.bg_color = tmp.bg_color;
+      buffer.s_ch.attr.bit.reverse  = false;
+      buffer.s_ch.attr.bit.standout = false;
+      cc = &buffer.s_ch;
     }
     else if ( tmp.attr.bit.inherit_background )
     {
       // Add the covered background to this character
-      std::memcpy (&i_ch, &tmp, sizeof(i_ch));
-      i_ch.bg_color = cc->bg_color;  // last background color
-      cc = &i_ch;
+      std::memcpy (&buffer.i_ch, &tmp, sizeof(buffer.i_ch));
+      buffer.i_ch.bg_color = cc->bg_color;  // last background color
+      cc = &buffer.i_ch;
     }
     else  // default
       cc = &tmp;
@@ -2013,8 +2576,8 @@ bool FVTerm::clearTerm (int fillchar) const
   const auto& cd = TCAP(fc::t_clr_eos);
   const auto& cb = TCAP(fc::t_clr_eol);
   const bool ut = FTermcap::background_color_erase;
-  const bool normal = FTerm::isNormal (next_attribute);
-  appendAttributes (next_attribute);
+  const bool normal = FTerm::isNormal (session->next_attribute);
+  appendAttributes (session->next_attribute);
 
   if ( ! ( (cl || cd || cb) && (normal || ut) )
     || fillchar != ' ' )
@@ -2025,17 +2588,17 @@ bool FVTerm::clearTerm (int fillchar) const
   if ( cl )  // Clear screen
   {
     appendOutputBuffer (cl);
-    term_pos->setPoint(0, 0);
+    session->term_pos->setPoint(0, 0);
   }
   else if ( cd )  // Clear to end of screen
   {
     setTermXY (0, 0);
     appendOutputBuffer (cd);
-    term_pos->setPoint(-1, -1);
+    session->term_pos->setPoint(-1, -1);
   }
   else if ( cb )  // Clear to end of line
   {
-    term_pos->setPoint(-1, -1);
+    session->term_pos->setPoint(-1, -1);
 
     for (auto i{0}; i < int(FTerm::getLineNumber()); i++)
     {
@@ -2057,25 +2620,25 @@ bool FVTerm::clearFullArea (const FTermArea* area, FChar& nc) const
   const int area_size = area->width * area->height;
   std::fill_n (area->data, area_size, nc);
 
-  if ( area != vdesktop )  // Is the area identical to the desktop?
+  if ( area != session->vdesktop )  // Is the area identical to the desktop?
     return false;
 
   // Try to clear the terminal rapidly with a control sequence
   if ( clearTerm (nc.ch[0]) )
   {
     nc.attr.bit.printed = true;
-    std::fill_n (vterm->data, area_size, nc);
+    std::fill_n (session->vterm->data, area_size, nc);
   }
   else
   {
-    for (auto i{0}; i < vdesktop->height; i++)
+    for (auto i{0}; i < session->vdesktop->height; i++)
     {
-      vdesktop->changes[i].xmin = 0;
-      vdesktop->changes[i].xmax = uInt(vdesktop->width) - 1;
-      vdesktop->changes[i].trans_count = 0;
+      session->vdesktop->changes[i].xmin = 0;
+      session->vdesktop->changes[i].xmax = uInt(session->vdesktop->width) - 1;
+      session->vdesktop->changes[i].trans_count = 0;
     }
 
-    vdesktop->has_changes = true;
+    session->vdesktop->has_changes = true;
   }
 
   return true;
@@ -2111,7 +2674,7 @@ bool FVTerm::canClearToEOL (uInt xmin, uInt y)
   // Is the line from xmin to the end of the line blank?
   // => clear to end of line
 
-  auto& vt = vterm;
+  auto& vt = session->vterm;
   const auto& ce = TCAP(fc::t_clr_eol);
   const auto& min_char = vt->data[y * uInt(vt->width) + xmin];
 
@@ -2133,7 +2696,7 @@ bool FVTerm::canClearToEOL (uInt xmin, uInt y)
 
     if ( beginning_whitespace == uInt(vt->width) - xmin
       && (ut || normal)
-      && clr_eol_length < beginning_whitespace )
+      && session->clr_eol_length < beginning_whitespace )
       return true;
   }
 
@@ -2146,7 +2709,7 @@ bool FVTerm::canClearLeadingWS (uInt& xmin, uInt y)
   // Line has leading whitespace
   // => clear from xmin to beginning of line
 
-  auto& vt = vterm;
+  auto& vt = session->vterm;
   const auto& cb = TCAP(fc::t_clr_bol);
   const auto& first_char = vt->data[y * uInt(vt->width)];
 
@@ -2168,7 +2731,7 @@ bool FVTerm::canClearLeadingWS (uInt& xmin, uInt y)
 
     if ( leading_whitespace > xmin
       && (ut || normal)
-      && clr_bol_length < leading_whitespace )
+      && session->clr_bol_length < leading_whitespace )
     {
       xmin = leading_whitespace - 1;
       return true;
@@ -2184,7 +2747,7 @@ bool FVTerm::canClearTrailingWS (uInt& xmax, uInt y)
   // Line has trailing whitespace
   // => clear from xmax to end of line
 
-  auto& vt = vterm;
+  auto& vt = session->vterm;
   const auto& ce = TCAP(fc::t_clr_eol);
   const auto& last_char = vt->data[(y + 1) * uInt(vt->width) - 1];
 
@@ -2206,7 +2769,7 @@ bool FVTerm::canClearTrailingWS (uInt& xmax, uInt y)
 
     if ( trailing_whitespace > uInt(vt->width) - xmax
       && (ut || normal)
-      && clr_bol_length < trailing_whitespace )
+      && session->clr_bol_length < trailing_whitespace )
     {
       xmax = uInt(vt->width) - trailing_whitespace;
       return true;
@@ -2217,11 +2780,59 @@ bool FVTerm::canClearTrailingWS (uInt& xmax, uInt y)
 }
 
 //----------------------------------------------------------------------
-bool FVTerm::skipUnchangedCharacters (uInt& x, uInt xmax, uInt y) const
+inline FVTerm::FTermOutput FVTerm::getSessionOutput()
+{
+  // Returns the output state of the current session
+
+  FTermOutput output{};
+  output.buffer = session->output_buffer;
+  output.term_pos = session->term_pos;
+  output.term_attribute = &session->term_attribute;
+  return output;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::setTermXY (FTermOutput& output, int x, int y) const
+{
+  // Appends the movement of the hardware cursor to (x,y)
+
+  if ( output.term_pos->getX() == x && output.term_pos->getY() == y )
+    return;
+
+  const auto term_width = int(FTerm::getColumnNumber());
+  const auto term_height = int(FTerm::getLineNumber());
+
+  if ( x >= term_width && term_width > 0 )
+  {
+    y += x / term_width;
+    x %= term_width;
+  }
+
+  if ( output.term_pos->getY() >= term_height )
+    output.term_pos->setY(term_height - 1);
+
+  if ( y >= term_height )
+    y = term_height - 1;
+
+  const int term_x = output.term_pos->getX();
+  const int term_y = output.term_pos->getY();
+  const char* move_str = ( output.opti_move )
+      ? output.opti_move->moveCursor (term_x, term_y, x, y)
+      : FTerm::moveCursorString (term_x, term_y, x, y);
+
+  if ( move_str )
+    appendOutputBuffer (output, move_str);
+
+  output.term_pos->setPoint(x, y);
+}
+
+//----------------------------------------------------------------------
+bool FVTerm::skipUnchangedCharacters ( FTermOutput& output
+                                      , uInt& x, uInt xmax, uInt y ) const
 {
   // Skip characters without changes if it is faster than redrawing
 
-  auto& vt = vterm;
+  auto& vt = session->vterm;
   auto& print_char = vt->data[y * uInt(vt->width) + x];
   print_char.attr.bit.printed = true;
 
@@ -2239,9 +2850,9 @@ bool FVTerm::skipUnchangedCharacters (uInt& x, uInt xmax, uInt y) const
         break;
     }
 
-    if ( count > cursor_address_length )
+    if ( count > session->cursor_address_length )
     {
-      setTermXY (int(x + count), int(y));
+      setTermXY (output, int(x + count), int(y));
       x = x + count - 1;
       return true;
     }
@@ -2251,12 +2862,12 @@ bool FVTerm::skipUnchangedCharacters (uInt& x, uInt xmax, uInt y) const
 }
 
 //----------------------------------------------------------------------
-void FVTerm::printRange ( uInt xmin, uInt xmax, uInt y
+void FVTerm::printRange ( FTermOutput& output, uInt xmin, uInt xmax, uInt y
                         , bool draw_trailing_ws ) const
 {
   for (uInt x = xmin; x <= xmax; x++)
   {
-    auto& vt = vterm;
+    auto& vt = session->vterm;
     const auto& ec = TCAP(fc::t_erase_chars);
     const auto& rp = TCAP(fc::t_repeat_char);
     auto& print_char = vt->data[y * uInt(vt->width) + x];
@@ -2264,26 +2875,26 @@ void FVTerm::printRange ( uInt xmin, uInt xmax, uInt y
     replaceNonPrintableFullwidth (x, print_char);
 
     // skip character with no changes
-    if ( skipUnchangedCharacters(x, xmax, y) )
+    if ( skipUnchangedCharacters (output, x, xmax, y) )
       continue;
 
     // Erase character
     if ( ec && print_char.ch[0] == ' ' )
     {
       exit_state erase_state = \
-          eraseCharacters(x, xmax, y, draw_trailing_ws);
+          eraseCharacters (output, x, xmax, y, draw_trailing_ws);
 
       if ( erase_state == line_completely_printed )
         break;
     }
     else if ( rp )  // Repeat one character n-fold
     {
-      repeatCharacter(x, xmax, y);
+      repeatCharacter (output, x, xmax, y);
     }
     else  // General character output
     {
       bool min_and_not_max( x == xmin && xmin != xmax );
-      printCharacter (x, y, min_and_not_max, print_char);
+      printCharacter (output, x, y, min_and_not_max, print_char);
     }
   }
 }
@@ -2301,7 +2912,7 @@ inline void FVTerm::replaceNonPrintableFullwidth ( uInt x
     print_char.ch[1] = L'\0';
     print_char.attr.bit.fullwidth_padding = false;
   }
-  else if ( x == uInt(vterm->width - 1)
+  else if ( x == uInt(session->vterm->width - 1)
          && isFullWidthChar(print_char) )
   {
     print_char.ch[0] = fc::SingleRightAngleQuotationMark;  // ›
@@ -2311,37 +2922,38 @@ inline void FVTerm::replaceNonPrintableFullwidth ( uInt x
 }
 
 //----------------------------------------------------------------------
-void FVTerm::printCharacter ( uInt& x, uInt y, bool min_and_not_max
+void FVTerm::printCharacter ( FTermOutput& output
+                            , uInt& x, uInt y, bool min_and_not_max
                             , FChar& print_char) const
 {
   // General character output on terminal
 
-  if ( x < uInt(vterm->width - 1) && isFullWidthChar(print_char) )
+  if ( x < uInt(session->vterm->width - 1) && isFullWidthChar(print_char) )
   {
-    printFullWidthCharacter (x, y, print_char);
+    printFullWidthCharacter (output, x, y, print_char);
   }
-  else if ( x > 0 && x < uInt(vterm->width - 1)
+  else if ( x > 0 && x < uInt(session->vterm->width - 1)
          && isFullWidthPaddingChar(print_char)  )
   {
-    printFullWidthPaddingCharacter (x, y, print_char);
+    printFullWidthPaddingCharacter (output, x, y, print_char);
   }
   else if ( x > 0 && min_and_not_max )
   {
-    printHalfCovertFullWidthCharacter (x, y, print_char);
+    printHalfCovertFullWidthCharacter (output, x, y, print_char);
   }
   else
   {
     // Print a half-width character
-    appendCharacter (print_char);
+    appendCharacter (output, print_char);
     markAsPrinted (x, y);
   }
 }
 
 //----------------------------------------------------------------------
-void FVTerm::printFullWidthCharacter ( uInt& x, uInt y
+void FVTerm::printFullWidthCharacter ( FTermOutput& output, uInt& x, uInt y
                                      , FChar& print_char ) const
 {
-  const auto vt = vterm;
+  const auto vt = session->vterm;
   auto& next_char = vt->data[y * uInt(vt->width) + x + 1];
 
   if ( print_char.attr.byte[0] == next_char.attr.byte[0]
@@ -2352,35 +2964,36 @@ void FVTerm::printFullWidthCharacter ( uInt& x, uInt y
     && isFullWidthPaddingChar(next_char) )
   {
     // Print a full-width character
-    appendCharacter (print_char);
+    appendCharacter (output, print_char);
     markAsPrinted (x, y);
-    skipPaddingCharacter (x, y, print_char);
+    skipPaddingCharacter (output, x, y, print_char);
   }
   else
   {
     // Print ellipses for the 1st full-width character column
-    appendAttributes (print_char);
-    appendOutputBuffer (fc::HorizontalEllipsis);
-    term_pos->x_ref()++;
+    appendAttributes (output, print_char);
+    appendOutputBuffer (output, fc::HorizontalEllipsis);
+    output.term_pos->x_ref()++;
     markAsPrinted (x, y);
 
     if ( isFullWidthPaddingChar(next_char) )
     {
       // Print ellipses for the 2nd full-width character column
       x++;
-      appendAttributes (next_char);
-      appendOutputBuffer (fc::HorizontalEllipsis);
-      term_pos->x_ref()++;
+      appendAttributes (output, next_char);
+      appendOutputBuffer (output, fc::HorizontalEllipsis);
+      output.term_pos->x_ref()++;
       markAsPrinted (x, y);
     }
   }
 }
 
 //----------------------------------------------------------------------
-void FVTerm::printFullWidthPaddingCharacter ( uInt& x, uInt y
+void FVTerm::printFullWidthPaddingCharacter ( FTermOutput& output
+                                            , uInt& x, uInt y
                                             , FChar& print_char) const
 {
-  const auto vt = vterm;
+  const auto vt = session->vterm;
   auto& prev_char = vt->data[y * uInt(vt->width) + x - 1];
 
   if ( print_char.attr.byte[0] == prev_char.attr.byte[0]
@@ -2395,37 +3008,38 @@ void FVTerm::printFullWidthPaddingCharacter ( uInt& x, uInt y
     const auto& LE = TCAP(fc::t_parm_left_cursor);
 
     if ( le )
-      appendOutputBuffer (le);
+      appendOutputBuffer (output, le);
     else if ( LE )
-      appendOutputBuffer (FTermcap::encodeParameter(LE, 1, 0, 0, 0, 0, 0, 0, 0, 0));
+      appendOutputBuffer (output, FTermcap::encodeParameter(LE, 1, 0, 0, 0, 0, 0, 0, 0, 0));
     else
     {
-      skipPaddingCharacter (x, y, prev_char);
+      skipPaddingCharacter (output, x, y, prev_char);
       return;
     }
 
     // Print a full-width character
     x--;
-    term_pos->x_ref()--;
-    appendCharacter (prev_char);
+    output.term_pos->x_ref()--;
+    appendCharacter (output, prev_char);
     markAsPrinted (x, y);
-    skipPaddingCharacter (x, y, prev_char);
+    skipPaddingCharacter (output, x, y, prev_char);
   }
   else
   {
     // Print ellipses for the 1st full-width character column
-    appendAttributes (print_char);
-    appendOutputBuffer (fc::HorizontalEllipsis);
-    term_pos->x_ref()++;
+    appendAttributes (output, print_char);
+    appendOutputBuffer (output, fc::HorizontalEllipsis);
+    output.term_pos->x_ref()++;
     markAsPrinted (x, y);
   }
 }
 
 //----------------------------------------------------------------------
-void FVTerm::printHalfCovertFullWidthCharacter ( uInt& x, uInt y
+void FVTerm::printHalfCovertFullWidthCharacter ( FTermOutput& output
+                                               , uInt& x, uInt y
                                                , FChar& print_char ) const
 {
-  const auto vt = vterm;
+  const auto vt = session->vterm;
   auto& prev_char = vt->data[y * uInt(vt->width) + x - 1];
 
   if ( isFullWidthChar(prev_char) && ! isFullWidthPaddingChar(print_char) )
@@ -2435,47 +3049,49 @@ void FVTerm::printHalfCovertFullWidthCharacter ( uInt& x, uInt y
     const auto& LE = TCAP(fc::t_parm_left_cursor);
 
     if ( le )
-      appendOutputBuffer (le);
+      appendOutputBuffer (output, le);
     else if ( LE )
-      appendOutputBuffer (FTermcap::encodeParameter(LE, 1, 0, 0, 0, 0, 0, 0, 0, 0));
+      appendOutputBuffer (output, FTermcap::encodeParameter(LE, 1, 0, 0, 0, 0, 0, 0, 0, 0));
 
     if ( le || LE )
     {
       // Print ellipses for the 1st full-width character column
       x--;
-      term_pos->x_ref()--;
-      appendAttributes (prev_char);
-      appendOutputBuffer (fc::HorizontalEllipsis);
-      term_pos->x_ref()++;
+      output.term_pos->x_ref()--;
+      appendAttributes (output, prev_char);
+      appendOutputBuffer (output, fc::HorizontalEllipsis);
+      output.term_pos->x_ref()++;
       markAsPrinted (x, y);
       x++;
     }
   }
 
   // Print a half-width character
-  appendCharacter (print_char);
+  appendCharacter (output, print_char);
   markAsPrinted (x, y);
 }
 
 //----------------------------------------------------------------------
-inline void FVTerm::skipPaddingCharacter ( uInt& x, uInt y
+inline void FVTerm::skipPaddingCharacter ( FTermOutput& output
+                                         , uInt& x, uInt y
                                          , const FChar& print_char ) const
 {
   if ( isFullWidthChar(print_char) )  // full-width character
   {
     x++;  // Skip the following padding character
-    term_pos->x_ref()++;
+    output.term_pos->x_ref()++;
     markAsPrinted (x, y);
   }
 }
 
 //----------------------------------------------------------------------
-FVTerm::exit_state FVTerm::eraseCharacters ( uInt& x, uInt xmax, uInt y
+FVTerm::exit_state FVTerm::eraseCharacters ( FTermOutput& output
+                                           , uInt& x, uInt xmax, uInt y
                                            , bool draw_trailing_ws ) const
 {
   // Erase a number of characters to draw simple whitespaces
 
-  const auto& vt = vterm;
+  const auto& vt = session->vterm;
   const auto& ec = TCAP(fc::t_erase_chars);
   auto& print_char = vt->data[y * uInt(vt->width) + x];
 
@@ -2497,7 +3113,7 @@ FVTerm::exit_state FVTerm::eraseCharacters ( uInt& x, uInt xmax, uInt y
 
   if ( whitespace == 1 )
   {
-    appendCharacter (print_char);
+    appendCharacter (output, print_char);
     markAsPrinted (x, y);
   }
   else
@@ -2505,14 +3121,15 @@ FVTerm::exit_state FVTerm::eraseCharacters ( uInt& x, uInt xmax, uInt y
     const uInt start_pos = x;
     const bool& ut = FTermcap::background_color_erase;
 
-    if ( whitespace > erase_char_length + cursor_address_length
+    if ( whitespace > session->erase_char_length
+                    + session->cursor_address_length
       && (ut || normal) )
     {
-      appendAttributes (print_char);
-      appendOutputBuffer (FTermcap::encodeParameter(ec, whitespace, 0, 0, 0, 0, 0, 0, 0, 0));
+      appendAttributes (output, print_char);
+      appendOutputBuffer (output, FTermcap::encodeParameter(ec, whitespace, 0, 0, 0, 0, 0, 0, 0, 0));
 
       if ( x + whitespace - 1 < xmax || draw_trailing_ws )
-        setTermXY (int(x + whitespace), int(y));
+        setTermXY (output, int(x + whitespace), int(y));
       else
         return line_completely_printed;
 
@@ -2524,7 +3141,7 @@ FVTerm::exit_state FVTerm::eraseCharacters ( uInt& x, uInt xmax, uInt y
 
       for (uInt i{0}; i < whitespace; i++)
       {
-        appendCharacter (print_char);
+        appendCharacter (output, print_char);
         x++;
       }
     }
@@ -2536,11 +3153,12 @@ FVTerm::exit_state FVTerm::eraseCharacters ( uInt& x, uInt xmax, uInt y
 }
 
 //----------------------------------------------------------------------
-FVTerm::exit_state FVTerm::repeatCharacter (uInt& x, uInt xmax, uInt y) const
+FVTerm::exit_state FVTerm::repeatCharacter ( FTermOutput& output
+                                           , uInt& x, uInt xmax, uInt y ) const
 {
   // Repeat one character n-fold
 
-  const auto& vt = vterm;
+  const auto& vt = session->vterm;
   const auto& rp = TCAP(fc::t_repeat_char);
   auto& print_char = vt->data[y * uInt(vt->width) + x];
 
@@ -2561,21 +3179,21 @@ FVTerm::exit_state FVTerm::repeatCharacter (uInt& x, uInt xmax, uInt y) const
 
   if ( repetitions == 1 )
   {
-    appendCharacter (print_char);
+    appendCharacter (output, print_char);
     markAsPrinted (x, y);
   }
   else
   {
     const uInt start_pos = x;
 
-    if ( repetitions > repeat_char_length
+    if ( repetitions > session->repeat_char_length
       && print_char.ch[0] < 128 )
     {
       newFontChanges (print_char);
       charsetChanges (print_char);
-      appendAttributes (print_char);
-      appendOutputBuffer (FTermcap::encodeParameter(rp, print_char.ch[0], repetitions, 0, 0, 0, 0, 0, 0, 0));
-      term_pos->x_ref() += int(repetitions);
+      appendAttributes (output, print_char);
+      appendOutputBuffer (output, FTermcap::encodeParameter(rp, print_char.ch[0], repetitions, 0, 0, 0, 0, 0, 0, 0));
+      output.term_pos->x_ref() += int(repetitions);
       x = x + repetitions - 1;
     }
     else
@@ -2584,7 +3202,7 @@ FVTerm::exit_state FVTerm::repeatCharacter (uInt& x, uInt xmax, uInt y) const
 
       for (uInt i{0}; i < repetitions; i++)
       {
-        appendCharacter (print_char);
+        appendCharacter (output, print_char);
         x++;
       }
     }
@@ -2608,28 +3226,28 @@ inline bool FVTerm::isFullWidthPaddingChar (const FChar& ch) const
 }
 
 //----------------------------------------------------------------------
-void FVTerm::cursorWrap()
+void FVTerm::cursorWrap (FTermOutput& output)
 {
   // Wrap the cursor
-  const auto& vt = vterm;
+  const auto& vt = session->vterm;
 
-  if ( term_pos->getX() >= vt->width )
+  if ( output.term_pos->getX() >= vt->width )
   {
-    if ( term_pos->getY() == vt->height - 1 )
-      term_pos->x_ref()--;
+    if ( output.term_pos->getY() == vt->height - 1 )
+      output.term_pos->x_ref()--;
     else
     {
       if ( FTermcap::eat_nl_glitch )
       {
-        term_pos->setPoint(-1, -1);
+        output.term_pos->setPoint(-1, -1);
       }
       else if ( FTermcap::automatic_right_margin )
       {
-        term_pos->setX(0);
-        term_pos->y_ref()++;
+        output.term_pos->setX(0);
+        output.term_pos->y_ref()++;
       }
       else
-        term_pos->x_ref()--;
+        output.term_pos->x_ref()--;
     }
   }
 }
@@ -2677,21 +3295,7 @@ inline void FVTerm::printCharacterOnCoordinate ( FTermArea* area
 
   if ( ac != ch )  // compare with an overloaded operator
   {
-    if ( ( ! ac.attr.bit.transparent && ch.attr.bit.transparent )
-      || ( ! ac.attr.bit.color_overlay && ch.attr.bit.color_overlay )
-      || ( ! ac.attr.bit.inherit_background && ch.attr.bit.inherit_background ) )
-    {
-      // add one transparent character form line
-      area->changes[ay].trans_count++;
-    }
-
-    if ( ( ac.attr.bit.transparent && ! ch.attr.bit.transparent )
-      || ( ac.attr.bit.color_overlay && ! ch.attr.bit.color_overlay )
-      || ( ac.attr.bit.inherit_background && ! ch.attr.bit.inherit_background ) )
-    {
-      // remove one transparent character from line
-      area->changes[ay].trans_count--;
-    }
+    updateTransparentCount (area->changes[ay], ac, ch);
 
     // copy character to area
     std::memcpy (&ac, &ch, sizeof(ac));
@@ -2704,6 +3308,76 @@ inline void FVTerm::printCharacterOnCoordinate ( FTermArea* area
   }
 }
 
+//----------------------------------------------------------------------
+bool FVTerm::joinPreviousCluster ( FTermArea* area
+                                 , const FChar& term_char ) const
+{
+  // Adds a single code point to the grapheme cluster of the previous
+  // character cell if it continues the cluster without changing
+  // its column width (e.g. combining marks or joined emoji)
+
+  const wchar_t wchar = term_char.ch[0];
+
+  if ( term_char.ch[1] != L'\0'
+    || term_char.attr.bit.fullwidth_padding
+    || FTerm::getEncoding() != fc::UTF8
+    || area->cursor_x <= 1
+    || area->cursor_y <= 0
+    || area->cursor_y > area->height + area->bottom_shadow )
+    return false;
+
+  const auto prop = FGrapheme::getBreakProperty(wchar);
+
+  if ( prop != FGrapheme::Extend
+    && prop != FGrapheme::ZWJ
+    && prop != FGrapheme::SpacingMark
+    && ! FGrapheme::isExtendedPictographic(wchar) )
+    return false;
+
+  const int line_len = area->width + area->right_shadow;
+  int ax = area->cursor_x - 2;
+  const int ay = area->cursor_y - 1;
+
+  if ( ax >= line_len )
+    return false;
+
+  auto* ac = &area->data[ay * line_len + ax];  // area character
+
+  if ( ac->attr.bit.fullwidth_padding && ax > 0 )
+  {
+    ax--;
+    ac--;
+  }
+
+  auto& ch = ac->ch;
+  const auto end = std::find(ch.begin(), ch.end(), L'\0');
+
+  if ( end == ch.begin() || end == ch.end() )
+    return false;  // Empty or full character cell
+
+  const auto length = std::size_t(std::distance(ch.begin(), end));
+  std::array<wchar_t, UNICODE_MAX> cluster{};
+  std::copy (ch.begin(), end, cluster.begin());
+  cluster[length] = wchar;
+  std::size_t width{0};
+
+  if ( FGrapheme::nextCluster(cluster.data(), length + 1, width) <= length
+    || width != ac->attr.bit.char_width )
+    return false;
+
+  *end = wchar;
+  ac->attr.bit.no_changes = false;
+  area->has_changes = true;
+
+  if ( ax < int(area->changes[ay].xmin) )
+    area->changes[ay].xmin = uInt(ax);
+
+  if ( ax > int(area->changes[ay].xmax) )
+    area->changes[ay].xmax = uInt(ax);
+
+  return true;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::printPaddingCharacter (FTermArea* area, const FChar& term_char)
 {
@@ -2734,12 +3408,12 @@ void FVTerm::printPaddingCharacter (FTermArea* area, const FChar& term_char)
 }
 
 //----------------------------------------------------------------------
-bool FVTerm::updateTerminalLine (uInt y) const
+bool FVTerm::updateTerminalLine (FTermOutput& output, uInt y) const
 {
   // Updates pending changes from line y to the terminal
 
   bool ret{false};
-  const auto& vt = vterm;
+  const auto& vt = session->vterm;
   uInt& xmin = vt->changes[y].xmin;
   uInt& xmax = vt->changes[y].xmax;
 
@@ -2762,13 +3436,13 @@ bool FVTerm::updateTerminalLine (uInt y) const
       draw_trailing_ws = canClearTrailingWS (xmax, y);
     }
 
-    setTermXY (int(xmin), int(y));
+    setTermXY (output, int(xmin), int(y));
 
     if ( is_eol_clean )
     {
       auto& min_char = vt->data[y * uInt(vt->width) + xmin];
-      appendAttributes (min_char);
-      appendOutputBuffer (ce);
+      appendAttributes (output, min_char);
+      appendOutputBuffer (output, ce);
       markAsPrinted (xmin, uInt(vt->width - 1), y);
     }
     else
@@ -2777,18 +3451,18 @@ bool FVTerm::updateTerminalLine (uInt y) const
       {
         const auto& cb = TCAP(fc::t_clr_bol);
         auto& first_char = vt->data[y * uInt(vt->width)];
-        appendAttributes (first_char);
-        appendOutputBuffer (cb);
+        appendAttributes (output, first_char);
+        appendOutputBuffer (output, cb);
         markAsPrinted (0, xmin, y);
       }
 
-      printRange (xmin, xmax, y, draw_trailing_ws);
+      printRange (output, xmin, xmax, y, draw_trailing_ws);
 
       if ( draw_trailing_ws )
       {
         auto& last_char = vt->data[(y + 1) * uInt(vt->width) - 1];
-        appendAttributes (last_char);
-        appendOutputBuffer (ce);
+        appendAttributes (output, last_char);
+        appendOutputBuffer (output, ce);
         markAsPrinted (xmax + 1, uInt(vt->width - 1), y);
       }
     }
@@ -2798,18 +3472,130 @@ bool FVTerm::updateTerminalLine (uInt y) const
     xmax = 0;
   }
 
-  cursorWrap();
+  cursorWrap (output);
   return ret;
 }
 
+//----------------------------------------------------------------------
+bool FVTerm::updateTerminalBands (std::size_t& changedlines) const
+{
+  // Encodes large terminal updates in row bands, which are processed
+  // by the worker pool. Each band has its own output buffer, cursor
+  // position, attributes and optimizers. A band (except the first)
+  // starts at an unknown cursor position with reset attributes, so
+  // that its first change begins with a cursor address. The bands
+  // are then joined in line order, with the attribute reset in front
+  // of each band. The band optimizers are copies that share the
+  // color lookup table of FOptiAttr read-only. Returns false if no
+  // bands were used.
+
+  auto pool = session->worker_pool;
+  const auto& vt = session->vterm;
+
+  // The instrumentation counters are not synchronized between threads
+  if ( ! pool || vt->height < 2 || FInstrumentation::isEnabled() )
+    return false;
+
+  int changed_cells{0};
+
+  for (auto y{0}; y < vt->height; y++)
+  {
+    const auto& line = vt->changes[y];
+
+    if ( line.xmin <= line.xmax )
+      changed_cells += int(line.xmax - line.xmin + 1);
+  }
+
+  if ( changed_cells < MIN_PARALLEL_CELLS )
+    return false;
+
+  FChar reset_attribute{};
+  reset_attribute.fg_color = fc::Default;
+  reset_attribute.bg_color = fc::Default;
+  auto& opti_attr = *FTerm::getFOptiAttr();
+  const auto& opti_move = *FTerm::getFOptiMove();
+
+  // Builds the color table before it is shared with the bands
+  if ( ! opti_attr.hasTrueColorSupport() )
+    opti_attr.initColorTable();
+
+  const bool cursor_optimisation = \
+      FTerm::getFTermData()->hasCursorOptimisation();
+  const auto rows = std::size_t(vt->height);
+  const auto count = std::min(rows, 2 * pool->getThreadCount());
+  std::vector<internal::TerminalBand> bands{};
+  bands.reserve(count);
+
+  for (std::size_t band{0}; band < count; band++)
+  {
+    bands.emplace_back (opti_attr, opti_move);
+    auto& term_band = bands.back();
+
+    if ( band == 0 )
+    {
+      term_band.term_pos = *session->term_pos;
+      term_band.term_attribute = session->term_attribute;
+    }
+    else
+      term_band.term_attribute = reset_attribute;
+  }
+
+  std::vector<std::size_t> changed_band_lines(count, 0);
+  pool->run ( count
+            , [this, rows, count, cursor_optimisation
+              , &bands, &changed_band_lines] (std::size_t band)
+              {
+                auto& term_band = bands[band];
+                FTermOutput output{};
+                output.buffer = &term_band.buffer;
+                output.term_pos = &term_band.term_pos;
+                output.term_attribute = &term_band.term_attribute;
+                output.opti_attr = &term_band.opti_attr;
+                output.opti_move = ( cursor_optimisation )
+                                 ? &term_band.opti_move : nullptr;
+                output.flushable = false;
+                const auto y_end = uInt(rows * (band + 1) / count);
+
+                for (auto y = uInt(rows * band / count); y < y_end; y++)
+                {
+                  if ( updateTerminalLine(output, y) )
+                    changed_band_lines[band]++;
+                }
+              } );
+
+  // Joins the bands in line order
+  for (std::size_t band{0}; band < count; band++)
+  {
+    auto& term_band = bands[band];
+    changedlines += changed_band_lines[band];
+
+    if ( band > 0 && term_band.buffer.empty() )
+      continue;
+
+    if ( band > 0 )
+    {
+      FChar band_attribute{reset_attribute};
+      appendAttributes (band_attribute);
+    }
+
+    for (auto&& ch : term_band.buffer)
+      appendOutputBuffer (ch);
+
+    *session->term_pos = term_band.term_pos;
+    session->term_attribute = term_band.term_attribute;
+  }
+
+  return true;
+}
+
 //----------------------------------------------------------------------
 bool FVTerm::updateTerminalCursor() const
 {
   // Updates the input cursor visibility and the position
-  if ( vterm && vterm->input_cursor_visible )
+  if ( session->vterm && session->vterm->input_cursor_visible )
   {
-    const int x = vterm->input_cursor_x;
-    const int y = vterm->input_cursor_y;
+    const int x = session->vterm->input_cursor_x;
+    const int y = session->vterm->input_cursor_y;
 
     if ( isInsideTerminal(FPoint{x, y}) )
     {
@@ -2843,7 +3629,7 @@ inline bool FVTerm::isTermSizeChanged() const
   if ( ! isTermSizeCheckTimeout() )
     return false;
 
-  FObject::getCurrentTime (&last_term_size_check);
+  FObject::getCurrentTime (&session->last_term_size_check);
 
   const auto& data = FTerm::getFTermData();
 
@@ -2864,13 +3650,29 @@ inline bool FVTerm::isTermSizeChanged() const
 //----------------------------------------------------------------------
 inline bool FVTerm::isFlushTimeout()
 {
-  return FObject::isTimeout (&time_last_flush, flush_wait);
+  return FObject::isTimeout (&session->time_last_flush, session->flush_wait);
+}
+
+//----------------------------------------------------------------------
+inline bool FVTerm::isBackgroundFrameTimeout()
+{
+  return FObject::isTimeout ( &session->time_last_background_frame
+                            , session->background_frame_wait );
 }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isTermSizeCheckTimeout()
 {
-  return FObject::isTimeout (&last_term_size_check, term_size_check_timeout);
+  return FObject::isTimeout ( &session->last_term_size_check
+                            , session->term_size_check_timeout );
+}
+
+//----------------------------------------------------------------------
+inline bool FVTerm::isOutputCongested()
+{
+  // The terminal has not yet taken all output of the last frame
+  return session->output_writer
+      && session->output_writer->hasPendingOutput();
 }
 
 //----------------------------------------------------------------------
@@ -2879,12 +3681,69 @@ inline bool FVTerm::hasPendingUpdates (const FTermArea* area)
   return ( area && area->has_changes ) ? true : false;
 }
 
+//----------------------------------------------------------------------
+std::size_t FVTerm::writeOutputBuffer (const FTerm::defaultPutChar& put_char)
+{
+  // Writes the output buffer to the terminal and returns
+  // the number of bytes
+
+  const auto& writer = session->output_writer;
+  const auto func = put_char.target<int(*)(int)>();
+  const bool utf8 = func && *func == &FTerm::putchar_UTF8;
+  const bool ascii = func && *func == &FTerm::putchar_ASCII;
+  std::size_t bytes{0};
+
+  if ( ! writer || ! (utf8 || ascii) )
+  {
+    // A user-defined output function writes blocking via stdio
+    for (auto&& ch : *session->output_buffer)
+      bytes += std::size_t(std::max(put_char(ch), 0));
+
+    std::fflush(stdout);
+    return bytes;
+  }
+
+  const auto recorder = FTerm::getFTermRecorder();
+  const std::size_t pending = writer->getPendingSize();
+  std::array<char, 4> buf{};
+
+  for (auto&& ch : *session->output_buffer)
+  {
+    std::size_t len{1};
+
+    if ( utf8 && ch >= 0x80 )  // Multi-byte sequence
+    {
+      const auto wc = wchar_t(ch);
+      len = encodeUTF8 (&wc, 1, buf.data());
+    }
+    else
+      buf[0] = char(ch);
+
+    writer->write (buf.data(), len);
+
+    if ( recorder )
+      for (std::size_t i{0}; i < len; i++)
+        recorder->recordOutput (buf[i]);
+  }
+
+  bytes = writer->getPendingSize() - pending;
+
+  // Output that was written via stdio must come first
+  std::fflush(stdout);
+
+  if ( ! writer->flush() )
+    FInstrumentation::count (FInstrumentation::OutputBlocked);
+
+  return bytes;
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm::markAsPrinted (uInt pos, uInt line)
 {
   // Marks a character as printed
 
-  vterm->data[line * uInt(vterm->width) + pos].attr.bit.printed = true;
+  auto& vt = *session->vterm;
+  vt.data[line * uInt(vt.width) + pos].attr.bit.printed = true;
 }
 
 //----------------------------------------------------------------------
@@ -2892,8 +3751,10 @@ inline void FVTerm::markAsPrinted (uInt from, uInt to, uInt line)
 {
   // Marks characters in the specified range [from .. to] as printed
 
+  auto& vt = *session->vterm;
+
   for (uInt x = from; x <= to; x++)
-    vterm->data[line * uInt(vterm->width) + x].attr.bit.printed = true;
+    vt.data[line * uInt(vt.width) + x].attr.bit.printed = true;
 }
 
 //----------------------------------------------------------------------
@@ -2957,55 +3818,75 @@ inline void FVTerm::charsetChanges (FChar& next_char)
 }
 
 //----------------------------------------------------------------------
-inline void FVTerm::appendCharacter (FChar& next_char) const
+inline void FVTerm::appendCharacter ( FTermOutput& output
+                                    , FChar& next_char ) const
 {
-  const int term_width = vterm->width - 1;
-  const int term_height = vterm->height - 1;
+  const int term_width = session->vterm->width - 1;
+  const int term_height = session->vterm->height - 1;
 
-  if ( term_pos->getX() == term_width
-    && term_pos->getY() == term_height )
-    appendLowerRight (next_char);
+  if ( output.term_pos->getX() == term_width
+    && output.term_pos->getY() == term_height )
+    appendLowerRight (output, next_char);
   else
-    appendChar (next_char);
+    appendChar (output, next_char);
 
-  term_pos->x_ref()++;
+  output.term_pos->x_ref()++;
 }
 
 //----------------------------------------------------------------------
-inline void FVTerm::appendChar (FChar& next_char) const
+inline void FVTerm::appendChar (FTermOutput& output, FChar& next_char) const
 {
   newFontChanges (next_char);
   charsetChanges (next_char);
-  appendAttributes (next_char);
+  appendAttributes (output, next_char);
   characterFilter (next_char);
-  appendOutputBuffer (next_char.encoded_char[0]);
+  appendOutputBuffer (output, next_char.encoded_char[0]);
+
+  if ( next_char.ch[1] == L'\0'
+    || next_char.encoded_char[0] != next_char.ch[0]
+    || FTerm::getEncoding() != fc::UTF8 )
+    return;
+
+  // Append the remaining code points of a grapheme cluster
+  for (std::size_t i{1}; i < UNICODE_MAX && next_char.ch[i]; i++)
+    appendOutputBuffer (output, next_char.ch[i]);
 }
 
 //----------------------------------------------------------------------
 inline void FVTerm::appendAttributes (FChar& next_attr) const
+{
+  auto output = getSessionOutput();
+  appendAttributes (output, next_attr);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::appendAttributes ( FTermOutput& output
+                                     , FChar& next_attr ) const
 {
   // generate attribute string for the next character
-  const auto& attr_str = FTerm::changeAttribute (term_attribute, next_attr);
+  const auto& attr_str = ( output.opti_attr )
+      ? output.opti_attr->changeAttribute (*output.term_attribute, next_attr)
+      : FTerm::changeAttribute (*output.term_attribute, next_attr);
 
   if ( attr_str )
-    appendOutputBuffer (attr_str);
+    appendOutputBuffer (output, attr_str);
 }
 
 //----------------------------------------------------------------------
-void FVTerm::appendLowerRight (FChar& last_char) const
+void FVTerm::appendLowerRight (FTermOutput& output, FChar& last_char) const
 {
   const auto& SA = TCAP(fc::t_enter_am_mode);
   const auto& RA = TCAP(fc::t_exit_am_mode);
 
   if ( ! FTermcap::automatic_right_margin )
   {
-    appendChar (last_char);
+    appendChar (output, last_char);
   }
   else if ( SA && RA )
   {
-    appendOutputBuffer (RA);
-    appendChar (last_char);
-    appendOutputBuffer (SA);
+    appendOutputBuffer (output, RA);
+    appendChar (output, last_char);
+    appendOutputBuffer (output, SA);
   }
   else
   {
@@ -3017,35 +3898,35 @@ void FVTerm::appendLowerRight (FChar& last_char) const
 
     const int x = int(FTerm::getColumnNumber()) - 2;
     const int y = int(FTerm::getLineNumber()) - 1;
-    setTermXY (x, y);
-    appendChar (last_char);
-    term_pos->x_ref()++;
+    setTermXY (output, x, y);
+    appendChar (output, last_char);
+    output.term_pos->x_ref()++;
 
-    setTermXY (x, y);
+    setTermXY (output, x, y);
     FChar& second_last = *(&last_char - 1);
 
     if ( IC )
     {
-      appendOutputBuffer (FTermcap::encodeParameter(IC, 1, 0, 0, 0, 0, 0, 0, 0, 0));
-      appendChar (second_last);
+      appendOutputBuffer (output, FTermcap::encodeParameter(IC, 1, 0, 0, 0, 0, 0, 0, 0, 0));
+      appendChar (output, second_last);
     }
     else if ( im && ei )
     {
-      appendOutputBuffer (im);
-      appendChar (second_last);
+      appendOutputBuffer (output, im);
+      appendChar (output, second_last);
 
       if ( ip )
-        appendOutputBuffer (ip);
+        appendOutputBuffer (output, ip);
 
-      appendOutputBuffer (ei);
+      appendOutputBuffer (output, ei);
     }
     else if ( ic )
     {
-      appendOutputBuffer (ic);
-      appendChar (second_last);
+      appendOutputBuffer (output, ic);
+      appendChar (output, second_last);
 
       if ( ip )
-        appendOutputBuffer (ip);
+        appendOutputBuffer (output, ip);
     }
   }
 }
@@ -3053,26 +3934,46 @@ void FVTerm::appendLowerRight (FChar& last_char) const
 //----------------------------------------------------------------------
 inline void FVTerm::characterFilter (FChar& next_char)
 {
-  charSubstitution& sub_map = fterm->getCharSubstitutionMap();
+  // The substitution map is only read, so that row bands
+  // can filter their characters concurrently
+  const charSubstitution& sub_map = \
+      session->fterm->getCharSubstitutionMap();
+  const auto iter = sub_map.find(next_char.encoded_char[0]);
 
-  if ( sub_map.find(next_char.encoded_char[0]) != sub_map.end() )
-    next_char.encoded_char[0] = sub_map[next_char.encoded_char[0]];
+  if ( iter != sub_map.end() )
+    next_char.encoded_char[0] = iter->second;
 }
 
 //----------------------------------------------------------------------
 inline void FVTerm::appendOutputBuffer (const std::string& str)
 {
-  for (auto&& ch : str)
-    FVTerm::appendOutputBuffer(int(ch));
+  auto output = getSessionOutput();
+  appendOutputBuffer (output, str);
 }
 
 //----------------------------------------------------------------------
 int FVTerm::appendOutputBuffer (int ch)
+{
+  auto output = getSessionOutput();
+  return appendOutputBuffer (output, ch);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::appendOutputBuffer ( FTermOutput& output
+                                       , const std::string& str )
+{
+  for (auto&& ch : str)
+    appendOutputBuffer (output, int(ch));
+}
+
+//----------------------------------------------------------------------
+inline int FVTerm::appendOutputBuffer (FTermOutput& output, int ch)
 {
   // append method for unicode character
-  output_buffer->push_back(ch);
+  output.buffer->push_back(ch);
 
-  if ( output_buffer->size() >= TERMINAL_OUTPUT_BUFFER_SIZE )
+  if ( output.flushable
+    && output.buffer->size() >= TERMINAL_OUTPUT_BUFFER_SIZE )
     flush();
 
   return ch;
@@ -20,10 +20,13 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "final/fapplication.h"
 #include "final/fevent.h"
+#include "final/finstrumentation.h"
 #include "final/flog.h"
 #include "final/fmenubar.h"
 #include "final/fstartoptions.h"
@@ -58,6 +61,7 @@ FWidget::FWidgetList* FWidget::window_list{nullptr};
 FWidget::FWidgetList* FWidget::dialog_list{nullptr};
 FWidget::FWidgetList* FWidget::always_on_top_list{nullptr};
 FWidget::FWidgetList* FWidget::close_widget{nullptr};
+FWidget::FWidgetList* FWidget::update_widget{nullptr};
 bool                  FWidget::init_terminal{false};
 bool                  FWidget::init_desktop{false};
 uInt                  FWidget::modal_dialog_counter{};
@@ -66,6 +70,9 @@ uInt                  FWidget::modal_dialog_counter{};
 // class FWidget
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FWidget> FWidget::type_tag{};
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FWidget::FWidget (FWidget* parent)
@@ -112,6 +119,7 @@ FWidget::~FWidget()  // destructor
   processDestroy();
   delCallback();
   removeQueuedEvent();
+  removeUpdateRequest();
 
   // unset clicked widget
   if ( this == getClickedWidget() )
@@ -889,6 +897,8 @@ void FWidget::redraw()
 {
   // Redraw the widget immediately unless it is hidden.
 
+  FInstrumentation::ScopedTimer timer(FInstrumentation::WidgetRedraw);
+
   if ( ! redraw_root_widget )
     redraw_root_widget = this;
 
@@ -917,6 +927,19 @@ void FWidget::redraw()
     redraw_root_widget = nullptr;
 }
 
+//----------------------------------------------------------------------
+void FWidget::update()
+{
+  // Schedules a redraw of the widget for the next event loop pass.
+  // Multiple calls before that are merged into a single redraw.
+
+  if ( flags.update_pending || ! update_widget )
+    return;
+
+  flags.update_pending = true;
+  update_widget->push_back(this);
+}
+
 //----------------------------------------------------------------------
 void FWidget::resize()
 {
@@ -1376,6 +1399,51 @@ void FWidget::hideArea (const FSize& size)
   flush();
 }
 
+//----------------------------------------------------------------------
+bool FWidget::processUpdateList()
+{
+  // Redraws each widget with a pending update() exactly once.
+  // The windows are drawn from the bottom to the top layer.
+
+  if ( ! update_widget || update_widget->empty() )
+    return false;
+
+  // Updates requested while drawing are handled in the next pass
+  FWidgetList pending{};
+  pending.swap(*update_widget);
+  std::vector<std::pair<int, FWidget*>> draw_list{};
+  draw_list.reserve(pending.size());
+
+  for (auto&& widget : pending)
+  {
+    // Skip widgets that are drawn with a pending parent widget
+    if ( widget->isShown() && ! widget->hasPendingParentUpdate() )
+      draw_list.emplace_back (FWindow::getWindowLayer(widget), widget);
+  }
+
+  for (auto&& widget : pending)
+    widget->flags.update_pending = false;
+
+  std::stable_sort ( draw_list.begin(), draw_list.end()
+                   , [] ( const std::pair<int, FWidget*>& lhs
+                        , const std::pair<int, FWidget*>& rhs )
+                     {
+                       return lhs.first < rhs.first;
+                     }
+                   );
+  // Terminal updates that the application has stopped stay stopped
+  const auto terminal_updates = ( isTerminalUpdateStopped() )
+                                ? FVTerm::stop_terminal_updates
+                                : FVTerm::continue_terminal_updates;
+  setTerminalUpdates (FVTerm::stop_terminal_updates);
+
+  for (auto&& entry : draw_list)
+    entry.second->redraw();
+
+  setTerminalUpdates (terminal_updates);
+  return true;
+}
+
 //----------------------------------------------------------------------
 bool FWidget::focusNextChild()
 {
@@ -1518,6 +1586,10 @@ bool FWidget::event (FEvent* ev)
       KeyDownEvent (static_cast<FKeyEvent*>(ev));
       break;
 
+    case fc::Paste_Event:
+      PasteEvent (static_cast<FPasteEvent*>(ev));
+      break;
+
     case fc::MouseDown_Event:
       emitCallback("mouse-press");
       onMouseDown (static_cast<FMouseEvent*>(ev));
@@ -1560,6 +1632,14 @@ bool FWidget::event (FEvent* ev)
       onChildFocusOut (static_cast<FFocusEvent*>(ev));
       break;
 
+    case fc::TerminalFocusIn_Event:
+      onTerminalFocusIn (static_cast<FFocusEvent*>(ev));
+      break;
+
+    case fc::TerminalFocusOut_Event:
+      onTerminalFocusOut (static_cast<FFocusEvent*>(ev));
+      break;
+
     case fc::Accelerator_Event:
       onAccel (static_cast<FAccelEvent*>(ev));
       break;
@@ -1608,6 +1688,13 @@ void FWidget::onKeyDown (FKeyEvent*)
   // to receive key down events for the widget
 }
 
+//----------------------------------------------------------------------
+void FWidget::onPaste (FPasteEvent*)
+{
+  // This event handler can be reimplemented in a subclass
+  // to receive bracketed paste events for the widget
+}
+
 //----------------------------------------------------------------------
 void FWidget::onMouseDown (FMouseEvent*)
 {
@@ -1671,6 +1758,20 @@ void FWidget::onChildFocusOut (FFocusEvent*)
   // to receive a child widget focus event (lost focus)
 }
 
+//----------------------------------------------------------------------
+void FWidget::onTerminalFocusIn (FFocusEvent*)
+{
+  // This event handler can be reimplemented in a subclass
+  // to receive a terminal focus event (get focus)
+}
+
+//----------------------------------------------------------------------
+void FWidget::onTerminalFocusOut (FFocusEvent*)
+{
+  // This event handler can be reimplemented in a subclass
+  // to receive a terminal focus event (lost focus)
+}
+
 //----------------------------------------------------------------------
 void FWidget::onAccel (FAccelEvent*)
 {
@@ -1733,6 +1834,7 @@ void FWidget::initRootWidget()
     dialog_list        = new FWidgetList();
     always_on_top_list = new FWidgetList();
     close_widget       = new FWidgetList();
+    update_widget      = new FWidgetList();
   }
   catch (const std::bad_alloc&)
   {
@@ -1764,6 +1866,12 @@ void FWidget::finish()
     close_widget = nullptr;
   }
 
+  if ( update_widget )
+  {
+    delete update_widget;
+    update_widget = nullptr;
+  }
+
   if ( dialog_list )
   {
     delete dialog_list;
@@ -1888,6 +1996,44 @@ void FWidget::KeyDownEvent (FKeyEvent* kev)
   }
 }
 
+//----------------------------------------------------------------------
+void FWidget::PasteEvent (FPasteEvent* pev)
+{
+  // The pasted text goes to the first widget (or parent)
+  // that accepts it. Otherwise, it is typed in as key presses.
+
+  FWidget* widget(this);
+
+  while ( widget )
+  {
+    widget->onPaste(pev);
+
+    if ( pev->isAccepted() )
+      return;
+
+    if ( widget->isRootWidget() )
+      break;
+
+    widget = widget->getParentWidget();
+  }
+
+  for (auto&& ch : pev->getText())
+  {
+    // A key press can move the focus to another widget
+    widget = getFocusWidget();
+
+    if ( ! widget )
+      widget = getMainWidget();
+
+    if ( ! widget || FApplication::isQuit() )
+      return;
+
+    const FKey key = ( ch == L'\n' ) ? FKey(fc::Fkey_return) : FKey(ch);
+    FKeyEvent k_press_ev (fc::KeyPress_Event, key);
+    FApplication::sendEvent (widget, &k_press_ev);
+  }
+}
+
 //----------------------------------------------------------------------
 void FWidget::emitWheelCallback (const FWheelEvent* ev) const
 {
@@ -2016,6 +2162,44 @@ void FWidget::drawChildren()
   }
 }
 
+//----------------------------------------------------------------------
+bool FWidget::hasPendingParentUpdate() const
+{
+  // A widget redraw includes all child widgets except windows,
+  // which are only included in the root widget redraw
+
+  bool window_boundary = isWindowWidget();
+  const FWidget* parent = getParentWidget();
+
+  while ( parent )
+  {
+    if ( parent->flags.update_pending
+      && ( ! window_boundary || parent->isRootWidget() ) )
+      return true;
+
+    if ( parent->isWindowWidget() )
+      window_boundary = true;
+
+    parent = parent->getParentWidget();
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+void FWidget::removeUpdateRequest()
+{
+  if ( ! flags.update_pending || ! update_widget )
+    return;
+
+  auto iter = std::find (update_widget->begin(), update_widget->end(), this);
+
+  if ( iter != update_widget->end() )
+    update_widget->erase(iter);
+
+  flags.update_pending = false;
+}
+
 //----------------------------------------------------------------------
 inline bool FWidget::isDefaultTheme()
 {
@@ -24,6 +24,7 @@
 
 #include "final/fapplication.h"
 #include "final/fcombobox.h"
+#include "final/fdialoglistmenu.h"
 #include "final/fevent.h"
 #include "final/fmenu.h"
 #include "final/fmenubar.h"
@@ -41,6 +42,9 @@ FWindow* FWindow::previous_window{nullptr};
 // class FWindow
 //----------------------------------------------------------------------
 
+// static class attribute
+const FTypeTag<FWindow> FWindow::type_tag{};
+
 // constructor and destructor
 //----------------------------------------------------------------------
 FWindow::FWindow(FWidget* parent)
@@ -292,7 +296,7 @@ void FWindow::hide()
 
   FWidget::hide();
   const auto& t_geometry = getTermGeometryWithShadow();
-  restoreVTerm (t_geometry);
+  addDamage (t_geometry);
 }
 
 //----------------------------------------------------------------------
@@ -656,7 +660,7 @@ bool FWindow::zoomWindow()
     zoomed = false;
     const FRect oldGeometry (getTermGeometryWithShadow());
     setGeometry (normalGeometry);
-    restoreVTerm (oldGeometry);
+    addDamage (oldGeometry);
     redraw();
   }
   else
@@ -666,7 +670,7 @@ bool FWindow::zoomWindow()
     normalGeometry = getGeometry();
     const FRect oldGeometry (getTermGeometryWithShadow());
     setGeometry (FPoint{1, 1}, FSize{getMaxWidth(), getMaxHeight()});
-    restoreVTerm (oldGeometry);
+    addDamage (oldGeometry);
     redraw();
   }
 
@@ -900,8 +904,8 @@ void closeDropDown (const FWidget* widget, const FPoint& mouse_position)
   if ( ! openmenu )
     return;
 
-  if ( openmenu->isInstanceOf("FMenu")
-    || openmenu->isInstanceOf("FDialogListMenu") )
+  if ( openmenu->isInstanceOf<FMenu>()
+    || openmenu->isInstanceOf<FDialogListMenu>() )
   {
     bool contains_menu_structure;
     auto menu = static_cast<FMenu*>(openmenu);
@@ -912,10 +916,8 @@ void closeDropDown (const FWidget* widget, const FPoint& mouse_position)
       return;
   }
 
-  if ( openmenu->isInstanceOf("FDropDownListBox") )
+  if ( auto drop_down = openmenu->cast<FDropDownListBox>() )
   {
-    auto drop_down = static_cast<FDropDownListBox*>(openmenu);
-
     if ( ! closeComboBox(drop_down, mouse_position) )
       return;
   }
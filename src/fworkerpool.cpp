@@ -0,0 +1,145 @@
+/***********************************************************************
+* fworkerpool.cpp - A pool of worker threads                           *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <system_error>
+
+#include "final/fworkerpool.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FWorkerPool
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FWorkerPool::FWorkerPool (std::size_t threads)
+{
+  // The calling thread of run() is one of the threads
+
+  try
+  {
+    for (std::size_t i{1}; i < threads; i++)
+      workers.emplace_back(&FWorkerPool::work, this);
+  }
+  catch (const std::system_error&)
+  {
+    // Continue with the threads created so far
+  }
+}
+
+//----------------------------------------------------------------------
+FWorkerPool::~FWorkerPool()  // destructor
+{
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+    running = false;
+  }
+
+  start.notify_all();
+
+  for (auto&& worker : workers)
+    worker.join();
+}
+
+
+// public methods of FWorkerPool
+//----------------------------------------------------------------------
+void FWorkerPool::run (std::size_t count, const Job& fn)
+{
+  if ( count == 0 )
+    return;
+
+  if ( workers.empty() || count == 1 )
+  {
+    for (std::size_t i{0}; i < count; i++)
+      fn(i);
+
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+    job = &fn;
+    job_count = count;
+    next_job.store(0, std::memory_order_relaxed);
+    active_workers = workers.size();
+    generation++;
+  }
+
+  start.notify_all();
+  processJobs();
+
+  // Wait until every worker has left this generation
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait (lock, [this] () { return active_workers == 0; });
+  job = nullptr;
+}
+
+
+// private methods of FWorkerPool
+//----------------------------------------------------------------------
+void FWorkerPool::work()
+{
+  uInt64 seen_generation{0};
+
+  while ( true )
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      start.wait ( lock, [this, &seen_generation] ()
+                         {
+                           return ! running
+                               || generation != seen_generation;
+                         } );
+
+      if ( ! running )
+        return;
+
+      seen_generation = generation;
+    }
+
+    processJobs();
+
+    std::lock_guard<std::mutex> lock_guard(mutex);
+
+    if ( --active_workers == 0 )
+      done.notify_one();
+  }
+}
+
+//----------------------------------------------------------------------
+void FWorkerPool::processJobs()
+{
+  // Takes the next unprocessed job until all jobs are assigned
+
+  std::size_t index = next_job.fetch_add(1, std::memory_order_relaxed);
+
+  while ( index < job_count )
+  {
+    (*job)(index);
+    index = next_job.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace finalcut
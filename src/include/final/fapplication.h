@@ -77,6 +77,7 @@ namespace finalcut
 class FAccelEvent;
 class FCloseEvent;
 class FEvent;
+class FEventStatistics;
 class FFocusEvent;
 class FKeyEvent;
 class FLog;
@@ -100,6 +101,9 @@ class FApplication : public FWidget
     // Typedef
     typedef std::shared_ptr<FLog> FLogPtr;
 
+    // Type tag
+    static const FTypeTag<FApplication> type_tag;
+
     // Constructor
     FApplication (const int&, char*[]);
 
@@ -114,11 +118,13 @@ class FApplication : public FWidget
 
     // Accessors
     FString               getClassName() const override;
+    FTypeId               getTypeId() const override;
     int                   getArgc() const;
     char**                getArgv() const;
     static FApplication*  getApplicationObject();
     static FWidget*       getKeyboardWidget();
     static FLogPtr&       getLog();
+    static FEventStatistics& getEventStatistics();
 
     // Mutator
     static void           setLog (const FLogPtr&);
@@ -141,6 +147,7 @@ class FApplication : public FWidget
     static void           setDefaultTheme();
     static void           setDarkTheme();
     static void           setLogFile (const FString&);
+    static void           setInstrumentation (const char[]);
     static void           setKeyboardWidget (FWidget*);
     static void           closeConfirmationDialog (FWidget*, FCloseEvent*);
 
@@ -183,6 +190,8 @@ class FApplication : public FWidget
     void                  keyReleased() const;
     void                  escapeKeyPressed() const;
     void                  mouseTracking() const;
+    void                  textPasted() const;
+    void                  terminalFocusChanged() const;
     void                  performKeyboardAction();
     void                  performMouseAction() const;
     void                  mouseEvent (const FMouseData&);
@@ -190,6 +199,8 @@ class FApplication : public FWidget
     bool                  sendKeyDownEvent (FWidget*) const;
     bool                  sendKeyPressEvent (FWidget*) const;
     bool                  sendKeyUpEvent (FWidget*) const;
+    void                  sendPasteEvent (FWidget*) const;
+    void                  sendTerminalFocusEvent (FObject*, FFocusEvent*) const;
     void                  sendKeyboardAccelerator();
     bool                  hasDataInQueue() const;
     void                  queuingKeyboardInput() const;
@@ -225,6 +236,7 @@ class FApplication : public FWidget
     static FWidget*       processParameters (const int&, char*[]);
     void                  processResizeEvent() const;
     void                  processCloseWidget();
+    void                  processInstrumentationDump() const;
     void                  processLogger() const;
     bool                  processNextEvent();
     void                  performTimerAction (FObject*, FEvent*) override;
@@ -260,6 +272,10 @@ FApplication* getFApplication();
 inline FString FApplication::getClassName() const
 { return "FApplication"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FApplication::getTypeId() const
+{ return getTypeIdOf<FApplication>(); }
+
 //----------------------------------------------------------------------
 inline int FApplication::getArgc() const
 { return app_argc; }
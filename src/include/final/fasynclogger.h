@@ -0,0 +1,216 @@
+/***********************************************************************
+* fasynclogger.h - The FINAL CUT background logger                     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Inheritance diagram
+ *  ═══════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ std::stringbuf ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *         ▲
+ *         │
+ *      ▕▔▔▔▔▔▔▏
+ *      ▕ FLog ▏
+ *      ▕▁▁▁▁▁▁▏
+ *         ▲
+ *         │
+ *    ▕▔▔▔▔▔▔▔▔▔▏
+ *    ▕ FLogger ▏
+ *    ▕▁▁▁▁▁▁▁▁▁▏
+ *         ▲
+ *         │
+ *  ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *  ▕ FAsyncLogger ▏
+ *  ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  The log messages are passed through a lock-free ring buffer
+ *  to a background thread, which formats and writes them.
+ *  The calling thread never waits for the output. If the ring
+ *  buffer is full, the message is dropped and counted.
+ *
+ *  Binary record format (all integers in little-endian byte order):
+ *
+ *    uInt64  seconds since the epoch
+ *    uInt32  microseconds
+ *    uInt8   log level (0 = Info, 1 = Warn, 2 = Error, 3 = Debug)
+ *    uInt32  message length in bytes
+ *    char[]  message
+ */
+
+#ifndef FASYNCLOGGER_H
+#define FASYNCLOGGER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "final/flogger.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FAsyncLogger
+//----------------------------------------------------------------------
+
+class FAsyncLogger : public FLogger
+{
+  public:
+    // Enumeration
+    enum LogFormat
+    {
+      Text,     // Same output as FLogger
+      Compact,  // <seconds>.<microseconds> <level letter> <message>
+      Binary    // Length-prefixed records
+    };
+
+    // Constant
+    static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+    // Constructor
+    explicit FAsyncLogger (std::size_t = DEFAULT_CAPACITY);
+
+    // Disable copy constructor
+    FAsyncLogger (const FAsyncLogger&) = delete;
+
+    // Destructor
+    ~FAsyncLogger() override;
+
+    // Disable copy assignment operator (=)
+    FAsyncLogger& operator = (const FAsyncLogger&) = delete;
+
+    // Accessors
+    FString      getClassName() const override;
+    std::size_t  getCapacity() const;
+    std::size_t  getDroppedCount() const;
+    LogFormat    getFormat() const;
+
+    // Mutators
+    void         setFormat (LogFormat);
+    void         setOutputStream (const std::ostream&) override;
+    void         setLineEnding (LineEnding) override;
+    void         enableTimestamp() override;
+    void         disableTimestamp() override;
+
+    // Methods
+    void         info (const std::string&) override;
+    void         warn (const std::string&) override;
+    void         error (const std::string&) override;
+    void         debug (const std::string&) override;
+    void         flush() override;
+    void         drain();
+
+  private:
+    // Typedef
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    struct LogRecord
+    {
+      TimePoint   time{};
+      LogLevel    level{Info};
+      std::string message{};
+    };
+
+    struct Slot
+    {
+      std::atomic<std::size_t> sequence{0};
+      LogRecord                record{};
+    };
+
+    // Methods
+    void         push (LogLevel, const std::string&);
+    bool         pop (LogRecord&);
+    bool         isQueueEmpty() const;
+    void         run();
+    void         writeRecord (const LogRecord&);
+    void         writeCompactRecord (const LogRecord&);
+    void         writeBinaryRecord (const LogRecord&);
+    void         reportDroppedMessages();
+
+    // Data members
+    std::size_t               capacity{};
+    std::unique_ptr<Slot[]>   ring{};
+    std::atomic<std::size_t>  enqueue_pos{0};
+    std::atomic<std::size_t>  dequeue_pos{0};
+    std::atomic<std::size_t>  written_pos{0};
+    std::atomic<std::size_t>  dropped{0};
+    std::size_t               reported_drops{0};
+    std::atomic<int>          format{Text};
+    std::atomic<bool>         running{true};
+    std::atomic<bool>         flush_request{false};
+    std::string               record_buffer{};
+    std::mutex                output_mutex{};
+    std::mutex                wait_mutex{};
+    std::condition_variable   wakeup{};
+    std::condition_variable   drained{};
+    std::thread               worker{};
+};
+
+// FAsyncLogger inline functions
+//----------------------------------------------------------------------
+inline FString FAsyncLogger::getClassName() const
+{ return "FAsyncLogger"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FAsyncLogger::getCapacity() const
+{ return capacity; }
+
+//----------------------------------------------------------------------
+inline std::size_t FAsyncLogger::getDroppedCount() const
+{ return dropped.load(std::memory_order_relaxed); }
+
+//----------------------------------------------------------------------
+inline FAsyncLogger::LogFormat FAsyncLogger::getFormat() const
+{ return LogFormat(format.load(std::memory_order_relaxed)); }
+
+//----------------------------------------------------------------------
+inline void FAsyncLogger::setFormat (LogFormat fmt)
+{ format.store(fmt, std::memory_order_relaxed); }
+
+//----------------------------------------------------------------------
+inline void FAsyncLogger::info (const std::string& msg)
+{ push (Info, msg); }
+
+//----------------------------------------------------------------------
+inline void FAsyncLogger::warn (const std::string& msg)
+{ push (Warn, msg); }
+
+//----------------------------------------------------------------------
+inline void FAsyncLogger::error (const std::string& msg)
+{ push (Error, msg); }
+
+//----------------------------------------------------------------------
+inline void FAsyncLogger::debug (const std::string& msg)
+{ push (Debug, msg); }
+
+}  // namespace finalcut
+
+#endif  // FASYNCLOGGER_H
@@ -69,6 +69,9 @@ namespace finalcut
 class FBusyIndicator : public FToolTip
 {
   public:
+    // Type tag
+    static const FTypeTag<FBusyIndicator> type_tag;
+
     // Constructor
     explicit FBusyIndicator (FWidget* = nullptr);
 
@@ -83,6 +86,7 @@ class FBusyIndicator : public FToolTip
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
 
     // Inquiries
     bool                isRunning() const;
@@ -99,8 +103,10 @@ class FBusyIndicator : public FToolTip
     void init();
     void createIndicatorText();
 
-    // Event handler
+    // Event handlers
     void onTimer (finalcut::FTimerEvent*) override;
+    void onTerminalFocusIn (FFocusEvent*) override;
+    void onTerminalFocusOut (FFocusEvent*) override;
 
     // Callback methods
 
@@ -116,6 +122,10 @@ class FBusyIndicator : public FToolTip
 inline FString FBusyIndicator::getClassName() const
 { return "FBusyIndicator"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FBusyIndicator::getTypeId() const
+{ return getTypeIdOf<FBusyIndicator>(); }
+
 //----------------------------------------------------------------------
 inline bool FBusyIndicator::isRunning() const
 {
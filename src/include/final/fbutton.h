@@ -60,6 +60,9 @@ namespace finalcut
 class FButton : public FWidget
 {
   public:
+    // Type tag
+    static const FTypeTag<FButton> type_tag;
+
     // Constructors
     explicit FButton (FWidget* = nullptr);
     explicit FButton (const FString&, FWidget* = nullptr);
@@ -78,6 +81,7 @@ class FButton : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     FString             getText() const;
 
     // Mutators
@@ -177,6 +181,10 @@ class FButton : public FWidget
 inline FString FButton::getClassName() const
 { return "FButton"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FButton::getTypeId() const
+{ return getTypeIdOf<FButton>(); }
+
 //----------------------------------------------------------------------
 inline FString FButton::getText() const
 { return text; }
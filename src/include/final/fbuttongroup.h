@@ -64,6 +64,9 @@ class FToggleButton;
 class FButtonGroup : public FScrollView
 {
   public:
+    // Type tag
+    static const FTypeTag<FButtonGroup> type_tag;
+
     // Constructors
     explicit FButtonGroup (FWidget* = nullptr);
     explicit FButtonGroup (const FString&, FWidget* = nullptr);
@@ -79,6 +82,7 @@ class FButtonGroup : public FScrollView
 
     // Accessor
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     FToggleButton*      getFirstButton();
     FToggleButton*      getLastButton();
     FToggleButton*      getButton (int) const;
@@ -146,6 +150,10 @@ class FButtonGroup : public FScrollView
 inline FString FButtonGroup::getClassName() const
 { return "FButtonGroup"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FButtonGroup::getTypeId() const
+{ return getTypeIdOf<FButtonGroup>(); }
+
 //----------------------------------------------------------------------
 inline bool FButtonGroup::setEnable()
 { return setEnable(true); }
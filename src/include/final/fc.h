@@ -59,6 +59,7 @@ enum events
   KeyPress_Event,           // key pressed
   KeyUp_Event,              // key released
   KeyDown_Event,            // key pressed
+  Paste_Event,              // text pasted
   MouseDown_Event,          // mouse button pressed
   MouseUp_Event,            // mouse button released
   MouseDoubleClick_Event,   // mouse button double click
@@ -72,6 +73,8 @@ enum events
   WindowInactive_Event,     // deactivate window
   WindowRaised_Event,       // raise window
   WindowLowered_Event,      // lower window
+  TerminalFocusIn_Event,    // terminal window gets the focus
+  TerminalFocusOut_Event,   // terminal window loses the focus
   Accelerator_Event,        // keyboard accelerator
   Resize_Event,             // terminal resize
   Show_Event,               // widget is shown
@@ -572,6 +575,9 @@ enum metakeys : FKey
   Fkey_mouse                 = 0x02000020,  // xterm mouse
   Fkey_extended_mouse        = 0x02000021,  // SGR extended mouse
   Fkey_urxvt_mouse           = 0x02000022,  // urxvt mouse extension
+  Fkey_paste                 = 0x02000023,  // bracketed paste
+  Fkey_term_focus_in         = 0x02000024,  // terminal focus in
+  Fkey_term_focus_out        = 0x02000025,  // terminal focus out
   Fmkey_meta                 = 0x020000e0,  // meta key offset
   Fmkey_tab                  = 0x020000e9,  // M-tab
   Fmkey_enter                = 0x020000ea,  // M-enter
@@ -209,6 +209,7 @@ class FCallback
     void delCallback (const Function& cb_function);
     void delCallback();
     void emitCallback (const FString& emit_signal) const;
+    void emitCallback (const char emit_signal[]) const;
 
   private:
     // Typedefs
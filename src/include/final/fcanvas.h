@@ -0,0 +1,203 @@
+/***********************************************************************
+* fcanvas.h - Widget FCanvas                                           *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Inheritance diagram
+ *  ═══════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▏ ▕▔▔▔▔▔▔▔▔▔▏
+ * ▕ FVTerm  ▏ ▕ FObject ▏
+ * ▕▁▁▁▁▁▁▁▁▁▏ ▕▁▁▁▁▁▁▁▁▁▏
+ *      ▲           ▲
+ *      │           │
+ *      └─────┬─────┘
+ *            │
+ *       ▕▔▔▔▔▔▔▔▔▔▏
+ *       ▕ FWidget ▏
+ *       ▕▁▁▁▁▁▁▁▁▁▏
+ *            ▲
+ *            │
+ *       ▕▔▔▔▔▔▔▔▔▔▏
+ *       ▕ FCanvas ▏
+ *       ▕▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  A pixel canvas with several pixels per character cell:
+ *
+ *    HalfBlock  1 x 2 pixels per cell, every pixel has its own color
+ *    Quadrant   2 x 2 pixels per cell, one pixel color per cell
+ *    Braille    2 x 4 pixels per cell, one pixel color per cell
+ *
+ *  Unset pixels (fc::Default) show the widget background color.
+ *  Only the cells with changed pixels are converted again,
+ *  and draw() copies the cells with FVTerm::blit().
+ *  The quadrant and braille characters require a UTF-8 terminal.
+ */
+
+#ifndef FCANVAS_H
+#define FCANVAS_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <vector>
+
+#include "final/fwidget.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FCanvas
+//----------------------------------------------------------------------
+
+class FCanvas : public FWidget
+{
+  public:
+    // Using-declarations
+    using FWidget::setGeometry;
+
+    // Enumeration
+    enum PixelMode
+    {
+      HalfBlock,  // ▀
+      Quadrant,   // ▚
+      Braille     // ⣿
+    };
+
+    // Type tag
+    static const FTypeTag<FCanvas> type_tag;
+
+    // Constructor
+    explicit FCanvas (FWidget* = nullptr);
+
+    // Disable copy constructor
+    FCanvas (const FCanvas&) = delete;
+
+    // Destructor
+    ~FCanvas() override;
+
+    // Disable copy assignment operator (=)
+    FCanvas& operator = (const FCanvas&) = delete;
+
+    // Accessors
+    FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
+    PixelMode           getPixelMode() const;
+    std::size_t         getPixelWidth() const;
+    std::size_t         getPixelHeight() const;
+    FColor              getPixel (int, int) const;
+
+    // Mutators
+    void                setPixelMode (PixelMode);
+    void                setSize (const FSize&, bool = true) override;
+    void                setGeometry ( const FPoint&, const FSize&
+                                    , bool = true ) override;
+    void                setPixel (int, int, FColor);
+    void                setPixels (const FColor*, std::size_t = 0);
+    void                unsetPixel (int, int);
+
+    // Methods
+    void                hide() override;
+    void                clear();
+    void                drawLine (const FPoint&, const FPoint&, FColor);
+
+  private:
+    // Typedef
+    typedef std::vector<FColor> FPixels;
+
+    // Accessors
+    int                 getCellPixelWidth() const;
+    int                 getCellPixelHeight() const;
+
+    // Inquiry
+    bool                isDirty() const;
+
+    // Methods
+    void                init();
+    void                resizeBuffers();
+    void                setDirty (int, int, int, int);
+    void                setAllDirty();
+    void                convertDirtyCells();
+    template <typename ConvertFunc>
+    void                convertCells (ConvertFunc);
+    void                convertHalfBlockCell (int, int, FChar&) const;
+    void                convertQuadrantCell (int, int, FChar&) const;
+    void                convertBrailleCell (int, int, FChar&) const;
+    FColor              getPixelColor (FColor) const;
+    void                draw() override;
+
+    // Data members
+    FPixels             pixels{};
+    std::vector<FChar>  cells{};
+    PixelMode           pixel_mode{HalfBlock};
+    std::size_t         pixel_width{0};
+    std::size_t         pixel_height{0};
+    FColor              cell_fg{fc::Default};  // Colors of the converted
+    FColor              cell_bg{fc::Default};  // cells
+    int                 dirty_x1{0};  // Dirty cell rectangle
+    int                 dirty_y1{0};
+    int                 dirty_x2{-1};
+    int                 dirty_y2{-1};
+};
+
+
+// FCanvas inline functions
+//----------------------------------------------------------------------
+inline FString FCanvas::getClassName() const
+{ return "FCanvas"; }
+
+//----------------------------------------------------------------------
+inline FObject::FTypeId FCanvas::getTypeId() const
+{ return getTypeIdOf<FCanvas>(); }
+
+//----------------------------------------------------------------------
+inline FCanvas::PixelMode FCanvas::getPixelMode() const
+{ return pixel_mode; }
+
+//----------------------------------------------------------------------
+inline std::size_t FCanvas::getPixelWidth() const
+{ return pixel_width; }
+
+//----------------------------------------------------------------------
+inline std::size_t FCanvas::getPixelHeight() const
+{ return pixel_height; }
+
+//----------------------------------------------------------------------
+inline void FCanvas::unsetPixel (int x, int y)
+{ setPixel (x, y, fc::Default); }
+
+//----------------------------------------------------------------------
+inline int FCanvas::getCellPixelWidth() const
+{ return ( pixel_mode == HalfBlock ) ? 1 : 2; }
+
+//----------------------------------------------------------------------
+inline int FCanvas::getCellPixelHeight() const
+{ return ( pixel_mode == Braille ) ? 4 : 2; }
+
+//----------------------------------------------------------------------
+inline bool FCanvas::isDirty() const
+{ return dirty_x1 <= dirty_x2 && dirty_y1 <= dirty_y2; }
+
+}  // namespace finalcut
+
+#endif  // FCANVAS_H
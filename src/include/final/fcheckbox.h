@@ -64,6 +64,9 @@ namespace finalcut
 class FCheckBox : public FToggleButton
 {
   public:
+    // Type tag
+    static const FTypeTag<FCheckBox> type_tag;
+
     // Constructors
     explicit FCheckBox (FWidget* = nullptr);
     explicit FCheckBox (const FString&, FWidget* = nullptr);
@@ -79,6 +82,7 @@ class FCheckBox : public FToggleButton
 
     // Accessor
     FString       getClassName() const override;
+    FTypeId       getTypeId() const override;
 
   private:
     // Methods
@@ -94,6 +98,10 @@ class FCheckBox : public FToggleButton
 inline FString FCheckBox::getClassName() const
 { return "FCheckBox"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FCheckBox::getTypeId() const
+{ return getTypeIdOf<FCheckBox>(); }
+
 }  // namespace finalcut
 
 #endif  // FCHECKBOX_H
@@ -64,6 +64,9 @@ namespace finalcut
 class FCheckMenuItem : public FMenuItem
 {
   public:
+    // Type tag
+    static const FTypeTag<FCheckMenuItem> type_tag;
+
     // Constructors
     explicit FCheckMenuItem (FWidget* = nullptr);
     explicit FCheckMenuItem (const FString&, FWidget* = nullptr);
@@ -79,6 +82,7 @@ class FCheckMenuItem : public FMenuItem
 
     // Accessor
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
 
   private:
     // Methods
@@ -92,6 +96,10 @@ class FCheckMenuItem : public FMenuItem
 inline FString FCheckMenuItem::getClassName() const
 { return "FCheckMenuItem"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FCheckMenuItem::getTypeId() const
+{ return getTypeIdOf<FCheckMenuItem>(); }
+
 }  // namespace finalcut
 
 #endif  // FCHECKMENUITEM_H
@@ -0,0 +1,165 @@
+/***********************************************************************
+* fcolorquantizer.h - Maps 24-bit RGB colors to a terminal palette     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FColorQuantizer ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  For each palette size (8, 16, 88 and 256 colors) there is a
+ *  lookup table with 32768 entries, one for each 15-bit RGB color
+ *  (5 bits per channel). A table is built on first use with the
+ *  perceptually closest palette color, so that the conversion of
+ *  an RGB color is a single table load. The 8 and 16 color tables
+ *  use the current system colors and are rebuilt after a change
+ *  of the palette. The 88 and 256 color tables use only the fixed
+ *  color cube and gray ramp of the terminal.
+ *
+ *  The tables are immutable once built and shared between copies
+ *  of a quantizer. Calling initTable() before copying a quantizer
+ *  to other threads lets all copies use the same table read-only.
+ */
+
+#ifndef FCOLORQUANTIZER_H
+#define FCOLORQUANTIZER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FColorQuantizer
+//----------------------------------------------------------------------
+
+class FColorQuantizer final
+{
+  public:
+    // Constants
+    static constexpr std::size_t TABLE_SIZE = 32768;
+
+    // Constructor
+    FColorQuantizer();
+
+    // Accessors
+    FString     getClassName() const;
+    FColor      getPaletteColor (FColor) const;
+
+    // Mutators
+    void        setPaletteColor (FColor, int, int, int);
+    void        resetPalette();
+
+    // Methods
+    void        initTable (int);
+    FColor      quantize (FColor, int);
+    FColor      quantize (uInt8, uInt8, uInt8, int);
+
+  private:
+    // Typedefs and Enumerations
+    typedef std::vector<uInt8> LookupTable;
+    typedef std::shared_ptr<const LookupTable> SharedTable;
+
+    enum PaletteType
+    {
+      Palette8,
+      Palette16,
+      Palette88,
+      Palette256,
+      PaletteTypes
+    };
+
+    // Accessor
+    static PaletteType   getPaletteType (int);
+
+    // Methods
+    const LookupTable&   getTable (PaletteType);
+    void                 buildTable (PaletteType);
+    FColor               getRGB (FColor, PaletteType) const;
+
+    // Data members
+    std::array<FColor, 16>                 system_colors{};
+    std::array<SharedTable, PaletteTypes>  tables{};
+};
+
+// FColorQuantizer inline functions
+//----------------------------------------------------------------------
+inline FString FColorQuantizer::getClassName() const
+{ return "FColorQuantizer"; }
+
+//----------------------------------------------------------------------
+inline void FColorQuantizer::initTable (int max_color)
+{
+  // Builds the lookup table for max_color ahead of its first use
+  getTable (getPaletteType(max_color));
+}
+
+//----------------------------------------------------------------------
+inline FColor FColorQuantizer::quantize (FColor color, int max_color)
+{
+  // Returns the palette color for an RGB color value.
+  // Palette colors are returned unchanged.
+
+  if ( ! isRGBColor(color) )
+    return color;
+
+  const auto index = ((color >> 9) & 0x7c00)
+                   | ((color >> 6) & 0x03e0)
+                   | ((color >> 3) & 0x001f);
+  const auto& table = getTable(getPaletteType(max_color));
+  const FColor palette_color = table[index];
+
+  if ( max_color >= 8 || max_color <= 0 )
+    return palette_color;
+
+  return palette_color % FColor(max_color);
+}
+
+//----------------------------------------------------------------------
+inline FColor FColorQuantizer::quantize ( uInt8 r, uInt8 g, uInt8 b
+                                        , int max_color )
+{ return quantize (rgbColor(r, g, b), max_color); }
+
+//----------------------------------------------------------------------
+inline const FColorQuantizer::LookupTable&
+    FColorQuantizer::getTable (PaletteType type)
+{
+  if ( ! tables[type] )
+    buildTable(type);
+
+  return *tables[type];
+}
+
+}  // namespace finalcut
+
+#endif  // FCOLORQUANTIZER_H
@@ -73,6 +73,9 @@ class FDropDownListBox : public FWindow
     // Using-declaration
     using FWidget::setGeometry;
 
+    // Type tag
+    static const FTypeTag<FDropDownListBox> type_tag;
+
     // Constructor
     explicit FDropDownListBox (FWidget* = nullptr);
 
@@ -87,6 +90,7 @@ class FDropDownListBox : public FWindow
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
 
     // Mutators
     void                setGeometry ( const FPoint&, const FSize&
@@ -120,6 +124,10 @@ class FDropDownListBox : public FWindow
 inline FString FDropDownListBox::getClassName() const
 { return "FDropDownListBox"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FDropDownListBox::getTypeId() const
+{ return getTypeIdOf<FDropDownListBox>(); }
+
 //----------------------------------------------------------------------
 inline bool FDropDownListBox::isEmpty() const
 { return bool( list.getCount() == 0 ); }
@@ -135,6 +143,9 @@ class FComboBox : public FWidget
     // Using-declaration
     using FWidget::setGeometry;
 
+    // Type tag
+    static const FTypeTag<FComboBox> type_tag;
+
     // Constructors
     explicit FComboBox (FWidget* = nullptr);
 
@@ -151,6 +162,7 @@ class FComboBox : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     std::size_t         getCount() const;
     FString             getText() const;
     template <typename DT>
@@ -244,6 +256,10 @@ bool closeComboBox (FDropDownListBox*, const FPoint&);
 inline FString FComboBox::getClassName() const
 { return "FComboBox"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FComboBox::getTypeId() const
+{ return getTypeIdOf<FComboBox>(); }
+
 //----------------------------------------------------------------------
 inline std::size_t FComboBox::getCount() const
 { return list_window.list.getCount(); }
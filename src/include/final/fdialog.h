@@ -77,6 +77,9 @@ class FDialog : public FWindow
       Accept = 1
     };
 
+    // Type tag
+    static const FTypeTag<FDialog> type_tag;
+
     // Constructors
     explicit FDialog (FWidget* = nullptr);
     explicit FDialog (const FString&, FWidget* = nullptr);
@@ -92,6 +95,7 @@ class FDialog : public FWindow
 
     // Accessors
     FString               getClassName() const override;
+    FTypeId               getTypeId() const override;
     virtual FString       getText() const;
 
     // Mutators
@@ -242,6 +246,10 @@ class FDialog : public FWindow
 inline FString FDialog::getClassName() const
 { return "FDialog"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FDialog::getTypeId() const
+{ return getTypeIdOf<FDialog>(); }
+
 //----------------------------------------------------------------------
 inline FString FDialog::getText() const
 { return tb_text; }
@@ -70,6 +70,9 @@ namespace finalcut
 class FDialogListMenu : public FMenu
 {
   public:
+    // Type tag
+    static const FTypeTag<FDialogListMenu> type_tag;
+
     // Constructors
     explicit FDialogListMenu (FWidget* = nullptr);
     explicit FDialogListMenu (const FString&, FWidget* = nullptr);
@@ -85,6 +88,7 @@ class FDialogListMenu : public FMenu
 
     // Accessors
     FString getClassName() const override;
+    FTypeId getTypeId() const override;
 
   private:
     // Method
@@ -97,6 +101,10 @@ class FDialogListMenu : public FMenu
 inline FString FDialogListMenu::getClassName() const
 { return "FDialogListMenu"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FDialogListMenu::getTypeId() const
+{ return getTypeIdOf<FDialogListMenu>(); }
+
 }  // namespace finalcut
 
 #endif  // FDIALOGLISTMENU_H
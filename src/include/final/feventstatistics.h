@@ -0,0 +1,142 @@
+/***********************************************************************
+* feventstatistics.h - Counts and times the dispatched events          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FEventStatistics ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  For each event type the number of dispatched events, the total
+ *  and the maximum handler time and a latency histogram are kept
+ *  in a fixed array, so recording an event allocates no memory.
+ *  Histogram bucket 0 counts times below 1 µs, bucket n counts
+ *  times from 2^(n-1) µs to below 2^n µs, and the last bucket
+ *  counts all longer times. The time of an event includes the
+ *  time of events that are sent synchronously from its handler.
+ */
+
+#ifndef FEVENTSTATISTICS_H
+#define FEVENTSTATISTICS_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <ostream>
+
+#include "final/fc.h"
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FEventStatistics
+//----------------------------------------------------------------------
+
+class FEventStatistics final
+{
+  public:
+    // Constants
+    static constexpr std::size_t HISTOGRAM_SIZE = 16;
+    static constexpr std::size_t EVENT_TYPES = fc::User_Event + 1;
+
+    // Typedefs
+    typedef std::array<uInt64, HISTOGRAM_SIZE> Histogram;
+
+    struct Entry
+    {
+      uInt64    count{0};
+      uInt64    total_time{0};  // in nanoseconds
+      uInt64    max_time{0};    // in nanoseconds
+      Histogram histogram{};
+    };
+
+    // Constructor
+    FEventStatistics() = default;
+
+    // Accessors
+    FString             getClassName() const;
+    const Entry&        getEntry (fc::events) const;
+    uInt64              getTotalCount() const;
+    static const char*  getEventName (fc::events);
+    static std::size_t  getHistogramBucket (uInt64);
+
+    // Mutators
+    void                enable();
+    void                disable();
+
+    // Inquiry
+    bool                isEnabled() const;
+
+    // Methods
+    void                add (fc::events, uInt64);
+    void                clear();
+    void                print (std::ostream&) const;
+
+  private:
+    // Accessor
+    static std::size_t  getIndex (fc::events);
+
+    // Data members
+    std::array<Entry, EVENT_TYPES>  entries{};
+    bool                            enabled{false};
+};
+
+// FEventStatistics inline functions
+//----------------------------------------------------------------------
+inline FString FEventStatistics::getClassName() const
+{ return "FEventStatistics"; }
+
+//----------------------------------------------------------------------
+inline const FEventStatistics::Entry&
+    FEventStatistics::getEntry (fc::events type) const
+{ return entries[getIndex(type)]; }
+
+//----------------------------------------------------------------------
+inline void FEventStatistics::enable()
+{ enabled = true; }
+
+//----------------------------------------------------------------------
+inline void FEventStatistics::disable()
+{ enabled = false; }
+
+//----------------------------------------------------------------------
+inline bool FEventStatistics::isEnabled() const
+{ return enabled; }
+
+//----------------------------------------------------------------------
+inline std::size_t FEventStatistics::getIndex (fc::events type)
+{
+  // User defined events can use type numbers above fc::User_Event
+  const auto index = std::size_t(type);
+  return ( index < EVENT_TYPES ) ? index : std::size_t(fc::User_Event);
+}
+
+}  // namespace finalcut
+
+#endif  // FEVENTSTATISTICS_H
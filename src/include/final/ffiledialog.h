@@ -97,6 +97,9 @@ class FFileDialog : public FDialog
       Save = 1
     };
 
+    // Type tag
+    static const FTypeTag<FFileDialog> type_tag;
+
     // Constructors
     explicit FFileDialog (FWidget* = nullptr);
     FFileDialog (const FFileDialog&);  // copy constructor
@@ -113,6 +116,7 @@ class FFileDialog : public FDialog
 
     // Accessors
     FString              getClassName() const override;
+    FTypeId              getTypeId() const override;
     FString              getPath() const;
     FString              getFilter() const;
     FString              getSelectedFile() const;
@@ -243,6 +247,10 @@ class FFileDialog : public FDialog
 inline FString FFileDialog::getClassName() const
 { return "FFileDialog"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FFileDialog::getTypeId() const
+{ return getTypeIdOf<FFileDialog>(); }
+
 //----------------------------------------------------------------------
 inline FString FFileDialog::getPath() const
 { return directory; }
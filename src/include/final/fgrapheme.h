@@ -0,0 +1,164 @@
+/***********************************************************************
+* fgrapheme.h - Grapheme cluster segmentation and column width         *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FGrapheme ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  The grapheme cluster boundaries follow the extended grapheme
+ *  cluster rules of UAX #29, the column widths the East Asian Width
+ *  property of UAX #11 (ambiguous characters are narrow).
+ *
+ *  Every code point has a property byte:
+ *
+ *    bits 0-3  Grapheme_Cluster_Break value (BreakProperty)
+ *    bits 4-5  column width (0, 1 or 2)
+ *    bit  6    Extended_Pictographic
+ *
+ *  The bytes are stored in a two-stage table. block_index maps the
+ *  upper bits of a code point to one of the distinct 128-byte blocks
+ *  in block_data. The tables are generated by the script
+ *  scripts/create_grapheme_data.sh.
+ *
+ *  The width of a cluster is the width of its base character.
+ *  A pair of regional indicators (a flag) and a pictograph with the
+ *  emoji presentation selector U+FE0F are two columns wide, spacing
+ *  marks add their width.
+ */
+
+#ifndef FGRAPHEME_H
+#define FGRAPHEME_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FGrapheme
+//----------------------------------------------------------------------
+
+class FGrapheme final
+{
+  public:
+    // Enumeration
+    enum BreakProperty
+    {
+      Other,
+      CR,
+      LF,
+      Control,
+      Extend,
+      ZWJ,
+      RegionalIndicator,
+      Prepend,
+      SpacingMark,
+      L,
+      V,
+      T,
+      LV,
+      LVT
+    };
+
+    // Constants
+    static constexpr wchar_t     UNICODE_LAST = 0x10ffff;
+    static constexpr std::size_t BLOCK_SHIFT = 7;
+    static constexpr std::size_t INDEX_SIZE = 0x110000 >> BLOCK_SHIFT;
+    static constexpr std::size_t DATA_SIZE = 176 << BLOCK_SHIFT;
+
+    // Accessors
+    static FString        getClassName();
+    static BreakProperty  getBreakProperty (wchar_t);
+    static std::size_t    getCharWidth (wchar_t);
+
+    // Inquiry
+    static bool           isExtendedPictographic (wchar_t);
+
+    // Methods
+    static std::size_t    nextCluster ( const wchar_t[], std::size_t
+                                      , std::size_t& );
+    static std::size_t    getClusterWidth (const wchar_t[], std::size_t);
+    static std::size_t    getColumnWidth (const wchar_t[], std::size_t);
+
+  private:
+    // Accessor
+    static uInt8          getProperty (wchar_t);
+
+    // Data members
+    static const std::array<uInt8, INDEX_SIZE>  block_index;
+    static const std::array<uInt8, DATA_SIZE>   block_data;
+};
+
+// FGrapheme inline functions
+//----------------------------------------------------------------------
+inline FString FGrapheme::getClassName()
+{ return "FGrapheme"; }
+
+//----------------------------------------------------------------------
+inline FGrapheme::BreakProperty FGrapheme::getBreakProperty (wchar_t wchar)
+{ return BreakProperty(getProperty(wchar) & 0x0f); }
+
+//----------------------------------------------------------------------
+inline std::size_t FGrapheme::getCharWidth (wchar_t wchar)
+{ return std::size_t((getProperty(wchar) >> 4) & 0x03); }
+
+//----------------------------------------------------------------------
+inline bool FGrapheme::isExtendedPictographic (wchar_t wchar)
+{ return (getProperty(wchar) & 0x40) != 0; }
+
+//----------------------------------------------------------------------
+inline std::size_t FGrapheme::getClusterWidth ( const wchar_t str[]
+                                              , std::size_t length )
+{
+  std::size_t width{0};
+  nextCluster (str, length, width);
+  return width;
+}
+
+//----------------------------------------------------------------------
+inline uInt8 FGrapheme::getProperty (wchar_t wchar)
+{
+  // Code points outside the Unicode range are handled like
+  // unassigned characters
+  const auto cp = std::size_t(uInt32(wchar));
+
+  if ( cp > std::size_t(UNICODE_LAST) )
+    return 0x10;
+
+  const std::size_t block = block_index[cp >> BLOCK_SHIFT];
+  return block_data[(block << BLOCK_SHIFT) | (cp & 0x7f)];
+}
+
+}  // namespace finalcut
+
+#endif  // FGRAPHEME_H
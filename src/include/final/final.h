@@ -32,11 +32,17 @@
 #include <final/fapplication.h>
 #include <final/fbuttongroup.h>
 #include <final/fbutton.h>
+#include <final/fcanvas.h>
 #include <final/fbusyindicator.h>
 #include <final/fc.h>
 #include <final/fdata.h>
 #include <final/fobject.h>
 #include <final/fcolorpalette.h>
+#include <final/fcolorquantizer.h>
+#include <final/feventstatistics.h>
+#include <final/finstrumentation.h>
+#include <final/fgrapheme.h>
+#include <final/foutputwriter.h>
 #include <final/fcolorpair.h>
 #include <final/fcombobox.h>
 #include <final/fcharmap.h>
@@ -53,6 +59,7 @@
 #include <final/flistview.h>
 #include <final/flog.h>
 #include <final/flogger.h>
+#include <final/fasynclogger.h>
 #include <final/fmenubar.h>
 #include <final/fmenu.h>
 #include <final/fmenuitem.h>
@@ -67,11 +74,13 @@
 #include <final/frect.h>
 #include <final/fscrollbar.h>
 #include <final/fscrollview.h>
+#include <final/fsearchindex.h>
 #include <final/fsize.h>
 #include <final/fspinbox.h>
 #include <final/fstartoptions.h>
 #include <final/fstatusbar.h>
 #include <final/fstring.h>
+#include <final/fstringbuilder.h>
 #include <final/fstyle.h>
 #include <final/fswitch.h>
 #include <final/fsystem.h>
@@ -83,15 +92,18 @@
 #include <final/ftermdebugdata.h>
 #include <final/ftermdetection.h>
 #include <final/ftermios.h>
+#include <final/ftermrecorder.h>
 #include <final/ftermxterminal.h>
 #include <final/ftextview.h>
 #include <final/ftogglebutton.h>
 #include <final/ftooltip.h>
+#include <final/futf8.h>
 #include <final/ftypes.h>
 #include <final/fvterm.h>
 #include <final/fwidgetcolors.h>
 #include <final/fwidget.h>
 #include <final/fwindow.h>
+#include <final/fworkerpool.h>
 
 #if defined(UNIT_TEST)
   #include <final/ftermlinux.h>
@@ -0,0 +1,272 @@
+/***********************************************************************
+* finstrumentation.h - Counters and timers for the drawing hot paths   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FInstrumentation ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  The probes are disabled by default and then cost a single test
+ *  of a boolean. When enabled, each probe counts its calls and,
+ *  if it is a timed probe, measures the time spent in it. The
+ *  counters of the running frame are added to the totals when the
+ *  output is flushed to the terminal, the values of the last frame
+ *  remain available until the next flush.
+ *
+ *  A dump of the counters can be requested by a signal. The signal
+ *  handler only sets a flag, the event loop writes the dump to the
+ *  log or to a listening Unix domain socket.
+ */
+
+#ifndef FINSTRUMENTATION_H
+#define FINSTRUMENTATION_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <ostream>
+#include <string>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FInstrumentation
+//----------------------------------------------------------------------
+
+class FInstrumentation final
+{
+  public:
+    // Enumeration
+    enum Probe
+    {
+      UpdateVTerm,      // FVTerm::updateVTerm() (timed)
+      PutArea,          // FVTerm::putArea() (timed)
+      UpdateTerminal,   // FVTerm::updateTerminal() (timed)
+      Flush,            // FVTerm::flush() (timed, amount = bytes)
+      ChangeAttribute,  // FOptiAttr::changeAttribute()
+      MoveCursor,       // FOptiMove::moveCursor()
+      TimerDispatch,    // Timer event dispatches (timed)
+      Event,            // Events sent by FApplication::sendEvent()
+      WidgetRedraw,     // FWidget::redraw() with its children (timed)
+      OutputBlocked,    // Terminal writes that would block
+      FrameSkipped,     // Frames skipped because of a blocked output
+      NumberOfProbes
+    };
+
+    struct Counter
+    {
+      uInt64 count{0};
+      uInt64 amount{0};
+      uInt64 total_time{0};  // in nanoseconds
+      uInt64 max_time{0};    // in nanoseconds
+    };
+
+    class ScopedTimer;
+
+    // Typedef
+    typedef std::array<Counter, NumberOfProbes> Counters;
+
+    // Accessors
+    static FString             getClassName();
+    static Counter             getCounter (Probe);
+    static const Counter&      getFrameCounter (Probe);
+    static uInt64              getFrameCount();
+    static const char*         getProbeName (Probe);
+    static const std::string&  getDumpSocket();
+
+    // Mutators
+    static void                enable();
+    static void                disable();
+    static void                setDumpSignal (int);
+    static void                setDumpSocket (const std::string&);
+
+    // Inquiry
+    static bool                isEnabled();
+    static bool                isDumpRequested();
+
+    // Methods
+    static void                count (Probe);
+    static void                addAmount (Probe, uInt64);
+    static void                addTime (Probe, uInt64);
+    static void                endFrame();
+    static void                clear();
+    static void                print (std::ostream&);
+    static void                requestDump();
+    static void                clearDumpRequest();
+    static bool                writeToSocket (const std::string&);
+
+  private:
+    // Methods
+    static void                dump_signal_handler (int);
+
+    // Data members
+    static Counters                      frame;
+    static Counters                      last_frame;
+    static Counters                      totals;
+    static uInt64                        frames;
+    static bool                          enabled;
+    static volatile std::sig_atomic_t    dump_request;
+    static std::string                   socket_path;
+};
+
+
+//----------------------------------------------------------------------
+// class FInstrumentation::ScopedTimer
+//----------------------------------------------------------------------
+
+class FInstrumentation::ScopedTimer final
+{
+  public:
+    // Constructor
+    explicit ScopedTimer (Probe);
+
+    // Disable copy constructor
+    ScopedTimer (const ScopedTimer&) = delete;
+
+    // Destructor
+    ~ScopedTimer();
+
+    // Disable copy assignment operator (=)
+    ScopedTimer& operator = (const ScopedTimer&) = delete;
+
+  private:
+    // Typedef
+    using Clock = std::chrono::steady_clock;
+
+    // Data members
+    Clock::time_point  start{};
+    Probe              probe;
+    bool               active;
+};
+
+
+// FInstrumentation inline functions
+//----------------------------------------------------------------------
+inline FString FInstrumentation::getClassName()
+{ return "FInstrumentation"; }
+
+//----------------------------------------------------------------------
+inline const FInstrumentation::Counter&
+    FInstrumentation::getFrameCounter (Probe probe)
+{ return last_frame[probe]; }
+
+//----------------------------------------------------------------------
+inline uInt64 FInstrumentation::getFrameCount()
+{ return frames; }
+
+//----------------------------------------------------------------------
+inline const std::string& FInstrumentation::getDumpSocket()
+{ return socket_path; }
+
+//----------------------------------------------------------------------
+inline void FInstrumentation::enable()
+{ enabled = true; }
+
+//----------------------------------------------------------------------
+inline void FInstrumentation::disable()
+{ enabled = false; }
+
+//----------------------------------------------------------------------
+inline void FInstrumentation::setDumpSocket (const std::string& path)
+{ socket_path = path; }
+
+//----------------------------------------------------------------------
+inline bool FInstrumentation::isEnabled()
+{ return enabled; }
+
+//----------------------------------------------------------------------
+inline bool FInstrumentation::isDumpRequested()
+{ return dump_request != 0; }
+
+//----------------------------------------------------------------------
+inline void FInstrumentation::count (Probe probe)
+{
+  if ( enabled )
+    frame[probe].count++;
+}
+
+//----------------------------------------------------------------------
+inline void FInstrumentation::addAmount (Probe probe, uInt64 amount)
+{
+  if ( enabled )
+    frame[probe].amount += amount;
+}
+
+//----------------------------------------------------------------------
+inline void FInstrumentation::addTime (Probe probe, uInt64 nsec)
+{
+  if ( ! enabled )
+    return;
+
+  auto& counter = frame[probe];
+  counter.total_time += nsec;
+
+  if ( nsec > counter.max_time )
+    counter.max_time = nsec;
+}
+
+//----------------------------------------------------------------------
+inline void FInstrumentation::requestDump()
+{ dump_request = 1; }
+
+//----------------------------------------------------------------------
+inline void FInstrumentation::clearDumpRequest()
+{ dump_request = 0; }
+
+
+// FInstrumentation::ScopedTimer inline functions
+//----------------------------------------------------------------------
+inline FInstrumentation::ScopedTimer::ScopedTimer (Probe p)
+  : probe{p}
+  , active{FInstrumentation::isEnabled()}
+{
+  if ( active )
+    start = Clock::now();
+}
+
+//----------------------------------------------------------------------
+inline FInstrumentation::ScopedTimer::~ScopedTimer()
+{
+  if ( ! active )
+    return;
+
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  const auto time = duration_cast<nanoseconds>(Clock::now() - start);
+  FInstrumentation::count (probe);
+  FInstrumentation::addTime (probe, uInt64(time.count()));
+}
+
+}  // namespace finalcut
+
+#endif  // FINSTRUMENTATION_H
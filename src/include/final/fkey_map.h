@@ -39,7 +39,7 @@ namespace fc
 
 extern std::array<FKeyMap, 188> fkey;
 extern const std::array<FMetakeyMap, 232> fmetakey;
-extern const std::array<FKeyName, 388> fkeyname;
+extern const std::array<FKeyName, 391> fkeyname;
 
 }  // namespace fc
 
@@ -41,6 +41,7 @@
 #include <functional>
 #include <memory>
 #include <queue>
+#include <string>
 
 #include "final/fkey_map.h"
 #include "final/fstring.h"
@@ -110,6 +111,7 @@ class FKeyboard final
     FKey                  getKey() const;
     FString               getKeyName (const FKey) const;
     keybuffer&            getKeyBuffer();
+    const FString&        getPasteText() const;
     timeval*              getKeyPressedTime();
     static uInt64         getKeypressTimeout();
     static uInt64         getReadBlockingTime();
@@ -131,10 +133,13 @@ class FKeyboard final
     void                  setReleaseCommand (const FKeyboardCommand&);
     void                  setEscPressedCommand (const FKeyboardCommand&);
     void                  setMouseTrackingCommand (const FKeyboardCommand&);
+    void                  setPasteCommand (const FKeyboardCommand&);
+    void                  setTermFocusCommand (const FKeyboardCommand&);
 
     // Inquiry
     bool                  hasPendingInput() const;
     bool                  hasDataInQueue() const;
+    bool                  isPasteMode() const;
 
     // Methods
     static void           init();
@@ -153,9 +158,12 @@ class FKeyboard final
     // Constants
     static constexpr FKey NOT_SET = static_cast<FKey>(-1);
     static constexpr std::size_t MAX_QUEUE_SIZE = 32;
+    static constexpr std::size_t PASTE_READ_SIZE = 1024;
+    static constexpr uInt64 PASTE_TIMEOUT = 1000000;  // 1 s
 
     // Accessors
     FKey                  getMouseProtocolKey() const;
+    FKey                  getTermFocusKey();
     FKey                  getTermcapKey();
     FKey                  getMetaKey();
     FKey                  getSingleKey();
@@ -163,24 +171,33 @@ class FKeyboard final
     // Inquiry
     static bool           isKeypressTimeout();
     static bool           isIntervalTimeout();
+    bool                  isPasteStart() const;
 
     // Methods
     FKey                  UTF8decode (const char[]) const;
     ssize_t               readKey();
     void                  parseKeyBuffer();
+    void                  parseFifoBuffer();
     FKey                  parseKeyString();
     FKey                  keyCorrection (const FKey&) const;
     void                  substringKeyHandling();
+    void                  startPasteMode();
+    void                  readPasteData();
+    void                  finishPasteMode();
     void                  keyPressed() const;
     void                  keyReleased() const;
     void                  escapeKeyPressed() const;
     void                  mouseTracking() const;
+    void                  textPasted() const;
+    void                  termFocusChanged() const;
 
     // Data members
     FKeyboardCommand      keypressed_cmd{};
     FKeyboardCommand      keyreleased_cmd{};
     FKeyboardCommand      escape_key_cmd{};
     FKeyboardCommand      mouse_tracking_cmd{};
+    FKeyboardCommand      paste_cmd{};
+    FKeyboardCommand      term_focus_cmd{};
 
 #if defined(__linux__)
     #undef linux
@@ -195,6 +212,9 @@ class FKeyboard final
     static bool           non_blocking_input_support;
     FKeyMapPtr            key_map{};
     std::queue<FKey>      fkey_queue{};
+    std::queue<FString>   paste_queue{};
+    std::string           paste_buffer{};
+    FString               paste_text{};
     FKey                  fkey{0};
     FKey                  key{0};
     char                  read_character{};
@@ -207,6 +227,7 @@ class FKeyboard final
     bool                  utf8_input{false};
     bool                  mouse_support{true};
     bool                  non_blocking_stdin{false};
+    bool                  paste_mode{false};
 };
 
 // FKeyboard inline functions
@@ -222,6 +243,10 @@ inline FKey FKeyboard::getKey() const
 inline FKeyboard::keybuffer& FKeyboard::getKeyBuffer()
 { return fifo_buf; }
 
+//----------------------------------------------------------------------
+inline const FString& FKeyboard::getPasteText() const
+{ return paste_text; }
+
 //----------------------------------------------------------------------
 inline timeval* FKeyboard::getKeyPressedTime()
 { return &time_keypressed; }
@@ -267,6 +292,10 @@ inline bool FKeyboard::hasPendingInput() const
 inline bool FKeyboard::hasDataInQueue() const
 { return ! fkey_queue.empty(); }
 
+//----------------------------------------------------------------------
+inline bool FKeyboard::isPasteMode() const
+{ return paste_mode; }
+
 //----------------------------------------------------------------------
 inline void FKeyboard::enableUTF8()
 { utf8_input = true; }
@@ -299,6 +328,14 @@ inline void FKeyboard::setEscPressedCommand (const FKeyboardCommand& cmd)
 inline void FKeyboard::setMouseTrackingCommand (const FKeyboardCommand& cmd)
 { mouse_tracking_cmd = cmd; }
 
+//----------------------------------------------------------------------
+inline void FKeyboard::setPasteCommand (const FKeyboardCommand& cmd)
+{ paste_cmd = cmd; }
+
+//----------------------------------------------------------------------
+inline void FKeyboard::setTermFocusCommand (const FKeyboardCommand& cmd)
+{ term_focus_cmd = cmd; }
+
 }  // namespace finalcut
 
 #endif  // FKEYBOARD_H
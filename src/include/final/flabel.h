@@ -65,6 +65,9 @@ class FLabel : public FWidget
     // Using-declaration
     using FWidget::setEnable;
 
+    // Type tag
+    static const FTypeTag<FLabel> type_tag;
+
     // Constructor
     explicit FLabel (FWidget* = nullptr);
     explicit FLabel (const FString&, FWidget* = nullptr);
@@ -88,6 +91,7 @@ class FLabel : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     FWidget*            getAccelWidget();
     fc::text_alignment  getAlignment() const;
     FString&            getText();
@@ -168,6 +172,10 @@ inline FLabel& FLabel::operator << (const typeT& s)
 inline FString FLabel::getClassName() const
 { return "FLabel"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FLabel::getTypeId() const
+{ return getTypeIdOf<FLabel>(); }
+
 //----------------------------------------------------------------------
 inline FWidget* FLabel::getAccelWidget ()
 { return accel_widget; }
@@ -81,6 +81,9 @@ class FLineEdit : public FWidget
       password  = 1
     };
 
+    // Type tag
+    static const FTypeTag<FLineEdit> type_tag;
+
     // Constructor
     explicit FLineEdit (FWidget* = nullptr);
     explicit FLineEdit (const FString&, FWidget* = nullptr);
@@ -104,6 +107,7 @@ class FLineEdit : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     FString             getText() const;
     std::size_t         getMaxLength() const;
     std::size_t         getCursorPosition() const;
@@ -148,6 +152,7 @@ class FLineEdit : public FWidget
 
     // Event handlers
     void                onKeyPress (FKeyEvent*) override;
+    void                onPaste (FPasteEvent*) override;
     void                onMouseDown (FMouseEvent*) override;
     void                onMouseUp (FMouseEvent*) override;
     void                onMouseMove (FMouseEvent*) override;
@@ -199,6 +204,7 @@ class FLineEdit : public FWidget
     void                switchInsertMode();
     void                acceptInput();
     bool                keyInput (FKey);
+    bool                pasteInput (const FString&);
     wchar_t             characterFilter (const wchar_t) const;
     void                processActivate();
     void                processChanged() const;
@@ -240,6 +246,10 @@ inline FLineEdit& FLineEdit::operator << (const typeT& s)
 inline FString FLineEdit::getClassName() const
 { return "FLineEdit"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FLineEdit::getTypeId() const
+{ return getTypeIdOf<FLineEdit>(); }
+
 //----------------------------------------------------------------------
 inline FString FLineEdit::getText() const
 { return text; }
@@ -48,6 +48,7 @@
   #error "Only <final/final.h> can be included directly."
 #endif
 
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -55,6 +56,7 @@
 
 #include "final/fdata.h"
 #include "final/fscrollbar.h"
+#include "final/fsearchindex.h"
 #include "final/fwidget.h"
 
 
@@ -62,6 +64,7 @@ namespace finalcut
 {
 
 // class forward declaration
+class FListBox;
 class FScrollbar;
 class FString;
 
@@ -108,6 +111,8 @@ class FListBoxItem
     // Data members
     FString               text{};
     FDataAccessPtr        data_pointer{};
+    FListBox*             listbox{nullptr};  // Owner, notified of changes
+    std::size_t           line_width{0};  // Width counted by FListBox
     fc::brackets_type     brackets{fc::NoBrackets};
     bool                  selected{false};
 
@@ -139,10 +144,6 @@ inline clean_fdata_t<DT>& FListBoxItem::getData() const
   return static_cast<FData<clean_fdata_t<DT>>&>(*data_pointer).get();
 }
 
-//----------------------------------------------------------------------
-inline void FListBoxItem::setText (const FString& txt)
-{ text.setString(txt); }
-
 //----------------------------------------------------------------------
 template <typename DT>
 inline void FListBoxItem::setData (DT&& data)
@@ -155,10 +156,6 @@ inline void FListBoxItem::setData (DT&& data)
 inline bool FListBoxItem::isSelected() const
 { return selected; }
 
-//----------------------------------------------------------------------
-inline void FListBoxItem::clear()
-{ text.clear(); }
-
 
 //----------------------------------------------------------------------
 // class FListBox
@@ -173,6 +170,9 @@ class FListBox : public FWidget
     // Typedef
     typedef std::vector<FListBoxItem> FListBoxItems;
 
+    // Type tag
+    static const FTypeTag<FListBox> type_tag;
+
     // Constructor
     explicit FListBox (FWidget* = nullptr);
     template <typename Iterator
@@ -193,6 +193,7 @@ class FListBox : public FWidget
 
     // Accessors
     FString              getClassName() const override;
+    FTypeId              getTypeId() const override;
     std::size_t          getCount() const;
     FListBoxItem&        getItem (std::size_t);
     const FListBoxItem&  getItem (std::size_t) const;
@@ -219,13 +220,22 @@ class FListBox : public FWidget
     void                 setMultiSelection (bool);
     void                 setMultiSelection ();
     void                 unsetMultiSelection ();
+    void                 setPasteInsertion (bool);
+    void                 setPasteInsertion ();
+    void                 unsetPasteInsertion ();
     bool                 setDisable() override;
     void                 setText (const FString&);
+    void                 setFilter ( const FString&
+                                   , FSearchIndex::MatchMode \
+                                         = FSearchIndex::SubstringMatch );
+    void                 clearFilter();
 
     // Inquiries
+    bool                 isFiltered() const;
     bool                 isSelected (std::size_t) const;
     bool                 isSelected (FListBoxItems::iterator) const;
     bool                 isMultiSelection() const;
+    bool                 isPasteInsertion() const;
     bool                 hasBrackets (std::size_t) const;
     bool                 hasBrackets (FListBoxItems::iterator) const;
 
@@ -243,6 +253,7 @@ class FListBox : public FWidget
             , typename LazyConverter>
     void                 insert (Container*, const LazyConverter&);
     void                 insert (const FListBoxItem&);
+    void                 insert (const FListBoxItems&);
     template <typename T
             , typename DT = std::nullptr_t>
     void                 insert ( const std::initializer_list<T>& list
@@ -256,11 +267,15 @@ class FListBox : public FWidget
                                 , bool = false
                                 , DT&& = DT() );
     void                 remove (std::size_t);
+    void                 remove (std::size_t, std::size_t);
+    void                 replace (std::size_t, const FListBoxItem&);
+    void                 replace (const FListBoxItems&);
     void                 reserve (std::size_t);
     void                 clear();
 
     // Event handlers
     void                 onKeyPress (FKeyEvent*) override;
+    void                 onPaste (FPasteEvent*) override;
     void                 onMouseDown (FMouseEvent*) override;
     void                 onMouseUp (FMouseEvent*) override;
     void                 onMouseMove (FMouseEvent*) override;
@@ -280,6 +295,18 @@ class FListBox : public FWidget
     typedef std::unordered_map<int, std::function<void()>> KeyMap;
     typedef std::unordered_map<int, std::function<bool()>> KeyMapResult;
     typedef std::function<void(FListBoxItem&, FDataAccess*, std::size_t)> LazyInsert;
+    typedef std::map<std::size_t, std::size_t> LineWidthCount;
+
+    struct FilterData
+    {
+      FListBoxItems            items{};  // All items
+      FSearchIndex             index{};
+      LineWidthCount           line_width_count{};
+      std::vector<std::size_t> positions{};  // Positions of the shown items
+      FString                  pattern{};
+      FSearchIndex::MatchMode  mode{FSearchIndex::SubstringMatch};
+      bool                     active{false};
+    };
 
     // Enumeration
     enum convert_type
@@ -312,7 +339,16 @@ class FListBox : public FWidget
     void                 setLineAttributes (int, bool, bool, bool&);
     void                 unsetAttributes() const;
     void                 updateDrawing (bool, bool);
-    void                 recalculateHorizontalBar (std::size_t, bool);
+    void                 appendItem (const FListBoxItem&);
+    void                 bindItems();
+    std::size_t          getItemPosition (const FListBoxItem&) const;
+    void                 changeItemText (FListBoxItem&, const FString&);
+    void                 removeItems (std::size_t, std::size_t);
+    void                 addLineWidth (FListBoxItem&);
+    void                 removeLineWidth (const FListBoxItem&);
+    void                 rebuildLineWidths();
+    void                 afterInsertion();
+    void                 recalculateHorizontalBar();
     void                 recalculateVerticalBar (std::size_t) const;
     void                 getWidgetFocus();
     void                 multiSelection (std::size_t);
@@ -344,6 +380,12 @@ class FListBox : public FWidget
     bool                 changeSelectionAndPosition();
     bool                 deletePreviousCharacter();
     bool                 keyIncSearchInput (FKey);
+    std::size_t          findIncSearchItem (const FString&);
+    void                 buildSearchIndex();
+    void                 applyFilter();
+    void                 reapplyFilter();
+    void                 restoreFilteredItems();
+    void                 afterFilterChange();
     void                 processClick() const;
     void                 processSelect() const;
     void                 processChanged() const;
@@ -360,6 +402,9 @@ class FListBox : public FWidget
 
     // Data members
     FListBoxItems   itemlist{};
+    LineWidthCount  line_width_count{};
+    FSearchIndex    search_index{};
+    FilterData      filter{};
     FDataAccess*    source_container{nullptr};
     FScrollbarPtr   vbar{nullptr};
     FScrollbarPtr   hbar{nullptr};
@@ -380,9 +425,13 @@ class FListBox : public FWidget
     std::size_t     nf_offset{0};
     std::size_t     max_line_width{0};
     bool            multi_select{false};
+    bool            paste_insertion{false};
     bool            mouse_select{false};
     bool            scroll_timer{false};
     bool            click_on_list{false};
+
+    // Friend class
+    friend class FListBoxItem;
 };
 
 // non-member function
@@ -409,12 +458,7 @@ inline FListBox::FListBox ( Iterator first
   : FWidget{parent}
 {
   init();
-
-  while ( first != last )
-  {
-    insert(convert(first), fc::NoBrackets, false, &(*first));
-    ++first;
-  }
+  insert (first, last, convert);
 }
 
 //----------------------------------------------------------------------
@@ -433,6 +477,10 @@ inline FListBox::FListBox ( Container container
 inline FString FListBox::getClassName() const
 { return "FListBox"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FListBox::getTypeId() const
+{ return getTypeIdOf<FListBox>(); }
+
 //----------------------------------------------------------------------
 inline std::size_t FListBox::getCount() const
 { return itemlist.size(); }
@@ -511,10 +559,26 @@ inline void FListBox::setMultiSelection()
 inline void FListBox::unsetMultiSelection()
 { setMultiSelection(false); }
 
+//----------------------------------------------------------------------
+inline void FListBox::setPasteInsertion (bool enable)
+{ paste_insertion = enable; }
+
+//----------------------------------------------------------------------
+inline void FListBox::setPasteInsertion()
+{ setPasteInsertion(true); }
+
+//----------------------------------------------------------------------
+inline void FListBox::unsetPasteInsertion()
+{ setPasteInsertion(false); }
+
 //----------------------------------------------------------------------
 inline bool FListBox::setDisable()
 { return setEnable(false); }
 
+//----------------------------------------------------------------------
+inline bool FListBox::isFiltered() const
+{ return filter.active; }
+
 //----------------------------------------------------------------------
 inline bool FListBox::isSelected (std::size_t index) const
 { return index2iterator(index - 1)->selected; }
@@ -527,6 +591,10 @@ inline bool FListBox::isSelected (FListBoxItems::iterator iter) const
 inline bool FListBox::isMultiSelection() const
 { return multi_select; }
 
+//----------------------------------------------------------------------
+inline bool FListBox::isPasteInsertion() const
+{ return paste_insertion; }
+
 //----------------------------------------------------------------------
 inline bool FListBox::hasBrackets(std::size_t index) const
 { return bool(index2iterator(index - 1)->brackets > 0); }
@@ -537,7 +605,10 @@ inline bool FListBox::hasBrackets(FListBoxItems::iterator iter) const
 
 //----------------------------------------------------------------------
 inline void FListBox::reserve (std::size_t new_cap)
-{ itemlist.reserve(new_cap); }
+{
+  itemlist.reserve(new_cap);
+  bindItems();  // The items may have been copied
+}
 
 //----------------------------------------------------------------------
 template <typename Iterator
@@ -550,9 +621,11 @@ inline void FListBox::insert ( Iterator first
 
   while ( first != last )
   {
-    insert (convert(first), fc::NoBrackets, false, &(*first));
+    appendItem (FListBoxItem(FString() << convert(first), &(*first)));
     ++first;
   }
+
+  afterInsertion();
 }
 
 //----------------------------------------------------------------------
@@ -565,8 +638,16 @@ void FListBox::insert (const Container& container, const LazyConverter& converte
   lazy_inserter = converter;
   const std::size_t size = container.size();
 
+  restoreFilteredItems();
+  filter.pattern.clear();  // No filter for lazy conversion
+  search_index.invalidate();
+
   if ( size > 0 )
+  {
     itemlist.resize(size);
+    bindItems();
+    rebuildLineWidths();
+  }
 
   recalculateVerticalBar(size);
 }
@@ -592,8 +673,10 @@ void FListBox::insert ( const std::initializer_list<T>& list
     FListBoxItem listItem (FString() << item, std::forward<DT>(d));
     listItem.brackets = b;
     listItem.selected = s;
-    insert (listItem);
+    appendItem (listItem);
   }
+
+  afterInsertion();
 }
 
 //----------------------------------------------------------------------
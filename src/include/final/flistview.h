@@ -55,6 +55,7 @@
 
 #include "final/fdata.h"
 #include "final/fscrollbar.h"
+#include "final/fsearchindex.h"
 #include "final/ftermbuffer.h"
 #include "final/ftypes.h"
 #include "final/fwidget.h"
@@ -74,6 +75,9 @@ class FString;
 class FListViewItem : public FObject
 {
   public:
+    // Type tag
+    static const FTypeTag<FListViewItem> type_tag;
+
     // Constructor
     FListViewItem (const FListViewItem&);  // copy constructor
     explicit FListViewItem (iterator);
@@ -88,6 +92,7 @@ class FListViewItem : public FObject
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     uInt                getColumnCount() const;
     int                 getSortColumn() const;
     FString             getText (int) const;
@@ -128,12 +133,17 @@ class FListViewItem : public FObject
     void                replaceControlCodes();
     std::size_t         getVisibleLines();
     void                resetVisibleLineCounter();
+    FListView*          getListView() const;
+    void                updateSearchIndex (int, const FString&) const;
+    static uInt64       newLineCacheId();
 
     // Data members
     FStringList         column_list{};
     FDataAccessPtr      data_pointer{};
     iterator            root{};
+    uInt64              line_cache_id{newLineCacheId()};  // cached row
     std::size_t         visible_lines{1};
+    std::size_t         search_position{0};  // Set by FListView
     bool                expandable{false};
     bool                is_expand{false};
     bool                checkable{false};
@@ -166,6 +176,10 @@ inline FListViewItem::FListViewItem ( const FStringList& cols
 inline FString FListViewItem::getClassName() const
 { return "FListViewItem"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FListViewItem::getTypeId() const
+{ return getTypeIdOf<FListViewItem>(); }
+
 //----------------------------------------------------------------------
 inline uInt FListViewItem::getColumnCount() const
 { return uInt(column_list.size()); }
@@ -299,6 +313,9 @@ class FListView : public FWidget
     // Typedef
     typedef std::list<FListViewItem*>  FListViewItems;
 
+    // Type tag
+    static const FTypeTag<FListView> type_tag;
+
     // Constructor
     explicit FListView (FWidget* = nullptr);
 
@@ -313,6 +330,7 @@ class FListView : public FWidget
 
     // Accessors
     FString               getClassName() const override;
+    FTypeId               getTypeId() const override;
     std::size_t           getCount() const;
     fc::text_alignment    getColumnAlignment (int) const;
     FString               getColumnText (int) const;
@@ -340,6 +358,9 @@ class FListView : public FWidget
     bool                  setTreeView();
     bool                  unsetTreeView();
 
+    // Inquiry
+    bool                  isUpdating() const;
+
     // Methods
     virtual int           addColumn (const FString&, int = USE_MAX_SIZE);
     void                  hide() override;
@@ -380,6 +401,9 @@ class FListView : public FWidget
                                  , iterator );
     void                  remove (FListViewItem*);
     void                  clear();
+    FListViewItem*        findItem (const FString&, int = 1);
+    void                  beginUpdate();
+    void                  endUpdate();
     FListViewItems&       getData();
     const FListViewItems& getData() const;
 
@@ -414,12 +438,25 @@ class FListView : public FWidget
     struct Header;  // forward declaration
     typedef std::vector<Header> HeaderItems;
     typedef std::vector<fc::sorting_type> SortTypes;
+    typedef std::vector<FListViewItem*> SearchItems;
+    typedef bool (*CompareFunction) (const FObject*, const FObject*);
+
+    struct LineCache  // Row of a visible item
+    {
+      FTermBuffer line{};
+      uInt64      item_id{0};  // line_cache_id of the item
+      uInt64      key{0};      // Column layout and item state
+      uInt64      pass{0};     // drawList() pass of the last use
+    };
+
+    typedef std::unordered_map<const FListViewItem*, LineCache> LineCacheMap;
 
     // Constants
     static constexpr int USE_MAX_SIZE = -1;
 
     // Accessors
     static iterator&      getNullIterator();
+    CompareFunction       getSortCompare() const;
 
     // Mutators
     static void           setNullIterator (const iterator&);
@@ -427,6 +464,7 @@ class FListView : public FWidget
     // Inquiry
     bool                  isHorizontallyScrollable() const;
     bool                  isVerticallyScrollable() const;
+    bool                  isSortOutdated() const;
 
     // Methods
     void                  init();
@@ -443,9 +481,13 @@ class FListView : public FWidget
     void                  drawScrollbars() const;
     void                  drawHeadlines();
     void                  drawList();
-    void                  drawListLine (const FListViewItem*, bool, bool);
+    void                  drawListLine (FListViewItem*, bool, bool);
+    void                  buildListLine (const FListViewItem*, FTermBuffer&);
     void                  clearList();
     void                  setLineAttributes (bool, bool) const;
+    void                  updateLineLayoutKey();
+    uInt64                getLineCacheKey (const FListViewItem*) const;
+    static void           changeLineColors (FTermBuffer&);
     FString               getCheckBox (const FListViewItem* item) const;
     FString               getLinePrefix (const FListViewItem*, std::size_t) const;
     void                  drawSortIndicator (std::size_t&, std::size_t);
@@ -469,6 +511,13 @@ class FListView : public FWidget
     void                  dragDown (int);
     void                  stopDragScroll();
     iterator              appendItem (FListViewItem*);
+    iterator              moveToSortPosition (FObjectList&, iterator);
+    void                  buildSearchIndex (int);
+    void                  invalidateSearchIndex();
+    void                  insertSearchItem (const FObjectList&, const_iterator);
+    void                  replaceSearchItem ( const FListViewItem*, int
+                                            , const FString& );
+    void                  addSearchItem (FListViewItem*);
     void                  processClick() const;
     void                  processChanged() const;
     void                  changeOnResize() const;
@@ -511,15 +560,23 @@ class FListView : public FWidget
     FPoint                clicked_header_pos{-1, -1};
     KeyMap                key_map{};
     KeyMapResult          key_map_result{};
+    FSearchIndex          search_index{};
+    SearchItems           search_items{};
     const FListViewItem*  clicked_checkbox_item{nullptr};
     std::size_t           nf_offset{0};
     std::size_t           max_line_width{1};
+    LineCacheMap          line_cache{};
+    uInt64                line_cache_pass{0};
+    uInt64                line_layout_key{0};
     fc::dragScroll        drag_scroll{fc::noScroll};
     int                   first_line_position_before{-1};
     int                   scroll_repeat{100};
     int                   scroll_distance{1};
     int                   xoffset{0};
     int                   sort_column{-1};
+    int                   search_column{-1};
+    int                   sorted_column{-1};
+    int                   update_depth{0};
     fc::sorting_order     sort_order{fc::unsorted};
     bool                  scroll_timer{false};
     bool                  tree_view{false};
@@ -529,6 +586,7 @@ class FListView : public FWidget
     // Function Pointer
     bool (*user_defined_ascending) (const FObject*, const FObject*){nullptr};
     bool (*user_defined_descending) (const FObject*, const FObject*){nullptr};
+    CompareFunction       sorted_by{nullptr};
 
     // Friend class
     friend class FListViewItem;
@@ -557,6 +615,10 @@ struct FListView::Header
 inline FString FListView::getClassName() const
 { return "FListView"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FListView::getTypeId() const
+{ return getTypeIdOf<FListView>(); }
+
 //----------------------------------------------------------------------
 inline fc::sorting_order FListView::getSortOrder() const
 { return sort_order; }
@@ -595,6 +657,10 @@ inline bool FListView::setTreeView()
 inline bool FListView::unsetTreeView()
 { return setTreeView(false); }
 
+//----------------------------------------------------------------------
+inline bool FListView::isUpdating() const
+{ return update_depth > 0; }
+
 //----------------------------------------------------------------------
 inline FObject::iterator FListView::insert (FListViewItem* item)
 { return insert (item, root); }
@@ -731,6 +797,13 @@ inline bool FListView::isHorizontallyScrollable() const
 inline bool FListView::isVerticallyScrollable() const
 { return bool( getCount() > getClientHeight() ); }
 
+//----------------------------------------------------------------------
+inline bool FListView::isSortOutdated() const
+{
+  return sorted_by != getSortCompare()
+      || ( sorted_by && sorted_column != sort_column );
+}
+
 //----------------------------------------------------------------------
 inline void FListView::scrollTo (const FPoint& pos)
 { scrollTo(pos.getX(), pos.getY()); }
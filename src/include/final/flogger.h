@@ -51,6 +51,7 @@
 #include <string>
 
 #include <chrono>
+#include <ctime>
 #include <iomanip>
 
 #include "final/flog.h"
@@ -83,15 +84,27 @@ class FLogger : public FLog
     void enableTimestamp() override;
     void disableTimestamp() override;
 
-  private:
+  protected:
+    // Accessors
+    const std::string& getTimeString (std::time_t);
+    const char*        getEOL();
+    std::ostream&      getOutputStream();
+
+    // Inquiry
+    bool               isTimestamp() const;
+
     // Methods
-    void              newlineReplace (std::string&, const std::string&) const;
-    std::string       getTimeString() const;
-    std::string       getEOL();
-    void              printLogLine (const std::string&);
+    static const char* getLevelString (LogLevel);
+    void               printLogLine (const std::string&);
+    void               printLogLine ( const std::string&
+                                    , const std::string& );
 
+  private:
     // Data member
     bool         timestamp{false};
+    std::time_t  time_cache{static_cast<std::time_t>(-1)};
+    std::string  time_string{};
+    std::string  line_buffer{};
     std::ostream output{std::cerr.rdbuf()};
 };
 
@@ -167,6 +180,14 @@ inline void FLogger::disableTimestamp()
   timestamp = false;
 }
 
+//----------------------------------------------------------------------
+inline std::ostream& FLogger::getOutputStream()
+{ return output; }
+
+//----------------------------------------------------------------------
+inline bool FLogger::isTimestamp() const
+{ return timestamp; }
+
 }  // namespace finalcut
 
 #endif  // FLOGGER_H
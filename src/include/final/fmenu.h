@@ -77,6 +77,9 @@ class FMenu : public FWindow, public FMenuList
     using FMenuList::getItem;
     using FMenuList::isSelected;
 
+    // Type tag
+    static const FTypeTag<FMenu> type_tag;
+
     // Constructor
     explicit FMenu (FWidget* = nullptr);
     explicit FMenu (const FString&, FWidget* = nullptr);
@@ -92,6 +95,7 @@ class FMenu : public FWindow, public FMenuList
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     FString             getText() const;
     FMenuItem*          getItem();
 
@@ -251,6 +255,10 @@ std::tuple<bool, bool> closeOpenMenus (FMenu*, const FPoint&);
 inline FString FMenu::getClassName() const
 { return "FMenu"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FMenu::getTypeId() const
+{ return getTypeIdOf<FMenu>(); }
+
 //----------------------------------------------------------------------
 inline FString FMenu::getText() const
 { return menuitem.getText(); }
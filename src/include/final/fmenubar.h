@@ -70,6 +70,9 @@ class FMenu;
 class FMenuBar : public FWindow, public FMenuList
 {
   public:
+    // Type tag
+    static const FTypeTag<FMenuBar> type_tag;
+
     // Constructor
     explicit FMenuBar (FWidget* = nullptr);
 
@@ -84,6 +87,7 @@ class FMenuBar : public FWindow, public FMenuList
 
     // Accessors
     FString       getClassName() const override;
+    FTypeId       getTypeId() const override;
 
     // Methods
     void          resetColors() override;
@@ -160,6 +164,10 @@ class FMenuBar : public FWindow, public FMenuList
 inline FString FMenuBar::getClassName() const
 { return "FMenuBar"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FMenuBar::getTypeId() const
+{ return getTypeIdOf<FMenuBar>(); }
+
 //----------------------------------------------------------------------
 inline bool FMenuBar::isMenu (const FMenuItem* mi) const
 { return mi->hasMenu(); }
@@ -73,6 +73,9 @@ class FMenuItem : public FWidget
     using FWidget::delAccelerator;
     using FWidget::setEnable;
 
+    // Type tag
+    static const FTypeTag<FMenuItem> type_tag;
+
     // Constructor
     explicit FMenuItem (FWidget* = nullptr);
     explicit FMenuItem (const FString&, FWidget* = nullptr);
@@ -89,6 +92,7 @@ class FMenuItem : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     FKey                getHotkey() const;
     FMenu*              getMenu() const;
     std::size_t         getTextLength() const;
@@ -199,6 +203,10 @@ class FMenuItem : public FWidget
 inline FString FMenuItem::getClassName() const
 { return "FMenuItem"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FMenuItem::getTypeId() const
+{ return getTypeIdOf<FMenuItem>(); }
+
 //----------------------------------------------------------------------
 inline FKey FMenuItem::getHotkey() const
 { return hotkey; }
@@ -88,6 +88,9 @@ class FMessageBox : public FDialog
       Ignore = 7
     };
 
+    // Type tag
+    static const FTypeTag<FMessageBox> type_tag;
+
     // Constructors
     explicit FMessageBox (FWidget* = nullptr);
     FMessageBox (const FMessageBox&);  // copy constructor
@@ -102,6 +105,7 @@ class FMessageBox : public FDialog
 
     // Accessor
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     FString             getTitlebarText() const;
     FString             getHeadline() const;
     FString             getText() const override;
@@ -169,6 +173,10 @@ class FMessageBox : public FDialog
 inline FString FMessageBox::getClassName() const
 { return "FMessageBox"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FMessageBox::getTypeId() const
+{ return getTypeIdOf<FMessageBox>(); }
+
 //----------------------------------------------------------------------
 inline FString FMessageBox::getTitlebarText() const
 {
@@ -68,7 +68,7 @@
 #include <cstddef>
 #include <functional>
 #include <map>
-#include <queue>
+#include <vector>
 
 #include "final/fkeyboard.h"
 #include "final/fpoint.h"
@@ -583,7 +583,7 @@ class FMouseControl
   private:
     // Typedef
     typedef std::map<FMouse::mouse_type, FMouse*> FMouseProtocol;
-    typedef std::unique_ptr<FMouseData> FMouseDataPtr;
+    typedef std::vector<FMouseData> FMouseDataQueue;
 
     // Accessor
     FMouse*                   getMouseWithData();
@@ -595,7 +595,8 @@ class FMouseControl
     // Data member
     FMouseProtocol            mouse_protocol{};
     FMouseCommand             event_cmd{};
-    std::queue<FMouseDataPtr> fmousedata_queue{};
+    FMouseDataQueue           fmousedata_queue{};
+    std::size_t               queue_pos{0};
     FPoint                    zero_point{0, 0};
     bool                      use_gpm_mouse{false};
     bool                      use_xterm_mouse{false};
@@ -612,7 +613,7 @@ inline void FMouseControl::setEventCommand (const FMouseCommand& cmd)
 
 //----------------------------------------------------------------------
 inline bool FMouseControl::hasDataInQueue() const
-{ return ! fmousedata_queue.empty(); }
+{ return queue_pos < fmousedata_queue.size(); }
 
 //----------------------------------------------------------------------
 inline void FMouseControl::enableXTermMouse() const
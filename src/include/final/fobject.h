@@ -28,6 +28,27 @@
  * ▕▁▁▁▁▁▁▁▁▁▏
  */
 
+/*  Every library class that overrides getClassName() also returns
+ *  its own type ID with getTypeId(). The type ID is the address of
+ *  the static type_tag member, which is defined once in the .cpp
+ *  file of the class. It is therefore the same in the library and
+ *  in the application, also with DLLs or hidden symbol visibility.
+ *  isInstanceOf<T>() and cast<T>() compare these IDs without
+ *  creating a string. They match the most derived class that
+ *  overrides getTypeId(), but not its base classes. A derived class
+ *  that overrides only getClassName() keeps the type ID of its base
+ *  class, so isInstanceOf<Base>() is true for it while
+ *  isInstanceOf("Base") is false. To get an own type, declare
+ *
+ *    static const FTypeTag<MyDialog> type_tag;
+ *    FTypeId getTypeId() const override
+ *    { return getTypeIdOf<MyDialog>(); }
+ *
+ *  in the class and define the tag in its .cpp file:
+ *
+ *    const FTypeTag<MyDialog> MyDialog::type_tag{};
+ */
+
 #ifndef FOBJECT_H
 #define FOBJECT_H
 
@@ -46,6 +67,7 @@
 #include <cstring>
 #include <list>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 #include "final/fstring.h"
@@ -56,6 +78,7 @@ namespace finalcut
 // class forward declaration
 class FEvent;
 class FKeyEvent;
+class FPasteEvent;
 class FMouseEvent;
 class FWheelEvent;
 class FFocusEvent;
@@ -66,6 +89,16 @@ class FCloseEvent;
 class FTimerEvent;
 class FUserEvent;
 
+//----------------------------------------------------------------------
+// struct FTypeTag
+//----------------------------------------------------------------------
+
+template <typename T>
+struct FTypeTag final
+{
+  // Type of the type_tag member of class T
+};
+
 //----------------------------------------------------------------------
 // class FObject
 //----------------------------------------------------------------------
@@ -79,10 +112,14 @@ class FObject
     using const_iterator  = FObjectList::const_iterator;
     using reference       = FObjectList::reference;
     using const_reference = FObjectList::const_reference;
+    using FTypeId         = const void*;
 
     // Constants
     static constexpr auto UNLIMITED = static_cast<std::size_t>(-1);
 
+    // Type tag
+    static const FTypeTag<FObject> type_tag;
+
     // Constructor
     explicit FObject (FObject* = nullptr);
 
@@ -97,6 +134,9 @@ class FObject
 
     // Accessors
     virtual FString       getClassName() const;
+    virtual FTypeId       getTypeId() const;
+    template <typename T>
+    static FTypeId        getTypeIdOf();
     FObject*              getParent() const;
     FObject*              getChild (int) const;
     FObjectList&          getChildren();
@@ -122,13 +162,21 @@ class FObject
     bool                  isDirectChild (const FObject*) const;
     bool                  isWidget() const;
     bool                  isInstanceOf (const FString&) const;
+    template <typename T>
+    bool                  isInstanceOf() const;
     bool                  isTimerInUpdating() const;
 
     // Methods
+    template <typename T>
+    T*                    cast();
+    template <typename T>
+    const T*              cast() const;
     void                  removeParent();
     void                  addChild (FObject*);
     void                  delChild (FObject*);
     void                  setParent (FObject*);
+    void                  moveChildren (FObject*);
+    void                  deleteChildren();
 
     // Event handler
     virtual bool          event (FEvent*);
@@ -167,12 +215,14 @@ class FObject
     virtual void          onUserEvent (FUserEvent*);
 
   private:
-    // Method
+    // Methods
+    void                  linkChild (FObject*);
     virtual void          performTimerAction (FObject*, FEvent*);
 
     // Data members
     FObject*              parent_obj{nullptr};
     FObjectList           children_list{};  // no children yet
+    iterator              child_iter{};     // position in parent list
     std::size_t           max_children{UNLIMITED};
     bool                  has_parent{false};
     bool                  widget_object{false};
@@ -185,6 +235,20 @@ class FObject
 inline FString FObject::getClassName() const
 { return "FObject"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FObject::getTypeId() const
+{ return getTypeIdOf<FObject>(); }
+
+//----------------------------------------------------------------------
+template <typename T>
+inline FObject::FTypeId FObject::getTypeIdOf()
+{
+  static_assert ( std::is_same< decltype(T::type_tag)
+                              , const FTypeTag<T> >::value
+                , "The class has no type tag of its own" );
+  return &T::type_tag;
+}
+
 //----------------------------------------------------------------------
 inline FObject* FObject::getParent() const
 { return parent_obj; }
@@ -261,10 +325,28 @@ inline bool FObject::isWidget() const
 inline bool FObject::isInstanceOf (const FString& classname) const
 { return bool( classname == getClassName() ); }
 
+//----------------------------------------------------------------------
+template <typename T>
+inline bool FObject::isInstanceOf() const
+{ return bool( getTypeId() == getTypeIdOf<T>() ); }
+
 //----------------------------------------------------------------------
 inline bool FObject::isTimerInUpdating() const
 { return timer_modify_lock; }
 
+//----------------------------------------------------------------------
+template <typename T>
+inline T* FObject::cast()
+{
+  // Returns nullptr if the object is not an instance of T
+  return isInstanceOf<T>() ? static_cast<T*>(this) : nullptr;
+}
+
+//----------------------------------------------------------------------
+template <typename T>
+inline const T* FObject::cast() const
+{ return isInstanceOf<T>() ? static_cast<const T*>(this) : nullptr; }
+
 //----------------------------------------------------------------------
 inline FObject::FTimerList* FObject::getTimerList() const
 { return timer_list; }
@@ -38,6 +38,7 @@
 #include <assert.h>
 #include <algorithm>  // need for std::swap
 
+#include "final/fcolorquantizer.h"
 #include "final/fstring.h"
 #include "final/sgr_optimizer.h"
 
@@ -97,8 +98,8 @@ class FOptiAttr final
     // Constructor
     FOptiAttr();
 
-    // Disable copy constructor
-    FOptiAttr (const FOptiAttr&) = delete;
+    // Copy constructor
+    FOptiAttr (const FOptiAttr&);
 
     // Destructor
     ~FOptiAttr();
@@ -115,6 +116,10 @@ class FOptiAttr final
     void          setNoColorVideo (int);
     void          setDefaultColorSupport();
     void          unsetDefaultColorSupport();
+    void          setTrueColorSupport();
+    void          unsetTrueColorSupport();
+    void          setPaletteColor (FColor, int, int, int);
+    void          resetPaletteColors();
     void          set_enter_bold_mode (const char[]);
     void          set_exit_bold_mode (const char[]);
     void          set_enter_dim_mode (const char[]);
@@ -151,12 +156,15 @@ class FOptiAttr final
     void          set_orig_pair (const char[]);
     void          set_orig_orig_colors (const char[]);
 
-    // Inquiry
+    // Inquiries
     static bool   isNormal (const FChar&);
+    bool          hasTrueColorSupport() const;
 
     // Methods
     void          initialize();
+    void          initColorTable();
     static FColor vga2ansi (FColor);
+    FColor        rgb2PaletteColor (FColor);
     const char*   changeAttribute (FChar&, FChar&);
 
   private:
@@ -252,6 +260,7 @@ class FOptiAttr final
     void          change_color (FChar&, FChar&);
     void          change_to_default_color (FChar&, FChar&, FColor&, FColor&);
     void          change_current_color (const FChar&, FColor, FColor);
+    void          change_rgb_color (int, FColor);
     void          resetAttribute (FChar&) const;
     void          reset (FChar&) const;
     bool          caused_reset_attributes (const char[], uChar = all_tests) const;
@@ -305,10 +314,12 @@ class FOptiAttr final
 
     SGRoptimizer    sgr_optimizer{attr_buf};
     AttributeBuffer attr_buf{};
+    FColorQuantizer quantizer{};
 
     int             max_color{1};
     int             attr_without_color{0};
     bool            ansi_default_color{false};
+    bool            true_color{false};
     bool            alt_equal_pc_charset{false};
     bool            monochron{true};
     bool            fake_reverse{false};
@@ -336,6 +347,34 @@ inline void FOptiAttr::setDefaultColorSupport()
 inline void FOptiAttr::unsetDefaultColorSupport()
 { ansi_default_color = false; }
 
+//----------------------------------------------------------------------
+inline void FOptiAttr::setTrueColorSupport()
+{ true_color = true; }
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::unsetTrueColorSupport()
+{ true_color = false; }
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::setPaletteColor (FColor index, int r, int g, int b)
+{ quantizer.setPaletteColor (index, r, g, b); }
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::resetPaletteColors()
+{ quantizer.resetPalette(); }
+
+//----------------------------------------------------------------------
+inline bool FOptiAttr::hasTrueColorSupport() const
+{ return true_color; }
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::initColorTable()
+{ quantizer.initTable (max_color); }
+
+//----------------------------------------------------------------------
+inline FColor FOptiAttr::rgb2PaletteColor (FColor color)
+{ return quantizer.quantize (color, max_color); }
+
 }  // namespace finalcut
 
 #endif  // FOPTIATTR_H
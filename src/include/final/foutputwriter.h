@@ -0,0 +1,155 @@
+/***********************************************************************
+* foutputwriter.h - Non-blocking writer for the terminal output        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FOutputWriter ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  The writer queues the encoded output bytes and writes them to
+ *  the file descriptor without blocking. The descriptor is only
+ *  switched to non-blocking mode during the write, so other users
+ *  of the shared terminal (e.g. the keyboard input) are not
+ *  affected. If the terminal cannot take all bytes (EAGAIN), the
+ *  rest remains queued and flush() returns false. The bytes are
+ *  never discarded, only a write error drops the queue.
+ */
+
+#ifndef FOUTPUTWRITER_H
+#define FOUTPUTWRITER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <string>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FOutputWriter
+//----------------------------------------------------------------------
+
+class FOutputWriter final
+{
+  public:
+    // Constructor
+    explicit FOutputWriter (int);
+
+    // Disable copy constructor
+    FOutputWriter (const FOutputWriter&) = delete;
+
+    // Destructor
+    ~FOutputWriter() = default;
+
+    // Disable copy assignment operator (=)
+    FOutputWriter& operator = (const FOutputWriter&) = delete;
+
+    // Accessors
+    FString             getClassName() const;
+    int                 getFileDescriptor() const;
+    std::size_t         getPendingSize() const;
+    uInt64              getWrittenBytes() const;
+    uInt64              getBlockedCount() const;
+    uInt64              getErrorCount() const;
+
+    // Inquiry
+    bool                hasPendingOutput() const;
+
+    // Methods
+    void                write (char);
+    void                write (const char[], std::size_t);
+    bool                flush();
+    bool                drain();
+    void                clear();
+
+  private:
+    // Constants
+    static constexpr std::size_t COMPACT_SIZE = 65536;
+
+    // Methods
+    bool                writeBuffer (bool);
+
+    // Data members
+    std::string         buffer{};
+    std::size_t         offset{0};
+    int                 fd{-1};
+    uInt64              written_bytes{0};
+    uInt64              blocked_count{0};
+    uInt64              error_count{0};
+};
+
+// FOutputWriter inline functions
+//----------------------------------------------------------------------
+inline FString FOutputWriter::getClassName() const
+{ return "FOutputWriter"; }
+
+//----------------------------------------------------------------------
+inline int FOutputWriter::getFileDescriptor() const
+{ return fd; }
+
+//----------------------------------------------------------------------
+inline std::size_t FOutputWriter::getPendingSize() const
+{ return buffer.size() - offset; }
+
+//----------------------------------------------------------------------
+inline uInt64 FOutputWriter::getWrittenBytes() const
+{ return written_bytes; }
+
+//----------------------------------------------------------------------
+inline uInt64 FOutputWriter::getBlockedCount() const
+{ return blocked_count; }
+
+//----------------------------------------------------------------------
+inline uInt64 FOutputWriter::getErrorCount() const
+{ return error_count; }
+
+//----------------------------------------------------------------------
+inline bool FOutputWriter::hasPendingOutput() const
+{ return offset < buffer.size(); }
+
+//----------------------------------------------------------------------
+inline void FOutputWriter::write (char ch)
+{ buffer.push_back(ch); }
+
+//----------------------------------------------------------------------
+inline void FOutputWriter::write (const char data[], std::size_t length)
+{ buffer.append(data, length); }
+
+//----------------------------------------------------------------------
+inline bool FOutputWriter::flush()
+{ return writeBuffer(false); }
+
+//----------------------------------------------------------------------
+inline bool FOutputWriter::drain()
+{ return writeBuffer(true); }
+
+}  // namespace finalcut
+
+#endif  // FOUTPUTWRITER_H
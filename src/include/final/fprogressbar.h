@@ -62,6 +62,9 @@ class FProgressbar : public FWidget
     // Using-declarations
     using FWidget::setGeometry;
 
+    // Type tag
+    static const FTypeTag<FProgressbar> type_tag;
+
     // Constructor
     explicit FProgressbar(FWidget* = nullptr);
 
@@ -70,6 +73,7 @@ class FProgressbar : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     std::size_t         getPercentage() const;
 
     // Mutators
@@ -88,6 +92,9 @@ class FProgressbar : public FWidget
     void                hide() override;
     void                reset();
 
+    // Event handler
+    void                onTerminalFocusIn (FFocusEvent*) override;
+
   private:
     // Constants
     static constexpr auto NOT_SET = static_cast<std::size_t>(-1);
@@ -111,6 +118,10 @@ class FProgressbar : public FWidget
 inline FString FProgressbar::getClassName() const
 { return "FProgressbar"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FProgressbar::getTypeId() const
+{ return getTypeIdOf<FProgressbar>(); }
+
 //----------------------------------------------------------------------
 inline std::size_t FProgressbar::getPercentage() const
 { return percentage; }
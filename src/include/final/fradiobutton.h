@@ -64,6 +64,9 @@ namespace finalcut
 class FRadioButton : public FToggleButton
 {
   public:
+    // Type tag
+    static const FTypeTag<FRadioButton> type_tag;
+
     // Constructors
     explicit FRadioButton (FWidget* = nullptr);
     explicit FRadioButton (const FString&, FWidget* = nullptr);
@@ -79,6 +82,7 @@ class FRadioButton : public FToggleButton
 
     // Accessor
     FString       getClassName() const override;
+    FTypeId       getTypeId() const override;
 
   private:
     // Methods
@@ -95,6 +99,10 @@ class FRadioButton : public FToggleButton
 inline FString FRadioButton::getClassName() const
 { return "FRadioButton"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FRadioButton::getTypeId() const
+{ return getTypeIdOf<FRadioButton>(); }
+
 }  // namespace finalcut
 
 #endif  // FRADIOBUTTON_H
@@ -64,6 +64,9 @@ namespace finalcut
 class FRadioMenuItem : public FMenuItem
 {
   public:
+    // Type tag
+    static const FTypeTag<FRadioMenuItem> type_tag;
+
     // Constructors
     explicit FRadioMenuItem (FWidget* = nullptr);
     explicit FRadioMenuItem (const FString&, FWidget* = nullptr);
@@ -79,6 +82,7 @@ class FRadioMenuItem : public FMenuItem
 
     // Accessor
     FString       getClassName() const override;
+    FTypeId       getTypeId() const override;
 
   private:
     // Methods
@@ -92,6 +96,10 @@ class FRadioMenuItem : public FMenuItem
 inline FString FRadioMenuItem::getClassName() const
 { return "FRadioMenuItem"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FRadioMenuItem::getTypeId() const
+{ return getTypeIdOf<FRadioMenuItem>(); }
+
 }  // namespace finalcut
 
 #endif  // FRADIOMENUITEM_H
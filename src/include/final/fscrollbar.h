@@ -86,6 +86,9 @@ class FScrollbar : public FWidget
       scrollWheelDown    = 7
     };
 
+    // Type tag
+    static const FTypeTag<FScrollbar> type_tag;
+
     // Constructors
     explicit FScrollbar (FWidget* = nullptr);
     explicit FScrollbar (fc::orientation = fc::vertical, FWidget* = nullptr);
@@ -101,6 +104,7 @@ class FScrollbar : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     int                 getValue() const;
     sType               getScrollType() const;
 
@@ -206,6 +210,10 @@ void initScrollbar ( FScrollbarPtr& bar
 inline FString FScrollbar::getClassName() const
 { return "FScrollbar"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FScrollbar::getTypeId() const
+{ return getTypeIdOf<FScrollbar>(); }
+
 //----------------------------------------------------------------------
 inline int FScrollbar::getValue() const
 { return val; }
@@ -67,6 +67,9 @@ class FScrollView : public FWidget
     using FWidget::setGeometry;
     using FWidget::print;
 
+    // Type tag
+    static const FTypeTag<FScrollView> type_tag;
+
     // Constructor
     explicit FScrollView (FWidget* = nullptr);
 
@@ -81,6 +84,7 @@ class FScrollView : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     std::size_t         getViewportWidth() const;
     std::size_t         getViewportHeight() const;
     FSize               getViewportSize() const;
@@ -194,6 +198,10 @@ class FScrollView : public FWidget
 inline FString FScrollView::getClassName() const
 { return "FScrollView"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FScrollView::getTypeId() const
+{ return getTypeIdOf<FScrollView>(); }
+
 //----------------------------------------------------------------------
 inline std::size_t FScrollView::getViewportWidth() const
 { return getWidth() - vertical_border_spacing - std::size_t(nf_offset); }
@@ -0,0 +1,140 @@
+/***********************************************************************
+* fsearchindex.h - Case-insensitive text search index                  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FSearchIndex ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  The index keeps lower-case copies of the item texts sorted
+ *  together with their list positions. A prefix search finds the
+ *  matching range with a binary search, and a min segment tree
+ *  returns the lowest list position in this range in O(log n).
+ *  Entries that are appended after the last lookup are sorted
+ *  and merged in at the next lookup. A replaced entry is found
+ *  with a binary search and only marked as removed until then.
+ *  Inserting or removing list items moves the positions of the
+ *  following items, so the owner invalidates the index and
+ *  rebuilds it once before the next lookup.
+ */
+
+#ifndef FSEARCHINDEX_H
+#define FSEARCHINDEX_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <string>
+#include <vector>
+
+#include "final/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FSearchIndex
+//----------------------------------------------------------------------
+
+class FSearchIndex final
+{
+  public:
+    // Enumeration
+    enum MatchMode
+    {
+      PrefixMatch,     // Text starts with the pattern
+      SubstringMatch,  // Text contains the pattern
+      FuzzyMatch       // Pattern characters appear in text order
+    };
+
+    // Constant
+    static constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+    // Constructor
+    FSearchIndex() = default;
+
+    // Accessors
+    FString                  getClassName() const;
+    std::size_t              getSize() const;
+
+    // Inquiry
+    bool                     isValid() const;
+
+    // Methods
+    void                     clear();
+    void                     invalidate();
+    void                     add (const FString&, std::size_t);
+    void                     replace ( const FString&, const FString&
+                                     , std::size_t );
+    std::size_t              findPrefix (const FString&);
+    std::vector<std::size_t> match (const FString&, MatchMode);
+    static bool              startsWith (const FString&, const FString&);
+
+  private:
+    // Typedefs
+    struct Entry
+    {
+      std::wstring key;
+      std::size_t  position;
+      bool         removed;  // Replaced, dropped at the next merge
+    };
+
+    typedef std::vector<Entry> Entries;
+
+    // Methods
+    static bool              lessEntry (const Entry&, const Entry&);
+    void                     foldCase (const FString&, std::wstring&) const;
+    void                     mergePendingEntries();
+    void                     buildMinTree();
+    std::size_t              getMinPosition (std::size_t, std::size_t) const;
+    static bool              isFuzzyMatch ( const std::wstring&
+                                          , const std::wstring& );
+
+    // Data members
+    Entries                  entries{};
+    std::vector<std::size_t> min_tree{};
+    std::wstring             pattern{};
+    std::size_t              sorted_count{0};
+    std::size_t              removed_count{0};
+    bool                     valid{true};
+};
+
+// FSearchIndex inline functions
+//----------------------------------------------------------------------
+inline FString FSearchIndex::getClassName() const
+{ return "FSearchIndex"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FSearchIndex::getSize() const
+{ return entries.size() - removed_count; }
+
+//----------------------------------------------------------------------
+inline bool FSearchIndex::isValid() const
+{ return valid; }
+
+}  // namespace finalcut
+
+#endif  // FSEARCHINDEX_H
@@ -67,6 +67,9 @@ class FSpinBox : public FWidget
     // Using-declaration
     using FWidget::setGeometry;
 
+    // Type tag
+    static const FTypeTag<FSpinBox> type_tag;
+
     // Constructors
     explicit FSpinBox (FWidget* = nullptr);
 
@@ -81,6 +84,7 @@ class FSpinBox : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     sInt64              getValue() const;
     FString             getPrefix() const;
     FString             getSuffix() const;
@@ -164,6 +168,10 @@ class FSpinBox : public FWidget
 inline FString FSpinBox::getClassName() const
 { return "FSpinBox"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FSpinBox::getTypeId() const
+{ return getTypeIdOf<FSpinBox>(); }
+
 //----------------------------------------------------------------------
 inline sInt64 FSpinBox::getValue() const
 { return value; }
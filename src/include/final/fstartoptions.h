@@ -98,6 +98,7 @@ class FStartOptions final
 
     fc::encoding                encoding{fc::UNKNOWN};
     std::ofstream               logfile_stream{};
+    FString                     recording_file{};
     static FStartOptions*       start_options;
 };
 
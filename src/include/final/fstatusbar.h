@@ -73,6 +73,9 @@ class FStatusBar;
 class FStatusKey : public FWidget
 {
   public:
+    // Type tag
+    static const FTypeTag<FStatusKey> type_tag;
+
     // Constructors
     explicit FStatusKey (FWidget* = nullptr);
     FStatusKey (FKey, const FString&, FWidget* = nullptr);
@@ -88,6 +91,7 @@ class FStatusKey : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     virtual FKey        getKey() const;
     virtual FString     getText() const;
 
@@ -131,6 +135,10 @@ class FStatusKey : public FWidget
 inline FString FStatusKey::getClassName() const
 { return "FStatusKey"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FStatusKey::getTypeId() const
+{ return getTypeIdOf<FStatusKey>(); }
+
 //----------------------------------------------------------------------
 inline FKey FStatusKey::getKey() const
 { return key; }
@@ -183,6 +191,9 @@ inline void FStatusKey::setConnectedStatusbar (FStatusBar* sb)
 class FStatusBar : public FWindow
 {
   public:
+    // Type tag
+    static const FTypeTag<FStatusBar> type_tag;
+
     // Constructor
     explicit FStatusBar (FWidget* = nullptr);
 
@@ -197,6 +208,7 @@ class FStatusBar : public FWindow
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     FStatusKey*         getStatusKey (int) const;
     FString             getMessage() const;
     std::size_t         getCount() const;
@@ -258,6 +270,10 @@ class FStatusBar : public FWindow
 inline FString FStatusBar::getClassName() const
 { return "FStatusBar"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FStatusBar::getTypeId() const
+{ return getTypeIdOf<FStatusBar>(); }
+
 //----------------------------------------------------------------------
 inline FStatusKey* FStatusBar::getStatusKey (int index) const
 { return key_list[uInt(index - 1)]; }
@@ -162,8 +162,9 @@ class FString
     template <typename CharT>
     bool operator >  (const CharT&) const;
 
-    // Accessor
+    // Accessors
     virtual FString getClassName() const;
+    static char getThousandsSeparator();
 
     // inquiries
     bool isNull() const;
@@ -222,9 +223,10 @@ class FString
     FString& setNumber (lDouble, int = getPrecision<lDouble>());
 
     template <typename NumT>
-    FString& setFormatedNumber (NumT, char = nl_langinfo(THOUSEP)[0]);
-    FString& setFormatedNumber (sInt64, char = nl_langinfo(THOUSEP)[0]);
-    FString& setFormatedNumber (uInt64, char = nl_langinfo(THOUSEP)[0]);
+    FString& setFormatedNumber (NumT, char = getThousandsSeparator());
+    FString& setFormatedNumber (sInt64, char = getThousandsSeparator());
+    FString& setFormatedNumber (uInt64, char = getThousandsSeparator());
+    static void updateNumericLocale();
 
     const FString& insert (const FString&, int);
     const FString& insert (const FString&, std::size_t);
@@ -246,16 +248,28 @@ class FString
     // Constants
     static constexpr uInt FWDBUFFER = 15;
     static constexpr uInt INPBUFFER = 200;
+    static constexpr std::size_t NUMBUFFER = 128;
+
+    // Typedef
+    typedef std::array<char, NUMBUFFER> NumberBuffer;
 
     // Methods
     void           _initLength (std::size_t);
     void           _assign (const wchar_t[]);
+    void           _assign (const wchar_t[], std::size_t);
+    bool           _setLength (std::size_t);
     void           _insert (std::size_t, const wchar_t[]);
     void           _insert (std::size_t, std::size_t, const wchar_t[]);
     void           _remove (std::size_t, std::size_t);
     const char*    _to_cstring (const wchar_t[]) const;
     const wchar_t* _to_wcstring (const char[]) const;
     const wchar_t* _extractToken (wchar_t*[], const wchar_t[], const wchar_t[]) const;
+    void           _appendNumber (sInt64);
+    void           _appendNumber (uInt64);
+    void           _appendNumber (lDouble, int);
+    static std::size_t _countDigits (uInt64);
+    static wchar_t*    _writeDigits (wchar_t*, uInt64, wchar_t = L'\0');
+    static std::size_t _formatFloat (NumberBuffer&, lDouble, int);
 
     // Data members
     wchar_t*      string{nullptr};
@@ -264,6 +278,11 @@ class FString
     mutable char* c_string{nullptr};
     static wchar_t null_char;
     static const wchar_t const_null_char;
+    static char thousands_separator;
+    static bool numeric_locale_cached;
+
+    // Friend class
+    friend class FStringBuilder;
 
     // Friend Non-member operator functions
     friend FString operator + (const FString&, const FString&);
@@ -286,8 +305,13 @@ template <typename NumT
                                  , int>::type >
 inline FString& FString::operator << (const NumT val)
 {
-  const FString numstr(FString().setNumber(val));
-  _insert (length, numstr.length, numstr.string);
+  if ( std::is_floating_point<NumT>::value )
+    _appendNumber (lDouble(val), getPrecision<NumT>());
+  else if ( isNegative(val) )
+    _appendNumber (sInt64(val));
+  else
+    _appendNumber (uInt64(val));
+
   return *this;
 }
 
@@ -369,6 +393,18 @@ inline bool FString::operator > (const CharT& s) const
 inline FString FString::getClassName() const
 { return "FString"; }
 
+//----------------------------------------------------------------------
+inline char FString::getThousandsSeparator()
+{
+  // The separator of the LC_NUMERIC locale is read only once.
+  // Call updateNumericLocale() after changing LC_NUMERIC.
+
+  if ( ! numeric_locale_cached )
+    updateNumericLocale();
+
+  return thousands_separator;
+}
+
 //----------------------------------------------------------------------
 inline bool FString::isNull() const
 { return ( bufsize == 0 || (bufsize > 0 && ! string) ); }
@@ -433,7 +469,7 @@ inline FString::const_reference FString::back() const
 template <typename... Args>
 inline FString& FString::sprintf (const FString& format, Args&&... args)
 {
-  std::array<wchar_t, 4096> buf{};
+  std::array<wchar_t, 4096> buf;  // No zero-fill, swprintf terminates
 
   if ( format.isEmpty() )
   {
@@ -441,9 +477,16 @@ inline FString& FString::sprintf (const FString& format, Args&&... args)
     return *this;
   }
 
-  std::swprintf ( buf.data(), buf.size(), format.wc_str()
-                , std::forward<Args>(args)... );
-  _assign(buf.data());
+  buf[0] = L'\0';
+  buf[buf.size() - 1] = L'\0';
+  const int len = std::swprintf ( buf.data(), buf.size(), format.wc_str()
+                                , std::forward<Args>(args)... );
+
+  if ( len >= 0 )
+    _assign (buf.data(), std::size_t(len));
+  else
+    _assign (buf.data());  // Truncated output
+
   return *this;
 }
 
@@ -0,0 +1,237 @@
+/***********************************************************************
+* fstringbuilder.h - Amortized construction of an FString              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FStringBuilder ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  FStringBuilder collects text in a buffer with geometric growth,
+ *  so a sequence of appends costs amortized linear time. The result
+ *  is handed over to an FString with release() without copying.
+ *
+ *  format() is a type-safe replacement for FString::sprintf():
+ *
+ *    builder.format ("{} of {} items ({}%)", pos, count, 12.5);
+ *
+ *  Each "{}" is replaced by the next argument, "{{" and "}}" insert
+ *  literal braces. The arguments are appended with operator <<,
+ *  so an unsupported argument type is a compile-time error.
+ *  Numbers are written directly into the buffer.
+ */
+
+#ifndef FSTRINGBUILDER_H
+#define FSTRINGBUILDER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <cassert>
+#include <type_traits>
+
+#include "final/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FStringBuilder
+//----------------------------------------------------------------------
+
+class FStringBuilder final
+{
+  public:
+    // Constructors
+    FStringBuilder() = default;
+    explicit FStringBuilder (std::size_t);
+
+    // Disable copy constructor
+    FStringBuilder (const FStringBuilder&) = delete;
+
+    // Destructor
+    ~FStringBuilder();
+
+    // Disable copy assignment operator (=)
+    FStringBuilder& operator = (const FStringBuilder&) = delete;
+
+    // Overloaded operators
+    FStringBuilder& operator << (const FString&);
+    FStringBuilder& operator << (const wchar_t);
+    FStringBuilder& operator << (const char);
+    template <typename NumT
+            , typename std::enable_if< ( std::is_integral<NumT>::value
+                                    && ! std::is_same<NumT, bool>::value
+                                    && ! std::is_same<NumT, wchar_t>::value )
+                                    || std::is_floating_point<NumT>::value
+                                     , int>::type = 0 >
+    FStringBuilder& operator << (const NumT);
+
+    // Accessors
+    FString          getClassName() const;
+    std::size_t      getLength() const;
+    std::size_t      capacity() const;
+
+    // Inquiry
+    bool             isEmpty() const;
+
+    // Methods
+    void             reserve (std::size_t);
+    FStringBuilder&  append (const FString&);
+    FStringBuilder&  append (const wchar_t[], std::size_t);
+    FStringBuilder&  append (wchar_t);
+    FStringBuilder&  append (std::size_t, wchar_t);
+    template <typename... Args>
+    FStringBuilder&  format (const FString&, const Args&...);
+    void             clear();
+    FString          str() const;
+    FString          release();
+
+  private:
+    // Constant
+    static constexpr std::size_t MIN_CAPACITY = 64;
+
+    // Methods
+    void             grow (std::size_t);
+    void             appendNumber (sInt64);
+    void             appendNumber (uInt64);
+    void             appendNumber (lDouble, int);
+    bool             appendFormatText (const FString&, std::size_t&);
+    void             formatArgs (const FString&, std::size_t&);
+    template <typename T, typename... Args>
+    void             formatArgs (const FString&, std::size_t&,
+                                 const T&, const Args&...);
+
+    // Data members
+    wchar_t*         buffer{nullptr};
+    std::size_t      length{0};
+    std::size_t      bufsize{0};
+};
+
+// FStringBuilder inline functions
+//----------------------------------------------------------------------
+inline FStringBuilder& FStringBuilder::operator << (const FString& s)
+{ return append(s); }
+
+//----------------------------------------------------------------------
+inline FStringBuilder& FStringBuilder::operator << (const wchar_t c)
+{ return append(c); }
+
+//----------------------------------------------------------------------
+inline FStringBuilder& FStringBuilder::operator << (const char c)
+{ return append(wchar_t(c & 0xff)); }
+
+//----------------------------------------------------------------------
+template <typename NumT
+        , typename std::enable_if< ( std::is_integral<NumT>::value
+                                && ! std::is_same<NumT, bool>::value
+                                && ! std::is_same<NumT, wchar_t>::value )
+                                || std::is_floating_point<NumT>::value
+                                 , int>::type >
+inline FStringBuilder& FStringBuilder::operator << (const NumT val)
+{
+  if ( std::is_floating_point<NumT>::value )
+    appendNumber (lDouble(val), getPrecision<NumT>());
+  else if ( isNegative(val) )
+    appendNumber (sInt64(val));
+  else
+    appendNumber (uInt64(val));
+
+  return *this;
+}
+
+//----------------------------------------------------------------------
+inline FString FStringBuilder::getClassName() const
+{ return "FStringBuilder"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FStringBuilder::getLength() const
+{ return length; }
+
+//----------------------------------------------------------------------
+inline std::size_t FStringBuilder::capacity() const
+{ return ( bufsize > 0 ) ? bufsize - 1 : 0; }
+
+//----------------------------------------------------------------------
+inline bool FStringBuilder::isEmpty() const
+{ return length == 0; }
+
+//----------------------------------------------------------------------
+inline FStringBuilder& FStringBuilder::append (const FString& s)
+{ return append (s.wc_str(), s.getLength()); }
+
+//----------------------------------------------------------------------
+inline FStringBuilder& FStringBuilder::append (wchar_t c)
+{
+  if ( length + 1 >= bufsize )
+    grow (length + 1);
+
+  if ( length + 1 >= bufsize )
+    return *this;  // Out of memory
+
+  buffer[length++] = c;
+  buffer[length] = L'\0';
+  return *this;
+}
+
+//----------------------------------------------------------------------
+template <typename... Args>
+inline FStringBuilder& FStringBuilder::format ( const FString& fmt
+                                              , const Args&... args )
+{
+  std::size_t pos{0};
+  formatArgs (fmt, pos, args...);
+  return *this;
+}
+
+//----------------------------------------------------------------------
+inline void FStringBuilder::formatArgs (const FString& fmt, std::size_t& pos)
+{
+  // Appends the text after the last argument
+
+  const bool placeholder = appendFormatText (fmt, pos);
+  assert ( ! placeholder && "Not enough format arguments" );
+  (void)placeholder;
+}
+
+//----------------------------------------------------------------------
+template <typename T, typename... Args>
+inline void FStringBuilder::formatArgs ( const FString& fmt
+                                       , std::size_t& pos
+                                       , const T& arg
+                                       , const Args&... args )
+{
+  const bool placeholder = appendFormatText (fmt, pos);
+  assert ( placeholder && "Too many format arguments" );
+
+  if ( placeholder )
+    *this << arg;
+
+  formatArgs (fmt, pos, args...);
+}
+
+}  // namespace finalcut
+
+#endif  // FSTRINGBUILDER_H
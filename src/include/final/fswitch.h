@@ -64,6 +64,9 @@ namespace finalcut
 class FSwitch : public FToggleButton
 {
   public:
+    // Type tag
+    static const FTypeTag<FSwitch> type_tag;
+
     // Constructors
     explicit FSwitch (FWidget* = nullptr);
     explicit FSwitch (const FString&, FWidget* = nullptr);
@@ -79,6 +82,7 @@ class FSwitch : public FToggleButton
 
     // Accessor
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
 
     // Mutator
     void                setText (const FString&) override;
@@ -105,6 +109,10 @@ class FSwitch : public FToggleButton
 inline FString FSwitch::getClassName() const
 { return "FSwitch"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FSwitch::getTypeId() const
+{ return getTypeIdOf<FSwitch>(); }
+
 }  // namespace finalcut
 
 #endif  // FSWITCH_H
@@ -132,6 +132,7 @@ class FKeyboard;
 class FMouseControl;
 class FOptiAttr;
 class FOptiMove;
+class FOutputWriter;
 class FPoint;
 class FStartOptions;
 class FSize;
@@ -140,6 +141,7 @@ class FTermBuffer;
 class FTermData;
 class FTermDebugData;
 class FTermDetection;
+class FTermRecorder;
 class FTermXTerminal;
 
 #if defined(UNIT_TEST)
@@ -198,6 +200,7 @@ class FTerm final
     static FTermXTerminal*   getFTermXTerminal();
     static FKeyboard*        getFKeyboard();
     static FMouseControl*    getFMouseControl();
+    static FTermRecorder*    getFTermRecorder();
 
 #if defined(UNIT_TEST)
     static FTermLinux*       getFTermLinux();
@@ -253,6 +256,7 @@ class FTerm final
 
     // Mutators
     static void              setFSystem (FSystem*);
+    static void              setOutputWriter (FOutputWriter*);
     static void              setTermType (const char[]);
     static void              setInsertCursor (bool);
     static void              setInsertCursor();
@@ -284,6 +288,8 @@ class FTerm final
     static void              setBeep (int, int);
     static void              resetBeep();
     static void              beep();
+    static bool              startRecording (const FString&);
+    static void              stopRecording();
 
     static void              setEncoding (fc::encoding);
     static fc::encoding      getEncoding();
@@ -351,10 +357,12 @@ class FTerm final
     static void              enableAlternateCharset();
     static void              useAlternateScreenBuffer();
     static void              useNormalScreenBuffer();
+    static void              drainOutputWriter();
     void                     allocationValues() const;
     void                     deallocationValues();
     void                     init();
     bool                     init_terminal() const;
+    bool                     init_recording() const;
     void                     initOSspecifics() const;
     void                     initTermspecifics() const;
     void                     initBaudRate() const;
@@ -378,6 +386,8 @@ class FTerm final
     static FTermXTerminal*   xterm;
     static FKeyboard*        keyboard;
     static FMouseControl*    mouse;
+    static FTermRecorder*    recorder;
+    static FOutputWriter*    output_writer;
 
 #if defined(UNIT_TEST)
     #undef linux
@@ -423,10 +433,18 @@ FPoint readCursorPos();
 inline FString FTerm::getClassName()
 { return "FTerm"; }
 
+//----------------------------------------------------------------------
+inline FTermRecorder* FTerm::getFTermRecorder()
+{ return recorder; }
+
 //----------------------------------------------------------------------
 inline void FTerm::setFSystem (FSystem* fsystem)
 { fsys = fsystem; }
 
+//----------------------------------------------------------------------
+inline void FTerm::setOutputWriter (FOutputWriter* writer)
+{ output_writer = writer; }
+
 //----------------------------------------------------------------------
 inline void FTerm::setInsertCursor()
 { return setInsertCursor(true); }
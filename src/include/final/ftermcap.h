@@ -56,6 +56,7 @@
 #endif
 
 #include <array>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -146,12 +147,14 @@ class FTermcap final
     static void          termcapStrings();
     static void          termcapKeys();
     static int           _tputs (const char*, int, fn_putc);
+    static char*         copyEncodedString (const char*);
 
     // Data member
     static FSystem*        fsystem;
     static FTermData*      fterm_data;
     static FTermDetection* term_detection;
     static char            string_buf[BUF_SIZE];
+    static std::mutex      encode_mutex;
 };
 
 
@@ -185,7 +188,8 @@ char* FTermcap::getString (const CharT& cap)
 template <typename CharT>
 char* FTermcap::encodeMotionParameter (const CharT& cap, int col, int row)
 {
-  return ::tgoto(C_STR(cap), col, row);
+  std::lock_guard<std::mutex> lock(encode_mutex);
+  return copyEncodedString (::tgoto(C_STR(cap), col, row));
 }
 
 //----------------------------------------------------------------------
@@ -193,7 +197,8 @@ template <typename CharT
         , typename... Args>
 inline char* FTermcap::encodeParameter (const CharT& cap, Args&&... args)
 {
-  return ::tparm (C_STR(cap), std::forward<Args>(args)...);
+  std::lock_guard<std::mutex> lock(encode_mutex);
+  return copyEncodedString (::tparm (C_STR(cap), std::forward<Args>(args)...));
 }
 
 //----------------------------------------------------------------------
@@ -127,6 +127,7 @@ class FTermDetection final
     static bool           isKtermTerminal();
     static bool           isMltermTerminal();
     static bool           canDisplay256Colors();
+    static bool           canDisplayTrueColor();
     static bool           hasTerminalDetection();
     static bool           hasSetCursorStyleSupport();
 
@@ -205,6 +206,7 @@ class FTermDetection final
     static bool           decscusr_support;
     static bool           terminal_detection;
     static bool           color256;
+    static bool           true_color;
     static int            gnome_terminal_id;
     static const FString* answer_back;
     static const FString* sec_da;
@@ -277,6 +279,10 @@ inline const char* FTermDetection::getTermType_SecDA()
 inline bool FTermDetection::canDisplay256Colors()
 { return color256; }
 
+//----------------------------------------------------------------------
+inline bool FTermDetection::canDisplayTrueColor()
+{ return true_color; }
+
 //----------------------------------------------------------------------
 inline bool FTermDetection::hasSetCursorStyleSupport()
 { return decscusr_support; }
@@ -0,0 +1,161 @@
+/***********************************************************************
+* ftermrecorder.h - Records the terminal output and input              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FTermRecorder ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  FTermRecorder writes the terminal session to a file in the
+ *  asciicast v2 format. The first line is a JSON header with the
+ *  terminal size, followed by one JSON array per event:
+ *
+ *    [<seconds since start>, "o", "<output bytes of one frame>"]
+ *    [<seconds since start>, "i", "<raw input bytes>"]
+ *
+ *  An output frame holds all bytes written between two flushes of
+ *  the virtual terminal. Consecutive input bytes are combined into
+ *  one input event. Bytes that are not part of a valid UTF-8
+ *  sequence are stored as \u00XX escapes. A reader must turn the
+ *  escapes \u0080 to \u00ff back into a single raw byte, so that
+ *  8-bit input like X10 mouse coordinates or meta keys is replayed
+ *  unchanged.
+ */
+
+#ifndef FTERMRECORDER_H
+#define FTERMRECORDER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+#include "final/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FTermRecorder
+//----------------------------------------------------------------------
+
+class FTermRecorder final
+{
+  public:
+    // Constructor
+    FTermRecorder() = default;
+
+    // Disable copy constructor
+    FTermRecorder (const FTermRecorder&) = delete;
+
+    // Destructor
+    ~FTermRecorder();
+
+    // Disable copy assignment operator (=)
+    FTermRecorder& operator = (const FTermRecorder&) = delete;
+
+    // Accessors
+    FString             getClassName() const;
+    std::size_t         getFrameCount() const;
+    std::size_t         getInputCount() const;
+    uInt64              getOutputBytes() const;
+
+    // Inquiry
+    bool                isRecording() const;
+
+    // Methods
+    bool                start (const FString&, std::size_t, std::size_t);
+    void                stop();
+    void                recordOutput (char);
+    void                recordInput (char);
+    void                endFrame();
+
+  private:
+    // Typedef
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    // Methods
+    void                writeInput();
+    void                writeEvent (double, char, const std::string&);
+    double              getSeconds (const TimePoint&) const;
+    static void         appendJsonString (std::string&, const std::string&);
+
+    // Data members
+    std::ofstream       stream{};
+    std::string         frame{};
+    std::string         input{};
+    std::string         line{};
+    TimePoint           start_time{};
+    TimePoint           input_time{};
+    std::size_t         frame_count{0};
+    std::size_t         input_count{0};
+    uInt64              output_bytes{0};
+};
+
+// FTermRecorder inline functions
+//----------------------------------------------------------------------
+inline FString FTermRecorder::getClassName() const
+{ return "FTermRecorder"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FTermRecorder::getFrameCount() const
+{ return frame_count; }
+
+//----------------------------------------------------------------------
+inline std::size_t FTermRecorder::getInputCount() const
+{ return input_count; }
+
+//----------------------------------------------------------------------
+inline uInt64 FTermRecorder::getOutputBytes() const
+{ return output_bytes; }
+
+//----------------------------------------------------------------------
+inline bool FTermRecorder::isRecording() const
+{ return stream.is_open(); }
+
+//----------------------------------------------------------------------
+inline void FTermRecorder::recordOutput (char ch)
+{
+  if ( ! input.empty() )
+    writeInput();
+
+  frame.push_back(ch);
+}
+
+//----------------------------------------------------------------------
+inline void FTermRecorder::recordInput (char ch)
+{
+  if ( input.empty() )
+    input_time = std::chrono::steady_clock::now();
+
+  input.push_back(ch);
+}
+
+}  // namespace finalcut
+
+#endif  // FTERMRECORDER_H
@@ -79,6 +79,8 @@ class FTermXTerminal final
     static void           setMouseSupport();
     static void           unsetMouseSupport();
     void                  metaSendsESC (bool);
+    void                  bracketedPaste (bool);
+    void                  focusReporting (bool);
 
     // Accessors
     FString               getClassName() const;
@@ -144,10 +146,16 @@ class FTermXTerminal final
     static void           disableXTermMouse();
     void                  enableXTermMetaSendsESC();
     void                  disableXTermMetaSendsESC();
+    void                  enableXTermBracketedPaste();
+    void                  disableXTermBracketedPaste();
+    void                  enableXTermFocusReporting();
+    void                  disableXTermFocusReporting();
 
     // Data members
     static bool           mouse_support;
     bool                  meta_sends_esc{false};
+    bool                  bracketed_paste{false};
+    bool                  focus_reporting{false};
     bool                  xterm_default_colors{false};
     bool                  title_was_changed{false};
     std::size_t           term_width{80};
@@ -70,6 +70,9 @@ class FTextView : public FWidget
     // Using-declarations
     using FWidget::setGeometry;
 
+    // Type tag
+    static const FTypeTag<FTextView> type_tag;
+
     // Constructor
     explicit FTextView (FWidget* = nullptr);
 
@@ -91,6 +94,7 @@ class FTextView : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     std::size_t         getColumns() const;
     std::size_t         getRows() const;
     FString             getText() const;
@@ -125,6 +129,7 @@ class FTextView : public FWidget
 
     // Event handlers
     void                onKeyPress (FKeyEvent*) override;
+    void                onPaste (FPasteEvent*) override;
     void                onMouseDown (FMouseEvent*) override;
     void                onMouseUp (FMouseEvent*) override;
     void                onMouseMove (FMouseEvent*) override;
@@ -215,6 +220,10 @@ inline FTextView& FTextView::operator << (const std::string& string)
 inline FString FTextView::getClassName() const
 { return "FTextView"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FTextView::getTypeId() const
+{ return getTypeIdOf<FTextView>(); }
+
 //----------------------------------------------------------------------
 inline std::size_t FTextView::getColumns() const
 { return max_line_width; }
@@ -65,6 +65,9 @@ class FToggleButton : public FWidget
     // Using-declaration
     using FWidget::setGeometry;
 
+    // Type tag
+    static const FTypeTag<FToggleButton> type_tag;
+
     // Constructors
     explicit FToggleButton (FWidget* = nullptr);
     explicit FToggleButton (const FString&, FWidget* = nullptr);
@@ -80,6 +83,7 @@ class FToggleButton : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     FString&            getText();
 
     // Mutators
@@ -168,6 +172,10 @@ class FToggleButton : public FWidget
 inline FString FToggleButton::getClassName() const
 { return "FToggleButton"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FToggleButton::getTypeId() const
+{ return getTypeIdOf<FToggleButton>(); }
+
 //----------------------------------------------------------------------
 inline FString& FToggleButton::getText()
 { return text; }
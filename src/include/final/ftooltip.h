@@ -66,6 +66,9 @@ namespace finalcut
 class FToolTip : public FWindow
 {
   public:
+    // Type tag
+    static const FTypeTag<FToolTip> type_tag;
+
     // Constructors
     explicit FToolTip (FWidget* = nullptr);
     explicit FToolTip (const FString&, FWidget* = nullptr);
@@ -81,6 +84,7 @@ class FToolTip : public FWindow
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     FString             getText() const;
 
     // Mutators
@@ -119,6 +123,10 @@ class FToolTip : public FWindow
 inline FString FToolTip::getClassName() const
 { return "FToolTip"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FToolTip::getTypeId() const
+{ return getTypeIdOf<FToolTip>(); }
+
 //----------------------------------------------------------------------
 inline FString FToolTip::getText() const
 { return text; }
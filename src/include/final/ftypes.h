@@ -67,7 +67,7 @@ typedef std::int64_t          sInt64;
 
 typedef long double           lDouble;
 
-typedef uInt16                FColor;
+typedef uInt32                FColor;
 typedef uInt16                FAttribute;
 typedef uInt32                FKey;
 typedef void*                 FDataPtr;
@@ -213,6 +213,41 @@ inline bool operator != (const FChar& lhs, const FChar& rhs)
   return ! ( lhs == rhs );
 }
 
+// 24-bit RGB color functions
+//----------------------------------------------------------------------
+static constexpr FColor RGB_COLOR_FLAG = 0x01000000;
+
+//----------------------------------------------------------------------
+constexpr FColor rgbColor (uInt8 r, uInt8 g, uInt8 b)
+{
+  // A true color value is stored as 0x01rrggbb in a FColor
+  return RGB_COLOR_FLAG | (FColor(r) << 16) | (FColor(g) << 8) | FColor(b);
+}
+
+//----------------------------------------------------------------------
+constexpr bool isRGBColor (FColor color)
+{
+  return (color & 0xff000000) == RGB_COLOR_FLAG;
+}
+
+//----------------------------------------------------------------------
+constexpr uInt8 getRed (FColor color)
+{
+  return uInt8((color >> 16) & 0xff);
+}
+
+//----------------------------------------------------------------------
+constexpr uInt8 getGreen (FColor color)
+{
+  return uInt8((color >> 8) & 0xff);
+}
+
+//----------------------------------------------------------------------
+constexpr uInt8 getBlue (FColor color)
+{
+  return uInt8(color & 0xff);
+}
+
 }  // namespace finalcut
 
 #endif  // FTYPES_H
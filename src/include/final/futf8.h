@@ -0,0 +1,57 @@
+/***********************************************************************
+* futf8.h - Locale-independent UTF-8 transcoding                       *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Conversion between wide character strings and UTF-8
+ *  ═══════════════════════════════════════════════════
+ *
+ *  The functions do not depend on the current locale. Runs of
+ *  ASCII characters are converted 16 characters at a time with
+ *  SSE2 instructions, where available.
+ *
+ *  Invalid input is replaced by U+FFFD (replacement character):
+ *  every byte of a malformed UTF-8 sequence when decoding, and
+ *  surrogates and values above U+10FFFF when encoding.
+ */
+
+#ifndef FUTF8_H
+#define FUTF8_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <cstddef>
+
+namespace finalcut
+{
+
+// non-member function declarations
+// implemented in futf8.cpp
+//----------------------------------------------------------------------
+bool         isASCII (const char[], std::size_t);
+std::size_t  getUTF8Length (const wchar_t[], std::size_t);
+std::size_t  encodeUTF8 (const wchar_t[], std::size_t, char[]);
+std::size_t  decodeUTF8 (const char[], std::size_t, wchar_t[]);
+
+}  // namespace finalcut
+
+#endif  // FUTF8_H
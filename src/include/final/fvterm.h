@@ -41,6 +41,19 @@
 
  */
 
+/*  The terminal state (virtual terminal, virtual desktop, output
+ *  buffer, attributes and flush timers) is kept in an FVTermSession.
+ *  All FVTerm objects work with the current session. A new session
+ *  is initialized by the first FVTerm object created while it is
+ *  current.
+ *
+ *  This groups the state for a later support of several terminals
+ *  per process. FTerm, the keyboard and mouse input, FApplication,
+ *  the widget window lists and the timer list are still global, and
+ *  the current session is one process-wide pointer. There is no
+ *  API to switch the session yet.
+ */
+
 #ifndef FVTERM_H
 #define FVTERM_H
 
@@ -69,6 +82,9 @@ namespace finalcut
 // class forward declaration
 class FColorPair;
 class FMouseControl;
+class FOptiAttr;
+class FOptiMove;
+class FOutputWriter;
 class FPoint;
 class FRect;
 class FSize;
@@ -79,6 +95,7 @@ class FTermBuffer;
 class FTermDebugData;
 class FStyle;
 class FWidget;
+class FWorkerPool;
 
 //----------------------------------------------------------------------
 // class FVTerm
@@ -100,6 +117,7 @@ class FVTerm
 
     struct FTermArea;             // forward declaration
     struct FVTermPreprocessing;   // forward declaration
+    struct FVTermSession;         // forward declaration
 
     typedef std::vector<FVTermPreprocessing> FPreprocessing;
 
@@ -142,6 +160,8 @@ class FVTerm
 
     // Accessors
     virtual FString       getClassName() const;
+    static std::size_t    getCompositionThreads();
+    static uInt64         getBackgroundFrameInterval();
     static FColor         getTermForegroundColor();
     static FColor         getTermBackgroundColor();
     FTermArea*&           getVWin();
@@ -151,6 +171,9 @@ class FVTerm
     FTerm&                getFTerm() const;
 
     // Mutators
+    static void           setCompositionThreads (std::size_t);
+    static void           setTerminalFocus (bool);
+    static void           setBackgroundFrameInterval (uInt64);
     void                  setTermXY (int, int) const;
     void                  setTerminalUpdates (terminal_update) const;
     void                  hideCursor (bool) const;
@@ -231,6 +254,7 @@ class FVTerm
     static void           unsetNonBlockingRead();
 
     // Inquiries
+    static bool           isTerminalFocused();
     static bool           isBold();
     static bool           isDim();
     static bool           isItalic();
@@ -274,6 +298,13 @@ class FVTerm
     virtual void          print (const FStyle&);
     virtual void          print (const FColorPair&);
     virtual FVTerm&       print();
+    int                   blit (const FSize&, const FChar*, std::size_t = 0);
+    int                   blit ( FTermArea*, const FSize&
+                               , const FChar*, std::size_t = 0 );
+    int                   blit ( const FSize&, const wchar_t*
+                               , const FColorPair*, std::size_t = 0 );
+    int                   blit ( FTermArea*, const FSize&, const wchar_t*
+                               , const FColorPair*, std::size_t = 0 );
     static void           flush();
 
   protected:
@@ -295,6 +326,7 @@ class FVTerm
     bool                  hasChildPrintArea() const;
     bool                  isVirtualWindow() const;
     bool                  isCursorHideable() const;
+    bool                  isTerminalUpdateStopped() const;
 
     // Methods
     void                  createArea ( const FRect&
@@ -305,6 +337,8 @@ class FVTerm
                                      , FTermArea* ) const;
     static void           removeArea (FTermArea*&);
     static void           restoreVTerm (const FRect&);
+    static void           addDamage (const FRect&);
+    static void           processDamage();
     bool                  updateVTermCursor (const FTermArea*) const;
     void                  hideVTermCursor() const;
     static void           setAreaCursor ( const FPoint&
@@ -337,9 +371,25 @@ class FVTerm
       line_completely_printed
     };
 
+    // Typedef
+    struct FComposeBuffer  // Intermediate characters of a composition
+    {
+      FChar s_ch{};  // shadow character
+      FChar i_ch{};  // inherit background character
+    };
+
+    struct FTermOutput;  // forward declaration
+
     // Constants
     //   Buffer size for character output on the terminal
     static constexpr uInt TERMINAL_OUTPUT_BUFFER_SIZE = 131072;
+    //   Damage rectangles before they are combined to one
+    static constexpr std::size_t MAX_DAMAGE_RECTS = 64;
+    //   Smaller compositions are not split into row bands
+    static constexpr int MIN_PARALLEL_CELLS = 16384;
+
+    // Accessor
+    static FTermOutput    getSessionOutput();
 
     // Methods
     void                  resetTextAreaToDefault ( const FTermArea*
@@ -355,6 +405,11 @@ class FVTerm
     static void           updateShadedCharacter (const FChar&, FChar&, FChar&);
     static void           updateInheritBackground (const FChar&, const FChar&, FChar&);
     static void           updateCharacter (const FChar&, FChar&);
+    static void           updateTransparentCount ( FLineChanges&
+                                                 , const FChar&
+                                                 , const FChar& );
+    static bool           blitLine ( FTermArea*, int, int
+                                   , const FChar*, std::size_t );
     static bool           updateVTermCharacter ( const FTermArea*
                                                , const FPoint&
                                                , const FPoint& );
@@ -363,7 +418,8 @@ class FVTerm
     bool                  hasChildAreaChanges (FTermArea*) const;
     void                  clearChildAreaChanges (const FTermArea*) const;
     static bool           isInsideArea (const FPoint&, const FTermArea*);
-    static FChar          generateCharacter (const FPoint&);
+    static const FChar*   composeCharacter ( const FTermArea*, int, int
+                                           , const FChar*, FComposeBuffer& );
     static FChar          getCharacter ( character_type
                                        , const FPoint&
                                        , const FTermArea* );
@@ -372,85 +428,87 @@ class FVTerm
     void                  init();
     static void           init_characterLengths (const FOptiMove*);
     void                  finish();
-    static void           putAreaLine (const FChar&, FChar&, std::size_t);
+    static bool           putAreaLine ( const FChar&, FChar&, std::size_t
+                                      , std::size_t&, std::size_t& );
     static void           putAreaCharacter ( const FPoint&, const FTermArea*
                                            , const FChar&, FChar& );
     static void           getAreaCharacter ( const FPoint&, const FTermArea*
-                                           , FChar*& );
+                                           , FChar*&, FComposeBuffer& );
+    static void           putAreaRows (const FTermArea*, int, int);
+    static void           restoreVTermRows (int, int, int, int);
+    static void           runRowBands ( int, int
+                                      , const std::function<void(int, int)>& );
     bool                  clearTerm (int = ' ') const;
     bool                  clearFullArea (const FTermArea*, FChar&) const;
     static void           clearAreaWithShadow (const FTermArea*, const FChar&);
     static bool           canClearToEOL (uInt, uInt);
     static bool           canClearLeadingWS (uInt&, uInt);
     static bool           canClearTrailingWS (uInt&, uInt);
-    bool                  skipUnchangedCharacters (uInt&, uInt, uInt) const;
-    void                  printRange (uInt, uInt, uInt, bool) const;
+    void                  setTermXY (FTermOutput&, int, int) const;
+    bool                  skipUnchangedCharacters ( FTermOutput&
+                                                  , uInt&, uInt, uInt ) const;
+    void                  printRange ( FTermOutput&
+                                     , uInt, uInt, uInt, bool ) const;
     void                  replaceNonPrintableFullwidth (uInt, FChar&) const;
-    void                  printCharacter (uInt&, uInt, bool, FChar&) const;
-    void                  printFullWidthCharacter (uInt&, uInt, FChar&) const;
-    void                  printFullWidthPaddingCharacter (uInt&, uInt, FChar&) const;
-    void                  printHalfCovertFullWidthCharacter (uInt&, uInt, FChar&) const;
-    void                  skipPaddingCharacter (uInt&, uInt, const FChar&) const;
-    exit_state            eraseCharacters (uInt&, uInt, uInt, bool) const;
-    exit_state            repeatCharacter (uInt&, uInt, uInt) const;
+    void                  printCharacter ( FTermOutput&, uInt&, uInt
+                                         , bool, FChar& ) const;
+    void                  printFullWidthCharacter ( FTermOutput&, uInt&
+                                                  , uInt, FChar& ) const;
+    void                  printFullWidthPaddingCharacter ( FTermOutput&, uInt&
+                                                         , uInt, FChar& ) const;
+    void                  printHalfCovertFullWidthCharacter ( FTermOutput&
+                                                            , uInt&, uInt
+                                                            , FChar& ) const;
+    void                  skipPaddingCharacter ( FTermOutput&, uInt&, uInt
+                                               , const FChar& ) const;
+    exit_state            eraseCharacters ( FTermOutput&, uInt&, uInt
+                                          , uInt, bool ) const;
+    exit_state            repeatCharacter ( FTermOutput&, uInt&
+                                          , uInt, uInt ) const;
     bool                  isFullWidthChar (const FChar&) const;
     bool                  isFullWidthPaddingChar (const FChar&) const;
-    static void           cursorWrap();
+    static void           cursorWrap (FTermOutput&);
     bool                  printWrap (FTermArea*) const;
     void                  printCharacterOnCoordinate ( FTermArea*
                                                      , const int&
                                                      , const int&
                                                      , const FChar&) const;
+    bool                  joinPreviousCluster ( FTermArea*
+                                              , const FChar& ) const;
     void                  printPaddingCharacter (FTermArea*, const FChar&);
-    bool                  updateTerminalLine (uInt) const;
+    bool                  updateTerminalLine (FTermOutput&, uInt) const;
+    bool                  updateTerminalBands (std::size_t&) const;
     bool                  updateTerminalCursor() const;
     bool                  isInsideTerminal (const FPoint&) const;
     bool                  isTermSizeChanged() const;
     static bool           isFlushTimeout();
+    static bool           isOutputCongested();
+    static bool           isBackgroundFrameTimeout();
     static bool           isTermSizeCheckTimeout();
     static bool           hasPendingUpdates (const FTermArea*);
+    static std::size_t    writeOutputBuffer (const FTerm::defaultPutChar&);
     static void           markAsPrinted (uInt, uInt);
     static void           markAsPrinted (uInt, uInt, uInt);
     static void           newFontChanges (FChar&);
     static void           charsetChanges (FChar&);
-    void                  appendCharacter (FChar&) const;
-    void                  appendChar (FChar&) const;
+    void                  appendCharacter (FTermOutput&, FChar&) const;
+    void                  appendChar (FTermOutput&, FChar&) const;
     void                  appendAttributes (FChar&) const;
-    void                  appendLowerRight (FChar&) const;
+    void                  appendAttributes (FTermOutput&, FChar&) const;
+    void                  appendLowerRight (FTermOutput&, FChar&) const;
     static void           characterFilter (FChar&);
     static void           appendOutputBuffer (const std::string&);
     static int            appendOutputBuffer (int);
+    static void           appendOutputBuffer ( FTermOutput&
+                                             , const std::string& );
+    static int            appendOutputBuffer (FTermOutput&, int);
 
     // Data members
     FTermArea*               print_area{nullptr};        // print area for this object
     FTermArea*               child_print_area{nullptr};  // print area for children
     FTermArea*               vwin{nullptr};              // virtual window
-    static const FVTerm*     init_object;  // Global FVTerm object
-    static FSystem*          fsystem;
-    static FTerm*            fterm;
-    static FTermArea*        vterm;        // virtual terminal
-    static FTermArea*        vdesktop;     // virtual desktop
-    static FTermArea*        active_area;  // active area
-    static std::vector<int>* output_buffer;
-    static FChar             term_attribute;
-    static FChar             next_attribute;
-    static FChar             s_ch;      // shadow character
-    static FChar             i_ch;      // inherit background character
-    static FPoint*           term_pos;  // terminal cursor position
-    static FMouseControl*    mouse;
-    static timeval           time_last_flush;
-    static timeval           last_term_size_check;
-    static bool              draw_completed;
-    static bool              no_terminal_updates;
-    static bool              force_terminal_update;
-    static uInt64            flush_wait;
-    static uInt64            term_size_check_timeout;
-    static uInt              erase_char_length;
-    static uInt              repeat_char_length;
-    static uInt              clr_bol_length;
-    static uInt              clr_eol_length;
-    static uInt              cursor_address_length;
-    static bool              cursor_hideable;
+    static FVTermSession     default_session;
+    static FVTermSession*    session;  // Current session
 };
 
 
@@ -493,6 +551,73 @@ struct FVTerm::FTermArea  // define virtual terminal character properties
 };
 
 
+//----------------------------------------------------------------------
+// struct FVTerm::FVTermSession
+//----------------------------------------------------------------------
+
+struct FVTerm::FVTermSession  // state of one virtual terminal session
+{
+  // Constructor
+  FVTermSession() = default;
+
+  // Disable copy constructor
+  FVTermSession (const FVTermSession&) = delete;
+
+  // Destructor
+  ~FVTermSession() = default;
+
+  // Disable copy assignment operator (=)
+  FVTermSession& operator = (const FVTermSession&) = delete;
+
+  // Data members
+  const FVTerm*        init_object{nullptr};  // Root FVTerm object
+  FSystem*             fsystem{nullptr};
+  FTerm*               fterm{nullptr};
+  FTermArea*           vterm{nullptr};        // virtual terminal
+  FTermArea*           vdesktop{nullptr};     // virtual desktop
+  FTermArea*           active_area{nullptr};  // active area
+  std::vector<int>*    output_buffer{nullptr};
+  FOutputWriter*       output_writer{nullptr};  // Non-blocking output
+  std::vector<FRect>*  damage_list{nullptr};  // Pending restore regions
+  FChar                term_attribute{};
+  FChar                next_attribute{};
+  FPoint*              term_pos{nullptr};     // terminal cursor position
+  FMouseControl*       mouse{nullptr};
+  FWorkerPool*         worker_pool{nullptr};  // Parallel composition
+  timeval              time_last_flush{};
+  timeval              time_last_background_frame{};
+  timeval              last_term_size_check{};
+  uInt64               flush_wait{16667};     // 16.6 ms  (60 Hz)
+  uInt64               background_frame_wait{1000000};  // 1 s  (1 Hz)
+  uInt64               term_size_check_timeout{500000};  // 500 ms
+  uInt                 erase_char_length{};
+  uInt                 repeat_char_length{};
+  uInt                 clr_bol_length{};
+  uInt                 clr_eol_length{};
+  uInt                 cursor_address_length{};
+  bool                 draw_completed{false};
+  bool                 no_terminal_updates{false};
+  bool                 force_terminal_update{false};
+  bool                 cursor_hideable{false};
+  bool                 terminal_focused{true};
+};
+
+
+//----------------------------------------------------------------------
+// struct FVTerm::FTermOutput
+//----------------------------------------------------------------------
+
+struct FVTerm::FTermOutput  // state of an encoder of terminal output
+{
+  std::vector<int>*  buffer{nullptr};          // encoded characters
+  FPoint*            term_pos{nullptr};        // terminal cursor position
+  FChar*             term_attribute{nullptr};  // terminal attributes
+  FOptiAttr*         opti_attr{nullptr};       // nullptr: FTerm optimizer
+  FOptiMove*         opti_move{nullptr};       // nullptr: FTerm optimizer
+  bool               flushable{true};          // flush() a full buffer
+};
+
+
 //----------------------------------------------------------------------
 // struct FVTerm::FVTermPreprocessing
 //----------------------------------------------------------------------
@@ -608,13 +733,21 @@ inline FVTerm& FVTerm::operator << (const FColorPair& pair)
 inline FString FVTerm::getClassName() const
 { return "FVTerm"; }
 
+//----------------------------------------------------------------------
+inline uInt64 FVTerm::getBackgroundFrameInterval()
+{ return session->background_frame_wait; }
+
+//----------------------------------------------------------------------
+inline void FVTerm::setBackgroundFrameInterval (uInt64 wait)
+{ session->background_frame_wait = wait; }
+
 //----------------------------------------------------------------------
 inline FColor FVTerm::getTermForegroundColor()
-{ return next_attribute.fg_color; }
+{ return session->next_attribute.fg_color; }
 
 //----------------------------------------------------------------------
 inline FColor FVTerm::getTermBackgroundColor()
-{ return next_attribute.bg_color; }
+{ return session->next_attribute.bg_color; }
 
 //----------------------------------------------------------------------
 inline FVTerm::FTermArea*& FVTerm::getVWin()
@@ -626,11 +759,11 @@ inline const FVTerm::FTermArea* FVTerm::getVWin() const
 
 //----------------------------------------------------------------------
 inline FChar FVTerm::getAttribute()
-{ return next_attribute; }
+{ return session->next_attribute; }
 
 //----------------------------------------------------------------------
 inline FTerm& FVTerm::getFTerm() const
-{ return *fterm; }
+{ return *session->fterm; }
 
 //----------------------------------------------------------------------
 inline void FVTerm::hideCursor() const
@@ -644,24 +777,24 @@ inline void FVTerm::showCursor() const
 inline void FVTerm::setColor (FColor fg, FColor bg)
 {
   // Changes colors
-  next_attribute.fg_color = fg;
-  next_attribute.bg_color = bg;
+  session->next_attribute.fg_color = fg;
+  session->next_attribute.bg_color = bg;
 }
 
 //----------------------------------------------------------------------
 inline void FVTerm::setNormal()
 {
   // reset all character attributes
-  next_attribute.attr.byte[0] = 0;
-  next_attribute.attr.byte[1] = 0;
-  next_attribute.attr.bit.no_changes = false;
-  next_attribute.fg_color = fc::Default;
-  next_attribute.bg_color = fc::Default;
+  session->next_attribute.attr.byte[0] = 0;
+  session->next_attribute.attr.byte[1] = 0;
+  session->next_attribute.attr.bit.no_changes = false;
+  session->next_attribute.fg_color = fc::Default;
+  session->next_attribute.bg_color = fc::Default;
 }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setBold (bool enable)
-{ return (next_attribute.attr.bit.bold = enable); }
+{ return (session->next_attribute.attr.bit.bold = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setBold()
@@ -673,7 +806,7 @@ inline bool FVTerm::unsetBold()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setDim (bool enable)
-{ return (next_attribute.attr.bit.dim = enable); }
+{ return (session->next_attribute.attr.bit.dim = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setDim()
@@ -685,7 +818,7 @@ inline bool FVTerm::unsetDim()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setItalic (bool enable)
-{ return (next_attribute.attr.bit.italic = enable); }
+{ return (session->next_attribute.attr.bit.italic = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setItalic()
@@ -697,7 +830,7 @@ inline bool FVTerm::unsetItalic()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setUnderline (bool enable)
-{ return (next_attribute.attr.bit.underline = enable); }
+{ return (session->next_attribute.attr.bit.underline = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setUnderline()
@@ -709,7 +842,7 @@ inline bool FVTerm::unsetUnderline()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setBlink (bool enable)
-{ return (next_attribute.attr.bit.blink = enable); }
+{ return (session->next_attribute.attr.bit.blink = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setBlink()
@@ -721,7 +854,7 @@ inline bool FVTerm::unsetBlink()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setReverse (bool enable)
-{ return (next_attribute.attr.bit.reverse = enable); }
+{ return (session->next_attribute.attr.bit.reverse = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setReverse()
@@ -733,7 +866,7 @@ inline bool FVTerm::unsetReverse()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setStandout (bool enable)
-{ return (next_attribute.attr.bit.standout = enable); }
+{ return (session->next_attribute.attr.bit.standout = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setStandout()
@@ -745,7 +878,7 @@ inline bool FVTerm::unsetStandout()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setInvisible (bool enable)
-{ return (next_attribute.attr.bit.invisible = enable); }
+{ return (session->next_attribute.attr.bit.invisible = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setInvisible()
@@ -757,7 +890,7 @@ inline bool FVTerm::unsetInvisible()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setProtected (bool enable)
-{ return (next_attribute.attr.bit.protect = enable); }
+{ return (session->next_attribute.attr.bit.protect = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setProtected()
@@ -769,7 +902,7 @@ inline bool FVTerm::unsetProtected()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setCrossedOut (bool enable)
-{ return (next_attribute.attr.bit.crossed_out = enable); }
+{ return (session->next_attribute.attr.bit.crossed_out = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setCrossedOut()
@@ -781,7 +914,7 @@ inline bool FVTerm::unsetCrossedOut()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setDoubleUnderline (bool enable)
-{ return (next_attribute.attr.bit.dbl_underline = enable); }
+{ return (session->next_attribute.attr.bit.dbl_underline = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setDoubleUnderline()
@@ -793,7 +926,7 @@ inline bool FVTerm::unsetDoubleUnderline()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setAltCharset (bool enable)
-{ return (next_attribute.attr.bit.alt_charset = enable); }
+{ return (session->next_attribute.attr.bit.alt_charset = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setAltCharset()
@@ -805,7 +938,7 @@ inline bool FVTerm::unsetAltCharset()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setPCcharset (bool enable)
-{ return (next_attribute.attr.bit.pc_charset = enable); }
+{ return (session->next_attribute.attr.bit.pc_charset = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setPCcharset()
@@ -817,7 +950,7 @@ inline bool FVTerm::unsetPCcharset()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setTransparent (bool enable)
-{ return (next_attribute.attr.bit.transparent = enable); }
+{ return (session->next_attribute.attr.bit.transparent = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setTransparent()
@@ -829,7 +962,7 @@ inline bool FVTerm::unsetTransparent()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setColorOverlay (bool enable)
-{ return (next_attribute.attr.bit.color_overlay = enable); }
+{ return (session->next_attribute.attr.bit.color_overlay = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setColorOverlay()
@@ -841,7 +974,7 @@ inline bool FVTerm::unsetColorOverlay()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setInheritBackground (bool enable)
-{ return (next_attribute.attr.bit.inherit_background = enable); }
+{ return (session->next_attribute.attr.bit.inherit_background = enable); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::setInheritBackground()
@@ -861,67 +994,71 @@ inline void FVTerm::unsetNonBlockingRead()
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isBold()
-{ return next_attribute.attr.bit.bold; }
+{ return session->next_attribute.attr.bit.bold; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isDim()
-{ return next_attribute.attr.bit.dim; }
+{ return session->next_attribute.attr.bit.dim; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isItalic()
-{ return next_attribute.attr.bit.italic; }
+{ return session->next_attribute.attr.bit.italic; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isUnderline()
-{ return next_attribute.attr.bit.underline; }
+{ return session->next_attribute.attr.bit.underline; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isBlink()
-{ return next_attribute.attr.bit.blink; }
+{ return session->next_attribute.attr.bit.blink; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isReverse()
-{ return next_attribute.attr.bit.reverse; }
+{ return session->next_attribute.attr.bit.reverse; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isStandout()
-{ return next_attribute.attr.bit.standout; }
+{ return session->next_attribute.attr.bit.standout; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isInvisible()
-{ return next_attribute.attr.bit.invisible; }
+{ return session->next_attribute.attr.bit.invisible; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isProtected()
-{ return next_attribute.attr.bit.protect; }
+{ return session->next_attribute.attr.bit.protect; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isCrossedOut()
-{ return next_attribute.attr.bit.crossed_out; }
+{ return session->next_attribute.attr.bit.crossed_out; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isDoubleUnderline()
-{ return next_attribute.attr.bit.dbl_underline; }
+{ return session->next_attribute.attr.bit.dbl_underline; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isAltCharset()
-{ return next_attribute.attr.bit.alt_charset; }
+{ return session->next_attribute.attr.bit.alt_charset; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isPCcharset()
-{ return next_attribute.attr.bit.pc_charset; }
+{ return session->next_attribute.attr.bit.pc_charset; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isTransparent()
-{ return next_attribute.attr.bit.transparent; }
+{ return session->next_attribute.attr.bit.transparent; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isTransShadow()
-{ return next_attribute.attr.bit.color_overlay; }
+{ return session->next_attribute.attr.bit.color_overlay; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isInheritBackground()
-{ return next_attribute.attr.bit.inherit_background; }
+{ return session->next_attribute.attr.bit.inherit_background; }
+
+//----------------------------------------------------------------------
+inline bool FVTerm::isTerminalFocused()
+{ return session->terminal_focused; }
 
 //----------------------------------------------------------------------
 template <typename... Args>
@@ -946,11 +1083,11 @@ inline FVTerm::FTermArea* FVTerm::getCurrentPrintArea() const
 
 //----------------------------------------------------------------------
 inline FVTerm::FTermArea* FVTerm::getVirtualDesktop() const
-{ return vdesktop; }
+{ return session->vdesktop; }
 
 //----------------------------------------------------------------------
 inline FVTerm::FTermArea* FVTerm::getVirtualTerminal() const
-{ return vterm; }
+{ return session->vterm; }
 
 //----------------------------------------------------------------------
 inline void FVTerm::setPrintArea (FTermArea* area)
@@ -962,11 +1099,11 @@ inline void FVTerm::setChildPrintArea (FTermArea* area)
 
 //----------------------------------------------------------------------
 inline void FVTerm::setActiveArea (FTermArea* area) const
-{ active_area = area; }
+{ session->active_area = area; }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isActive (const FTermArea* area) const
-{ return bool( area == active_area ); }
+{ return bool( area == session->active_area ); }
 
 //----------------------------------------------------------------------
 inline bool FVTerm::hasPrintArea() const
@@ -982,11 +1119,15 @@ inline bool FVTerm::isVirtualWindow() const
 
 //----------------------------------------------------------------------
 inline bool FVTerm::isCursorHideable() const
-{ return cursor_hideable; }
+{ return session->cursor_hideable; }
+
+//----------------------------------------------------------------------
+inline bool FVTerm::isTerminalUpdateStopped() const
+{ return session->no_terminal_updates; }
 
 //----------------------------------------------------------------------
 inline void FVTerm::hideVTermCursor() const
-{ vterm->input_cursor_visible = false; }
+{ session->vterm->input_cursor_visible = false; }
 
 
 }  // namespace finalcut
@@ -161,9 +161,13 @@ class FWidget : public FVTerm, public FObject
       uInt32 flat           : 1;
       uInt32 no_border      : 1;
       uInt32 no_underline   : 1;
-      uInt32                : 13;  // padding bits
+      uInt32 update_pending : 1;
+      uInt32                : 12;  // padding bits
     };
 
+    // Type tag
+    static const FTypeTag<FWidget> type_tag;
+
     // Constructor
     explicit FWidget (FWidget* = nullptr);
 
@@ -178,6 +182,7 @@ class FWidget : public FVTerm, public FObject
 
     // Accessors
     FString                  getClassName() const override;
+    FTypeId                  getTypeId() const override;
     FWidget*                 getRootWidget();
     FWidget*                 getParentWidget() const;
     static FWidget*&         getMainWidget();
@@ -316,11 +321,13 @@ class FWidget : public FVTerm, public FObject
     template <typename... Args>
     void                     delCallback (Args&&...) noexcept;
     void                     emitCallback (const FString&) const;
+    void                     emitCallback (const char[]) const;
     void                     addAccelerator (FKey);
     virtual void             addAccelerator (FKey, FWidget*);
     void                     delAccelerator ();
     virtual void             delAccelerator (FWidget*);
     virtual void             redraw();
+    void                     update();
     virtual void             resize();
     virtual void             show();
     virtual void             hide();
@@ -339,6 +346,7 @@ class FWidget : public FVTerm, public FObject
     static FWidgetList*&     getDialogList();
     static FWidgetList*&     getAlwaysOnTopList();
     static FWidgetList*&     getWidgetCloseList();
+    static FWidgetList*&     getWidgetUpdateList();
     void                     addPreprocessingHandler ( const FVTerm*
                                                      , const FPreprocessingFunction& ) override;
     void                     delPreprocessingHandler (const FVTerm*) override;
@@ -360,6 +368,7 @@ class FWidget : public FVTerm, public FObject
     virtual void             adjustSize();
     void                     adjustSizeGlobal();
     void                     hideArea (const FSize&);
+    bool                     processUpdateList();
     virtual bool             focusNextChild();  // Change child...
     virtual bool             focusPrevChild();  // ...focus
 
@@ -368,6 +377,7 @@ class FWidget : public FVTerm, public FObject
     virtual void             onKeyPress (FKeyEvent*);
     virtual void             onKeyUp (FKeyEvent*);
     virtual void             onKeyDown (FKeyEvent*);
+    virtual void             onPaste (FPasteEvent*);
     virtual void             onMouseDown (FMouseEvent*);
     virtual void             onMouseUp (FMouseEvent*);
     virtual void             onMouseDoubleClick (FMouseEvent*);
@@ -377,6 +387,8 @@ class FWidget : public FVTerm, public FObject
     virtual void             onFocusOut (FFocusEvent*);
     virtual void             onChildFocusIn (FFocusEvent*);
     virtual void             onChildFocusOut (FFocusEvent*);
+    virtual void             onTerminalFocusIn (FFocusEvent*);
+    virtual void             onTerminalFocusOut (FFocusEvent*);
     virtual void             onAccel (FAccelEvent*);
     virtual void             onResize (FResizeEvent*);
     virtual void             onShow (FShowEvent*);
@@ -436,6 +448,7 @@ class FWidget : public FVTerm, public FObject
     void                     insufficientSpaceAdjust();
     void                     KeyPressEvent (FKeyEvent*);
     void                     KeyDownEvent (FKeyEvent*);
+    void                     PasteEvent (FPasteEvent*);
     void                     emitWheelCallback (const FWheelEvent*) const;
     void                     setWindowFocus (bool);
     bool                     changeFocus (FWidget*, FWidget*, fc::FocusTypes);
@@ -443,6 +456,8 @@ class FWidget : public FVTerm, public FObject
     virtual void             draw();
     void                     drawWindows() const;
     void                     drawChildren();
+    bool                     hasPendingParentUpdate() const;
+    void                     removeUpdateRequest();
     static bool              isDefaultTheme();
     static void              initColorTheme();
     void                     destroyColorTheme();
@@ -491,6 +506,7 @@ class FWidget : public FVTerm, public FObject
     static FWidgetList*      dialog_list;
     static FWidgetList*      always_on_top_list;
     static FWidgetList*      close_widget;
+    static FWidgetList*      update_widget;
     static uInt              modal_dialog_counter;
     static bool              init_terminal;
     static bool              init_desktop;
@@ -538,6 +554,10 @@ void          drawNewFontListBox (FWidget*, const FRect&);
 inline FString FWidget::getClassName() const
 { return "FWidget"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FWidget::getTypeId() const
+{ return getTypeIdOf<FWidget>(); }
+
 //----------------------------------------------------------------------
 inline FWidget*& FWidget::getMainWidget()
 { return main_widget; }
@@ -998,6 +1018,12 @@ inline void FWidget::emitCallback (const FString& emit_signal) const
   callback_impl.emitCallback(emit_signal);
 }
 
+//----------------------------------------------------------------------
+inline void FWidget::emitCallback (const char emit_signal[]) const
+{
+  callback_impl.emitCallback(emit_signal);
+}
+
 //----------------------------------------------------------------------
 inline void FWidget::addAccelerator (FKey key)
 { addAccelerator (key, this); }
@@ -1041,6 +1067,10 @@ inline FWidget::FWidgetList*& FWidget::getAlwaysOnTopList()
 inline FWidget::FWidgetList*& FWidget::getWidgetCloseList()
 { return close_widget; }
 
+//----------------------------------------------------------------------
+inline FWidget::FWidgetList*& FWidget::getWidgetUpdateList()
+{ return update_widget; }
+
 //----------------------------------------------------------------------
 inline uInt& FWidget::setModalDialogCounter()
 { return modal_dialog_counter; }
@@ -70,6 +70,9 @@ class FWindow : public FWidget
     // Using-declaration
     using FWidget::setGeometry;
 
+    // Type tag
+    static const FTypeTag<FWindow> type_tag;
+
     // Constructor
     explicit FWindow (FWidget* = nullptr);
 
@@ -84,6 +87,7 @@ class FWindow : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    FTypeId             getTypeId() const override;
     static FWindow*     getWindowWidget (FWidget*);
     static int          getWindowLayer (FWidget*);
     FWidget*            getWindowFocusWidget() const;
@@ -184,6 +188,10 @@ void closeDropDown (const FWidget*, const FPoint&);
 inline FString FWindow::getClassName() const
 { return "FWindow"; }
 
+//----------------------------------------------------------------------
+inline FObject::FTypeId FWindow::getTypeId() const
+{ return getTypeIdOf<FWindow>(); }
+
 //----------------------------------------------------------------------
 inline bool FWindow::setWindowWidget()
 { return setWindowWidget(true); }
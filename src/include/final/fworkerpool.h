@@ -0,0 +1,114 @@
+/***********************************************************************
+* fworkerpool.h - A pool of worker threads                             *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FWorkerPool ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  FWorkerPool runs the jobs 0 … n-1 of a parallel loop on a fixed
+ *  set of threads. The calling thread takes part in the work, and
+ *  run() returns when all jobs are done. A pool with one thread
+ *  runs the jobs directly in the calling thread.
+ */
+
+#ifndef FWORKERPOOL_H
+#define FWORKERPOOL_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "final/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FWorkerPool
+//----------------------------------------------------------------------
+
+class FWorkerPool final
+{
+  public:
+    // Typedef
+    typedef std::function<void(std::size_t)> Job;
+
+    // Constructor
+    explicit FWorkerPool (std::size_t);
+
+    // Disable copy constructor
+    FWorkerPool (const FWorkerPool&) = delete;
+
+    // Destructor
+    ~FWorkerPool();
+
+    // Disable copy assignment operator (=)
+    FWorkerPool& operator = (const FWorkerPool&) = delete;
+
+    // Accessors
+    FString                  getClassName() const;
+    std::size_t              getThreadCount() const;
+
+    // Method
+    void                     run (std::size_t, const Job&);
+
+  private:
+    // Methods
+    void                     work();
+    void                     processJobs();
+
+    // Data members
+    std::vector<std::thread> workers{};
+    std::mutex               mutex{};
+    std::condition_variable  start{};
+    std::condition_variable  done{};
+    const Job*               job{nullptr};
+    std::size_t              job_count{0};
+    std::atomic<std::size_t> next_job{0};
+    std::size_t              active_workers{0};
+    uInt64                   generation{0};
+    bool                     running{true};
+};
+
+// FWorkerPool inline functions
+//----------------------------------------------------------------------
+inline FString FWorkerPool::getClassName() const
+{ return "FWorkerPool"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FWorkerPool::getThreadCount() const
+{ return workers.size() + 1; }
+
+}  // namespace finalcut
+
+#endif  // FWORKERPOOL_H
@@ -0,0 +1,267 @@
+/***********************************************************************
+* fcolorquantizer-test.cpp - FColorQuantizer unit tests                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2019-2020 Markus Gans                                      *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FColorQuantizerTest
+//----------------------------------------------------------------------
+
+class FColorQuantizerTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FColorQuantizerTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void rgbColorTest();
+    void paletteColorTest();
+    void paletteIndexTest();
+    void quantize8Test();
+    void quantize16Test();
+    void quantize88Test();
+    void quantize256Test();
+    void changedPaletteTest();
+    void copyTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FColorQuantizerTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (rgbColorTest);
+    CPPUNIT_TEST (paletteColorTest);
+    CPPUNIT_TEST (paletteIndexTest);
+    CPPUNIT_TEST (quantize8Test);
+    CPPUNIT_TEST (quantize16Test);
+    CPPUNIT_TEST (quantize88Test);
+    CPPUNIT_TEST (quantize256Test);
+    CPPUNIT_TEST (changedPaletteTest);
+    CPPUNIT_TEST (copyTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::classNameTest()
+{
+  const finalcut::FColorQuantizer q;
+  const finalcut::FString& classname = q.getClassName();
+  CPPUNIT_ASSERT ( classname == "FColorQuantizer" );
+  CPPUNIT_ASSERT ( finalcut::FColorQuantizer::TABLE_SIZE == 32768 );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::rgbColorTest()
+{
+  const FColor color = finalcut::rgbColor (0x12, 0x34, 0x56);
+  CPPUNIT_ASSERT ( color == 0x01123456 );
+  CPPUNIT_ASSERT ( finalcut::isRGBColor(color) );
+  CPPUNIT_ASSERT ( finalcut::getRed(color) == 0x12 );
+  CPPUNIT_ASSERT ( finalcut::getGreen(color) == 0x34 );
+  CPPUNIT_ASSERT ( finalcut::getBlue(color) == 0x56 );
+  CPPUNIT_ASSERT ( finalcut::isRGBColor(finalcut::rgbColor(0, 0, 0)) );
+  CPPUNIT_ASSERT ( ! finalcut::isRGBColor(finalcut::fc::Default) );
+  CPPUNIT_ASSERT ( ! finalcut::isRGBColor(finalcut::fc::Black) );
+  CPPUNIT_ASSERT ( ! finalcut::isRGBColor(finalcut::fc::Grey93) );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::paletteColorTest()
+{
+  finalcut::FColorQuantizer q;
+  CPPUNIT_ASSERT ( q.getPaletteColor(finalcut::fc::Black)
+                   == finalcut::rgbColor(0x00, 0x00, 0x00) );
+  CPPUNIT_ASSERT ( q.getPaletteColor(finalcut::fc::Blue)
+                   == finalcut::rgbColor(0x00, 0x00, 0xaa) );
+  CPPUNIT_ASSERT ( q.getPaletteColor(finalcut::fc::Brown)
+                   == finalcut::rgbColor(0xaa, 0x55, 0x00) );
+  CPPUNIT_ASSERT ( q.getPaletteColor(finalcut::fc::White)
+                   == finalcut::rgbColor(0xff, 0xff, 0xff) );
+  CPPUNIT_ASSERT ( q.getPaletteColor(16) == finalcut::fc::Default );
+  CPPUNIT_ASSERT ( q.getPaletteColor(finalcut::fc::Default)
+                   == finalcut::fc::Default );
+
+  q.setPaletteColor (finalcut::fc::Blue, 0x10, 0x3b, 0x9e);
+  CPPUNIT_ASSERT ( q.getPaletteColor(finalcut::fc::Blue)
+                   == finalcut::rgbColor(0x10, 0x3b, 0x9e) );
+
+  // Only system colors can be changed
+  q.setPaletteColor (100, 0x10, 0x3b, 0x9e);
+  CPPUNIT_ASSERT ( q.getPaletteColor(100) == finalcut::fc::Default );
+
+  q.resetPalette();
+  CPPUNIT_ASSERT ( q.getPaletteColor(finalcut::fc::Blue)
+                   == finalcut::rgbColor(0x00, 0x00, 0xaa) );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::paletteIndexTest()
+{
+  // Palette colors are not converted
+  finalcut::FColorQuantizer q;
+  CPPUNIT_ASSERT ( q.quantize(finalcut::fc::Red, 16) == finalcut::fc::Red );
+  CPPUNIT_ASSERT ( q.quantize(finalcut::fc::Grey50, 256)
+                   == finalcut::fc::Grey50 );
+  CPPUNIT_ASSERT ( q.quantize(finalcut::fc::Default, 256)
+                   == finalcut::fc::Default );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::quantize8Test()
+{
+  finalcut::FColorQuantizer q;
+  CPPUNIT_ASSERT ( q.quantize(0x00, 0x00, 0x00, 8) == finalcut::fc::Black );
+  CPPUNIT_ASSERT ( q.quantize(0xff, 0xff, 0xff, 8)
+                   == finalcut::fc::LightGray );
+  CPPUNIT_ASSERT ( q.quantize(0xe0, 0x10, 0x10, 8) == finalcut::fc::Red );
+  CPPUNIT_ASSERT ( q.quantize(0x10, 0x10, 0xc0, 8) == finalcut::fc::Blue );
+  CPPUNIT_ASSERT ( q.quantize(0x20, 0xb0, 0x20, 8) == finalcut::fc::Green );
+
+  // Every table entry is a valid palette index
+  for (uInt i{0}; i < 256; i += 5)
+    CPPUNIT_ASSERT ( q.quantize(uInt8(i), uInt8(255 - i), 0x80, 8) < 8 );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::quantize16Test()
+{
+  finalcut::FColorQuantizer q;
+  CPPUNIT_ASSERT ( q.quantize(0xff, 0xff, 0xff, 16) == finalcut::fc::White );
+  CPPUNIT_ASSERT ( q.quantize(0xaa, 0xaa, 0xaa, 16)
+                   == finalcut::fc::LightGray );
+  CPPUNIT_ASSERT ( q.quantize(0x50, 0x50, 0x50, 16)
+                   == finalcut::fc::DarkGray );
+  CPPUNIT_ASSERT ( q.quantize(0xff, 0x50, 0x50, 16)
+                   == finalcut::fc::LightRed );
+  CPPUNIT_ASSERT ( q.quantize(0x00, 0x00, 0xa0, 16) == finalcut::fc::Blue );
+  CPPUNIT_ASSERT ( q.quantize(0xf0, 0xf0, 0x60, 16) == finalcut::fc::Yellow );
+
+  for (uInt i{0}; i < 256; i += 5)
+    CPPUNIT_ASSERT ( q.quantize(0x80, uInt8(i), uInt8(255 - i), 16) < 16 );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::quantize88Test()
+{
+  // Colors 16 to 79 form a 4x4x4 color cube
+  // and colors 80 to 87 are a gray ramp
+  finalcut::FColorQuantizer q;
+  CPPUNIT_ASSERT ( q.quantize(0x00, 0x00, 0x00, 88) == 16 );
+  CPPUNIT_ASSERT ( q.quantize(0xff, 0x00, 0x00, 88) == 64 );
+  CPPUNIT_ASSERT ( q.quantize(0x00, 0x8b, 0xff, 88) == 23 );
+  CPPUNIT_ASSERT ( q.quantize(0xff, 0xff, 0xff, 88) == 79 );
+  CPPUNIT_ASSERT ( q.quantize(0x5c, 0x5c, 0x5c, 88) == 81 );
+
+  for (uInt i{0}; i < 256; i += 5)
+  {
+    const FColor color = q.quantize(uInt8(i), 0x40, uInt8(255 - i), 88);
+    CPPUNIT_ASSERT ( color >= 16 && color < 88 );
+  }
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::quantize256Test()
+{
+  // Colors 16 to 231 form a 6x6x6 color cube
+  // and colors 232 to 255 are a gray ramp
+  finalcut::FColorQuantizer q;
+  CPPUNIT_ASSERT ( q.quantize(0x00, 0x00, 0x00, 256)
+                   == finalcut::fc::Grey0 );
+  CPPUNIT_ASSERT ( q.quantize(0xff, 0x00, 0x00, 256)
+                   == finalcut::fc::Red1 );
+  CPPUNIT_ASSERT ( q.quantize(0x5f, 0x87, 0xaf, 256)
+                   == finalcut::fc::SteelBlue );
+  CPPUNIT_ASSERT ( q.quantize(0xff, 0xff, 0xff, 256)
+                   == finalcut::fc::Grey100 );
+  CPPUNIT_ASSERT ( q.quantize(0x30, 0x30, 0x30, 256)
+                   == finalcut::fc::Grey19 );
+  CPPUNIT_ASSERT ( q.quantize(finalcut::rgbColor(0xee, 0xee, 0xee), 256)
+                   == finalcut::fc::Grey93 );
+
+  for (uInt i{0}; i < 256; i += 5)
+    CPPUNIT_ASSERT ( q.quantize(0x20, uInt8(255 - i), uInt8(i), 256) >= 16 );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::changedPaletteTest()
+{
+  finalcut::FColorQuantizer q;
+  const FColor orange = finalcut::rgbColor(0xe8, 0x87, 0x1f);
+  CPPUNIT_ASSERT ( q.quantize(orange, 16) == finalcut::fc::LightRed );
+
+  // The tables of the system colors are rebuilt after a palette change
+  q.setPaletteColor (finalcut::fc::Brown, 0xe8, 0x87, 0x1f);
+  CPPUNIT_ASSERT ( q.quantize(orange, 16) == finalcut::fc::Brown );
+  CPPUNIT_ASSERT ( q.quantize(orange, 8) == finalcut::fc::Brown );
+
+  // The color cube of the 256 color palette is fixed
+  const FColor cube_color = q.quantize(orange, 256);
+  CPPUNIT_ASSERT ( cube_color >= 16 );
+  q.setPaletteColor (finalcut::fc::Brown, 0x00, 0x00, 0x00);
+  CPPUNIT_ASSERT ( q.quantize(orange, 256) == cube_color );
+  CPPUNIT_ASSERT ( q.quantize(orange, 16) != finalcut::fc::Brown );
+
+  q.resetPalette();
+  CPPUNIT_ASSERT ( q.quantize(orange, 16) != finalcut::fc::Brown );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::copyTest()
+{
+  finalcut::FColorQuantizer q;
+  const FColor orange = finalcut::rgbColor(0xe8, 0x87, 0x1f);
+  q.initTable(16);
+  q.initTable(256);
+  const FColor cube_color = q.quantize(orange, 256);
+
+  // A copy shares the built tables
+  finalcut::FColorQuantizer copy{q};
+  CPPUNIT_ASSERT ( copy.quantize(orange, 16) == finalcut::fc::LightRed );
+  CPPUNIT_ASSERT ( copy.quantize(orange, 256) == cube_color );
+
+  // A palette change does not affect the tables of the other copy
+  q.setPaletteColor (finalcut::fc::Brown, 0xe8, 0x87, 0x1f);
+  CPPUNIT_ASSERT ( q.quantize(orange, 16) == finalcut::fc::Brown );
+  CPPUNIT_ASSERT ( copy.quantize(orange, 16) == finalcut::fc::LightRed );
+  copy.setPaletteColor (finalcut::fc::LightRed, 0x00, 0x00, 0x00);
+  CPPUNIT_ASSERT ( copy.quantize(orange, 16) != finalcut::fc::LightRed );
+  CPPUNIT_ASSERT ( q.quantize(orange, 16) == finalcut::fc::Brown );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FColorQuantizerTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,225 @@
+/***********************************************************************
+* feventstatistics-test.cpp - FEventStatistics unit tests              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <sstream>
+#include <string>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FEventStatisticsTest
+//----------------------------------------------------------------------
+
+class FEventStatisticsTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FEventStatisticsTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void eventNameTest();
+    void histogramBucketTest();
+    void addTest();
+    void userEventTest();
+    void clearTest();
+    void printTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FEventStatisticsTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (eventNameTest);
+    CPPUNIT_TEST (histogramBucketTest);
+    CPPUNIT_TEST (addTest);
+    CPPUNIT_TEST (userEventTest);
+    CPPUNIT_TEST (clearTest);
+    CPPUNIT_TEST (printTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+
+//----------------------------------------------------------------------
+void FEventStatisticsTest::classNameTest()
+{
+  const finalcut::FEventStatistics s;
+  const finalcut::FString& classname = s.getClassName();
+  CPPUNIT_ASSERT ( classname == "FEventStatistics" );
+}
+
+//----------------------------------------------------------------------
+void FEventStatisticsTest::noArgumentTest()
+{
+  finalcut::FEventStatistics s;
+  CPPUNIT_ASSERT ( ! s.isEnabled() );
+  CPPUNIT_ASSERT ( s.getTotalCount() == 0 );
+
+  const auto& entry = s.getEntry(finalcut::fc::KeyPress_Event);
+  CPPUNIT_ASSERT ( entry.count == 0 );
+  CPPUNIT_ASSERT ( entry.total_time == 0 );
+  CPPUNIT_ASSERT ( entry.max_time == 0 );
+
+  for (auto&& n : entry.histogram)
+    CPPUNIT_ASSERT ( n == 0 );
+
+  s.enable();
+  CPPUNIT_ASSERT ( s.isEnabled() );
+  s.disable();
+  CPPUNIT_ASSERT ( ! s.isEnabled() );
+}
+
+//----------------------------------------------------------------------
+void FEventStatisticsTest::eventNameTest()
+{
+  using finalcut::FEventStatistics;
+  using finalcut::fc::events;
+  CPPUNIT_ASSERT ( std::string(FEventStatistics::getEventName
+                     (finalcut::fc::None_Event)) == "None" );
+  CPPUNIT_ASSERT ( std::string(FEventStatistics::getEventName
+                     (finalcut::fc::MouseMove_Event)) == "MouseMove" );
+  CPPUNIT_ASSERT ( std::string(FEventStatistics::getEventName
+                     (finalcut::fc::Timer_Event)) == "Timer" );
+  CPPUNIT_ASSERT ( std::string(FEventStatistics::getEventName
+                     (finalcut::fc::User_Event)) == "User" );
+  CPPUNIT_ASSERT ( std::string(FEventStatistics::getEventName
+                     (events(finalcut::fc::User_Event + 7))) == "User" );
+}
+
+//----------------------------------------------------------------------
+void FEventStatisticsTest::histogramBucketTest()
+{
+  using finalcut::FEventStatistics;
+  CPPUNIT_ASSERT ( FEventStatistics::getHistogramBucket(0) == 0 );
+  CPPUNIT_ASSERT ( FEventStatistics::getHistogramBucket(999) == 0 );
+  CPPUNIT_ASSERT ( FEventStatistics::getHistogramBucket(1000) == 1 );
+  CPPUNIT_ASSERT ( FEventStatistics::getHistogramBucket(1999) == 1 );
+  CPPUNIT_ASSERT ( FEventStatistics::getHistogramBucket(2000) == 2 );
+  CPPUNIT_ASSERT ( FEventStatistics::getHistogramBucket(3999) == 2 );
+  CPPUNIT_ASSERT ( FEventStatistics::getHistogramBucket(4000) == 3 );
+  CPPUNIT_ASSERT ( FEventStatistics::getHistogramBucket(1000000) == 10 );
+
+  // Very long times are counted in the last bucket
+  const std::size_t last = FEventStatistics::HISTOGRAM_SIZE - 1;
+  CPPUNIT_ASSERT ( FEventStatistics::getHistogramBucket(uInt64(1) << 40)
+                   == last );
+}
+
+//----------------------------------------------------------------------
+void FEventStatisticsTest::addTest()
+{
+  finalcut::FEventStatistics s;
+  s.add (finalcut::fc::KeyPress_Event, 500);
+  s.add (finalcut::fc::KeyPress_Event, 3000);
+  s.add (finalcut::fc::KeyPress_Event, 1500);
+  s.add (finalcut::fc::Timer_Event, 20000);
+
+  const auto& key = s.getEntry(finalcut::fc::KeyPress_Event);
+  CPPUNIT_ASSERT ( key.count == 3 );
+  CPPUNIT_ASSERT ( key.total_time == 5000 );
+  CPPUNIT_ASSERT ( key.max_time == 3000 );
+  CPPUNIT_ASSERT ( key.histogram[0] == 1 );
+  CPPUNIT_ASSERT ( key.histogram[1] == 1 );
+  CPPUNIT_ASSERT ( key.histogram[2] == 1 );
+  CPPUNIT_ASSERT ( key.histogram[3] == 0 );
+
+  const auto& timer = s.getEntry(finalcut::fc::Timer_Event);
+  CPPUNIT_ASSERT ( timer.count == 1 );
+  CPPUNIT_ASSERT ( timer.max_time == 20000 );
+  CPPUNIT_ASSERT ( timer.histogram[5] == 1 );
+
+  CPPUNIT_ASSERT ( s.getEntry(finalcut::fc::MouseMove_Event).count == 0 );
+  CPPUNIT_ASSERT ( s.getTotalCount() == 4 );
+}
+
+//----------------------------------------------------------------------
+void FEventStatisticsTest::userEventTest()
+{
+  // User events with a higher type number share one entry
+  finalcut::FEventStatistics s;
+  const auto user_type = finalcut::fc::events(finalcut::fc::User_Event + 3);
+  s.add (finalcut::fc::User_Event, 100);
+  s.add (user_type, 200);
+
+  CPPUNIT_ASSERT ( s.getEntry(finalcut::fc::User_Event).count == 2 );
+  CPPUNIT_ASSERT ( s.getEntry(user_type).count == 2 );
+  CPPUNIT_ASSERT ( s.getEntry(user_type).total_time == 300 );
+  CPPUNIT_ASSERT ( s.getTotalCount() == 2 );
+}
+
+//----------------------------------------------------------------------
+void FEventStatisticsTest::clearTest()
+{
+  finalcut::FEventStatistics s;
+  s.enable();
+  s.add (finalcut::fc::MouseMove_Event, 12345);
+  s.add (finalcut::fc::Resize_Event, 54321);
+  CPPUNIT_ASSERT ( s.getTotalCount() == 2 );
+
+  s.clear();
+  CPPUNIT_ASSERT ( s.getTotalCount() == 0 );
+  CPPUNIT_ASSERT ( s.getEntry(finalcut::fc::MouseMove_Event).max_time == 0 );
+  CPPUNIT_ASSERT ( s.getEntry(finalcut::fc::Resize_Event)
+                    .histogram[6] == 0 );
+
+  // Clearing does not change the enable state
+  CPPUNIT_ASSERT ( s.isEnabled() );
+}
+
+//----------------------------------------------------------------------
+void FEventStatisticsTest::printTest()
+{
+  finalcut::FEventStatistics s;
+  s.add (finalcut::fc::MouseMove_Event, 1500);
+  s.add (finalcut::fc::MouseMove_Event, 2500);
+
+  std::ostringstream out{};
+  out << std::hex;
+  s.print(out);
+  const std::string& table = out.str();
+  CPPUNIT_ASSERT ( table.find("event") == 0 );
+  CPPUNIT_ASSERT ( table.find("MouseMove") != std::string::npos );
+  CPPUNIT_ASSERT ( table.find("KeyPress") == std::string::npos );
+  CPPUNIT_ASSERT ( table.find(" 1:1 2:1") != std::string::npos );
+
+  // The format flags of the stream are restored
+  CPPUNIT_ASSERT ( out.flags() & std::ios::hex );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FEventStatisticsTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,313 @@
+/***********************************************************************
+* fgrapheme-test.cpp - FGrapheme unit tests                            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <cwchar>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FGraphemeTest
+//----------------------------------------------------------------------
+
+class FGraphemeTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FGraphemeTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void breakPropertyTest();
+    void charWidthTest();
+    void controlTest();
+    void combiningMarkTest();
+    void hangulTest();
+    void emojiTest();
+    void regionalIndicatorTest();
+    void columnWidthTest();
+    void charCellTest();
+
+  private:
+    std::size_t clusterLength (const wchar_t[]);
+    std::size_t clusterWidth (const wchar_t[]);
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FGraphemeTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (breakPropertyTest);
+    CPPUNIT_TEST (charWidthTest);
+    CPPUNIT_TEST (controlTest);
+    CPPUNIT_TEST (combiningMarkTest);
+    CPPUNIT_TEST (hangulTest);
+    CPPUNIT_TEST (emojiTest);
+    CPPUNIT_TEST (regionalIndicatorTest);
+    CPPUNIT_TEST (columnWidthTest);
+    CPPUNIT_TEST (charCellTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+
+//----------------------------------------------------------------------
+void FGraphemeTest::classNameTest()
+{
+  const finalcut::FString& classname = finalcut::FGrapheme::getClassName();
+  CPPUNIT_ASSERT ( classname == "FGrapheme" );
+}
+
+//----------------------------------------------------------------------
+void FGraphemeTest::breakPropertyTest()
+{
+  using finalcut::FGrapheme;
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(L'A') == FGrapheme::Other );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(L'\r') == FGrapheme::CR );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(L'\n') == FGrapheme::LF );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(L'\t') == FGrapheme::Control );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0x0301) == FGrapheme::Extend );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0x200d) == FGrapheme::ZWJ );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0x1f1e9)
+                   == FGrapheme::RegionalIndicator );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0x0600) == FGrapheme::Prepend );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0x0903)
+                   == FGrapheme::SpacingMark );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0x1100) == FGrapheme::L );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0x1161) == FGrapheme::V );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0x11a8) == FGrapheme::T );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0xac00) == FGrapheme::LV );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0xac01) == FGrapheme::LVT );
+
+  CPPUNIT_ASSERT ( FGrapheme::isExtendedPictographic(0x1f600) );
+  CPPUNIT_ASSERT ( FGrapheme::isExtendedPictographic(0x2764) );
+  CPPUNIT_ASSERT ( ! FGrapheme::isExtendedPictographic(L'A') );
+  CPPUNIT_ASSERT ( ! FGrapheme::isExtendedPictographic(0x1f1e9) );
+
+  // Code points outside the Unicode range
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(0x110000) == FGrapheme::Other );
+  CPPUNIT_ASSERT ( FGrapheme::getBreakProperty(wchar_t(-1))
+                   == FGrapheme::Other );
+  CPPUNIT_ASSERT ( ! FGrapheme::isExtendedPictographic(0x110000) );
+}
+
+//----------------------------------------------------------------------
+void FGraphemeTest::charWidthTest()
+{
+  using finalcut::FGrapheme;
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(L'A') == 1 );
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(L'\0') == 0 );
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(L'\n') == 0 );
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x00e4) == 1 );   // ä
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x00ad) == 1 );   // Soft hyphen
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x0301) == 0 );   // Combining
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x200b) == 0 );   // Zero width
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x2502) == 1 );   // │
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x00b1) == 1 );   // Ambiguous
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x4e2d) == 2 );   // 中
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x1100) == 2 );   // ᄀ
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x1161) == 0 );   // ᅡ
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0xac00) == 2 );   // 가
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0xff21) == 2 );   // Ａ
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0xff61) == 1 );   // ｡
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x1f600) == 2 );  // 😀
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x20000) == 2 );  // 𠀀
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0xe000) == 1 );   // Private use
+  CPPUNIT_ASSERT ( FGrapheme::getCharWidth(0x110000) == 1 );
+}
+
+//----------------------------------------------------------------------
+void FGraphemeTest::controlTest()
+{
+  // GB3 - GB5
+  CPPUNIT_ASSERT ( clusterLength(L"\r\nA") == 2 );
+  CPPUNIT_ASSERT ( clusterWidth(L"\r\nA") == 0 );
+  CPPUNIT_ASSERT ( clusterLength(L"\n\r") == 1 );
+  CPPUNIT_ASSERT ( clusterLength(L"\r\x0301") == 1 );
+  CPPUNIT_ASSERT ( clusterLength(L"A\r") == 1 );
+  CPPUNIT_ASSERT ( clusterLength(L"\t\x0301") == 1 );
+
+  // Empty strings
+  std::size_t width{1};
+  CPPUNIT_ASSERT ( finalcut::FGrapheme::nextCluster(nullptr, 5, width) == 0 );
+  CPPUNIT_ASSERT ( width == 0 );
+  CPPUNIT_ASSERT ( finalcut::FGrapheme::nextCluster(L"A", 0, width) == 0 );
+  CPPUNIT_ASSERT ( width == 0 );
+
+  // The length limits the cluster
+  CPPUNIT_ASSERT ( finalcut::FGrapheme::nextCluster(L"e\x0301", 1, width)
+                   == 1 );
+  CPPUNIT_ASSERT ( width == 1 );
+}
+
+//----------------------------------------------------------------------
+void FGraphemeTest::combiningMarkTest()
+{
+  // GB9 - GB9b
+  CPPUNIT_ASSERT ( clusterLength(L"e\x0301x") == 2 );
+  CPPUNIT_ASSERT ( clusterWidth(L"e\x0301x") == 1 );
+  CPPUNIT_ASSERT ( clusterLength(L"a\x0308\x0323\x0301") == 4 );
+  CPPUNIT_ASSERT ( clusterWidth(L"a\x0308\x0323\x0301") == 1 );
+  CPPUNIT_ASSERT ( clusterLength(L"A\x200d") == 2 );
+  CPPUNIT_ASSERT ( clusterLength(L"A\x200d" L"B") == 2 );
+
+  // A combining mark without base character
+  CPPUNIT_ASSERT ( clusterLength(L"\x0301" L"a") == 1 );
+  CPPUNIT_ASSERT ( clusterWidth(L"\x0301" L"a") == 0 );
+
+  // Devanagari ka + sign aa (spacing mark)
+  CPPUNIT_ASSERT ( clusterLength(L"\x0915\x093e") == 2 );
+
+  // Arabic number sign (prepend) + digit
+  CPPUNIT_ASSERT ( clusterLength(L"\x0600" L"1") == 2 );
+  CPPUNIT_ASSERT ( clusterWidth(L"\x0600" L"1") == 1 );
+}
+
+//----------------------------------------------------------------------
+void FGraphemeTest::hangulTest()
+{
+  // GB6 - GB8
+  CPPUNIT_ASSERT ( clusterLength(L"\x1100\x1161\x11a8\x1100") == 3 );
+  CPPUNIT_ASSERT ( clusterWidth(L"\x1100\x1161\x11a8\x1100") == 2 );
+  CPPUNIT_ASSERT ( clusterLength(L"\xac00\x11a8") == 2 );
+  CPPUNIT_ASSERT ( clusterWidth(L"\xac00\x11a8") == 2 );
+  CPPUNIT_ASSERT ( clusterLength(L"\xac01\x1161") == 1 );
+  CPPUNIT_ASSERT ( clusterLength(L"\xac00\xac00") == 1 );
+}
+
+//----------------------------------------------------------------------
+void FGraphemeTest::emojiTest()
+{
+  // Family: man, woman, girl, boy (GB11)
+  const wchar_t family[] = L"\U0001f468\x200d\U0001f469\x200d"
+                           L"\U0001f467\x200d\U0001f466!";
+  CPPUNIT_ASSERT ( clusterLength(family) == 7 );
+  CPPUNIT_ASSERT ( clusterWidth(family) == 2 );
+
+  // Thumbs up with skin tone modifier
+  CPPUNIT_ASSERT ( clusterLength(L"\U0001f44d\U0001f3fd") == 2 );
+  CPPUNIT_ASSERT ( clusterWidth(L"\U0001f44d\U0001f3fd") == 2 );
+
+  // Heart with emoji presentation selector
+  CPPUNIT_ASSERT ( clusterWidth(L"\x2764") == 1 );
+  CPPUNIT_ASSERT ( clusterLength(L"\x2764\xfe0f") == 2 );
+  CPPUNIT_ASSERT ( clusterWidth(L"\x2764\xfe0f") == 2 );
+
+  // Rainbow flag: flag + VS16 + ZWJ + rainbow
+  const wchar_t rainbow_flag[] = L"\U0001f3f3\xfe0f\x200d\U0001f308";
+  CPPUNIT_ASSERT ( clusterLength(rainbow_flag) == 4 );
+  CPPUNIT_ASSERT ( clusterWidth(rainbow_flag) == 2 );
+
+  // A zero width joiner after a letter joins no pictograph
+  CPPUNIT_ASSERT ( clusterLength(L"A\x200d\U0001f600") == 2 );
+
+  // Two emoji without joiner
+  CPPUNIT_ASSERT ( clusterLength(L"\U0001f600\U0001f600") == 1 );
+}
+
+//----------------------------------------------------------------------
+void FGraphemeTest::regionalIndicatorTest()
+{
+  // GB12, GB13 - German and French flag
+  const wchar_t flags[] = L"\U0001f1e9\U0001f1ea\U0001f1eb\U0001f1f7";
+  CPPUNIT_ASSERT ( clusterLength(flags) == 2 );
+  CPPUNIT_ASSERT ( clusterWidth(flags) == 2 );
+  CPPUNIT_ASSERT ( clusterLength(flags + 2) == 2 );
+  CPPUNIT_ASSERT ( finalcut::FGrapheme::getColumnWidth(flags, 4) == 4 );
+
+  // A single regional indicator
+  CPPUNIT_ASSERT ( clusterLength(L"\U0001f1e9A") == 1 );
+  CPPUNIT_ASSERT ( clusterWidth(L"\U0001f1e9A") == 1 );
+}
+
+//----------------------------------------------------------------------
+void FGraphemeTest::columnWidthTest()
+{
+  using finalcut::FGrapheme;
+  CPPUNIT_ASSERT ( FGrapheme::getColumnWidth(L"", 0) == 0 );
+  CPPUNIT_ASSERT ( FGrapheme::getColumnWidth(L"abc", 3) == 3 );
+  CPPUNIT_ASSERT ( FGrapheme::getColumnWidth(L"abc", 2) == 2 );
+  CPPUNIT_ASSERT ( FGrapheme::getColumnWidth(L"\x4e2d\x6587", 2) == 4 );
+  CPPUNIT_ASSERT ( FGrapheme::getColumnWidth(L"Cafe\x0301", 5) == 4 );
+
+  const wchar_t text[] = L"a\U0001f468\x200d\U0001f469\x200d\U0001f467b";
+  CPPUNIT_ASSERT ( FGrapheme::getColumnWidth(text, 7) == 4 );
+
+  // The string functions use the grapheme clusters
+  const finalcut::FString str{text};
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(str) == 4 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(str, 1) == 1 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(str, 2) == 3 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(str, 6) == 3 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(str, 7) == 4 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(str, 100) == 4 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(finalcut::FString{}) == 0 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(wchar_t(0x4e2d)) == 2 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(wchar_t(0x0301)) == 0 );
+}
+
+//----------------------------------------------------------------------
+void FGraphemeTest::charCellTest()
+{
+  // A character cell with all code points of a grapheme cluster
+  finalcut::FChar fchar{};
+  fchar.ch = { L'e', 0x0301, 0x0323, L'\0' };
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 1 );
+  CPPUNIT_ASSERT ( fchar.attr.bit.char_width == 1 );
+
+  fchar.ch = { 0x0301, L'\0' };
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
+  CPPUNIT_ASSERT ( fchar.attr.bit.char_width == 0 );
+
+  fchar.ch = { L'A', 0x0308, 0x0301, 0x0323, 0x0304 };
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 1 );
+  CPPUNIT_ASSERT ( fchar.ch[4] == 0x0304 );
+}
+
+//----------------------------------------------------------------------
+std::size_t FGraphemeTest::clusterLength (const wchar_t str[])
+{
+  std::size_t width{0};
+  return finalcut::FGrapheme::nextCluster (str, std::wcslen(str), width);
+}
+
+//----------------------------------------------------------------------
+std::size_t FGraphemeTest::clusterWidth (const wchar_t str[])
+{
+  std::size_t width{0};
+  finalcut::FGrapheme::nextCluster (str, std::wcslen(str), width);
+  return width;
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FGraphemeTest);
+
+// The general unit test main part
+#include <main-test.inc>
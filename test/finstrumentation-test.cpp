@@ -0,0 +1,322 @@
+/***********************************************************************
+* finstrumentation-test.cpp - FInstrumentation unit tests              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <array>
+#include <csignal>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FInstrumentationTest
+//----------------------------------------------------------------------
+
+class FInstrumentationTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FInstrumentationTest()
+    { }
+
+    void setUp() override;
+    void tearDown() override;
+
+  protected:
+    void classNameTest();
+    void probeNameTest();
+    void disabledTest();
+    void countTest();
+    void frameTest();
+    void scopedTimerTest();
+    void printTest();
+    void dumpSignalTest();
+    void socketTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FInstrumentationTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (probeNameTest);
+    CPPUNIT_TEST (disabledTest);
+    CPPUNIT_TEST (countTest);
+    CPPUNIT_TEST (frameTest);
+    CPPUNIT_TEST (scopedTimerTest);
+    CPPUNIT_TEST (printTest);
+    CPPUNIT_TEST (dumpSignalTest);
+    CPPUNIT_TEST (socketTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::setUp()
+{
+  finalcut::FInstrumentation::clear();
+  finalcut::FInstrumentation::enable();
+}
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::tearDown()
+{
+  finalcut::FInstrumentation::disable();
+  finalcut::FInstrumentation::clear();
+  finalcut::FInstrumentation::clearDumpRequest();
+  finalcut::FInstrumentation::setDumpSocket("");
+}
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::classNameTest()
+{
+  const finalcut::FString& classname =
+      finalcut::FInstrumentation::getClassName();
+  CPPUNIT_ASSERT ( classname == "FInstrumentation" );
+}
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::probeNameTest()
+{
+  using finalcut::FInstrumentation;
+  CPPUNIT_ASSERT ( std::string(FInstrumentation::getProbeName
+                     (FInstrumentation::UpdateVTerm)) == "updateVTerm" );
+  CPPUNIT_ASSERT ( std::string(FInstrumentation::getProbeName
+                     (FInstrumentation::Flush)) == "flush" );
+  CPPUNIT_ASSERT ( std::string(FInstrumentation::getProbeName
+                     (FInstrumentation::WidgetRedraw)) == "widgetRedraw" );
+  CPPUNIT_ASSERT ( std::string(FInstrumentation::getProbeName
+                     (FInstrumentation::FrameSkipped)) == "frameSkipped" );
+  CPPUNIT_ASSERT ( std::string(FInstrumentation::getProbeName
+                     (FInstrumentation::NumberOfProbes)) == "" );
+}
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::disabledTest()
+{
+  using finalcut::FInstrumentation;
+  FInstrumentation::disable();
+  CPPUNIT_ASSERT ( ! FInstrumentation::isEnabled() );
+
+  FInstrumentation::count (FInstrumentation::MoveCursor);
+  FInstrumentation::addAmount (FInstrumentation::Flush, 100);
+  FInstrumentation::addTime (FInstrumentation::PutArea, 1000);
+
+  {
+    FInstrumentation::ScopedTimer timer(FInstrumentation::UpdateTerminal);
+  }
+
+  FInstrumentation::endFrame();
+  CPPUNIT_ASSERT ( FInstrumentation::getFrameCount() == 0 );
+
+  for (std::size_t i{0}; i < FInstrumentation::NumberOfProbes; i++)
+  {
+    const auto counter =
+        FInstrumentation::getCounter(FInstrumentation::Probe(i));
+    CPPUNIT_ASSERT ( counter.count == 0 );
+    CPPUNIT_ASSERT ( counter.amount == 0 );
+    CPPUNIT_ASSERT ( counter.total_time == 0 );
+  }
+}
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::countTest()
+{
+  using finalcut::FInstrumentation;
+  CPPUNIT_ASSERT ( FInstrumentation::isEnabled() );
+
+  for (int i{0}; i < 5; i++)
+    FInstrumentation::count (FInstrumentation::ChangeAttribute);
+
+  FInstrumentation::count (FInstrumentation::Flush);
+  FInstrumentation::addAmount (FInstrumentation::Flush, 300);
+  FInstrumentation::addTime (FInstrumentation::Flush, 4000);
+  FInstrumentation::addTime (FInstrumentation::Flush, 1000);
+
+  const auto attr = FInstrumentation::getCounter
+      (FInstrumentation::ChangeAttribute);
+  CPPUNIT_ASSERT ( attr.count == 5 );
+  CPPUNIT_ASSERT ( attr.amount == 0 );
+
+  const auto flush = FInstrumentation::getCounter(FInstrumentation::Flush);
+  CPPUNIT_ASSERT ( flush.count == 1 );
+  CPPUNIT_ASSERT ( flush.amount == 300 );
+  CPPUNIT_ASSERT ( flush.total_time == 5000 );
+  CPPUNIT_ASSERT ( flush.max_time == 4000 );
+
+  FInstrumentation::clear();
+  CPPUNIT_ASSERT ( FInstrumentation::getCounter
+                     (FInstrumentation::ChangeAttribute).count == 0 );
+  CPPUNIT_ASSERT ( FInstrumentation::getCounter
+                     (FInstrumentation::Flush).amount == 0 );
+}
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::frameTest()
+{
+  using finalcut::FInstrumentation;
+  FInstrumentation::count (FInstrumentation::MoveCursor);
+  FInstrumentation::count (FInstrumentation::MoveCursor);
+  FInstrumentation::addTime (FInstrumentation::PutArea, 7000);
+
+  // Values of the running frame are not a completed frame yet
+  CPPUNIT_ASSERT ( FInstrumentation::getFrameCount() == 0 );
+  CPPUNIT_ASSERT ( FInstrumentation::getFrameCounter
+                     (FInstrumentation::MoveCursor).count == 0 );
+
+  FInstrumentation::endFrame();
+  CPPUNIT_ASSERT ( FInstrumentation::getFrameCount() == 1 );
+  CPPUNIT_ASSERT ( FInstrumentation::getFrameCounter
+                     (FInstrumentation::MoveCursor).count == 2 );
+
+  FInstrumentation::count (FInstrumentation::MoveCursor);
+  FInstrumentation::addTime (FInstrumentation::PutArea, 3000);
+  FInstrumentation::endFrame();
+  CPPUNIT_ASSERT ( FInstrumentation::getFrameCount() == 2 );
+  CPPUNIT_ASSERT ( FInstrumentation::getFrameCounter
+                     (FInstrumentation::MoveCursor).count == 1 );
+
+  const auto& put_area = FInstrumentation::getFrameCounter
+      (FInstrumentation::PutArea);
+  CPPUNIT_ASSERT ( put_area.total_time == 3000 );
+  CPPUNIT_ASSERT ( put_area.max_time == 3000 );
+
+  // The totals contain all frames
+  const auto total = FInstrumentation::getCounter(FInstrumentation::PutArea);
+  CPPUNIT_ASSERT ( total.total_time == 10000 );
+  CPPUNIT_ASSERT ( total.max_time == 7000 );
+  CPPUNIT_ASSERT ( FInstrumentation::getCounter
+                     (FInstrumentation::MoveCursor).count == 3 );
+}
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::scopedTimerTest()
+{
+  using finalcut::FInstrumentation;
+
+  {
+    FInstrumentation::ScopedTimer timer(FInstrumentation::WidgetRedraw);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+
+  const auto redraw = FInstrumentation::getCounter
+      (FInstrumentation::WidgetRedraw);
+  CPPUNIT_ASSERT ( redraw.count == 1 );
+  CPPUNIT_ASSERT ( redraw.total_time >= 2000000 );
+  CPPUNIT_ASSERT ( redraw.max_time == redraw.total_time );
+}
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::printTest()
+{
+  using finalcut::FInstrumentation;
+  FInstrumentation::count (FInstrumentation::Event);
+  FInstrumentation::count (FInstrumentation::Event);
+  FInstrumentation::endFrame();
+
+  std::ostringstream out{};
+  FInstrumentation::print(out);
+  const std::string& dump = out.str();
+  CPPUNIT_ASSERT ( dump.find("frames: 1\n") == 0 );
+  CPPUNIT_ASSERT ( dump.find("updateVTerm") != std::string::npos );
+  CPPUNIT_ASSERT ( dump.find("widgetRedraw") != std::string::npos );
+
+  const auto pos = dump.find("event ");
+  CPPUNIT_ASSERT ( pos != std::string::npos );
+  const auto line = dump.substr(pos, dump.find('\n', pos) - pos);
+  CPPUNIT_ASSERT ( line.find(" 2 ") != std::string::npos );
+}
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::dumpSignalTest()
+{
+  using finalcut::FInstrumentation;
+  CPPUNIT_ASSERT ( ! FInstrumentation::isDumpRequested() );
+
+  FInstrumentation::setDumpSignal (SIGUSR1);
+  std::raise (SIGUSR1);
+  CPPUNIT_ASSERT ( FInstrumentation::isDumpRequested() );
+
+  FInstrumentation::clearDumpRequest();
+  CPPUNIT_ASSERT ( ! FInstrumentation::isDumpRequested() );
+  std::signal (SIGUSR1, SIG_DFL);
+}
+
+//----------------------------------------------------------------------
+void FInstrumentationTest::socketTest()
+{
+  using finalcut::FInstrumentation;
+
+  // Without a socket path nothing can be written
+  CPPUNIT_ASSERT ( FInstrumentation::getDumpSocket().empty() );
+  CPPUNIT_ASSERT ( ! FInstrumentation::writeToSocket("test") );
+
+  // No listener on the socket path
+  const std::string path = "/tmp/finstrumentation-test."
+                         + std::to_string(getpid());
+  FInstrumentation::setDumpSocket (path);
+  CPPUNIT_ASSERT ( FInstrumentation::getDumpSocket() == path );
+  CPPUNIT_ASSERT ( ! FInstrumentation::writeToSocket("test") );
+
+  const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  CPPUNIT_ASSERT ( server >= 0 );
+  struct sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strncpy (address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  auto addr = reinterpret_cast<struct sockaddr*>(&address);
+  CPPUNIT_ASSERT ( bind(server, addr, sizeof(address)) == 0 );
+  CPPUNIT_ASSERT ( listen(server, 1) == 0 );
+
+  const std::string text = "frames: 42\n";
+  CPPUNIT_ASSERT ( FInstrumentation::writeToSocket(text) );
+
+  const int client = accept(server, nullptr, nullptr);
+  CPPUNIT_ASSERT ( client >= 0 );
+  std::array<char, 64> buffer{};
+  const ssize_t bytes = read(client, buffer.data(), buffer.size() - 1);
+  CPPUNIT_ASSERT ( bytes == ssize_t(text.length()) );
+  CPPUNIT_ASSERT ( std::string(buffer.data()) == text );
+
+  close(client);
+  close(server);
+  unlink(path.c_str());
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FInstrumentationTest);
+
+// The general unit test main part
+#include <main-test.inc>
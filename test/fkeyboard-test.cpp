@@ -301,6 +301,8 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void sequencesTest();
     void mouseTest();
     void utf8Test();
+    void pasteTest();
+    void termFocusTest();
     void unknownKeyTest();
 
   private:
@@ -318,6 +320,8 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (sequencesTest);
     CPPUNIT_TEST (mouseTest);
     CPPUNIT_TEST (utf8Test);
+    CPPUNIT_TEST (pasteTest);
+    CPPUNIT_TEST (termFocusTest);
     CPPUNIT_TEST (unknownKeyTest);
 
     // End of test suite definition
@@ -330,11 +334,16 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void keyReleased();
     void escapeKeyPressed();
     void mouseTracking();
+    void textPasted();
+    void termFocusChanged();
 
     // Data members
     FKey key_pressed{0};
     FKey key_released{0};
     int  number_of_keys{0};
+    int  number_of_pastes{0};
+    int  number_of_focus_changes{0};
+    finalcut::FString pasted_text{};
     finalcut::FKeyboard* keyboard{nullptr};
 };
 
@@ -2958,6 +2967,64 @@ void FKeyboardTest::utf8Test()
   clear();
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::pasteTest()
+{
+  // Bracketed paste (the text arrives as a single paste)
+  input("\033[200~Hello\r\nWorld\033[201~");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  CPPUNIT_ASSERT ( pasted_text == L"Hello\nWorld" );
+  CPPUNIT_ASSERT ( ! keyboard->isPasteMode() );
+  CPPUNIT_ASSERT ( keyboard->getPasteText().isEmpty() );
+  clear();
+
+  // Keys within the paste do not trigger key presses
+  input("\033[200~\033OP\t\342\202\254\033[201~B");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( pasted_text == L"\033OP\t\u20ac" );
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == 'B' );
+  clear();
+
+  // Paste in several parts
+  input("\033[200~first ");
+  processInput();
+  CPPUNIT_ASSERT ( keyboard->isPasteMode() );
+  CPPUNIT_ASSERT ( number_of_pastes == 0 );
+  input("second\033[20");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 0 );
+  input("1~");
+  processInput();
+  CPPUNIT_ASSERT ( ! keyboard->isPasteMode() );
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( pasted_text == L"first second" );
+  clear();
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::termFocusTest()
+{
+  // Terminal focus out
+  input("\033[O");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_focus_changes == 1 );
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::fc::Fkey_term_focus_out );
+  clear();
+
+  // Terminal focus in, followed by a key
+  input("\033[IA");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_focus_changes == 1 );
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == 'A' );
+  clear();
+}
+
 //----------------------------------------------------------------------
 void FKeyboardTest::unknownKeyTest()
 {
@@ -2983,14 +3050,20 @@ void FKeyboardTest::init()
   auto cmd2 = std::bind(&FKeyboardTest::keyReleased, this);
   auto cmd3 = std::bind(&FKeyboardTest::escapeKeyPressed, this);
   auto cmd4 = std::bind(&FKeyboardTest::mouseTracking, this);
+  auto cmd5 = std::bind(&FKeyboardTest::textPasted, this);
+  auto cmd6 = std::bind(&FKeyboardTest::termFocusChanged, this);
   finalcut::FKeyboardCommand key_cmd1 (cmd1);
   finalcut::FKeyboardCommand key_cmd2 (cmd2);
   finalcut::FKeyboardCommand key_cmd3 (cmd3);
   finalcut::FKeyboardCommand key_cmd4 (cmd4);
+  finalcut::FKeyboardCommand key_cmd5 (cmd5);
+  finalcut::FKeyboardCommand key_cmd6 (cmd6);
   keyboard->setPressCommand (key_cmd1);
   keyboard->setReleaseCommand (key_cmd2);
   keyboard->setEscPressedCommand (key_cmd3);
   keyboard->setMouseTrackingCommand (key_cmd4);
+  keyboard->setPasteCommand (key_cmd5);
+  keyboard->setTermFocusCommand (key_cmd6);
   keyboard->setKeypressTimeout (100000);  // 100 ms
   processInput();
   CPPUNIT_ASSERT ( key_pressed == 0 );
@@ -3046,8 +3119,11 @@ void FKeyboardTest::clear()
 {
   keyboard->clearKeyBuffer();
   number_of_keys = \
+     number_of_pastes = \
+     number_of_focus_changes = \
      key_pressed = \
      key_released = 0;
+  pasted_text = finalcut::FString{};
 }
 
 //----------------------------------------------------------------------
@@ -3077,6 +3153,20 @@ void FKeyboardTest::mouseTracking()
   key_pressed = keyboard->getKey();
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::textPasted()
+{
+  pasted_text = keyboard->getPasteText();
+  number_of_pastes++;
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::termFocusChanged()
+{
+  key_pressed = keyboard->getKey();
+  number_of_focus_changes++;
+}
+
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FKeyboardTest);
 
@@ -0,0 +1,321 @@
+/***********************************************************************
+* flistbox-test.cpp - FListBox unit tests                              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FListBoxTest
+//----------------------------------------------------------------------
+
+class FListBoxTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FListBoxTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void removeTest();
+    void filterTest();
+    void filterRemoveTest();
+    void filterReplaceTest();
+    void lineWidthTest();
+    void changedTextTest();
+    void pasteTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FListBoxTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (removeTest);
+    CPPUNIT_TEST (filterTest);
+    CPPUNIT_TEST (filterRemoveTest);
+    CPPUNIT_TEST (filterReplaceTest);
+    CPPUNIT_TEST (lineWidthTest);
+    CPPUNIT_TEST (changedTextTest);
+    CPPUNIT_TEST (pasteTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Methods
+    void fillList (finalcut::FListBox&) const;
+    int scrollToRightEnd (finalcut::FListBox&) const;
+
+    // Data member
+    static finalcut::FWidget root_widget;
+};
+
+// static class attributes
+finalcut::FWidget FListBoxTest::root_widget{nullptr};
+
+//----------------------------------------------------------------------
+void FListBoxTest::fillList (finalcut::FListBox& listbox) const
+{
+  listbox.insert (finalcut::FString{"apple"});
+  listbox.insert (finalcut::FString{"banana"});
+  listbox.insert (finalcut::FString{"Apricot"});
+  listbox.insert (finalcut::FString{"cherry"});
+  listbox.insert (finalcut::FString{"grape"});
+  listbox.insert (finalcut::FString{"papaya"});
+}
+
+//----------------------------------------------------------------------
+int FListBoxTest::scrollToRightEnd (finalcut::FListBox& listbox) const
+{
+  // Returns the horizontal offset at the end of the longest line
+
+  for (int i{0}; i < 40; i++)
+  {
+    finalcut::FKeyEvent k_ev{finalcut::fc::KeyPress_Event
+                            , finalcut::fc::Fkey_right};
+    listbox.onKeyPress (&k_ev);
+  }
+
+  int xoffset{0};
+
+  for (auto&& child : listbox.getChildren())
+    if ( const auto scrollbar = child->cast<finalcut::FScrollbar>() )
+      xoffset = std::max (xoffset, scrollbar->getValue());
+
+  return xoffset;
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::classNameTest()
+{
+  const finalcut::FListBox listbox{&root_widget};
+  const finalcut::FString& classname = listbox.getClassName();
+  CPPUNIT_ASSERT ( classname == "FListBox" );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::removeTest()
+{
+  finalcut::FListBox listbox{&root_widget};
+  fillList (listbox);
+  CPPUNIT_ASSERT ( listbox.getCount() == 6 );
+
+  // The search index follows the removed positions
+  listbox.remove (2, 2);
+  CPPUNIT_ASSERT ( listbox.getCount() == 4 );
+  CPPUNIT_ASSERT ( listbox.getItem(2).getText() == "cherry" );
+  listbox.setFilter ("ap");
+  CPPUNIT_ASSERT ( listbox.getCount() == 3 );
+  CPPUNIT_ASSERT ( listbox.getItem(1).getText() == "apple" );
+  CPPUNIT_ASSERT ( listbox.getItem(2).getText() == "grape" );
+  CPPUNIT_ASSERT ( listbox.getItem(3).getText() == "papaya" );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::filterTest()
+{
+  finalcut::FListBox listbox{&root_widget};
+  fillList (listbox);
+  listbox.setFilter ("ap", finalcut::FSearchIndex::PrefixMatch);
+  CPPUNIT_ASSERT ( listbox.isFiltered() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 2 );
+  CPPUNIT_ASSERT ( listbox.getItem(1).getText() == "apple" );
+  CPPUNIT_ASSERT ( listbox.getItem(2).getText() == "Apricot" );
+
+  // New items are filtered as well
+  listbox.insert (finalcut::FString{"kiwi"});
+  listbox.insert (finalcut::FString{"Apple pie"});
+  CPPUNIT_ASSERT ( listbox.isFiltered() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 3 );
+  CPPUNIT_ASSERT ( listbox.getItem(3).getText() == "Apple pie" );
+
+  listbox.clearFilter();
+  CPPUNIT_ASSERT ( ! listbox.isFiltered() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 8 );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::filterRemoveTest()
+{
+  finalcut::FListBox listbox{&root_widget};
+  fillList (listbox);
+
+  // Shows "apple", "Apricot", "grape" and "papaya"
+  listbox.setFilter ("ap");
+  CPPUNIT_ASSERT ( listbox.getCount() == 4 );
+  listbox.setCurrentItem (2);
+  CPPUNIT_ASSERT ( listbox.getItem(listbox.currentItem()).getText()
+                   == "Apricot" );
+
+  // The position refers to the shown items and the filter stays
+  listbox.remove (listbox.currentItem());
+  CPPUNIT_ASSERT ( listbox.isFiltered() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 3 );
+  CPPUNIT_ASSERT ( listbox.getItem(1).getText() == "apple" );
+  CPPUNIT_ASSERT ( listbox.getItem(2).getText() == "grape" );
+  CPPUNIT_ASSERT ( listbox.getItem(3).getText() == "papaya" );
+  CPPUNIT_ASSERT ( listbox.currentItem() == 1 );
+
+  // Removes the shown items "apple" and "grape" at once
+  listbox.remove (1, 2);
+  CPPUNIT_ASSERT ( listbox.isFiltered() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 1 );
+  CPPUNIT_ASSERT ( listbox.getItem(1).getText() == "papaya" );
+
+  listbox.clearFilter();
+  CPPUNIT_ASSERT ( listbox.getCount() == 3 );
+  CPPUNIT_ASSERT ( listbox.getItem(1).getText() == "banana" );
+  CPPUNIT_ASSERT ( listbox.getItem(2).getText() == "cherry" );
+  CPPUNIT_ASSERT ( listbox.getItem(3).getText() == "papaya" );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::filterReplaceTest()
+{
+  finalcut::FListBox listbox{&root_widget};
+  fillList (listbox);
+
+  // Shows "banana" and "papaya"
+  listbox.setFilter ("aa", finalcut::FSearchIndex::FuzzyMatch);
+  CPPUNIT_ASSERT ( listbox.getCount() == 2 );
+  CPPUNIT_ASSERT ( listbox.getItem(2).getText() == "papaya" );
+
+  // The position refers to the shown items
+  listbox.replace (2, finalcut::FListBoxItem{"guava"});
+  CPPUNIT_ASSERT ( listbox.isFiltered() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 2 );
+  CPPUNIT_ASSERT ( listbox.getItem(2).getText() == "guava" );
+
+  // A replaced item that no longer matches is hidden
+  listbox.replace (2, finalcut::FListBoxItem{"mango"});
+  CPPUNIT_ASSERT ( listbox.isFiltered() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 1 );
+  CPPUNIT_ASSERT ( listbox.getItem(1).getText() == "banana" );
+
+  listbox.clearFilter();
+  CPPUNIT_ASSERT ( listbox.getCount() == 6 );
+  CPPUNIT_ASSERT ( listbox.getItem(2).getText() == "banana" );
+  CPPUNIT_ASSERT ( listbox.getItem(6).getText() == "mango" );
+
+  // The search index contains the new text
+  listbox.setFilter ("man");
+  CPPUNIT_ASSERT ( listbox.getCount() == 1 );
+  CPPUNIT_ASSERT ( listbox.getItem(1).getText() == "mango" );
+  listbox.setFilter ("pap");
+  CPPUNIT_ASSERT ( listbox.getCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::lineWidthTest()
+{
+  finalcut::FListBox listbox{&root_widget};
+  listbox.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{12, 8});
+  fillList (listbox);
+
+  // 20 columns + 2 spaces - 10 columns client width
+  listbox.getItem(2).setText (finalcut::FString{20, L'x'});
+  CPPUNIT_ASSERT ( scrollToRightEnd(listbox) == 12 );
+
+  // The list box follows a shorter text of the longest item
+  listbox.getItem(2).setText (finalcut::FString{16, L'x'});
+  CPPUNIT_ASSERT ( scrollToRightEnd(listbox) == 8 );
+
+  listbox.getItem(4).setText (finalcut::FString{18, L'x'});
+  listbox.remove (2);
+  CPPUNIT_ASSERT ( scrollToRightEnd(listbox) == 10 );
+
+  // Changes of filtered items are kept after the filter
+  listbox.setFilter ("grape");
+  CPPUNIT_ASSERT ( listbox.getCount() == 1 );
+  listbox.getItem(1).setText (finalcut::FString{24, L'x'});
+  listbox.clearFilter();
+  CPPUNIT_ASSERT ( listbox.getItem(4).getText().getLength() == 24 );
+  CPPUNIT_ASSERT ( scrollToRightEnd(listbox) == 16 );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::changedTextTest()
+{
+  finalcut::FListBox listbox{&root_widget};
+  fillList (listbox);
+  CPPUNIT_ASSERT ( listbox.currentItem() == 1 );
+
+  // The incremental search finds the new text
+  listbox.getItem(4).setText ("kiwi");
+  finalcut::FKeyEvent k_ev{finalcut::fc::KeyPress_Event, L'k'};
+  listbox.onKeyPress (&k_ev);
+  CPPUNIT_ASSERT ( k_ev.isAccepted() );
+  CPPUNIT_ASSERT ( listbox.currentItem() == 4 );
+
+  listbox.setFilter ("ch");
+  CPPUNIT_ASSERT ( listbox.getCount() == 0 );
+  listbox.setFilter ("w");
+  CPPUNIT_ASSERT ( listbox.getCount() == 1 );
+
+  // Text changes of shown items reach the complete list
+  listbox.getItem(1).setText ("melon");
+  listbox.clearFilter();
+  CPPUNIT_ASSERT ( listbox.getItem(4).getText() == "melon" );
+  listbox.setFilter ("me");
+  CPPUNIT_ASSERT ( listbox.getCount() == 1 );
+  listbox.setFilter ("kiwi");
+  CPPUNIT_ASSERT ( listbox.getCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::pasteTest()
+{
+  finalcut::FListBox listbox{&root_widget};
+  fillList (listbox);
+  CPPUNIT_ASSERT ( ! listbox.isPasteInsertion() );
+
+  // Without paste insertion, the text is left to the key presses
+  finalcut::FPasteEvent p_ev{finalcut::fc::Paste_Event, "kiwi\n\nlime"};
+  listbox.onPaste (&p_ev);
+  CPPUNIT_ASSERT ( ! p_ev.isAccepted() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 6 );
+
+  // Each non-empty line becomes a new item
+  listbox.setPasteInsertion();
+  CPPUNIT_ASSERT ( listbox.isPasteInsertion() );
+  listbox.onPaste (&p_ev);
+  CPPUNIT_ASSERT ( p_ev.isAccepted() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 8 );
+  CPPUNIT_ASSERT ( listbox.getItem(7).getText() == "kiwi" );
+  CPPUNIT_ASSERT ( listbox.getItem(8).getText() == "lime" );
+
+  listbox.unsetPasteInsertion();
+  CPPUNIT_ASSERT ( ! listbox.isPasteInsertion() );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FListBoxTest);
+
+// The general unit test main part
+#include <main-test.inc>
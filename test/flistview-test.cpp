@@ -0,0 +1,145 @@
+/***********************************************************************
+* flistview-test.cpp - FListView unit tests                            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FListViewTest
+//----------------------------------------------------------------------
+
+class FListViewTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FListViewTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void findItemTest();
+    void findSubItemTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FListViewTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (findItemTest);
+    CPPUNIT_TEST (findSubItemTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Method
+    static finalcut::FString getName (const finalcut::FListViewItem*);
+
+    // Data member
+    static finalcut::FWidget root_widget;
+};
+
+// static class attributes
+finalcut::FWidget FListViewTest::root_widget{nullptr};
+
+//----------------------------------------------------------------------
+finalcut::FString FListViewTest::getName (const finalcut::FListViewItem* item)
+{
+  return ( item ) ? item->getText(1) : finalcut::FString{"-"};
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::classNameTest()
+{
+  const finalcut::FListView listview{&root_widget};
+  const finalcut::FString& classname = listview.getClassName();
+  CPPUNIT_ASSERT ( classname == "FListView" );
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::findItemTest()
+{
+  finalcut::FListView listview{&root_widget};
+  listview.addColumn ("Name");
+  listview.addColumn ("Color");
+  CPPUNIT_ASSERT ( listview.findItem("a") == nullptr );
+
+  const auto apple = listview.insert ({"apple", "red"});
+  listview.insert ({"banana", "yellow"});
+  CPPUNIT_ASSERT ( getName(listview.findItem("B")) == "banana" );
+  CPPUNIT_ASSERT ( getName(listview.findItem("y", 2)) == "banana" );
+  CPPUNIT_ASSERT ( listview.findItem("x") == nullptr );
+
+  // Inserted items are added to the existing index
+  CPPUNIT_ASSERT ( getName(listview.findItem("c")) == "-" );
+  listview.insert ({"cherry", "red"});
+  CPPUNIT_ASSERT ( getName(listview.findItem("c")) == "cherry" );
+
+  // Changed texts replace their index entries
+  auto item = static_cast<finalcut::FListViewItem*>(*apple);
+  item->setText (1, "avocado");
+  CPPUNIT_ASSERT ( getName(listview.findItem("ap")) == "-" );
+  CPPUNIT_ASSERT ( getName(listview.findItem("av")) == "avocado" );
+
+  // Removed items leave the index
+  listview.remove (item);
+  CPPUNIT_ASSERT ( getName(listview.findItem("a")) == "-" );
+  CPPUNIT_ASSERT ( getName(listview.findItem("c")) == "cherry" );
+  delete item;
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::findSubItemTest()
+{
+  finalcut::FListView listview{&root_widget};
+  listview.addColumn ("Name");
+  listview.setTreeView();
+  const auto fruit = listview.insert ({"fruit"});
+  const auto berry = listview.insert ({"berries"});
+  CPPUNIT_ASSERT ( getName(listview.findItem("b")) == "berries" );
+
+  // The first match in tree order wins
+  listview.insert ({"banana"}, fruit);
+  CPPUNIT_ASSERT ( getName(listview.findItem("b")) == "banana" );
+  listview.insert ({"blueberry"}, berry);
+  CPPUNIT_ASSERT ( getName(listview.findItem("bl")) == "blueberry" );
+
+  // Removes "fruit" together with "banana"
+  listview.remove (static_cast<finalcut::FListViewItem*>(*fruit));
+  CPPUNIT_ASSERT ( getName(listview.findItem("f")) == "-" );
+  CPPUNIT_ASSERT ( getName(listview.findItem("b")) == "berries" );
+  CPPUNIT_ASSERT ( getName(listview.findItem("bl")) == "blueberry" );
+  delete static_cast<finalcut::FListViewItem*>(*fruit);
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FListViewTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -105,6 +105,7 @@ class FLoggerTest : public CPPUNIT_NS::TestFixture
     void lineEndingTest();
     void timestampTest();
     void fileTest();
+    void asyncLoggerTest();
     void applicationObjectTest();
 
   private:
@@ -117,6 +118,7 @@ class FLoggerTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (lineEndingTest);
     CPPUNIT_TEST (timestampTest);
     CPPUNIT_TEST (fileTest);
+    CPPUNIT_TEST (asyncLoggerTest);
     CPPUNIT_TEST (applicationObjectTest);
 
     // End of test suite definition
@@ -313,6 +315,85 @@ void FLoggerTest::fileTest()
   }
 }
 
+//----------------------------------------------------------------------
+void FLoggerTest::asyncLoggerTest()
+{
+  finalcut::FAsyncLogger log{};
+  const finalcut::FString& classname = log.getClassName();
+  CPPUNIT_ASSERT ( classname == "FAsyncLogger" );
+  CPPUNIT_ASSERT ( log.getCapacity() == finalcut::FAsyncLogger::DEFAULT_CAPACITY );
+  CPPUNIT_ASSERT ( log.getFormat() == finalcut::FAsyncLogger::Text );
+
+  std::ostringstream buf{};
+  log.setOutputStream(buf);
+  log.info("Hello, World!");
+  log.drain();
+  CPPUNIT_ASSERT ( buf.str() == "[INFO] Hello, World!\r\n" );
+  buf.str("");  // Clear buffer
+
+  log << finalcut::FLog::Warn << "Line 1\nLine 2" << std::flush;
+  log.drain();
+  CPPUNIT_ASSERT ( buf.str() == "[WARNING] Line 1\r\n[WARNING] Line 2\r\n" );
+  buf.str("");  // Clear buffer
+
+  // Compact format
+  log.setFormat (finalcut::FAsyncLogger::Compact);
+  log.setLineEnding (finalcut::FLog::LF);
+  log.error("compact");
+  log.debug("format");
+  log.drain();
+  CPPUNIT_ASSERT ( buf.str() == "E compact\nD format\n" );
+  buf.str("");  // Clear buffer
+
+  log.enableTimestamp();
+  log.info("compact");
+  log.drain();
+  std::size_t length = buf.str().length();
+  CPPUNIT_ASSERT ( buf.str().substr(length - 10) == "I compact\n" );
+  CPPUNIT_ASSERT ( buf.str()[buf.str().find('.') + 7] == ' ' );
+  log.disableTimestamp();
+  buf.str("");  // Clear buffer
+
+  // Binary format
+  log.setFormat (finalcut::FAsyncLogger::Binary);
+  log.warn("bin");
+  log.drain();
+  const std::string record = buf.str();
+  CPPUNIT_ASSERT ( record.length() == 8 + 4 + 1 + 4 + 3 );
+  CPPUNIT_ASSERT ( record[12] == char(finalcut::FLog::Warn) );
+  CPPUNIT_ASSERT ( record[13] == 3 );
+  CPPUNIT_ASSERT ( record[14] == 0 );
+  CPPUNIT_ASSERT ( record.substr(17) == "bin" );
+  buf.str("");  // Clear buffer
+
+  // Overflow: the smallest ring buffer drops excess messages
+  finalcut::FAsyncLogger small_log{1};
+  CPPUNIT_ASSERT ( small_log.getCapacity() == 2 );
+  std::ostringstream small_buf{};
+  small_log.setOutputStream(small_buf);
+  small_log.setLineEnding (finalcut::FLog::LF);
+
+  for (int i{0}; i < 1000; i++)
+    small_log.debug("overflow");
+
+  small_log.drain();
+  std::size_t line_count{0};
+  std::size_t pos{0};
+
+  while ( (pos = small_buf.str().find("[DEBUG] overflow\n", pos))
+          != std::string::npos )
+  {
+    line_count++;
+    pos++;
+  }
+
+  CPPUNIT_ASSERT ( line_count + small_log.getDroppedCount() == 1000 );
+
+  if ( small_log.getDroppedCount() > 0 )
+    CPPUNIT_ASSERT ( small_buf.str().find("log messages dropped")
+                     != std::string::npos );
+}
+
 //----------------------------------------------------------------------
 void FLoggerTest::applicationObjectTest()
 {
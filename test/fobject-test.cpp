@@ -28,6 +28,9 @@
 #include <cppunit/TestResultCollector.h>
 #include <cppunit/TestRunner.h>
 
+#include <stdexcept>
+#include <vector>
+
 #include <final/final.h>
 
 namespace test
@@ -135,6 +138,44 @@ class FObject_userEvent : public finalcut::FObject
     int value{0};
 };
 
+//----------------------------------------------------------------------
+
+class FObject_typed : public finalcut::FObject
+{
+  public:
+    static const finalcut::FTypeTag<FObject_typed> type_tag;
+
+    FObject_typed()
+    { }
+
+    finalcut::FString getClassName() const override
+    {
+      return "FObject_typed";
+    }
+
+    FTypeId getTypeId() const override
+    {
+      return getTypeIdOf<FObject_typed>();
+    }
+};
+
+//----------------------------------------------------------------------
+
+class FObject_named : public FObject_typed
+{
+  public:
+    FObject_named()
+    { }
+
+    finalcut::FString getClassName() const override
+    {
+      return "FObject_named";
+    }
+};
+
+// static class attribute
+const finalcut::FTypeTag<FObject_typed> FObject_typed::type_tag{};
+
 }  // namespace test
 
 
@@ -150,6 +191,8 @@ class FObjectTest : public CPPUNIT_NS::TestFixture
 
   protected:
     void classNameTest();
+    void typeIdTest();
+    void castTest();
     void noArgumentTest();
     void childObjectTest();
     void widgetObjectTest();
@@ -157,6 +200,7 @@ class FObjectTest : public CPPUNIT_NS::TestFixture
     void setParentTest();
     void addTest();
     void delTest();
+    void bulkTest();
     void elementAccessTest();
     void iteratorTest();
     void timeTest();
@@ -170,6 +214,8 @@ class FObjectTest : public CPPUNIT_NS::TestFixture
 
     // Add a methods to the test suite
     CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (typeIdTest);
+    CPPUNIT_TEST (castTest);
     CPPUNIT_TEST (noArgumentTest);
     CPPUNIT_TEST (childObjectTest);
     CPPUNIT_TEST (widgetObjectTest);
@@ -177,6 +223,7 @@ class FObjectTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (setParentTest);
     CPPUNIT_TEST (addTest);
     CPPUNIT_TEST (delTest);
+    CPPUNIT_TEST (bulkTest);
     CPPUNIT_TEST (elementAccessTest);
     CPPUNIT_TEST (iteratorTest);
     CPPUNIT_TEST (timeTest);
@@ -196,6 +243,75 @@ void FObjectTest::classNameTest()
   CPPUNIT_ASSERT ( classname == "FObject" );
 }
 
+//----------------------------------------------------------------------
+void FObjectTest::typeIdTest()
+{
+  using finalcut::FObject;
+  const auto object_id = FObject::getTypeIdOf<FObject>();
+  const auto typed_id = FObject::getTypeIdOf<test::FObject_typed>();
+  CPPUNIT_ASSERT ( object_id != nullptr );
+  CPPUNIT_ASSERT ( typed_id != nullptr );
+  CPPUNIT_ASSERT ( object_id != typed_id );
+  CPPUNIT_ASSERT ( object_id == FObject::getTypeIdOf<FObject>() );
+  CPPUNIT_ASSERT ( object_id == &FObject::type_tag );
+
+  FObject o;
+  CPPUNIT_ASSERT ( o.getTypeId() == object_id );
+  CPPUNIT_ASSERT ( o.isInstanceOf<FObject>() );
+  CPPUNIT_ASSERT ( ! o.isInstanceOf<test::FObject_typed>() );
+
+  // Only the exact class matches
+  test::FObject_typed t;
+  const FObject* obj = &t;
+  CPPUNIT_ASSERT ( obj->getTypeId() == typed_id );
+  CPPUNIT_ASSERT ( obj->isInstanceOf<test::FObject_typed>() );
+  CPPUNIT_ASSERT ( ! obj->isInstanceOf<FObject>() );
+  CPPUNIT_ASSERT ( obj->isInstanceOf("FObject_typed") );
+  CPPUNIT_ASSERT ( ! obj->isInstanceOf("FObject") );
+
+  // A class without its own getTypeId() has the ID of its base class
+  test::FObject_timer timer;
+  CPPUNIT_ASSERT ( timer.getTypeId() == object_id );
+  CPPUNIT_ASSERT ( timer.isInstanceOf<FObject>() );
+  CPPUNIT_ASSERT ( timer.isInstanceOf("FObject") );
+
+  // Overriding only getClassName() keeps the type ID of the base
+  // class, so the integer and the string check differ here.
+  // isInstanceOf<test::FObject_named>() does not compile, because
+  // the class has no type tag of its own.
+  test::FObject_named named;
+  obj = &named;
+  CPPUNIT_ASSERT ( obj->getTypeId() == typed_id );
+  CPPUNIT_ASSERT ( obj->isInstanceOf<test::FObject_typed>() );
+  CPPUNIT_ASSERT ( obj->isInstanceOf("FObject_named") );
+  CPPUNIT_ASSERT ( ! obj->isInstanceOf("FObject_typed") );
+}
+
+//----------------------------------------------------------------------
+void FObjectTest::castTest()
+{
+  using finalcut::FObject;
+  FObject o;
+  CPPUNIT_ASSERT ( o.cast<FObject>() == &o );
+  CPPUNIT_ASSERT ( o.cast<test::FObject_typed>() == nullptr );
+
+  // Only the exact class matches
+  test::FObject_typed t;
+  FObject* obj = &t;
+  CPPUNIT_ASSERT ( obj->cast<test::FObject_typed>() == &t );
+  CPPUNIT_ASSERT ( obj->cast<FObject>() == nullptr );
+
+  const FObject* const_obj = &t;
+  const test::FObject_typed* const_typed = \
+      const_obj->cast<test::FObject_typed>();
+  CPPUNIT_ASSERT ( const_typed == &t );
+
+  // A class that overrides only getClassName() casts to its base class
+  test::FObject_named named;
+  obj = &named;
+  CPPUNIT_ASSERT ( obj->cast<test::FObject_typed>() == &named );
+}
+
 //----------------------------------------------------------------------
 void FObjectTest::noArgumentTest()
 {
@@ -216,6 +332,7 @@ void FObjectTest::noArgumentTest()
   CPPUNIT_ASSERT ( ! o1.isDirectChild(&o2) );
   CPPUNIT_ASSERT ( ! o1.isWidget() );
   CPPUNIT_ASSERT ( o1.isInstanceOf("FObject") );
+  CPPUNIT_ASSERT ( o1.isInstanceOf<finalcut::FObject>() );
   CPPUNIT_ASSERT ( ! o1.isTimerInUpdating() );
 
   test::FObject_protected t;
@@ -458,6 +575,68 @@ void FObjectTest::delTest()
   delete obj;
 }
 
+//----------------------------------------------------------------------
+void FObjectTest::bulkTest()
+{
+  // obj -> child1 ... child5
+  // => newobj -> child0 -> child1 ... child5
+
+  auto obj =  new finalcut::FObject();
+  auto newobj =  new finalcut::FObject();
+  auto child0 = new finalcut::FObject(newobj);
+  std::vector<finalcut::FObject*> children{};
+
+  for (int i{0}; i < 5; i++)
+    children.push_back(new finalcut::FObject(obj));
+
+  CPPUNIT_ASSERT ( obj->numOfChildren() == 5 );
+  CPPUNIT_ASSERT ( obj->getChild(1) == children[0] );
+  CPPUNIT_ASSERT ( obj->getChild(2) == children[1] );
+  CPPUNIT_ASSERT ( obj->getChild(4) == children[3] );
+  CPPUNIT_ASSERT ( obj->getChild(5) == children[4] );
+  CPPUNIT_ASSERT ( obj->getChild(6) == nullptr );
+
+  // Removing a non-child object changes nothing
+  obj->delChild(child0);
+  CPPUNIT_ASSERT ( child0->getParent() == newobj );
+  CPPUNIT_ASSERT ( newobj->numOfChildren() == 1 );
+
+  // A descendant cannot become the new parent
+  obj->moveChildren(children[2]);
+  CPPUNIT_ASSERT ( obj->numOfChildren() == 5 );
+
+  obj->moveChildren(newobj);
+  CPPUNIT_ASSERT ( ! obj->hasChildren() );
+  CPPUNIT_ASSERT ( newobj->numOfChildren() == 6 );
+  CPPUNIT_ASSERT ( newobj->front() == child0 );
+  CPPUNIT_ASSERT ( newobj->back() == children[4] );
+
+  for (auto&& child : children)
+  {
+    CPPUNIT_ASSERT ( child->getParent() == newobj );
+    CPPUNIT_ASSERT ( newobj->isDirectChild(child) );
+  }
+
+  // The moved children can still be unlinked individually
+  newobj->delChild(children[2]);
+  CPPUNIT_ASSERT ( newobj->numOfChildren() == 5 );
+  CPPUNIT_ASSERT ( newobj->getChild(4) == children[3] );
+  CPPUNIT_ASSERT ( ! children[2]->hasParent() );
+  delete children[2];
+
+  // The new parent must have enough free child slots
+  obj->setMaxChildren(3);
+  CPPUNIT_ASSERT_THROW ( newobj->moveChildren(obj), std::length_error );
+  CPPUNIT_ASSERT ( newobj->numOfChildren() == 5 );
+
+  newobj->deleteChildren();
+  CPPUNIT_ASSERT ( ! newobj->hasChildren() );
+  CPPUNIT_ASSERT ( newobj->numOfChildren() == 0 );
+
+  delete newobj;
+  delete obj;
+}
+
 //----------------------------------------------------------------------
 void FObjectTest::elementAccessTest()
 {
@@ -70,6 +70,7 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     void vga2ansiTest();
     void sgrOptimizerTest();
     void fakeReverseTest();
+    void copyTest();
     void ansiTest();
     void vt100Test();
     void xtermTest();
@@ -80,6 +81,7 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     void teratermTest();
     void ibmColorTest();
     void wyse50Test();
+    void trueColorTest();
 
   private:
     std::string printSequence (const std::string&);
@@ -93,6 +95,7 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (vga2ansiTest);
     CPPUNIT_TEST (sgrOptimizerTest);
     CPPUNIT_TEST (fakeReverseTest);
+    CPPUNIT_TEST (copyTest);
     CPPUNIT_TEST (ansiTest);
     CPPUNIT_TEST (vt100Test);
     CPPUNIT_TEST (xtermTest);
@@ -103,6 +106,7 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (teratermTest);
     CPPUNIT_TEST (ibmColorTest);
     CPPUNIT_TEST (wyse50Test);
+    CPPUNIT_TEST (trueColorTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -398,6 +402,44 @@ void FOptiAttrTest::fakeReverseTest()
   CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
 }
 
+//----------------------------------------------------------------------
+void FOptiAttrTest::copyTest()
+{
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = false;
+  finalcut::FOptiAttr oa;
+  oa.setDefaultColorSupport();  // ANSI default color
+  oa.setMaxColor (8);
+  oa.setNoColorVideo (4);       // Avoid reverse (4)
+  oa.set_a_foreground_color (CSI "3%p1%dm");
+  oa.set_a_background_color (CSI "4%p1%dm");
+  oa.initialize();
+
+  // Gray text on blue background in fake reverse mode
+  finalcut::FChar from{};
+  finalcut::FChar to{};
+  to.fg_color = finalcut::fc::LightGray;
+  to.bg_color = finalcut::fc::Blue;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , CSI "37m" CSI "44m" );
+  to.attr.bit.reverse = true;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , CSI "34m" CSI "47m" );
+
+  // The copy continues with the same state in its own buffer
+  finalcut::FOptiAttr oa_copy{oa};
+  finalcut::FChar copy_from{from};
+  finalcut::FChar copy_to{to};
+  copy_to.bg_color = finalcut::fc::Red;
+  const char* copy_str = oa_copy.changeAttribute(copy_from, copy_to);
+  CPPUNIT_ASSERT_CSTRING ( copy_str, CSI "31m" CSI "47m" );
+  CPPUNIT_ASSERT ( copy_from == copy_to );
+
+  to.bg_color = finalcut::fc::Green;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , CSI "32m" CSI "47m" );
+  CPPUNIT_ASSERT_CSTRING ( copy_str, CSI "31m" CSI "47m" );
+}
+
 //----------------------------------------------------------------------
 void FOptiAttrTest::ansiTest()
 {
@@ -4603,6 +4645,87 @@ void FOptiAttrTest::wyse50Test()
   CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
 }
 
+//----------------------------------------------------------------------
+void FOptiAttrTest::trueColorTest()
+{
+  // Simulate a 256 color terminal with 24-bit color support
+
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = false;
+  finalcut::FOptiAttr oa;
+  oa.setDefaultColorSupport();  // ANSI default color
+  oa.setMaxColor (256);
+  oa.set_a_foreground_color (CSI "%?%p1%{8}%<"
+                                 "%t3%p1%d"
+                                 "%e%p1%{16}%<"
+                                 "%t9%p1%{8}%-%d"
+                                 "%e38;5;%p1%d%;m");
+  oa.set_a_background_color (CSI "%?%p1%{8}%<"
+                                 "%t4%p1%d"
+                                 "%e%p1%{16}%<"
+                                 "%t10%p1%{8}%-%d"
+                                 "%e48;5;%p1%d%;m");
+  oa.set_orig_pair (CSI "39;49m");
+  oa.initialize();
+  CPPUNIT_ASSERT ( ! oa.hasTrueColorSupport() );
+
+  finalcut::FChar from{};
+  finalcut::FChar to{};
+  from.fg_color = finalcut::fc::Default;
+  from.bg_color = finalcut::fc::Default;
+
+  // RGB colors are downsampled to the 256 color palette
+  to.fg_color = finalcut::rgbColor(0xff, 0x00, 0x00);
+  to.bg_color = finalcut::rgbColor(0x5f, 0x87, 0xaf);
+  CPPUNIT_ASSERT ( from != to );
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , CSI "38;5;196m" CSI "48;5;67m" );
+  CPPUNIT_ASSERT ( from == to );
+  CPPUNIT_ASSERT ( to.fg_color == finalcut::rgbColor(0xff, 0x00, 0x00) );
+  CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
+  CPPUNIT_ASSERT ( oa.rgb2PaletteColor(to.bg_color)
+                   == finalcut::fc::SteelBlue );
+
+  // 24-bit colors
+  oa.setTrueColorSupport();
+  CPPUNIT_ASSERT ( oa.hasTrueColorSupport() );
+  to.fg_color = finalcut::rgbColor(0x12, 0x34, 0x56);
+  to.bg_color = finalcut::rgbColor(0xfe, 0xdc, 0xba);
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , CSI "38;2;18;52;86m" CSI "48;2;254;220;186m" );
+  CPPUNIT_ASSERT ( from == to );
+  CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
+
+  // Palette color in the foreground
+  to.fg_color = finalcut::fc::Blue;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), CSI "34m" );
+  CPPUNIT_ASSERT ( from == to );
+
+  // RGB color in the foreground
+  to.fg_color = finalcut::rgbColor(0x00, 0x00, 0x00);
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), CSI "38;2;0;0;0m" );
+  CPPUNIT_ASSERT ( from == to );
+
+  // Default background color
+  to.bg_color = finalcut::fc::Default;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), CSI "49m" );
+  CPPUNIT_ASSERT ( from == to );
+
+  // Without true color support again
+  oa.unsetTrueColorSupport();
+  to.bg_color = finalcut::rgbColor(0xee, 0xee, 0xee);
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), CSI "48;5;255m" );
+  CPPUNIT_ASSERT ( from == to );
+
+  // 8 color terminal
+  oa.setMaxColor (8);
+  oa.initialize();
+  to.fg_color = finalcut::rgbColor(0xe0, 0x10, 0x10);
+  to.bg_color = finalcut::rgbColor(0x10, 0x10, 0xc0);
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , CSI "31m" CSI "44m" );
+  CPPUNIT_ASSERT ( from == to );
+}
+
 //----------------------------------------------------------------------
 std::string FOptiAttrTest::printSequence (const std::string& s)
 {
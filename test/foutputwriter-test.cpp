@@ -0,0 +1,303 @@
+/***********************************************************************
+* foutputwriter-test.cpp - FOutputWriter unit tests                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <sstream>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <csignal>
+#include <string>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FOutputWriterTest
+//----------------------------------------------------------------------
+
+class FOutputWriterTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FOutputWriterTest()
+    { }
+
+    void setUp() override;
+    void tearDown() override;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void writeTest();
+    void wouldBlockTest();
+    void drainTest();
+    void writeErrorTest();
+    void directOutputTest();
+
+  private:
+    std::string readPipe (std::size_t);
+    std::size_t fillPipe();
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FOutputWriterTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (writeTest);
+    CPPUNIT_TEST (wouldBlockTest);
+    CPPUNIT_TEST (drainTest);
+    CPPUNIT_TEST (writeErrorTest);
+    CPPUNIT_TEST (directOutputTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Data member
+    int pipe_fd[2]{-1, -1};
+};
+
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::setUp()
+{
+  CPPUNIT_ASSERT ( ::pipe(pipe_fd) == 0 );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::tearDown()
+{
+  for (auto&& fd : pipe_fd)
+  {
+    if ( fd >= 0 )
+      ::close(fd);
+
+    fd = -1;
+  }
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::classNameTest()
+{
+  const finalcut::FOutputWriter w{pipe_fd[1]};
+  const finalcut::FString& classname = w.getClassName();
+  CPPUNIT_ASSERT ( classname == "FOutputWriter" );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::noArgumentTest()
+{
+  finalcut::FOutputWriter w{pipe_fd[1]};
+  CPPUNIT_ASSERT ( w.getFileDescriptor() == pipe_fd[1] );
+  CPPUNIT_ASSERT ( w.getPendingSize() == 0 );
+  CPPUNIT_ASSERT ( w.getWrittenBytes() == 0 );
+  CPPUNIT_ASSERT ( w.getBlockedCount() == 0 );
+  CPPUNIT_ASSERT ( w.getErrorCount() == 0 );
+  CPPUNIT_ASSERT ( ! w.hasPendingOutput() );
+  CPPUNIT_ASSERT ( w.flush() );
+  CPPUNIT_ASSERT ( w.drain() );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::writeTest()
+{
+  finalcut::FOutputWriter w{pipe_fd[1]};
+  w.write ("\033[1mHello", 9);
+  w.write (' ');
+  w.write ("world\033[m", 8);
+  CPPUNIT_ASSERT ( w.hasPendingOutput() );
+  CPPUNIT_ASSERT ( w.getPendingSize() == 18 );
+  CPPUNIT_ASSERT ( w.flush() );
+  CPPUNIT_ASSERT ( ! w.hasPendingOutput() );
+  CPPUNIT_ASSERT ( w.getPendingSize() == 0 );
+  CPPUNIT_ASSERT ( w.getWrittenBytes() == 18 );
+  CPPUNIT_ASSERT ( readPipe(18) == "\033[1mHello world\033[m" );
+
+  // The file status flags are restored
+  CPPUNIT_ASSERT ( (::fcntl(pipe_fd[1], F_GETFL) & O_NONBLOCK) == 0 );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::wouldBlockTest()
+{
+  finalcut::FOutputWriter w{pipe_fd[1]};
+  const std::size_t capacity = fillPipe();
+  CPPUNIT_ASSERT ( capacity > 0 );
+
+  // The full pipe takes nothing, the flush returns without blocking
+  const std::string frame(5000, 'x');
+  w.write (frame.data(), frame.length());
+  w.write ('!');
+  CPPUNIT_ASSERT ( ! w.flush() );
+  CPPUNIT_ASSERT ( w.hasPendingOutput() );
+  CPPUNIT_ASSERT ( w.getPendingSize() == 5001 );
+  CPPUNIT_ASSERT ( w.getBlockedCount() == 1 );
+  CPPUNIT_ASSERT ( w.getErrorCount() == 0 );
+  CPPUNIT_ASSERT ( (::fcntl(pipe_fd[1], F_GETFL) & O_NONBLOCK) == 0 );
+
+  // The terminal takes the bytes again
+  CPPUNIT_ASSERT ( readPipe(capacity) == std::string(capacity, '.') );
+  CPPUNIT_ASSERT ( w.flush() );
+  CPPUNIT_ASSERT ( ! w.hasPendingOutput() );
+  CPPUNIT_ASSERT ( w.getWrittenBytes() == 5001 );
+  CPPUNIT_ASSERT ( readPipe(5001) == frame + "!" );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::drainTest()
+{
+  finalcut::FOutputWriter w{pipe_fd[1]};
+  const std::size_t capacity = fillPipe();
+  w.write ("end", 3);
+  CPPUNIT_ASSERT ( ! w.flush() );
+
+  // The reader empties the pipe while drain() waits
+  const pid_t pid = ::fork();
+  CPPUNIT_ASSERT ( pid >= 0 );
+
+  if ( pid == 0 )
+  {
+    ::usleep(50000);
+    std::string data(capacity, '\0');
+    std::size_t n{0};
+
+    while ( n < capacity )
+    {
+      const ssize_t bytes = ::read(pipe_fd[0], &data[n], capacity - n);
+
+      if ( bytes <= 0 )
+        break;
+
+      n += std::size_t(bytes);
+    }
+
+    ::_exit(0);
+  }
+
+  CPPUNIT_ASSERT ( w.drain() );
+  ::waitpid (pid, nullptr, 0);
+  CPPUNIT_ASSERT ( ! w.hasPendingOutput() );
+  CPPUNIT_ASSERT ( w.getWrittenBytes() == 3 );
+  CPPUNIT_ASSERT ( readPipe(3) == "end" );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::writeErrorTest()
+{
+  finalcut::FOutputWriter w{pipe_fd[1]};
+  const auto old_handler = std::signal(SIGPIPE, SIG_IGN);
+  ::close(pipe_fd[0]);
+  pipe_fd[0] = -1;
+
+  // Writing into a pipe without reader fails with EPIPE
+  w.write ("lost", 4);
+  CPPUNIT_ASSERT ( ! w.flush() );
+  CPPUNIT_ASSERT ( ! w.hasPendingOutput() );
+  CPPUNIT_ASSERT ( w.getErrorCount() == 1 );
+  CPPUNIT_ASSERT ( w.getWrittenBytes() == 0 );
+  std::signal(SIGPIPE, old_handler);
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::directOutputTest()
+{
+  // Redirect stdout into the pipe
+  std::fflush(stdout);
+  const int stdout_fd = ::dup(fileno(stdout));
+  CPPUNIT_ASSERT ( stdout_fd >= 0 );
+  CPPUNIT_ASSERT ( ::dup2(pipe_fd[1], fileno(stdout)) >= 0 );
+
+  // The direct output of FTerm waits for the queued output
+  finalcut::FOutputWriter w{pipe_fd[1]};
+  w.write ("queued", 6);
+  CPPUNIT_ASSERT ( w.hasPendingOutput() );
+  finalcut::FTerm::setOutputWriter (&w);
+  finalcut::FTerm::putchar_ASCII ('!');
+  std::fflush(stdout);
+  CPPUNIT_ASSERT ( ! w.hasPendingOutput() );
+
+  // Without pending output, nothing is drained
+  finalcut::FTerm::putchar_ASCII ('?');
+  std::fflush(stdout);
+  finalcut::FTerm::setOutputWriter (nullptr);
+  ::dup2 (stdout_fd, fileno(stdout));
+  ::close (stdout_fd);
+  CPPUNIT_ASSERT ( w.getWrittenBytes() == 6 );
+  CPPUNIT_ASSERT ( readPipe(8) == "queued!?" );
+}
+
+//----------------------------------------------------------------------
+std::string FOutputWriterTest::readPipe (std::size_t length)
+{
+  std::string data(length, '\0');
+  std::size_t n{0};
+
+  while ( n < length )
+  {
+    const ssize_t bytes = ::read(pipe_fd[0], &data[n], length - n);
+
+    if ( bytes <= 0 )
+      break;
+
+    n += std::size_t(bytes);
+  }
+
+  data.resize(n);
+  return data;
+}
+
+//----------------------------------------------------------------------
+std::size_t FOutputWriterTest::fillPipe()
+{
+  // Fills the pipe until it can take no more bytes
+
+  const int flags = ::fcntl(pipe_fd[1], F_GETFL);
+  ::fcntl (pipe_fd[1], F_SETFL, flags | O_NONBLOCK);
+  const std::string block(1024, '.');
+  std::size_t capacity{0};
+
+  while ( true )
+  {
+    const ssize_t bytes = ::write(pipe_fd[1], block.data(), block.length());
+
+    if ( bytes <= 0 )
+      break;
+
+    capacity += std::size_t(bytes);
+  }
+
+  ::fcntl (pipe_fd[1], F_SETFL, flags);
+  return capacity;
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FOutputWriterTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,254 @@
+/***********************************************************************
+* fsearchindex-test.cpp - FSearchIndex unit tests                       *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FSearchIndexTest
+//----------------------------------------------------------------------
+
+class FSearchIndexTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FSearchIndexTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void prefixTest();
+    void appendTest();
+    void matchTest();
+    void replaceTest();
+    void invalidateTest();
+    void startsWithTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FSearchIndexTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (prefixTest);
+    CPPUNIT_TEST (appendTest);
+    CPPUNIT_TEST (matchTest);
+    CPPUNIT_TEST (replaceTest);
+    CPPUNIT_TEST (invalidateTest);
+    CPPUNIT_TEST (startsWithTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Method
+    void fillIndex (finalcut::FSearchIndex&) const;
+};
+
+//----------------------------------------------------------------------
+void FSearchIndexTest::fillIndex (finalcut::FSearchIndex& index) const
+{
+  index.add ("Zebra", 0);
+  index.add ("apple", 1);
+  index.add ("Apricot", 2);
+  index.add ("banana", 3);
+  index.add ("APPLE PIE", 4);
+  index.add ("cherry", 5);
+}
+
+//----------------------------------------------------------------------
+void FSearchIndexTest::classNameTest()
+{
+  const finalcut::FSearchIndex index;
+  const finalcut::FString& classname = index.getClassName();
+  CPPUNIT_ASSERT ( classname == "FSearchIndex" );
+}
+
+//----------------------------------------------------------------------
+void FSearchIndexTest::noArgumentTest()
+{
+  finalcut::FSearchIndex index{};
+  CPPUNIT_ASSERT ( index.getSize() == 0 );
+  CPPUNIT_ASSERT ( index.isValid() );
+  CPPUNIT_ASSERT ( index.findPrefix("a") == finalcut::FSearchIndex::NOT_FOUND );
+  CPPUNIT_ASSERT ( index.match("a", finalcut::FSearchIndex::PrefixMatch)
+                   .empty() );
+}
+
+//----------------------------------------------------------------------
+void FSearchIndexTest::prefixTest()
+{
+  finalcut::FSearchIndex index{};
+  fillIndex (index);
+  CPPUNIT_ASSERT ( index.getSize() == 6 );
+
+  // The lowest position wins
+  CPPUNIT_ASSERT ( index.findPrefix("a") == 1 );
+  CPPUNIT_ASSERT ( index.findPrefix("AP") == 1 );
+  CPPUNIT_ASSERT ( index.findPrefix("apr") == 2 );
+  CPPUNIT_ASSERT ( index.findPrefix("Apple ") == 4 );
+  CPPUNIT_ASSERT ( index.findPrefix("z") == 0 );
+  CPPUNIT_ASSERT ( index.findPrefix("") == 0 );
+  CPPUNIT_ASSERT ( index.findPrefix("x") == finalcut::FSearchIndex::NOT_FOUND );
+  CPPUNIT_ASSERT ( index.findPrefix("cherry pie")
+                   == finalcut::FSearchIndex::NOT_FOUND );
+}
+
+//----------------------------------------------------------------------
+void FSearchIndexTest::appendTest()
+{
+  finalcut::FSearchIndex index{};
+  fillIndex (index);
+  CPPUNIT_ASSERT ( index.findPrefix("b") == 3 );
+
+  // Entries added after a lookup are merged in
+  index.add ("Ant", 6);
+  index.add ("blueberry", 7);
+  CPPUNIT_ASSERT ( index.getSize() == 8 );
+  CPPUNIT_ASSERT ( index.findPrefix("an") == 6 );
+  CPPUNIT_ASSERT ( index.findPrefix("a") == 1 );
+  CPPUNIT_ASSERT ( index.findPrefix("bl") == 7 );
+  CPPUNIT_ASSERT ( index.findPrefix("b") == 3 );
+
+  index.clear();
+  CPPUNIT_ASSERT ( index.getSize() == 0 );
+  CPPUNIT_ASSERT ( index.findPrefix("a") == finalcut::FSearchIndex::NOT_FOUND );
+}
+
+//----------------------------------------------------------------------
+void FSearchIndexTest::matchTest()
+{
+  finalcut::FSearchIndex index{};
+  fillIndex (index);
+
+  auto pos = index.match("APP", finalcut::FSearchIndex::PrefixMatch);
+  CPPUNIT_ASSERT ( pos.size() == 2 );
+  CPPUNIT_ASSERT ( pos[0] == 1 );
+  CPPUNIT_ASSERT ( pos[1] == 4 );
+
+  pos = index.match("an", finalcut::FSearchIndex::SubstringMatch);
+  CPPUNIT_ASSERT ( pos.size() == 1 );
+  CPPUNIT_ASSERT ( pos[0] == 3 );
+
+  pos = index.match("r", finalcut::FSearchIndex::SubstringMatch);
+  CPPUNIT_ASSERT ( pos.size() == 3 );
+  CPPUNIT_ASSERT ( pos[0] == 0 );
+  CPPUNIT_ASSERT ( pos[1] == 2 );
+  CPPUNIT_ASSERT ( pos[2] == 5 );
+
+  pos = index.match("ape", finalcut::FSearchIndex::FuzzyMatch);
+  CPPUNIT_ASSERT ( pos.size() == 2 );
+  CPPUNIT_ASSERT ( pos[0] == 1 );
+  CPPUNIT_ASSERT ( pos[1] == 4 );
+
+  pos = index.match("ppa", finalcut::FSearchIndex::FuzzyMatch);
+  CPPUNIT_ASSERT ( pos.empty() );
+
+  pos = index.match("", finalcut::FSearchIndex::SubstringMatch);
+  CPPUNIT_ASSERT ( pos.size() == 6 );
+}
+
+//----------------------------------------------------------------------
+void FSearchIndexTest::replaceTest()
+{
+  finalcut::FSearchIndex index{};
+  fillIndex (index);
+  CPPUNIT_ASSERT ( index.findPrefix("b") == 3 );
+
+  index.replace ("banana", "Blueberry", 3);
+  CPPUNIT_ASSERT ( index.getSize() == 6 );
+  CPPUNIT_ASSERT ( index.findPrefix("ban")
+                   == finalcut::FSearchIndex::NOT_FOUND );
+  CPPUNIT_ASSERT ( index.findPrefix("blue") == 3 );
+
+  // Several replacements before the next lookup
+  index.replace ("apple", "Fig", 1);
+  index.replace ("zebra", "Avocado", 0);
+  CPPUNIT_ASSERT ( index.getSize() == 6 );
+  CPPUNIT_ASSERT ( index.findPrefix("f") == 1 );
+  CPPUNIT_ASSERT ( index.findPrefix("a") == 0 );
+  CPPUNIT_ASSERT ( index.findPrefix("apr") == 2 );
+  CPPUNIT_ASSERT ( index.findPrefix("z")
+                   == finalcut::FSearchIndex::NOT_FOUND );
+  CPPUNIT_ASSERT ( index.match("", finalcut::FSearchIndex::SubstringMatch)
+                   .size() == 6 );
+
+  // A not yet merged entry invalidates the index
+  index.add ("elderberry", 6);
+  index.replace ("elderberry", "Grape", 6);
+  CPPUNIT_ASSERT ( ! index.isValid() );
+
+  // An unknown entry invalidates the index
+  index.clear();
+  fillIndex (index);
+  CPPUNIT_ASSERT ( index.findPrefix("g")
+                   == finalcut::FSearchIndex::NOT_FOUND );
+  index.replace ("grape", "Kiwi", 2);
+  CPPUNIT_ASSERT ( ! index.isValid() );
+}
+
+//----------------------------------------------------------------------
+void FSearchIndexTest::invalidateTest()
+{
+  finalcut::FSearchIndex index{};
+  fillIndex (index);
+  index.invalidate();
+  CPPUNIT_ASSERT ( ! index.isValid() );
+  CPPUNIT_ASSERT ( index.getSize() == 0 );
+
+  // An invalid index ignores new entries
+  index.add ("apple", 0);
+  CPPUNIT_ASSERT ( index.getSize() == 0 );
+  CPPUNIT_ASSERT ( index.findPrefix("a") == finalcut::FSearchIndex::NOT_FOUND );
+
+  index.clear();
+  CPPUNIT_ASSERT ( index.isValid() );
+  index.add ("apple", 0);
+  CPPUNIT_ASSERT ( index.findPrefix("a") == 0 );
+}
+
+//----------------------------------------------------------------------
+void FSearchIndexTest::startsWithTest()
+{
+  using finalcut::FSearchIndex;
+  CPPUNIT_ASSERT ( FSearchIndex::startsWith("Hello World", "hello") );
+  CPPUNIT_ASSERT ( FSearchIndex::startsWith("Hello World", "HELLO W") );
+  CPPUNIT_ASSERT ( FSearchIndex::startsWith("Hello", "") );
+  CPPUNIT_ASSERT ( FSearchIndex::startsWith("", "") );
+  CPPUNIT_ASSERT ( ! FSearchIndex::startsWith("Hello", "Hello!") );
+  CPPUNIT_ASSERT ( ! FSearchIndex::startsWith("Hello", "world") );
+  CPPUNIT_ASSERT ( ! FSearchIndex::startsWith("", "a") );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FSearchIndexTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -1353,6 +1353,41 @@ void FStringTest::convertFromNumberTest()
                    == "1234.567800000000033833202905952930450439453125" );
   CPPUNIT_ASSERT ( finalcut::FString().setNumber(n17, 100)
                    == "12345.67889999999999961488583721802569925785064697265625" );
+
+  // Limits
+  const auto min64 = std::numeric_limits<sInt64>::min();
+  const auto max64 = std::numeric_limits<uInt64>::max();
+  CPPUNIT_ASSERT ( finalcut::FString().setNumber(min64)
+                   == "-9223372036854775808" );
+  CPPUNIT_ASSERT ( finalcut::FString().setNumber(max64)
+                   == "18446744073709551615" );
+  CPPUNIT_ASSERT ( finalcut::FString().setNumber(0) == "0" );
+  CPPUNIT_ASSERT ( finalcut::FString().setNumber(9) == "9" );
+  CPPUNIT_ASSERT ( finalcut::FString().setNumber(10) == "10" );
+  CPPUNIT_ASSERT ( finalcut::FString().setNumber(100) == "100" );
+  CPPUNIT_ASSERT ( finalcut::FString().setFormatedNumber(min64, '.')
+                   == "-9.223.372.036.854.775.808" );
+  CPPUNIT_ASSERT ( finalcut::FString().setFormatedNumber(100, '.')
+                   == "100" );
+  CPPUNIT_ASSERT ( finalcut::FString().setFormatedNumber(-1000, '.')
+                   == "-1.000" );
+
+  // The buffer is reused for shorter numbers
+  finalcut::FString num{};
+  num.setNumber(1234567890);
+  const wchar_t* const buffer = num.wc_str();
+  num.setNumber(-42);
+  CPPUNIT_ASSERT ( num == "-42" );
+  CPPUNIT_ASSERT ( num.getLength() == 3 );
+  CPPUNIT_ASSERT ( num.wc_str() == buffer );
+  num.setNumber(0.5);
+  CPPUNIT_ASSERT ( num == "0.5" );
+  CPPUNIT_ASSERT ( num.wc_str() == buffer );
+
+  // Append numbers
+  num = "x=";
+  num << -12 << ',' << 3.25f << ',' << uInt64(18446744073709551615u);
+  CPPUNIT_ASSERT ( num == "x=-12,3.25,18446744073709551615" );
 }
 
 //----------------------------------------------------------------------
@@ -0,0 +1,242 @@
+/***********************************************************************
+* fstringbuilder-test.cpp - FStringBuilder unit tests                  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FStringBuilderTest
+//----------------------------------------------------------------------
+
+class FStringBuilderTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FStringBuilderTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void appendTest();
+    void streamingTest();
+    void formatTest();
+    void reserveTest();
+    void releaseTest();
+    void replaceTest();
+    void expandTabsTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FStringBuilderTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (appendTest);
+    CPPUNIT_TEST (streamingTest);
+    CPPUNIT_TEST (formatTest);
+    CPPUNIT_TEST (reserveTest);
+    CPPUNIT_TEST (releaseTest);
+    CPPUNIT_TEST (replaceTest);
+    CPPUNIT_TEST (expandTabsTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FStringBuilderTest::classNameTest()
+{
+  const finalcut::FStringBuilder builder{};
+  const finalcut::FString& classname = builder.getClassName();
+  CPPUNIT_ASSERT ( classname == "FStringBuilder" );
+}
+
+//----------------------------------------------------------------------
+void FStringBuilderTest::noArgumentTest()
+{
+  finalcut::FStringBuilder builder{};
+  CPPUNIT_ASSERT ( builder.isEmpty() );
+  CPPUNIT_ASSERT ( builder.getLength() == 0 );
+  CPPUNIT_ASSERT ( builder.capacity() == 0 );
+  CPPUNIT_ASSERT ( builder.str().isNull() );
+  CPPUNIT_ASSERT ( builder.release().isNull() );
+}
+
+//----------------------------------------------------------------------
+void FStringBuilderTest::appendTest()
+{
+  finalcut::FStringBuilder builder{};
+  builder.append ("abc");
+  builder.append (L'd');
+  builder.append (3, L'e');
+  builder.append (L"xyz", 2);
+  builder.append (finalcut::FString{});
+  CPPUNIT_ASSERT ( ! builder.isEmpty() );
+  CPPUNIT_ASSERT ( builder.getLength() == 9 );
+  CPPUNIT_ASSERT ( builder.str() == "abcdeeexy" );
+
+  builder.clear();
+  CPPUNIT_ASSERT ( builder.isEmpty() );
+  CPPUNIT_ASSERT ( builder.capacity() > 0 );
+  CPPUNIT_ASSERT ( builder.str().isNull() );
+
+  // Growth beyond the initial capacity
+  for (int i{0}; i < 1000; i++)
+    builder.append (L'.');
+
+  CPPUNIT_ASSERT ( builder.getLength() == 1000 );
+  CPPUNIT_ASSERT ( builder.capacity() >= 1000 );
+  CPPUNIT_ASSERT ( builder.str() == finalcut::FString(1000, L'.') );
+}
+
+//----------------------------------------------------------------------
+void FStringBuilderTest::streamingTest()
+{
+  finalcut::FStringBuilder builder{};
+  builder << "Line " << 42 << L':' << ' ' << -7 << " " << 2.5;
+  CPPUNIT_ASSERT ( builder.str() == "Line 42: -7 2.5" );
+}
+
+//----------------------------------------------------------------------
+void FStringBuilderTest::formatTest()
+{
+  finalcut::FStringBuilder builder{};
+  builder.format ("{} of {} items ({}%)", 3, 40u, 7.5);
+  CPPUNIT_ASSERT ( builder.str() == "3 of 40 items (7.5%)" );
+
+  builder.clear();
+  builder.format ("{{{}}} {}}}", L'x', finalcut::FString("y"));
+  CPPUNIT_ASSERT ( builder.str() == "{x} y}" );
+
+  builder.clear();
+  builder.format ("no placeholder");
+  CPPUNIT_ASSERT ( builder.str() == "no placeholder" );
+
+  builder.clear();
+  builder.format ("{}", std::numeric_limits<sInt64>::min());
+  CPPUNIT_ASSERT ( builder.str() == "-9223372036854775808" );
+
+  builder.clear();
+  builder.format (finalcut::FString{});
+  CPPUNIT_ASSERT ( builder.isEmpty() );
+
+  // Reused buffer
+  builder.reserve(64);
+  const std::size_t cap = builder.capacity();
+
+  for (int i{0}; i < 1000; i++)
+  {
+    builder.clear();
+    builder.format ("{}: {}", i, -i);
+  }
+
+  CPPUNIT_ASSERT ( builder.str() == "999: -999" );
+  CPPUNIT_ASSERT ( builder.capacity() == cap );
+}
+
+//----------------------------------------------------------------------
+void FStringBuilderTest::reserveTest()
+{
+  finalcut::FStringBuilder builder{100};
+  CPPUNIT_ASSERT ( builder.capacity() == 100 );
+  CPPUNIT_ASSERT ( builder.isEmpty() );
+
+  builder.append (finalcut::FString(100, L'x'));
+  CPPUNIT_ASSERT ( builder.capacity() == 100 );
+
+  builder.reserve (50);  // Never shrinks
+  CPPUNIT_ASSERT ( builder.capacity() == 100 );
+  CPPUNIT_ASSERT ( builder.getLength() == 100 );
+
+  builder.reserve (300);
+  CPPUNIT_ASSERT ( builder.capacity() == 300 );
+  CPPUNIT_ASSERT ( builder.str() == finalcut::FString(100, L'x') );
+}
+
+//----------------------------------------------------------------------
+void FStringBuilderTest::releaseTest()
+{
+  finalcut::FStringBuilder builder{};
+  builder << "Hello" << ", " << "World";
+  const std::size_t capacity = builder.capacity();
+  finalcut::FString str = builder.release();
+  CPPUNIT_ASSERT ( str == "Hello, World" );
+  CPPUNIT_ASSERT ( str.getLength() == 12 );
+  CPPUNIT_ASSERT ( str.capacity() == capacity );  // Buffer was moved
+  CPPUNIT_ASSERT ( builder.isEmpty() );
+  CPPUNIT_ASSERT ( builder.capacity() == 0 );
+
+  // The released string behaves like any other FString
+  str += "!";
+  CPPUNIT_ASSERT ( str == "Hello, World!" );
+
+  // The builder is reusable after a release
+  builder << "again";
+  CPPUNIT_ASSERT ( builder.release() == "again" );
+}
+
+//----------------------------------------------------------------------
+void FStringBuilderTest::replaceTest()
+{
+  // FString::replace() uses a string builder
+  const finalcut::FString text{"a-b-c--d-"};
+  CPPUNIT_ASSERT ( text.replace("-", "+") == "a+b+c++d+" );
+  CPPUNIT_ASSERT ( text.replace("-", "") == "abcd" );
+  CPPUNIT_ASSERT ( text.replace("--", "=") == "a-b-c=d-" );
+  CPPUNIT_ASSERT ( text.replace("-", "<->") == "a<->b<->c<-><->d<->" );
+  CPPUNIT_ASSERT ( text.replace("x", "y") == text );
+
+  finalcut::FStringBuilder builder{};
+
+  for (int i{0}; i < 10000; i++)
+    builder << "ab";
+
+  const finalcut::FString big = builder.release().replace("a", "xyz");
+  CPPUNIT_ASSERT ( big.getLength() == 40000 );
+  CPPUNIT_ASSERT ( big.left(8) == "xyzbxyzb" );
+  CPPUNIT_ASSERT ( big.right(4) == "xyzb" );
+}
+
+//----------------------------------------------------------------------
+void FStringBuilderTest::expandTabsTest()
+{
+  // FString::expandTabs() uses a string builder
+  const finalcut::FString tab_str{"\tA\tBC\tDEFGHIJ\t"};
+  CPPUNIT_ASSERT ( tab_str.expandTabs(4) == "    A   BC  DEFGHIJ " );
+  CPPUNIT_ASSERT ( tab_str.expandTabs(1) == " A BC DEFGHIJ " );
+  CPPUNIT_ASSERT ( tab_str.expandTabs(0) == tab_str );
+  CPPUNIT_ASSERT ( finalcut::FString{"no tab"}.expandTabs() == "no tab" );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FStringBuilderTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,260 @@
+/***********************************************************************
+* ftermrecorder-test.cpp - FTermRecorder unit tests                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <final/final.h>
+
+#define RECORDING_FILE "ftermrecorder-test.cast"
+
+//----------------------------------------------------------------------
+// class FTermRecorderTest
+//----------------------------------------------------------------------
+
+class FTermRecorderTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FTermRecorderTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void headerTest();
+    void frameTest();
+    void inputTest();
+    void escapeTest();
+    void openErrorTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FTermRecorderTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (headerTest);
+    CPPUNIT_TEST (frameTest);
+    CPPUNIT_TEST (inputTest);
+    CPPUNIT_TEST (escapeTest);
+    CPPUNIT_TEST (openErrorTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Methods
+    static void recordString (finalcut::FTermRecorder&, const std::string&);
+    static std::vector<std::string> readEvents();
+    static std::string getEventData (const std::string&);
+};
+
+//----------------------------------------------------------------------
+void FTermRecorderTest::recordString ( finalcut::FTermRecorder& recorder
+                                     , const std::string& str )
+{
+  for (auto&& ch : str)
+    recorder.recordOutput(ch);
+}
+
+//----------------------------------------------------------------------
+std::vector<std::string> FTermRecorderTest::readEvents()
+{
+  std::vector<std::string> events{};
+  std::ifstream file{RECORDING_FILE};
+  std::string line{};
+
+  while ( std::getline(file, line) )
+    events.push_back(line);
+
+  std::remove (RECORDING_FILE);
+  return events;
+}
+
+//----------------------------------------------------------------------
+std::string FTermRecorderTest::getEventData (const std::string& line)
+{
+  // Returns the part after the time stamp
+  const auto pos = line.find(", ");
+  return ( pos == std::string::npos ) ? line : line.substr(pos + 2);
+}
+
+//----------------------------------------------------------------------
+void FTermRecorderTest::classNameTest()
+{
+  const finalcut::FTermRecorder recorder;
+  const finalcut::FString& classname = recorder.getClassName();
+  CPPUNIT_ASSERT ( classname == "FTermRecorder" );
+}
+
+//----------------------------------------------------------------------
+void FTermRecorderTest::noArgumentTest()
+{
+  finalcut::FTermRecorder recorder{};
+  CPPUNIT_ASSERT ( ! recorder.isRecording() );
+  CPPUNIT_ASSERT ( recorder.getFrameCount() == 0 );
+  CPPUNIT_ASSERT ( recorder.getInputCount() == 0 );
+  CPPUNIT_ASSERT ( recorder.getOutputBytes() == 0 );
+
+  // Without a file, the data is discarded
+  recordString (recorder, "abc");
+  recorder.endFrame();
+  recorder.stop();
+  CPPUNIT_ASSERT ( recorder.getFrameCount() == 0 );
+  CPPUNIT_ASSERT ( recorder.getOutputBytes() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FTermRecorderTest::headerTest()
+{
+  finalcut::FTermRecorder recorder{};
+  CPPUNIT_ASSERT ( recorder.start(RECORDING_FILE, 132, 43) );
+  CPPUNIT_ASSERT ( recorder.isRecording() );
+  recorder.stop();
+  CPPUNIT_ASSERT ( ! recorder.isRecording() );
+
+  const auto events = readEvents();
+  CPPUNIT_ASSERT ( events.size() == 1 );
+  CPPUNIT_ASSERT ( events[0].find("{\"version\": 2, \"width\": 132, "
+                                 "\"height\": 43, \"timestamp\": ") == 0 );
+  CPPUNIT_ASSERT ( events[0].find("\"env\": {\"TERM\": ")
+                   != std::string::npos );
+}
+
+//----------------------------------------------------------------------
+void FTermRecorderTest::frameTest()
+{
+  finalcut::FTermRecorder recorder{};
+  CPPUNIT_ASSERT ( recorder.start(RECORDING_FILE, 80, 24) );
+
+  // An empty frame is not written
+  recorder.endFrame();
+  CPPUNIT_ASSERT ( recorder.getFrameCount() == 0 );
+
+  recordString (recorder, "Hello ");
+  recordString (recorder, "world");
+  recorder.endFrame();
+  recordString (recorder, "!");
+  recorder.endFrame();
+  CPPUNIT_ASSERT ( recorder.getFrameCount() == 2 );
+  CPPUNIT_ASSERT ( recorder.getOutputBytes() == 12 );
+
+  // Stopping writes the pending frame
+  recordString (recorder, "end");
+  recorder.stop();
+  CPPUNIT_ASSERT ( recorder.getFrameCount() == 3 );
+  CPPUNIT_ASSERT ( recorder.getOutputBytes() == 15 );
+
+  const auto events = readEvents();
+  CPPUNIT_ASSERT ( events.size() == 4 );
+  CPPUNIT_ASSERT ( events[1][0] == '[' );
+  CPPUNIT_ASSERT ( getEventData(events[1]) == "\"o\", \"Hello world\"]" );
+  CPPUNIT_ASSERT ( getEventData(events[2]) == "\"o\", \"!\"]" );
+  CPPUNIT_ASSERT ( getEventData(events[3]) == "\"o\", \"end\"]" );
+}
+
+//----------------------------------------------------------------------
+void FTermRecorderTest::inputTest()
+{
+  finalcut::FTermRecorder recorder{};
+  CPPUNIT_ASSERT ( recorder.start(RECORDING_FILE, 80, 24) );
+
+  // Consecutive input bytes form one event
+  recorder.recordInput('\033');
+  recorder.recordInput('[');
+  recorder.recordInput('A');
+  recordString (recorder, "up");
+  recorder.endFrame();
+  recorder.recordInput('q');
+  recorder.stop();
+  CPPUNIT_ASSERT ( recorder.getInputCount() == 2 );
+  CPPUNIT_ASSERT ( recorder.getFrameCount() == 1 );
+
+  const auto events = readEvents();
+  CPPUNIT_ASSERT ( events.size() == 4 );
+  CPPUNIT_ASSERT ( getEventData(events[1]) == "\"i\", \"\\u001b[A\"]" );
+  CPPUNIT_ASSERT ( getEventData(events[2]) == "\"o\", \"up\"]" );
+  CPPUNIT_ASSERT ( getEventData(events[3]) == "\"i\", \"q\"]" );
+
+  // X10 mouse report at column 160, row 223, followed by a raw "ä"
+  CPPUNIT_ASSERT ( recorder.start(RECORDING_FILE, 80, 24) );
+
+  for (const char ch : std::string("\033[M \xc0\xff\xc3\xa4"))
+    recorder.recordInput(ch);
+
+  recorder.stop();
+  CPPUNIT_ASSERT ( recorder.getInputCount() == 1 );
+
+  const auto events_8bit = readEvents();
+  CPPUNIT_ASSERT ( events_8bit.size() == 2 );
+  CPPUNIT_ASSERT ( getEventData(events_8bit[1])
+                   == "\"i\", \"\\u001b[M \\u00c0\\u00ff\xc3\xa4\"]" );
+}
+
+//----------------------------------------------------------------------
+void FTermRecorderTest::escapeTest()
+{
+  finalcut::FTermRecorder recorder{};
+  CPPUNIT_ASSERT ( recorder.start(RECORDING_FILE, 80, 24) );
+  recordString (recorder, "\"\\\t\x7f");
+  recorder.endFrame();
+  recordString (recorder, "\xc3\xa4\xe2\x94\x80");  // Valid UTF-8
+  recorder.endFrame();
+  recordString (recorder, "\xc3 \xe2\x94 \xff");  // Invalid UTF-8
+  recorder.endFrame();
+  recorder.stop();
+
+  const auto events = readEvents();
+  CPPUNIT_ASSERT ( events.size() == 4 );
+  CPPUNIT_ASSERT ( getEventData(events[1])
+                   == "\"o\", \"\\\"\\\\\\u0009\\u007f\"]" );
+  CPPUNIT_ASSERT ( getEventData(events[2])
+                   == "\"o\", \"\xc3\xa4\xe2\x94\x80\"]" );
+  CPPUNIT_ASSERT ( getEventData(events[3])
+                   == "\"o\", \"\\u00c3 \\u00e2\\u0094 \\u00ff\"]" );
+}
+
+//----------------------------------------------------------------------
+void FTermRecorderTest::openErrorTest()
+{
+  finalcut::FTermRecorder recorder{};
+  const finalcut::FString filename{"/nonexistent/directory/file.cast"};
+  CPPUNIT_ASSERT ( ! recorder.start(filename, 80, 24) );
+  CPPUNIT_ASSERT ( ! recorder.isRecording() );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FTermRecorderTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,214 @@
+/***********************************************************************
+* futf8-test.cpp - UTF-8 transcoding unit tests                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <string>
+#include <vector>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FUTF8Test
+//----------------------------------------------------------------------
+
+class FUTF8Test : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FUTF8Test()
+    { }
+
+  protected:
+    void asciiTest();
+    void encodeTest();
+    void decodeTest();
+    void invalidEncodeTest();
+    void invalidDecodeTest();
+    void roundTripTest();
+    void fstringTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FUTF8Test);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (asciiTest);
+    CPPUNIT_TEST (encodeTest);
+    CPPUNIT_TEST (decodeTest);
+    CPPUNIT_TEST (invalidEncodeTest);
+    CPPUNIT_TEST (invalidDecodeTest);
+    CPPUNIT_TEST (roundTripTest);
+    CPPUNIT_TEST (fstringTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Methods
+    static std::string encode (const std::wstring&);
+    static std::wstring decode (const std::string&);
+};
+
+//----------------------------------------------------------------------
+std::string FUTF8Test::encode (const std::wstring& str)
+{
+  const auto size = finalcut::getUTF8Length(str.data(), str.length());
+  std::string dest(size, '\0');
+  const auto len = finalcut::encodeUTF8(str.data(), str.length(), &dest[0]);
+  CPPUNIT_ASSERT ( len == size );
+  return dest;
+}
+
+//----------------------------------------------------------------------
+std::wstring FUTF8Test::decode (const std::string& str)
+{
+  std::vector<wchar_t> dest(str.length() + 1);
+  const auto len = finalcut::decodeUTF8(str.data(), str.length(), dest.data());
+  return std::wstring(dest.data(), len);
+}
+
+//----------------------------------------------------------------------
+void FUTF8Test::asciiTest()
+{
+  // Strings longer than one 16 character block
+  const std::string ascii{"The quick brown fox jumps over the lazy dog"};
+  CPPUNIT_ASSERT ( finalcut::isASCII(ascii.data(), ascii.length()) );
+  CPPUNIT_ASSERT ( finalcut::isASCII("", 0) );
+
+  for (std::size_t pos{0}; pos < ascii.length(); pos++)
+  {
+    std::string str{ascii};
+    str[pos] = '\xc3';
+    CPPUNIT_ASSERT ( ! finalcut::isASCII(str.data(), str.length()) );
+  }
+
+  const std::wstring wide{L"The quick brown fox jumps over the lazy dog"};
+  CPPUNIT_ASSERT ( finalcut::getUTF8Length(wide.data(), wide.length())
+                   == wide.length() );
+  CPPUNIT_ASSERT ( encode(wide) == ascii );
+  CPPUNIT_ASSERT ( decode(ascii) == wide );
+}
+
+//----------------------------------------------------------------------
+void FUTF8Test::encodeTest()
+{
+  CPPUNIT_ASSERT ( encode(L"") == "" );
+  CPPUNIT_ASSERT ( encode(L"A") == "A" );
+  CPPUNIT_ASSERT ( encode(L"ä") == "\xc3\xa4" );
+  CPPUNIT_ASSERT ( encode(L"߿") == "\xdf\xbf" );
+  CPPUNIT_ASSERT ( encode(L"ࠀ") == "\xe0\xa0\x80" );
+  CPPUNIT_ASSERT ( encode(L"▒") == "\xe2\x96\x92" );
+  CPPUNIT_ASSERT ( encode(L"￿") == "\xef\xbf\xbf" );
+  CPPUNIT_ASSERT ( encode(std::wstring(1, wchar_t(0x1f600)))
+                   == "\xf0\x9f\x98\x80" );
+  CPPUNIT_ASSERT ( encode(std::wstring(1, wchar_t(0x10ffff)))
+                   == "\xf4\x8f\xbf\xbf" );
+
+  // Non-ASCII character inside a 16 character block
+  const std::wstring mixed{L"0123456789abcäef0123456789"};
+  CPPUNIT_ASSERT ( finalcut::getUTF8Length(mixed.data(), mixed.length())
+                   == mixed.length() + 1 );
+  CPPUNIT_ASSERT ( encode(mixed) == "0123456789abc\xc3\xa4" "ef0123456789" );
+}
+
+//----------------------------------------------------------------------
+void FUTF8Test::decodeTest()
+{
+  CPPUNIT_ASSERT ( decode("") == L"" );
+  CPPUNIT_ASSERT ( decode("A") == L"A" );
+  CPPUNIT_ASSERT ( decode("\xc3\xa4") == L"ä" );
+  CPPUNIT_ASSERT ( decode("\xe2\x96\x92") == L"▒" );
+  CPPUNIT_ASSERT ( decode("\xf0\x9f\x98\x80")
+                   == std::wstring(1, wchar_t(0x1f600)) );
+  CPPUNIT_ASSERT ( decode("0123456789abcdef\xc3\xa4" "0123456789abcdef")
+                   == L"0123456789abcdefä0123456789abcdef" );
+  CPPUNIT_ASSERT ( decode("Gr\xc3\xbc\xc3\x9f" "e") == L"Grüße" );
+}
+
+//----------------------------------------------------------------------
+void FUTF8Test::invalidEncodeTest()
+{
+  // Surrogates and values above U+10FFFF become U+FFFD
+  const std::string replacement{"\xef\xbf\xbd"};
+  CPPUNIT_ASSERT ( encode(std::wstring(1, wchar_t(0xd800))) == replacement );
+  CPPUNIT_ASSERT ( encode(std::wstring(1, wchar_t(0xdfff))) == replacement );
+  CPPUNIT_ASSERT ( encode(std::wstring(1, wchar_t(0x110000)))
+                   == replacement );
+  CPPUNIT_ASSERT ( encode(std::wstring(1, wchar_t(-1))) == replacement );
+}
+
+//----------------------------------------------------------------------
+void FUTF8Test::invalidDecodeTest()
+{
+  // Every byte of a malformed sequence becomes U+FFFD
+  CPPUNIT_ASSERT ( decode("\x80") == L"�" );
+  CPPUNIT_ASSERT ( decode("a\xbf" "b") == L"a�b" );
+  CPPUNIT_ASSERT ( decode("\xc0\x80") == L"��" );  // Overlong
+  CPPUNIT_ASSERT ( decode("\xe0\x80\x80") == L"���" );
+  CPPUNIT_ASSERT ( decode("\xed\xa0\x80") == L"���" );
+  CPPUNIT_ASSERT ( decode("\xf4\x90\x80\x80")
+                   == L"����" );  // > U+10FFFF
+  CPPUNIT_ASSERT ( decode("\xf5\x80") == L"��" );
+  CPPUNIT_ASSERT ( decode("\xc3") == L"�" );  // Truncated
+  CPPUNIT_ASSERT ( decode("\xe2\x96" "A") == L"��A" );
+}
+
+//----------------------------------------------------------------------
+void FUTF8Test::roundTripTest()
+{
+  std::wstring wide{};
+
+  for (wchar_t c{1}; c < 0x3000; c += 7)
+    if ( c < 0xd800 || c > 0xdfff )
+      wide += c;
+
+  wide += wchar_t(0x1f600);
+  wide += L"and some trailing ASCII text";
+  CPPUNIT_ASSERT ( decode(encode(wide)) == wide );
+}
+
+//----------------------------------------------------------------------
+void FUTF8Test::fstringTest()
+{
+  // FString uses the transcoder in UTF-8 and ASCII locales
+  const finalcut::FString ascii{std::string{"plain ASCII text"}};
+  CPPUNIT_ASSERT ( ascii == L"plain ASCII text" );
+  CPPUNIT_ASSERT ( ascii.toString() == "plain ASCII text" );
+
+  const finalcut::FString utf8{std::string{"Gr\xc3\xbc\xc3\x9f" "e"}};
+  CPPUNIT_ASSERT ( utf8.getLength() == 5 );
+  CPPUNIT_ASSERT ( utf8 == L"Grüße" );
+  CPPUNIT_ASSERT ( std::string(utf8.c_str()) == "Gr\xc3\xbc\xc3\x9f" "e" );
+  CPPUNIT_ASSERT ( utf8.toString() == "Gr\xc3\xbc\xc3\x9f" "e" );
+  CPPUNIT_ASSERT ( utf8.toString().length() == 7 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FUTF8Test);
+
+// The general unit test main part
+#include <main-test.inc>
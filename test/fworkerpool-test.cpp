@@ -0,0 +1,166 @@
+/***********************************************************************
+* fworkerpool-test.cpp - FWorkerPool unit tests                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FWorkerPoolTest
+//----------------------------------------------------------------------
+
+class FWorkerPoolTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FWorkerPoolTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void threadCountTest();
+    void emptyRunTest();
+    void serialRunTest();
+    void parallelRunTest();
+    void repeatedRunTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FWorkerPoolTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (threadCountTest);
+    CPPUNIT_TEST (emptyRunTest);
+    CPPUNIT_TEST (serialRunTest);
+    CPPUNIT_TEST (parallelRunTest);
+    CPPUNIT_TEST (repeatedRunTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Method
+    void checkAllJobs (finalcut::FWorkerPool&, std::size_t) const;
+};
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::checkAllJobs ( finalcut::FWorkerPool& pool
+                                   , std::size_t count ) const
+{
+  // Every job must run exactly once
+  std::vector<std::atomic<int>> calls(count);
+
+  for (auto&& c : calls)
+    c.store(0);
+
+  pool.run (count, [&calls] (std::size_t n) { calls[n]++; });
+
+  for (auto&& c : calls)
+    CPPUNIT_ASSERT ( c.load() == 1 );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::classNameTest()
+{
+  const finalcut::FWorkerPool pool{1};
+  const finalcut::FString& classname = pool.getClassName();
+  CPPUNIT_ASSERT ( classname == "FWorkerPool" );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::threadCountTest()
+{
+  const finalcut::FWorkerPool p0{0};
+  CPPUNIT_ASSERT ( p0.getThreadCount() == 1 );
+  const finalcut::FWorkerPool p1{1};
+  CPPUNIT_ASSERT ( p1.getThreadCount() == 1 );
+  const finalcut::FWorkerPool p4{4};
+  CPPUNIT_ASSERT ( p4.getThreadCount() == 4 );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::emptyRunTest()
+{
+  finalcut::FWorkerPool pool{3};
+  int calls{0};
+  pool.run (0, [&calls] (std::size_t) { calls++; });
+  CPPUNIT_ASSERT ( calls == 0 );
+
+  // A single job runs in the calling thread
+  const auto caller = std::this_thread::get_id();
+  bool same_thread{false};
+  pool.run ( 1, [&caller, &same_thread] (std::size_t n)
+                {
+                  same_thread = ( n == 0
+                               && std::this_thread::get_id() == caller );
+                } );
+  CPPUNIT_ASSERT ( same_thread );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::serialRunTest()
+{
+  finalcut::FWorkerPool pool{1};
+  std::vector<std::size_t> order{};
+  pool.run (5, [&order] (std::size_t n) { order.push_back(n); });
+  CPPUNIT_ASSERT ( order.size() == 5 );
+
+  for (std::size_t i{0}; i < order.size(); i++)
+    CPPUNIT_ASSERT ( order[i] == i );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::parallelRunTest()
+{
+  finalcut::FWorkerPool pool{4};
+  checkAllJobs (pool, 2);
+  checkAllJobs (pool, 7);
+  checkAllJobs (pool, 1000);
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::repeatedRunTest()
+{
+  finalcut::FWorkerPool pool{3};
+  std::atomic<std::size_t> sum{0};
+
+  for (std::size_t i{0}; i < 200; i++)
+    pool.run (8, [&sum] (std::size_t n) { sum += n; });
+
+  CPPUNIT_ASSERT ( sum.load() == 200 * 28 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FWorkerPoolTest);
+
+// The general unit test main part
+#include <main-test.inc>